@@ -11,6 +11,28 @@ typedef std::size_t Idx;
 /// Idx value so large that it will be invalid as index.
 constexpr std::size_t nil_idx = (std::size_t)-1;
 
+/// The value that represents nil_idx when indices are stored in a smaller
+/// unsigned integer type IndexT, such as std::uint32_t. The indices stored in
+/// IndexT must be less than this value.
+template <typename IndexT>
+constexpr IndexT nilIndex() {
+	return (IndexT)-1;
+}
+
+/// Converts index to the storage type IndexT. nil_idx is converted to
+/// nilIndex<IndexT>().
+template <typename IndexT>
+constexpr IndexT compactIndex(Idx index) {
+	return (IndexT)index;
+}
+
+/// Converts index stored in type IndexT back to Idx, converting
+/// nilIndex<IndexT>() to nil_idx.
+template <typename IndexT>
+constexpr Idx expandIndex(IndexT index) {
+	return index == nilIndex<IndexT>() ? nil_idx : (Idx)index;
+}
+
 }
 
 #endif
@@ -0,0 +1,77 @@
+#ifndef FRIVOL_CONTAINERS_ALLOCATOR_HPP
+#define FRIVOL_CONTAINERS_ALLOCATOR_HPP
+
+#include <memory>
+#include <utility>
+
+namespace frivol {
+namespace containers {
+
+/// The default allocator of the containers that allocate objects of several
+/// types, such as the priority queues and the search trees, and of Policy.
+typedef std::allocator<char> DefaultAllocator;
+
+/// The allocator type AllocatorT rebound to allocate objects of type T. The
+/// containers take an allocator of any value type and rebind it to the types
+/// they allocate.
+template <typename AllocatorT, typename T>
+using RebindAllocator = typename std::allocator_traits<AllocatorT>::template rebind_alloc<T>;
+
+/// Deleter for std::unique_ptr that destroys the object and releases its
+/// memory through a copy of the allocator that allocated it. Used for objects
+/// created with allocateObject.
+/// @tparam T The type of the deleted objects.
+/// @tparam AllocatorT The allocator, of any value type.
+template <typename T, typename AllocatorT>
+class AllocatorDelete {
+public:
+	/// Constructs deleter with a default-constructed allocator, for empty
+	/// pointers.
+	AllocatorDelete() { }
+	
+	/// Constructs deleter that releases the memory through given allocator.
+	/// @param allocator The allocator, rebound to T.
+	AllocatorDelete(const AllocatorT& allocator) : allocator_(allocator) { }
+	
+	void operator()(T* ptr) {
+		ptr->~T();
+		std::allocator_traits<RebindAllocator<AllocatorT, T>>::deallocate(allocator_, ptr, 1);
+	}
+	
+	/// Returns a copy of the allocator of the deleter.
+	AllocatorT getAllocator() const {
+		return AllocatorT(allocator_);
+	}
+	
+private:
+	RebindAllocator<AllocatorT, T> allocator_;
+};
+
+/// AllocatorDelete as a template of the deleted type only, for the templates
+/// that take the deleter as a template template parameter, such as AVLNode.
+/// @tparam AllocatorT The allocator, of any value type.
+template <typename AllocatorT>
+struct AllocatorDeleteFor {
+	template <typename T>
+	using Type = AllocatorDelete<T, AllocatorT>;
+};
+
+/// Owning pointer to an object created with allocateObject.
+template <typename T, typename AllocatorT>
+using AllocatorPtr = std::unique_ptr<T, AllocatorDelete<T, AllocatorT>>;
+
+/// Allocates memory for an object of type T through an allocator and
+/// constructs the object in it. The returned pointer keeps a copy of the
+/// allocator to release the memory.
+/// @param allocator The allocator, of any value type.
+/// @param args The arguments passed to the constructor of T.
+/// @returns owning pointer to the new object.
+template <typename T, typename AllocatorT, typename... ArgsT>
+AllocatorPtr<T, AllocatorT> allocateObject(const AllocatorT& allocator, ArgsT&&... args);
+
+}
+}
+
+#include "allocator_impl.hpp"
+
+#endif
@@ -0,0 +1,19 @@
+namespace frivol {
+namespace containers {
+
+template <typename T, typename AllocatorT, typename... ArgsT>
+AllocatorPtr<T, AllocatorT> allocateObject(const AllocatorT& allocator, ArgsT&&... args) {
+	typedef RebindAllocator<AllocatorT, T> TAllocatorT;
+	TAllocatorT t_allocator(allocator);
+	T* ptr = std::allocator_traits<TAllocatorT>::allocate(t_allocator, 1);
+	try {
+		::new((void*)ptr) T(std::forward<ArgsT>(args)...);
+	} catch(...) {
+		std::allocator_traits<TAllocatorT>::deallocate(t_allocator, ptr, 1);
+		throw;
+	}
+	return AllocatorPtr<T, AllocatorT>(ptr, AllocatorDelete<T, AllocatorT>(allocator));
+}
+
+}
+}
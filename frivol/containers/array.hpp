@@ -2,28 +2,64 @@
 #define FRIVOL_CONTAINERS_ARRAY_HPP
 
 #include <frivol/common.hpp>
+#include <frivol/containers/allocator.hpp>
+#include <frivol/memory_usage.hpp>
 
 #include <boost/concept_check.hpp>
 
 #include <memory>
 #include <stdexcept>
+#include <type_traits>
 
 namespace frivol {
 namespace containers {
 
-/// Simple fixed-size array.
+/// Tag type for the constructors of the arrays that leave the elements
+/// uninitialized.
+struct NoInit { };
+
+/// Tag value of type NoInit.
+constexpr NoInit no_init = NoInit();
+
+/// Simple fixed-size array. The elements are stored in raw storage and
+/// constructed in place, so that trivially copyable elements can be left
+/// uninitialized and moved with memcpy.
 /// @tparam T The type of stored elements. Should be default constructible.
-template <typename T>
+/// @tparam AllocatorT The allocator used for the storage, rebound to T. The
+/// array keeps the allocator given to its constructor, so the allocator may
+/// be stateful. It is moved along with the elements, and a copy of the array
+/// gets the allocator selected by select_on_container_copy_construction.
+template <typename T, typename AllocatorT = std::allocator<T>>
 class Array {
 public:
 	BOOST_CONCEPT_ASSERT((boost::DefaultConstructible<T>));
 	
 	/// Creates an array with size 0.
-	Array();
+	/// @param allocator The allocator used for the storage.
+	explicit Array(const AllocatorT& allocator = AllocatorT());
 	
 	/// Creates an array with all elements default-constructed.
 	/// @param size The size of the array.
-	Array(Idx size);
+	/// @param allocator The allocator used for the storage.
+	Array(Idx size, const AllocatorT& allocator = AllocatorT());
+	
+	/// Creates an array with unspecified element values, to be used when all
+	/// elements are assigned before they are read. Trivially copyable
+	/// elements are not initialized at all, so the memory is not touched.
+	/// Other elements are default-constructed.
+	/// @param size The size of the array.
+	/// @param allocator The allocator used for the storage.
+	Array(Idx size, NoInit, const AllocatorT& allocator = AllocatorT());
+	
+	/// Copies the elements of another array to this array.
+	Array(const Array<T, AllocatorT>& other);
+	
+	/// Moves the elements of another array to this array, together with a
+	/// copy of its allocator. The other array is left with size 0.
+	Array(Array<T, AllocatorT>&& other);
+	Array<T, AllocatorT>& operator=(Array<T, AllocatorT>&& other);
+	
+	~Array();
 	
 	/// @{
 	/// Returns reference to an element in the array.
@@ -36,16 +72,76 @@ public:
 	/// Returns the size of the array.
 	Idx getSize() const;
 	
+	/// Returns a copy of the allocator of the array.
+	AllocatorT getAllocator() const;
+	
+	/// Returns the memory allocated for the elements, all of which are in use.
+	MemoryUsage getMemoryUsage() const;
+	
 	/// Resizes the array to size. If size decreases the extra elements are
 	/// removed. If size increases, the new elements are default-constructed.
-	/// The operation may assign the current elements to a new place, and
-	/// therefore pointers to the array may be invalidated.
+	/// The operation may move the current elements to a new place, and
+	/// therefore pointers to the array may be invalidated. If an element
+	/// constructor throws, the array is left unchanged, unless the elements
+	/// can only be moved with a move constructor that may throw.
 	/// @param size The new size.
 	void resize(Idx size);
 	
+	/// Resizes the array to size, keeping the values of only the first
+	/// elements. The other elements have unspecified values as with the
+	/// NoInit constructor. Exception safety is as in resize(size).
+	/// @param size The new size.
+	/// @param preserved The number of elements to keep, at most the current
+	/// size.
+	void resize(Idx size, Idx preserved);
+	
 private:
-	/// The array of elements in the array.
-	std::unique_ptr<T[]> elements_;
+	typedef std::is_trivially_copyable<T> IsTriviallyCopyable;
+	typedef RebindAllocator<AllocatorT, T> TAllocatorT;
+	typedef std::allocator_traits<TAllocatorT> TAllocatorTraits;
+	
+	/// Implements the resize overloads. The new elements are prepared with
+	/// constructNoInit_ with tag NoInitT.
+	template <typename NoInitT>
+	void resize_(Idx size, Idx preserved, NoInitT);
+	
+	/// Allocates raw storage for size elements through allocator_.
+	T* allocate_(Idx size);
+	
+	/// Releases raw storage returned by allocate_.
+	void deallocate_(T* elements, Idx size);
+	
+	/// Destroys the elements and releases the storage.
+	void release_();
+	
+	/// Default-constructs count elements starting from begin. If a
+	/// constructor throws, the elements constructed so far are destroyed.
+	static void construct_(T* begin, Idx count);
+	
+	/// Destroys count elements starting from begin.
+	static void destroy_(T* begin, Idx count);
+	
+	/// Prepares count elements starting from begin to be assigned, leaving
+	/// trivially copyable elements uninitialized.
+	static void constructNoInit_(T* begin, Idx count, std::true_type);
+	static void constructNoInit_(T* begin, Idx count, std::false_type);
+	
+	/// Moves count elements from src to uninitialized storage at dest and
+	/// destroys the source elements. If a constructor throws, the source
+	/// elements are left intact.
+	static void relocate_(T* src, Idx count, T* dest, std::true_type);
+	static void relocate_(T* src, Idx count, T* dest, std::false_type);
+	
+	/// Copies count elements from src to uninitialized storage at dest. If a
+	/// constructor throws, the copies made so far are destroyed.
+	static void copy_(const T* src, Idx count, T* dest, std::true_type);
+	static void copy_(const T* src, Idx count, T* dest, std::false_type);
+	
+	/// The allocator of the storage.
+	TAllocatorT allocator_;
+	
+	/// The storage of the elements.
+	T* elements_;
 	
 	/// Number of elements in the array.
 	Idx size_;
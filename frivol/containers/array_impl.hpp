@@ -1,53 +1,243 @@
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
 namespace frivol {
 namespace containers {
 
-template <typename T>
-Array<T>::Array() : Array(0) { }
+template <typename T, typename AllocatorT>
+Array<T, AllocatorT>::Array(const AllocatorT& allocator) : Array(0, allocator) { }
+
+template <typename T, typename AllocatorT>
+Array<T, AllocatorT>::Array(Idx size, const AllocatorT& allocator)
+	: allocator_(allocator),
+	  elements_(allocate_(size)),
+	  size_(size)
+{
+	try {
+		construct_(elements_, size_);
+	} catch(...) {
+		deallocate_(elements_, size_);
+		throw;
+	}
+}
 
-template <typename T>
-Array<T>::Array(Idx size)
-	: elements_(new T[size]),
+template <typename T, typename AllocatorT>
+Array<T, AllocatorT>::Array(Idx size, NoInit, const AllocatorT& allocator)
+	: allocator_(allocator),
+	  elements_(allocate_(size)),
 	  size_(size)
-{ }
+{
+	try {
+		constructNoInit_(elements_, size_, IsTriviallyCopyable());
+	} catch(...) {
+		deallocate_(elements_, size_);
+		throw;
+	}
+}
+
+template <typename T, typename AllocatorT>
+Array<T, AllocatorT>::Array(const Array<T, AllocatorT>& other)
+	: allocator_(TAllocatorTraits::select_on_container_copy_construction(other.allocator_)),
+	  elements_(allocate_(other.size_)),
+	  size_(other.size_)
+{
+	try {
+		copy_(other.elements_, size_, elements_, IsTriviallyCopyable());
+	} catch(...) {
+		deallocate_(elements_, size_);
+		throw;
+	}
+}
+
+template <typename T, typename AllocatorT>
+Array<T, AllocatorT>::Array(Array<T, AllocatorT>&& other)
+	: allocator_(other.allocator_),
+	  elements_(other.elements_),
+	  size_(other.size_)
+{
+	other.elements_ = nullptr;
+	other.size_ = 0;
+}
+
+template <typename T, typename AllocatorT>
+Array<T, AllocatorT>& Array<T, AllocatorT>::operator=(Array<T, AllocatorT>&& other) {
+	if(this != &other) {
+		// The old storage is released through the old allocator, and the
+		// allocator of the storage of 'other' comes along with it.
+		release_();
+		allocator_ = other.allocator_;
+		elements_ = other.elements_;
+		size_ = other.size_;
+		other.elements_ = nullptr;
+		other.size_ = 0;
+	}
+	return *this;
+}
 
-template <typename T>
-const T& Array<T>::operator[](Idx index) const {
+template <typename T, typename AllocatorT>
+Array<T, AllocatorT>::~Array() {
+	release_();
+}
+
+template <typename T, typename AllocatorT>
+const T& Array<T, AllocatorT>::operator[](Idx index) const {
 #ifdef FRIVOL_ARRAY_BOUNDS_CHECKING
 	if(index >= getSize()) {
 		throw std::out_of_range("Array<T>::operator[] const: Array index out of bounds.");
 	}
 #endif
-	
+
 	return elements_[index];
 }
 
-template <typename T>
-T& Array<T>::operator[](Idx index) {
+template <typename T, typename AllocatorT>
+T& Array<T, AllocatorT>::operator[](Idx index) {
 #ifdef FRIVOL_ARRAY_BOUNDS_CHECKING
 	if(index >= getSize()) {
 		throw std::out_of_range("Array<T>::operator[]: Array index out of bounds.");
 	}
 #endif
-	
+
 	return elements_[index];
 }
 
-template <typename T>
-Idx Array<T>::getSize() const {
+template <typename T, typename AllocatorT>
+Idx Array<T, AllocatorT>::getSize() const {
 	return size_;
 }
 
-template <typename T>
-void Array<T>::resize(Idx size) {
-	BOOST_CONCEPT_ASSERT((boost::Assignable<T>));
-	
-	std::unique_ptr<T[]> new_elements(new T[size]);
-	for(Idx i = 0; i < size_ && i < size; ++i) {
-		new_elements[i] = elements_[i];
+template <typename T, typename AllocatorT>
+AllocatorT Array<T, AllocatorT>::getAllocator() const {
+	return AllocatorT(allocator_);
+}
+
+template <typename T, typename AllocatorT>
+MemoryUsage Array<T, AllocatorT>::getMemoryUsage() const {
+	return MemoryUsage(size_ * sizeof(T), size_ * sizeof(T));
+}
+
+template <typename T, typename AllocatorT>
+void Array<T, AllocatorT>::resize(Idx size) {
+	resize_(size, std::min(size_, size), std::false_type());
+}
+
+template <typename T, typename AllocatorT>
+void Array<T, AllocatorT>::resize(Idx size, Idx preserved) {
+	resize_(size, preserved, IsTriviallyCopyable());
+}
+
+template <typename T, typename AllocatorT>
+template <typename NoInitT>
+void Array<T, AllocatorT>::resize_(Idx size, Idx preserved, NoInitT) {
+	// Construct the new elements before relocating the old ones, so that the
+	// array is left unchanged if either throws.
+	T* new_elements = allocate_(size);
+	try {
+		constructNoInit_(new_elements + preserved, size - preserved, NoInitT());
+	} catch(...) {
+		deallocate_(new_elements, size);
+		throw;
+	}
+	try {
+		relocate_(elements_, preserved, new_elements, IsTriviallyCopyable());
+	} catch(...) {
+		destroy_(new_elements + preserved, size - preserved);
+		deallocate_(new_elements, size);
+		throw;
 	}
 	
+	// The relocated elements were already destroyed.
+	destroy_(elements_ + preserved, size_ - preserved);
+	deallocate_(elements_, size_);
+	
+	elements_ = new_elements;
 	size_ = size;
-	elements_ = std::move(new_elements);
+}
+
+template <typename T, typename AllocatorT>
+T* Array<T, AllocatorT>::allocate_(Idx size) {
+	return TAllocatorTraits::allocate(allocator_, size);
+}
+
+template <typename T, typename AllocatorT>
+void Array<T, AllocatorT>::deallocate_(T* elements, Idx size) {
+	TAllocatorTraits::deallocate(allocator_, elements, size);
+}
+
+template <typename T, typename AllocatorT>
+void Array<T, AllocatorT>::release_() {
+	if(elements_ == nullptr) return;
+	destroy_(elements_, size_);
+	deallocate_(elements_, size_);
+}
+
+template <typename T, typename AllocatorT>
+void Array<T, AllocatorT>::construct_(T* begin, Idx count) {
+	Idx i = 0;
+	try {
+		for(; i < count; ++i) {
+			::new((void*)(begin + i)) T;
+		}
+	} catch(...) {
+		destroy_(begin, i);
+		throw;
+	}
+}
+
+template <typename T, typename AllocatorT>
+void Array<T, AllocatorT>::destroy_(T* begin, Idx count) {
+	for(Idx i = 0; i < count; ++i) {
+		begin[i].~T();
+	}
+}
+
+template <typename T, typename AllocatorT>
+void Array<T, AllocatorT>::constructNoInit_(T*, Idx, std::true_type) { }
+
+template <typename T, typename AllocatorT>
+void Array<T, AllocatorT>::constructNoInit_(T* begin, Idx count, std::false_type) {
+	construct_(begin, count);
+}
+
+template <typename T, typename AllocatorT>
+void Array<T, AllocatorT>::relocate_(T* src, Idx count, T* dest, std::true_type) {
+	if(count != 0) std::memcpy((void*)dest, (const void*)src, count * sizeof(T));
+}
+
+template <typename T, typename AllocatorT>
+void Array<T, AllocatorT>::relocate_(T* src, Idx count, T* dest, std::false_type) {
+	// The source elements are destroyed only after all have been moved, and
+	// elements whose move constructor may throw are copied instead, so that
+	// the source is intact if a constructor throws.
+	Idx i = 0;
+	try {
+		for(; i < count; ++i) {
+			::new((void*)(dest + i)) T(std::move_if_noexcept(src[i]));
+		}
+	} catch(...) {
+		destroy_(dest, i);
+		throw;
+	}
+	destroy_(src, count);
+}
+
+template <typename T, typename AllocatorT>
+void Array<T, AllocatorT>::copy_(const T* src, Idx count, T* dest, std::true_type) {
+	if(count != 0) std::memcpy((void*)dest, (const void*)src, count * sizeof(T));
+}
+
+template <typename T, typename AllocatorT>
+void Array<T, AllocatorT>::copy_(const T* src, Idx count, T* dest, std::false_type) {
+	Idx i = 0;
+	try {
+		for(; i < count; ++i) {
+			::new((void*)(dest + i)) T(src[i]);
+		}
+	} catch(...) {
+		destroy_(dest, i);
+		throw;
+	}
 }
 
 }
@@ -8,19 +8,38 @@ namespace frivol {
 namespace containers {
 
 /// Array that is more efficient at adding elements to the end than a regular
-/// array because DynamicArray constructs more elements in advance.
+/// array because DynamicArray reserves space for more elements in advance.
 /// @tparam T The type of stored elements. Should be default constructible.
-template <typename T>
+/// @tparam AllocatorT The allocator used for the storage (see Array).
+template <typename T, typename AllocatorT = std::allocator<T>>
 class DynamicArray {
 public:
 	BOOST_CONCEPT_ASSERT((boost::DefaultConstructible<T>));
 	
 	/// Creates a dynamic array of size 0.
-	DynamicArray();
+	/// @param allocator The allocator used for the storage.
+	explicit DynamicArray(const AllocatorT& allocator = AllocatorT());
 	
 	/// Creates a dynamic array with all elements default-constructed.
 	/// @param size The size of the array.
-	DynamicArray(Idx size);
+	/// @param allocator The allocator used for the storage.
+	DynamicArray(Idx size, const AllocatorT& allocator = AllocatorT());
+	
+	/// Creates a dynamic array with unspecified element values, like the NoInit
+	/// constructor of Array.
+	/// @param size The size of the array.
+	/// @param allocator The allocator used for the storage.
+	DynamicArray(Idx size, NoInit, const AllocatorT& allocator = AllocatorT());
+	
+	/// Copies the elements of another dynamic array, reserving capacity only
+	/// for them. The allocator is selected as in the copy constructor of
+	/// Array.
+	DynamicArray(const DynamicArray<T, AllocatorT>& other);
+	
+	/// Moves the elements and the capacity of another dynamic array to this
+	/// array, as in the move operations of Array.
+	DynamicArray(DynamicArray<T, AllocatorT>&& other) = default;
+	DynamicArray<T, AllocatorT>& operator=(DynamicArray<T, AllocatorT>&& other) = default;
 	
 	/// @{
 	/// Returns reference to an element in the array.
@@ -33,6 +52,37 @@ public:
 	/// Returns the size of the array.
 	Idx getSize() const;
 	
+	/// Returns the number of elements the array can contain without
+	/// allocating memory.
+	Idx getCapacity() const;
+	
+	/// Returns a copy of the allocator of the array.
+	AllocatorT getAllocator() const;
+	
+	/// Returns the memory allocated for the capacity, of which the elements
+	/// up to the size are in use.
+	MemoryUsage getMemoryUsage() const;
+	
+	/// Resizes the array to size. The capacity is never decreased, so resizing
+	/// to at most the largest size so far does not allocate memory. If the
+	/// size increases, the values of the new elements are unspecified: they
+	/// may be left uninitialized or from earlier use of the array.
+	/// @param size The new size.
+	void resize(Idx size);
+	
+	/// Sets the size of the array to 0, keeping the capacity.
+	void clear();
+	
+	/// Increases the capacity to at least capacity, so that the array can
+	/// grow to that size without further allocations. Does nothing if the
+	/// capacity is already large enough.
+	/// @param capacity The minimum capacity.
+	void reserve(Idx capacity);
+	
+	/// Decreases the capacity to the size of the array, releasing the unused
+	/// memory.
+	void shrinkToFit();
+	
 	/// Adds given element to the end of the dynamic array, increasing its size
 	/// by one.
 	/// @param element The element to add.
@@ -40,8 +90,13 @@ public:
 	Idx add(const T& element);
 	
 private:
+	/// Moves the elements to a new array of given capacity. Only the first
+	/// size_ elements are moved, and the rest are left uninitialized.
+	/// @param capacity The new capacity, at least size_.
+	void reallocate_(Idx capacity);
+	
 	/// Array containing the elements. May be larger than size_.
-	Array<T> elements_;
+	Array<T, AllocatorT> elements_;
 	
 	/// The size of the dynamic array.
 	Idx size_;
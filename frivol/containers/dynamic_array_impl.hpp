@@ -1,52 +1,112 @@
+#include <algorithm>
+
 namespace frivol {
 namespace containers {
 
-template <typename T>
-DynamicArray<T>::DynamicArray() : DynamicArray(0) { }
+template <typename T, typename AllocatorT>
+DynamicArray<T, AllocatorT>::DynamicArray(const AllocatorT& allocator) : DynamicArray(0, allocator) { }
 
-template <typename T>
-DynamicArray<T>::DynamicArray(Idx size)
-	: elements_(size),
+template <typename T, typename AllocatorT>
+DynamicArray<T, AllocatorT>::DynamicArray(Idx size, const AllocatorT& allocator)
+	: elements_(size, allocator),
 	  size_(size)
 {
-	
+
+}
+
+template <typename T, typename AllocatorT>
+DynamicArray<T, AllocatorT>::DynamicArray(Idx size, NoInit, const AllocatorT& allocator)
+	: elements_(size, no_init, allocator),
+	  size_(size)
+{ }
+
+template <typename T, typename AllocatorT>
+DynamicArray<T, AllocatorT>::DynamicArray(const DynamicArray<T, AllocatorT>& other)
+	: elements_(
+		other.size_,
+		no_init,
+		std::allocator_traits<AllocatorT>::select_on_container_copy_construction(other.getAllocator())
+	  ),
+	  size_(other.size_)
+{
+	for(Idx i = 0; i < size_; ++i) {
+		elements_[i] = other.elements_[i];
+	}
 }
 
-template <typename T>
-const T& DynamicArray<T>::operator[](Idx index) const {
+template <typename T, typename AllocatorT>
+const T& DynamicArray<T, AllocatorT>::operator[](Idx index) const {
 #ifdef FRIVOL_ARRAY_BOUNDS_CHECKING
 	if(index >= getSize()) {
 		throw std::out_of_range("DynamicArray<T>::operator[] const: Array index out of bounds.");
 	}
 #endif
-	
+
 	return elements_[index];
 }
 
-template <typename T>
-T& DynamicArray<T>::operator[](Idx index) {
+template <typename T, typename AllocatorT>
+T& DynamicArray<T, AllocatorT>::operator[](Idx index) {
 #ifdef FRIVOL_ARRAY_BOUNDS_CHECKING
 	if(index >= getSize()) {
 		throw std::out_of_range("DynamicArray<T>::operator[] const: Array index out of bounds.");
 	}
 #endif
-	
+
 	return elements_[index];
 }
 
-template <typename T>
-Idx DynamicArray<T>::getSize() const {
+template <typename T, typename AllocatorT>
+Idx DynamicArray<T, AllocatorT>::getSize() const {
 	return size_;
 }
 
-template <typename T>
-Idx DynamicArray<T>::add(const T& element) {
+template <typename T, typename AllocatorT>
+AllocatorT DynamicArray<T, AllocatorT>::getAllocator() const {
+	return elements_.getAllocator();
+}
+
+template <typename T, typename AllocatorT>
+MemoryUsage DynamicArray<T, AllocatorT>::getMemoryUsage() const {
+	return MemoryUsage(elements_.getSize() * sizeof(T), size_ * sizeof(T));
+}
+
+template <typename T, typename AllocatorT>
+Idx DynamicArray<T, AllocatorT>::getCapacity() const {
+	return elements_.getSize();
+}
+
+template <typename T, typename AllocatorT>
+void DynamicArray<T, AllocatorT>::resize(Idx size) {
+	if(size > elements_.getSize()) {
+		reallocate_(std::max(size, 2 * elements_.getSize()));
+	}
+	size_ = size;
+}
+
+template <typename T, typename AllocatorT>
+void DynamicArray<T, AllocatorT>::clear() {
+	size_ = 0;
+}
+
+template <typename T, typename AllocatorT>
+void DynamicArray<T, AllocatorT>::reserve(Idx capacity) {
+	if(capacity > elements_.getSize()) {
+		reallocate_(capacity);
+	}
+}
+
+template <typename T, typename AllocatorT>
+void DynamicArray<T, AllocatorT>::shrinkToFit() {
+	if(size_ < elements_.getSize()) {
+		reallocate_(size_);
+	}
+}
+
+template <typename T, typename AllocatorT>
+Idx DynamicArray<T, AllocatorT>::add(const T& element) {
 	if(elements_.getSize() == size_) {
-		if(size_ == 0) {
-			elements_.resize(1);
-		} else {
-			elements_.resize(2 * size_);
-		}
+		reallocate_(std::max(2 * size_, (Idx)1));
 	}
 	
 	elements_[size_] = element;
@@ -55,5 +115,10 @@ Idx DynamicArray<T>::add(const T& element) {
 	return size_ - 1;
 }
 
+template <typename T, typename AllocatorT>
+void DynamicArray<T, AllocatorT>::reallocate_(Idx capacity) {
+	elements_.resize(capacity, size_);
+}
+
 }
 }
@@ -0,0 +1,166 @@
+#ifndef FRIVOL_CONTAINERS_ORDERED_KEY_TRAITS_HPP
+#define FRIVOL_CONTAINERS_ORDERED_KEY_TRAITS_HPP
+
+#include <frivol/common.hpp>
+
+#include <boost/concept_check.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace frivol {
+namespace containers {
+
+/// Traits class that maps values of type T to unsigned integer keys that are
+/// ordered in the same way as the values. Used by priority queues that
+/// operate on the bits of the priorities, such as RadixHeap.
+/// @tparam T The type of the values.
+template <typename T>
+struct OrderedKeyTraits { };
+
+/// Concept for checking that OrderedKeyTraits is implemented for type T.
+/// Required members are:
+///  - typedef Key, the key type. Should be default constructible to the
+///    smallest key, copyable and ordered with the < and == operators.
+///  - static constexpr Idx bits, the number of bits in the key.
+///  - Key getKey(T value) returns the key of value. For values a and b,
+///    getKey(a) < getKey(b) if and only if a < b.
+///  - Idx getDifferingBitCount(Key a, Key b) returns 0 if a == b, and
+///    otherwise one plus the position of the most significant bit in which
+///    a and b differ, in range 1, ..., bits.
+/// 
+/// @tparam T The type of the values.
+template <typename T>
+class OrderedKeyTraitsImplementedConcept {
+public:
+	BOOST_CONCEPT_USAGE(OrderedKeyTraitsImplementedConcept) {
+		typedef OrderedKeyTraits<T> Traits;
+		typedef typename Traits::Key Key;
+		BOOST_CONCEPT_ASSERT((boost::DefaultConstructible<Key>));
+		BOOST_CONCEPT_ASSERT((boost::LessThanComparable<Key>));
+		BOOST_CONCEPT_ASSERT((boost::EqualityComparable<Key>));
+		
+		Key key = Traits::getKey(value);
+		sameType(Traits::getDifferingBitCount(key, key), Idx());
+		sameType((Idx)Traits::bits, Idx());
+	}
+	
+private:
+	T value;
+	
+	/// Function that causes compile time error if called with parameters of
+	/// different types.
+	template <typename U>
+	void sameType(const U&, const U&);
+};
+
+// Implementations of OrderedKeyTraits for basic types.
+
+/// Implementation of OrderedKeyTraits for unsigned integer types.
+template <typename T>
+struct OrderedKeyTraitsUnsigned {
+	typedef T Key;
+	static constexpr Idx bits = std::numeric_limits<T>::digits;
+	
+	static Key getKey(T value);
+	static Idx getDifferingBitCount(Key a, Key b);
+};
+
+/// Implementation of OrderedKeyTraits for signed integer types. The sign bit
+/// is flipped so that the negative values come first.
+template <typename T>
+struct OrderedKeyTraitsSigned {
+	typedef typename std::make_unsigned<T>::type Key;
+	static constexpr Idx bits = std::numeric_limits<Key>::digits;
+	
+	static Key getKey(T value);
+	static Idx getDifferingBitCount(Key a, Key b);
+};
+
+/// Implementation of OrderedKeyTraits for IEEE 754 floating point types
+/// (float and double). The key is the bit pattern of the value, in which the
+/// sign bit is flipped for positive values and all bits are flipped for
+/// negative values. Negative zero gets the same key as positive zero. NaN
+/// values are not supported. In addition to OrderedKeyTraits, has member
+/// getValue for decoding the keys.
+/// @tparam KeyT Unsigned integer type of the same size as T.
+template <typename T, typename KeyT>
+struct OrderedKeyTraitsFloat {
+	static_assert(
+		std::numeric_limits<T>::is_iec559 && sizeof(T) == sizeof(KeyT),
+		"OrderedKeyTraitsFloat: the type must be IEEE 754 and of the key size."
+	);
+	
+	typedef KeyT Key;
+	static constexpr Idx bits = std::numeric_limits<KeyT>::digits;
+	
+	static Key getKey(T value);
+	static Idx getDifferingBitCount(Key a, Key b);
+	
+	/// Returns the value of given key, the inverse of getKey.
+	static T getValue(Key key);
+};
+
+/// Implementation of OrderedKeyTraits for pairs, ordered lexicographically.
+/// The key is the pair of the keys of the elements.
+template <typename FirstT, typename SecondT>
+struct OrderedKeyTraitsPair {
+	typedef OrderedKeyTraits<FirstT> FirstTraits;
+	typedef OrderedKeyTraits<SecondT> SecondTraits;
+	
+	typedef std::pair<typename FirstTraits::Key, typename SecondTraits::Key> Key;
+	static constexpr Idx bits = FirstTraits::bits + SecondTraits::bits;
+	
+	static Key getKey(const FirstT& first, const SecondT& second);
+	static Key getKey(const std::pair<FirstT, SecondT>& value);
+	static Idx getDifferingBitCount(const Key& a, const Key& b);
+};
+
+template <typename T>
+constexpr Idx OrderedKeyTraitsUnsigned<T>::bits;
+template <typename T>
+constexpr Idx OrderedKeyTraitsSigned<T>::bits;
+template <typename T, typename KeyT>
+constexpr Idx OrderedKeyTraitsFloat<T, KeyT>::bits;
+template <typename FirstT, typename SecondT>
+constexpr Idx OrderedKeyTraitsPair<FirstT, SecondT>::bits;
+
+template <>
+struct OrderedKeyTraits<unsigned char> : OrderedKeyTraitsUnsigned<unsigned char> { };
+template <>
+struct OrderedKeyTraits<unsigned short> : OrderedKeyTraitsUnsigned<unsigned short> { };
+template <>
+struct OrderedKeyTraits<unsigned int> : OrderedKeyTraitsUnsigned<unsigned int> { };
+template <>
+struct OrderedKeyTraits<unsigned long> : OrderedKeyTraitsUnsigned<unsigned long> { };
+template <>
+struct OrderedKeyTraits<unsigned long long> : OrderedKeyTraitsUnsigned<unsigned long long> { };
+
+template <>
+struct OrderedKeyTraits<signed char> : OrderedKeyTraitsSigned<signed char> { };
+template <>
+struct OrderedKeyTraits<short> : OrderedKeyTraitsSigned<short> { };
+template <>
+struct OrderedKeyTraits<int> : OrderedKeyTraitsSigned<int> { };
+template <>
+struct OrderedKeyTraits<long> : OrderedKeyTraitsSigned<long> { };
+template <>
+struct OrderedKeyTraits<long long> : OrderedKeyTraitsSigned<long long> { };
+
+template <>
+struct OrderedKeyTraits<float> : OrderedKeyTraitsFloat<float, std::uint32_t> { };
+template <>
+struct OrderedKeyTraits<double> : OrderedKeyTraitsFloat<double, std::uint64_t> { };
+
+template <typename FirstT, typename SecondT>
+struct OrderedKeyTraits<std::pair<FirstT, SecondT>>
+	: OrderedKeyTraitsPair<FirstT, SecondT> { };
+
+}
+}
+
+#include "ordered_key_traits_impl.hpp"
+
+#endif
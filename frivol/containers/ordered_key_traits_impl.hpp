@@ -0,0 +1,111 @@
+#include <cstring>
+
+namespace frivol {
+namespace containers {
+
+/// Returns the number of bits needed to represent an unsigned integer, i.e.
+/// one plus the position of the most significant set bit, or 0 for 0.
+template <typename T>
+Idx getBitLength(T value) {
+#ifdef __GNUC__
+	if(value == 0) return 0;
+	if(sizeof(T) <= sizeof(unsigned int)) {
+		return std::numeric_limits<unsigned int>::digits - __builtin_clz(value);
+	} else {
+		return std::numeric_limits<unsigned long long>::digits - __builtin_clzll(value);
+	}
+#else
+	Idx length = 0;
+	while(value != 0) {
+		value >>= 1;
+		++length;
+	}
+	return length;
+#endif
+}
+
+template <typename T>
+typename OrderedKeyTraitsUnsigned<T>::Key OrderedKeyTraitsUnsigned<T>::getKey(T value) {
+	return value;
+}
+
+template <typename T>
+Idx OrderedKeyTraitsUnsigned<T>::getDifferingBitCount(Key a, Key b) {
+	return getBitLength<Key>(a ^ b);
+}
+
+template <typename T>
+typename OrderedKeyTraitsSigned<T>::Key OrderedKeyTraitsSigned<T>::getKey(T value) {
+	const Key sign_bit = (Key)1 << (bits - 1);
+	return (Key)value ^ sign_bit;
+}
+
+template <typename T>
+Idx OrderedKeyTraitsSigned<T>::getDifferingBitCount(Key a, Key b) {
+	return getBitLength<Key>(a ^ b);
+}
+
+template <typename T, typename KeyT>
+KeyT OrderedKeyTraitsFloat<T, KeyT>::getKey(T value) {
+	// Normalize negative zero to positive zero.
+	if(value == 0) value = 0;
+	
+	KeyT bit_pattern;
+	std::memcpy(&bit_pattern, &value, sizeof(KeyT));
+	
+	const KeyT sign_bit = (KeyT)1 << (bits - 1);
+	if(bit_pattern & sign_bit) {
+		return ~bit_pattern;
+	} else {
+		return bit_pattern | sign_bit;
+	}
+}
+
+template <typename T, typename KeyT>
+Idx OrderedKeyTraitsFloat<T, KeyT>::getDifferingBitCount(KeyT a, KeyT b) {
+	return getBitLength<KeyT>(a ^ b);
+}
+
+template <typename T, typename KeyT>
+T OrderedKeyTraitsFloat<T, KeyT>::getValue(KeyT key) {
+	const KeyT sign_bit = (KeyT)1 << (bits - 1);
+	
+	KeyT bit_pattern;
+	if(key & sign_bit) {
+		bit_pattern = key ^ sign_bit;
+	} else {
+		bit_pattern = ~key;
+	}
+	
+	T value;
+	std::memcpy(&value, &bit_pattern, sizeof(T));
+	return value;
+}
+
+template <typename FirstT, typename SecondT>
+typename OrderedKeyTraitsPair<FirstT, SecondT>::Key
+OrderedKeyTraitsPair<FirstT, SecondT>::getKey(const FirstT& first, const SecondT& second) {
+	return Key(FirstTraits::getKey(first), SecondTraits::getKey(second));
+}
+
+template <typename FirstT, typename SecondT>
+typename OrderedKeyTraitsPair<FirstT, SecondT>::Key
+OrderedKeyTraitsPair<FirstT, SecondT>::getKey(const std::pair<FirstT, SecondT>& value) {
+	return getKey(value.first, value.second);
+}
+
+template <typename FirstT, typename SecondT>
+Idx OrderedKeyTraitsPair<FirstT, SecondT>::getDifferingBitCount(
+	const Key& a,
+	const Key& b
+) {
+	// The first element is more significant than the second.
+	if(a.first == b.first) {
+		return SecondTraits::getDifferingBitCount(a.second, b.second);
+	} else {
+		return SecondTraits::bits + FirstTraits::getDifferingBitCount(a.first, b.first);
+	}
+}
+
+}
+}
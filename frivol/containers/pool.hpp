@@ -0,0 +1,137 @@
+#ifndef FRIVOL_CONTAINERS_POOL_HPP
+#define FRIVOL_CONTAINERS_POOL_HPP
+
+#include <frivol/common.hpp>
+#include <frivol/containers/allocator.hpp>
+#include <frivol/memory_usage.hpp>
+
+#include <type_traits>
+
+namespace frivol {
+namespace containers {
+
+/// Slab allocator for objects of type T. Memory is allocated in blocks of
+/// slots, and deallocated slots are recycled through a free list, so that
+/// after reserve() no further memory allocations are needed as long as at most
+/// the reserved number of objects are allocated at a time. All memory is
+/// released when the pool is destroyed.
+/// 
+/// The pool only manages raw memory: the objects must be constructed with
+/// placement new after allocate() and destroyed before deallocate().
+/// @tparam T The type of objects allocated from the pool.
+/// @tparam AllocatorT The allocator used for the blocks (see Array).
+template <typename T, typename AllocatorT = std::allocator<T>>
+class Pool {
+public:
+	/// Constructs a pool with no slots.
+	/// @param allocator The allocator used for the blocks.
+	explicit Pool(const AllocatorT& allocator = AllocatorT());
+	
+	Pool(const Pool<T, AllocatorT>&) = delete;
+	Pool<T, AllocatorT>& operator=(const Pool<T, AllocatorT>&) = delete;
+	
+	/// Moves the slots of another pool to this pool, together with a copy of
+	/// its allocator.
+	/// @param other The pool to move from. It is left without slots.
+	Pool(Pool<T, AllocatorT>&& other);
+	
+	/// Swaps the slots and the allocators of this pool and another pool. The
+	/// old slots are released when 'other' is destroyed.
+	/// @param other The pool to move from.
+	Pool<T, AllocatorT>& operator=(Pool<T, AllocatorT>&& other);
+	
+	/// Releases all memory of the pool. Objects still allocated from the pool
+	/// should have been destroyed before this.
+	~Pool();
+	
+	/// Makes sure that the pool has at least 'count' slots in total, allocating
+	/// a new block if needed.
+	/// @param count The number of slots the pool must have.
+	void reserve(Idx count);
+	
+	/// Returns pointer to memory for one object of type T. If there are no
+	/// free slots, a new block is allocated.
+	T* allocate();
+	
+	/// Returns slot to the free list.
+	/// @param ptr Pointer returned by allocate() of this pool. The object in it
+	/// must have been destroyed.
+	void deallocate(T* ptr);
+	
+	/// Returns the total number of slots in the pool.
+	Idx getCapacity() const;
+	
+	/// Returns the number of free slots in the pool.
+	Idx getFreeCount() const;
+	
+	/// Returns the memory of the blocks, of which the slots allocated with
+	/// allocate() are in use.
+	MemoryUsage getMemoryUsage() const;
+	
+	/// Returns the number of bytes that reserve(count) allocates for an empty
+	/// pool.
+	/// @param count The number of slots.
+	static std::size_t estimateMemoryUsage(Idx count);
+	
+private:
+	/// Storage of one object. When the slot is free, it is used to store the
+	/// free list link instead.
+	union Slot {
+		typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+		Slot* next;
+		Idx block_size;
+	};
+	
+	typedef RebindAllocator<AllocatorT, Slot> SlotAllocatorT;
+	typedef std::allocator_traits<SlotAllocatorT> SlotAllocatorTraits;
+	
+	/// Number of slots at the start of each block used for bookkeeping: the
+	/// link to the next block and the total number of slots in the block,
+	/// which is needed to deallocate it.
+	static constexpr Idx block_header_size_ = 2;
+	
+	/// Allocates a new block of slots and adds the slots to the free list.
+	/// The first slots of each block are used for linking the blocks together.
+	/// @param count The number of slots to add.
+	void addBlock_(Idx count);
+	
+	/// The allocator of the blocks.
+	SlotAllocatorT allocator_;
+	
+	/// Linked list of the allocated blocks, through the first slot of each
+	/// block.
+	Slot* blocks_;
+	
+	/// Number of blocks in blocks_.
+	Idx block_count_;
+	
+	/// Linked list of the free slots.
+	Slot* free_list_;
+	
+	/// Total number of slots in the blocks.
+	Idx capacity_;
+	
+	/// Number of slots in free_list_.
+	Idx free_count_;
+};
+
+template <typename T, typename AllocatorT>
+constexpr Idx Pool<T, AllocatorT>::block_header_size_;
+
+/// Deleter for std::unique_ptr that only destroys the object without releasing
+/// its memory. Used for objects allocated from a Pool, the memory of which is
+/// returned to the pool separately or released with the pool.
+/// @tparam T The type of the deleted objects.
+template <typename T>
+struct DestroyingDeleter {
+	void operator()(T* ptr) const {
+		ptr->~T();
+	}
+};
+
+}
+}
+
+#include "pool_impl.hpp"
+
+#endif
@@ -0,0 +1,125 @@
+#include <algorithm>
+#include <utility>
+
+namespace frivol {
+namespace containers {
+
+template <typename T, typename AllocatorT>
+Pool<T, AllocatorT>::Pool(const AllocatorT& allocator)
+	: allocator_(allocator),
+	  blocks_(nullptr),
+	  block_count_(0),
+	  free_list_(nullptr),
+	  capacity_(0),
+	  free_count_(0)
+{ }
+
+template <typename T, typename AllocatorT>
+Pool<T, AllocatorT>::Pool(Pool<T, AllocatorT>&& other)
+	: allocator_(other.allocator_),
+	  blocks_(other.blocks_),
+	  block_count_(other.block_count_),
+	  free_list_(other.free_list_),
+	  capacity_(other.capacity_),
+	  free_count_(other.free_count_)
+{
+	other.blocks_ = nullptr;
+	other.block_count_ = 0;
+	other.free_list_ = nullptr;
+	other.capacity_ = 0;
+	other.free_count_ = 0;
+}
+
+template <typename T, typename AllocatorT>
+Pool<T, AllocatorT>& Pool<T, AllocatorT>::operator=(Pool<T, AllocatorT>&& other) {
+	std::swap(allocator_, other.allocator_);
+	std::swap(blocks_, other.blocks_);
+	std::swap(block_count_, other.block_count_);
+	std::swap(free_list_, other.free_list_);
+	std::swap(capacity_, other.capacity_);
+	std::swap(free_count_, other.free_count_);
+	return *this;
+}
+
+template <typename T, typename AllocatorT>
+Pool<T, AllocatorT>::~Pool() {
+	while(blocks_ != nullptr) {
+		Slot* next = blocks_[0].next;
+		SlotAllocatorTraits::deallocate(allocator_, blocks_, blocks_[1].block_size);
+		blocks_ = next;
+	}
+}
+
+template <typename T, typename AllocatorT>
+void Pool<T, AllocatorT>::reserve(Idx count) {
+	if(capacity_ < count) {
+		addBlock_(count - capacity_);
+	}
+}
+
+template <typename T, typename AllocatorT>
+T* Pool<T, AllocatorT>::allocate() {
+	if(free_list_ == nullptr) {
+		// Grow geometrically so that the number of blocks stays logarithmic.
+		addBlock_(std::max(capacity_, (Idx)16));
+	}
+	
+	Slot* slot = free_list_;
+	free_list_ = slot->next;
+	--free_count_;
+	
+	return reinterpret_cast<T*>(&slot->storage);
+}
+
+template <typename T, typename AllocatorT>
+void Pool<T, AllocatorT>::deallocate(T* ptr) {
+	Slot* slot = reinterpret_cast<Slot*>(ptr);
+	slot->next = free_list_;
+	free_list_ = slot;
+	++free_count_;
+}
+
+template <typename T, typename AllocatorT>
+Idx Pool<T, AllocatorT>::getCapacity() const {
+	return capacity_;
+}
+
+template <typename T, typename AllocatorT>
+Idx Pool<T, AllocatorT>::getFreeCount() const {
+	return free_count_;
+}
+
+template <typename T, typename AllocatorT>
+MemoryUsage Pool<T, AllocatorT>::getMemoryUsage() const {
+	Idx slot_count = capacity_ + block_count_ * block_header_size_;
+	return MemoryUsage(slot_count * sizeof(Slot), (capacity_ - free_count_) * sizeof(Slot));
+}
+
+template <typename T, typename AllocatorT>
+std::size_t Pool<T, AllocatorT>::estimateMemoryUsage(Idx count) {
+	if(count == 0) return 0;
+	return (count + block_header_size_) * sizeof(Slot);
+}
+
+template <typename T, typename AllocatorT>
+void Pool<T, AllocatorT>::addBlock_(Idx count) {
+	Idx block_size = count + block_header_size_;
+	Slot* block = SlotAllocatorTraits::allocate(allocator_, block_size);
+	block[0].next = blocks_;
+	block[1].block_size = block_size;
+	blocks_ = block;
+	++block_count_;
+	
+	// Push the slots in reverse order so that they are allocated in memory
+	// order.
+	for(Idx i = block_size - 1; i >= block_header_size_; --i) {
+		block[i].next = free_list_;
+		free_list_ = &block[i];
+	}
+	
+	capacity_ += count;
+	free_count_ += count;
+}
+
+}
+}
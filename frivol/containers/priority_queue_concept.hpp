@@ -2,42 +2,84 @@
 #define FRIVOL_CONTAINERS_PRIORITY_QUEUE_CONCEPT_HPP
 
 #include <frivol/common.hpp>
+#include <frivol/memory_usage.hpp>
 #include <boost/concept_check.hpp>
 
+#include <memory>
+#include <type_traits>
+
 namespace frivol {
 namespace containers {
 
 /// Concept checking class for priority queues X with priority values of type
-/// PriorityT (or NIL). Priority queues are initialized with given size, and
+/// PriorityT (or NIL), allocating memory through allocators of type AllocatorT. Priority queues are initialized with given size, and
 /// contain priority values for keys 0, 1, ..., size-1. Initially, all priority
 /// values are NIL. X must support the following operations:
-///  - <construct>(Idx size) creates priority queue for keys 0, 1, ..., size-1.
+///  - <construct>(Idx size, const AllocatorT& allocator) creates priority
+///    queue for keys 0, 1, ..., size-1, allocating all memory through
+///    'allocator'.
+///  - <construct>(Idx size) does the same with a default constructed
+///    allocator. Only required if AllocatorT is default constructible.
 ///  - bool empty() const returns true if all keys have NIL priority.
 ///  - std::pair<Idx, PriorityT> pop() returns pair of a key with lowest non-NIL
 ///    priority and its priority and sets the priority to NIL.
+///  - std::pair<Idx, PriorityT> top() returns the pair that pop() would return
+///    without changing the priorities.
 ///  - void setPriority(Idx key, PriorityT priority) sets the priority value of
 ///    'key' to non-NIL value 'priority'.
 ///  - void setPriorityNIL(Idx key) sets the priority value of key 'key' to NIL.
+///  - void reset(Idx size) changes the keys to 0, 1, ..., size-1 and sets
+///    all priority values to NIL. The memory allocated for a larger size
+///    should be kept, so that resetting to at most the largest size so far
+///    does not allocate memory.
+///  - MemoryUsage getMemoryUsage() const returns the memory allocated by the
+///    queue.
+///  - static std::size_t estimateMemoryUsage(Idx size) returns the number of
+///    bytes allocated by a queue that has been constructed with or reset to
+///    'size' and not resized before, excluding the bookkeeping of the
+///    allocator.
 /// 
 /// X may assume that PriorityT is ordered with <-operator. X may have
-/// undefined behavior if supplied keys are out of range or if pop() is called
-/// when empty() returns true.
-template <typename X, typename PriorityT>
+/// undefined behavior if supplied keys are out of range or if pop() or top() is
+/// called when empty() returns true.
+/// 
+/// Optionally, X may have the lazy invalidation capability, denoted by static
+/// member constant lazy_invalidation with value true. Then setPriorityNIL and
+/// replacing a non-NIL priority take constant time, and the cost of removing
+/// the old priorities is paid later in pop() and top(). See
+/// IsLazyPriorityQueue.
+/// 
+/// Optionally, X may accept a hint of the range of the priorities, denoted
+/// by static member constant range_hint with value true. Then
+/// void setRangeHint(PriorityT min, PriorityT max) tells that the priorities
+/// are expected to be mostly between min and max. See HasPriorityRangeHint.
+template <typename X, typename PriorityT, typename AllocatorT = std::allocator<char>>
 class PriorityQueueConcept {
 public:
 	BOOST_CONCEPT_ASSERT((boost::LessThanComparable<PriorityT>));
 	BOOST_CONCEPT_USAGE(PriorityQueueConcept) {
-		X x(size);
+		X x(size, allocator);
+		constructDefault_(std::is_default_constructible<AllocatorT>());
 		x.setPriorityNIL(key);
 		x.setPriority(key, priority);
 		sameType(x.empty(), bool());
 		sameType(x.pop(), std::pair<Idx, PriorityT>(key, priority));
+		sameType(x.top(), std::pair<Idx, PriorityT>(key, priority));
+		x.reset(size);
+		sameType(x.getMemoryUsage(), MemoryUsage());
+		sameType(X::estimateMemoryUsage(size), std::size_t());
 	}
 	
 private:
 	Idx size;
 	Idx key;
 	PriorityT priority;
+	AllocatorT allocator;
+	
+	void constructDefault_(std::true_type) {
+		X x(size);
+	}
+	void constructDefault_(std::false_type) { }
 	
 	/// Function that causes compile time error if called with parameters of
 	/// different types.
@@ -45,6 +87,26 @@ private:
 	void sameType(const T&, const T&);
 };
 
+/// Type trait for detecting the lazy invalidation capability of priority
+/// queue X (see PriorityQueueConcept). Member constant value is true if
+/// X::lazy_invalidation exists and is true.
+template <typename X, typename Enable = void>
+struct IsLazyPriorityQueue : std::false_type { };
+
+template <typename X>
+struct IsLazyPriorityQueue<X, typename std::enable_if<X::lazy_invalidation>::type>
+	: std::true_type { };
+
+/// Type trait for detecting whether priority queue X accepts a hint of the
+/// range of the priorities (see PriorityQueueConcept). Member constant value
+/// is true if X::range_hint exists and is true.
+template <typename X, typename Enable = void>
+struct HasPriorityRangeHint : std::false_type { };
+
+template <typename X>
+struct HasPriorityRangeHint<X, typename std::enable_if<X::range_hint>::type>
+	: std::true_type { };
+
 }
 }
 
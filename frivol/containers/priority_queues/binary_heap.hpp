@@ -2,7 +2,7 @@
 #define FRIVOL_CONTAINERS_PRIORITY_QUEUES_BINARY_HEAP_HPP
 
 #include <frivol/common.hpp>
-#include <frivol/containers/array.hpp>
+#include <frivol/containers/dynamic_array.hpp>
 
 #include <boost/optional.hpp>
 
@@ -11,20 +11,29 @@ namespace containers {
 namespace priority_queues {
 
 /// Implementation of PriorityQueueConcept using a binary heap.
-template <typename PriorityT>
+/// @tparam AllocatorT The allocator used for the internal arrays (see Array).
+/// @tparam IndexT The unsigned integer type in which the keys and their heap
+/// positions are stored. The keys must be less than nilIndex<IndexT>().
+template <typename PriorityT, typename AllocatorT = DefaultAllocator, typename IndexT = Idx>
 class BinaryHeap {
 public:
 	BOOST_CONCEPT_ASSERT((boost::LessThanComparable<PriorityT>));
 	
-	BinaryHeap(Idx size);
+	BinaryHeap(Idx size, const AllocatorT& allocator = AllocatorT());
 	
 	std::pair<Idx, PriorityT> pop();
+	std::pair<Idx, PriorityT> top();
 	
 	bool empty() const;
 	
 	void setPriority(Idx key, PriorityT priority);
 	void setPriorityNIL(Idx key);
 	
+	void reset(Idx size);
+	
+	MemoryUsage getMemoryUsage() const;
+	static std::size_t estimateMemoryUsage(Idx size);
+	
 private:
 	/// Returns the heap index of the parent of given heap index.
 	/// @param heap_idx The heap index.
@@ -64,16 +73,16 @@ private:
 	typedef boost::optional<PriorityT> OptionalPriorityT;
 	
 	/// Array of priority values (empty in case of NIL).
-	Array<OptionalPriorityT> priorities_;
+	DynamicArray<OptionalPriorityT, AllocatorT> priorities_;
 	
 	/// Size of the heap, i.e. the number of keys with non-NIL priorities.
 	Idx heap_size_;
 	
 	/// The binary heap of the keys is stored in heap_[i], i = 0...non_nil_count_-1.
-	Array<Idx> heap_;
+	DynamicArray<IndexT, AllocatorT> heap_;
 	
 	/// Indices of the non-NIL elements in the heap by key.
-	Array<Idx> heap_indices_;
+	DynamicArray<IndexT, AllocatorT> heap_indices_;
 };
 
 }
@@ -2,16 +2,17 @@ namespace frivol {
 namespace containers {
 namespace priority_queues {
 
-template <typename PriorityT>
-BinaryHeap<PriorityT>::BinaryHeap(Idx size)
-	: priorities_(size),
-	  heap_size_(0),
-	  heap_(size),
-	  heap_indices_(size)
-{ }
-
-template <typename PriorityT>
-std::pair<Idx, PriorityT> BinaryHeap<PriorityT>::pop() {
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+BinaryHeap<PriorityT, AllocatorT, IndexT>::BinaryHeap(Idx size, const AllocatorT& allocator)
+	: priorities_(allocator),
+	  heap_(allocator),
+	  heap_indices_(allocator)
+{
+	reset(size);
+}
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+std::pair<Idx, PriorityT> BinaryHeap<PriorityT, AllocatorT, IndexT>::pop() {
 	Idx top_key = heap_[0];
 	PriorityT top_priority = priorities_[top_key].get();
 	priorities_[top_key].reset();
@@ -21,13 +22,18 @@ std::pair<Idx, PriorityT> BinaryHeap<PriorityT>::pop() {
 	return std::make_pair(top_key, top_priority);
 }
 
-template <typename PriorityT>
-bool BinaryHeap<PriorityT>::empty() const {
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+std::pair<Idx, PriorityT> BinaryHeap<PriorityT, AllocatorT, IndexT>::top() {
+	return std::make_pair(heap_[0], priorities_[heap_[0]].get());
+}
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+bool BinaryHeap<PriorityT, AllocatorT, IndexT>::empty() const {
 	return heap_size_ == 0;
 }
 
-template <typename PriorityT>
-void BinaryHeap<PriorityT>::setPriority(Idx key, PriorityT priority) {
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+void BinaryHeap<PriorityT, AllocatorT, IndexT>::setPriority(Idx key, PriorityT priority) {
 	// If the element is in the heap already, remove it.
 	setPriorityNIL(key);
 	
@@ -37,63 +43,84 @@ void BinaryHeap<PriorityT>::setPriority(Idx key, PriorityT priority) {
 	Idx heap_idx = heap_size_;
 	++heap_size_;
 	
-	heap_[heap_idx] = key;
-	heap_indices_[key] = heap_idx;
+	heap_[heap_idx] = compactIndex<IndexT>(key);
+	heap_indices_[key] = compactIndex<IndexT>(heap_idx);
 	
 	bubbleUp_(heap_idx);
 }
 
-template <typename PriorityT>
-void BinaryHeap<PriorityT>::setPriorityNIL(Idx key) {
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+void BinaryHeap<PriorityT, AllocatorT, IndexT>::setPriorityNIL(Idx key) {
 	if(priorities_[key].get_ptr() == nullptr) return;
 	
 	priorities_[key].reset();
 	removeFromHeap_(heap_indices_[key]);
 }
 
-template <typename PriorityT>
-Idx BinaryHeap<PriorityT>::getHeapParent_(Idx heap_idx) const {
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+MemoryUsage BinaryHeap<PriorityT, AllocatorT, IndexT>::getMemoryUsage() const {
+	return priorities_.getMemoryUsage() + heap_.getMemoryUsage() + heap_indices_.getMemoryUsage();
+}
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+std::size_t BinaryHeap<PriorityT, AllocatorT, IndexT>::estimateMemoryUsage(Idx size) {
+	return size * (sizeof(OptionalPriorityT) + 2 * sizeof(IndexT));
+}
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+void BinaryHeap<PriorityT, AllocatorT, IndexT>::reset(Idx size) {
+	priorities_.resize(size);
+	heap_.resize(size);
+	heap_indices_.resize(size);
+	for(Idx key = 0; key < size; ++key) {
+		priorities_[key].reset();
+	}
+	heap_size_ = 0;
+}
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+Idx BinaryHeap<PriorityT, AllocatorT, IndexT>::getHeapParent_(Idx heap_idx) const {
 	return (heap_idx - 1) / 2;
 }
 
-template <typename PriorityT>
-Idx BinaryHeap<PriorityT>::getHeapLeftChild_(Idx heap_idx) const {
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+Idx BinaryHeap<PriorityT, AllocatorT, IndexT>::getHeapLeftChild_(Idx heap_idx) const {
 	return 2 * heap_idx + 1;
 }
 
-template <typename PriorityT>
-Idx BinaryHeap<PriorityT>::getHeapRightChild_(Idx heap_idx) const {
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+Idx BinaryHeap<PriorityT, AllocatorT, IndexT>::getHeapRightChild_(Idx heap_idx) const {
 	return 2 * heap_idx + 2;
 }
 
-template <typename PriorityT>
-void BinaryHeap<PriorityT>::removeFromHeap_(Idx heap_idx) {
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+void BinaryHeap<PriorityT, AllocatorT, IndexT>::removeFromHeap_(Idx heap_idx) {
 	--heap_size_;
 	
 	if(heap_idx == heap_size_) return;
 	
 	// Move the last element in the place and restore heap property by bubbling.
 	heap_[heap_idx] = heap_[heap_size_];
-	heap_indices_[heap_[heap_idx]] = heap_idx;
+	heap_indices_[heap_[heap_idx]] = compactIndex<IndexT>(heap_idx);
 	
 	bubbleDown_(heap_idx);
 	bubbleUp_(heap_idx);
 }
 
-template <typename PriorityT>
-void BinaryHeap<PriorityT>::swapInHeap_(Idx heap_idx1, Idx heap_idx2) {
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+void BinaryHeap<PriorityT, AllocatorT, IndexT>::swapInHeap_(Idx heap_idx1, Idx heap_idx2) {
 	std::swap(heap_[heap_idx1], heap_[heap_idx2]);
-	heap_indices_[heap_[heap_idx1]] = heap_idx1;
-	heap_indices_[heap_[heap_idx2]] = heap_idx2;
+	heap_indices_[heap_[heap_idx1]] = compactIndex<IndexT>(heap_idx1);
+	heap_indices_[heap_[heap_idx2]] = compactIndex<IndexT>(heap_idx2);
 }
 
-template <typename PriorityT>
-bool BinaryHeap<PriorityT>::hasHigherPriority_(Idx heap_idx1, Idx heap_idx2) {
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+bool BinaryHeap<PriorityT, AllocatorT, IndexT>::hasHigherPriority_(Idx heap_idx1, Idx heap_idx2) {
 	return priorities_[heap_[heap_idx1]].get() < priorities_[heap_[heap_idx2]].get();
 }
 
-template <typename PriorityT>
-void BinaryHeap<PriorityT>::bubbleUp_(Idx heap_idx) {
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+void BinaryHeap<PriorityT, AllocatorT, IndexT>::bubbleUp_(Idx heap_idx) {
 	while(heap_idx != 0) {
 		Idx parent = getHeapParent_(heap_idx);
 		if(hasHigherPriority_(parent, heap_idx)) break;
@@ -102,8 +129,8 @@ void BinaryHeap<PriorityT>::bubbleUp_(Idx heap_idx) {
 	}
 }
 
-template <typename PriorityT>
-void BinaryHeap<PriorityT>::bubbleDown_(Idx heap_idx) {
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+void BinaryHeap<PriorityT, AllocatorT, IndexT>::bubbleDown_(Idx heap_idx) {
 	while(getHeapLeftChild_(heap_idx) < heap_size_) {
 		Idx left = getHeapLeftChild_(heap_idx);
 		Idx right = getHeapRightChild_(heap_idx);
@@ -0,0 +1,193 @@
+#ifndef FRIVOL_CONTAINERS_PRIORITY_QUEUES_CALENDAR_QUEUE_HPP
+#define FRIVOL_CONTAINERS_PRIORITY_QUEUES_CALENDAR_QUEUE_HPP
+
+#include <frivol/common.hpp>
+#include <frivol/containers/dynamic_array.hpp>
+
+#include <boost/concept_check.hpp>
+
+#include <type_traits>
+#include <utility>
+
+namespace frivol {
+namespace containers {
+namespace priority_queues {
+
+/// Mapping from priorities of type PriorityT to real positions, used by
+/// CalendarQueue to choose the buckets. Static member function
+/// double getPosition(const PriorityT& priority) must be nondecreasing in the
+/// order of the priorities. The default implementation converts arithmetic
+/// priorities to double, and uses priority.getY() for other types, such as
+/// the event priorities of Fortune's algorithm. Specialize for other
+/// priority types.
+template <typename PriorityT, typename Enable = void>
+struct CalendarQueuePosition {
+	static double getPosition(const PriorityT& priority) {
+		return (double)priority.getY();
+	}
+};
+
+template <typename PriorityT>
+struct CalendarQueuePosition<
+	PriorityT,
+	typename std::enable_if<std::is_arithmetic<PriorityT>::value>::type
+> {
+	static double getPosition(const PriorityT& priority) {
+		return (double)priority;
+	}
+};
+
+/// Implementation of PriorityQueueConcept using a calendar queue. The
+/// positions of the priorities (see CalendarQueuePosition) in a range are
+/// split to buckets of equal width, at most one bucket per two keys, and the
+/// keys are kept unsorted in the buckets. The minimum is searched from the
+/// first nonempty bucket, found by advancing a cursor over the buckets.
+///
+/// When the popped priorities are nondecreasing and evenly distributed over
+/// the range, as the events of Fortune's algorithm for uniformly distributed
+/// sites, the operations take amortized constant time. The range can be
+/// given with setRangeHint (see HasPriorityRangeHint). The priorities
+/// outside the range are placed to the first or last bucket, and if the
+/// first nonempty bucket is too large when searched, the range is
+/// recomputed from the current priorities. Skewed or adversarial
+/// distributions still work correctly, but degrade towards linear time per
+/// operation.
+/// @tparam PriorityT The priority type. Should implement
+/// CalendarQueuePosition, and be default constructible and assignable.
+/// @tparam AllocatorT The allocator used for the internal arrays (see Array).
+/// @tparam IndexT The unsigned integer type in which the keys, buckets and
+/// bucket sizes are stored. The keys must be less than nilIndex<IndexT>().
+template <typename PriorityT, typename AllocatorT = DefaultAllocator, typename IndexT = Idx>
+class CalendarQueue {
+public:
+	BOOST_CONCEPT_ASSERT((boost::LessThanComparable<PriorityT>));
+	
+	static constexpr bool range_hint = true;
+	
+	CalendarQueue(Idx size, const AllocatorT& allocator = AllocatorT());
+	
+	std::pair<Idx, PriorityT> pop();
+	std::pair<Idx, PriorityT> top();
+	
+	bool empty() const;
+	
+	void setPriority(Idx key, PriorityT priority);
+	void setPriorityNIL(Idx key);
+	
+	void reset(Idx size);
+	
+	MemoryUsage getMemoryUsage() const;
+	static std::size_t estimateMemoryUsage(Idx size);
+	
+	/// Sets the range of positions split to the buckets, redistributing the
+	/// current keys.
+	/// @param min,max The priorities that are expected to be the lowest and
+	/// the highest in the queue.
+	void setRangeHint(PriorityT min, PriorityT max);
+	
+	/// Returns the number of times the range has been recomputed because a
+	/// bucket grew too large.
+	Idx getResizeCount() const;
+	
+private:
+	typedef CalendarQueuePosition<PriorityT> CalendarQueuePositionT;
+	
+	/// The size of the first bucket that triggers recomputing the range.
+	static constexpr Idx skew_limit_ = 16;
+	
+	/// Queue element of a key.
+	struct Entry {
+		/// The priority of the key.
+		PriorityT priority;
+		
+		/// The bucket containing the key, or nilIndex<IndexT>() if the
+		/// priority is NIL.
+		IndexT bucket;
+		
+		/// The previous and the next key in the same bucket, or
+		/// nilIndex<IndexT>().
+		IndexT prev;
+		IndexT next;
+	};
+	
+	/// Returns the key with the lowest priority. The queue must be nonempty.
+	Idx getTopKey_();
+	
+	/// Returns the bucket in which given priority belongs.
+	/// @param priority The priority.
+	Idx getBucket_(const PriorityT& priority) const;
+	
+	/// Adds key to the beginning of the list of given bucket.
+	/// @param key The key. Must not be in any bucket.
+	/// @param bucket The bucket.
+	void linkToBucket_(Idx key, Idx bucket);
+	
+	/// Removes key from the list of its bucket.
+	/// @param key The key. Must be in a bucket.
+	void unlinkFromBucket_(Idx key);
+	
+	/// Sets the range of positions split to the buckets and redistributes
+	/// the keys.
+	/// @param min,max The range of positions.
+	/// @param bucket_count The number of buckets to use, at most the size of
+	/// bucket_heads_.
+	void setRange_(double min, double max, Idx bucket_count);
+	
+	/// Recomputes the range from the current priorities. Must be nonempty.
+	void resize_();
+	
+	/// The queue elements by key.
+	DynamicArray<Entry, AllocatorT> entries_;
+	
+	/// The first keys of the lists of the buckets, or nilIndex<IndexT>() for
+	/// empty bucket.
+	DynamicArray<IndexT, AllocatorT> bucket_heads_;
+	
+	/// The numbers of keys in the buckets.
+	DynamicArray<IndexT, AllocatorT> bucket_sizes_;
+	
+	/// Work space for the positions of the priorities in resize_.
+	DynamicArray<double, AllocatorT> positions_;
+	
+	/// The number of buckets in use, the first ones of bucket_heads_. The
+	/// range is recomputed with about two buckets per key, so that the time
+	/// is proportional to the number of keys.
+	Idx bucket_count_;
+	
+	/// All buckets before first_bucket_ are empty.
+	Idx first_bucket_;
+	
+	/// The position at the start of bucket 0.
+	double origin_;
+	
+	/// The inverse of the bucket width, or 0 if the range is unknown.
+	double inv_width_;
+	
+	/// The number of keys visited when searching the minimum since the last
+	/// recomputation of the range. The range is only recomputed when this is
+	/// at least the number of keys in the queue, so that the cost is
+	/// amortized.
+	Idx search_work_;
+	
+	/// The key with the lowest priority, or nil_idx if it is not known.
+	Idx top_key_;
+	
+	/// The number of keys with non-NIL priorities.
+	Idx size_;
+	
+	/// Counter for getResizeCount.
+	Idx resize_count_;
+};
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+constexpr bool CalendarQueue<PriorityT, AllocatorT, IndexT>::range_hint;
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+constexpr Idx CalendarQueue<PriorityT, AllocatorT, IndexT>::skew_limit_;
+
+}
+}
+}
+
+#include "calendar_queue_impl.hpp"
+
+#endif
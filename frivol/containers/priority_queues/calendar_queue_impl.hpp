@@ -0,0 +1,253 @@
+#include <algorithm>
+#include <limits>
+
+namespace frivol {
+namespace containers {
+namespace priority_queues {
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+CalendarQueue<PriorityT, AllocatorT, IndexT>::CalendarQueue(Idx size, const AllocatorT& allocator)
+	: entries_(allocator),
+	  bucket_heads_(allocator),
+	  bucket_sizes_(allocator),
+	  positions_(allocator)
+{
+	reset(size);
+}
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+std::pair<Idx, PriorityT> CalendarQueue<PriorityT, AllocatorT, IndexT>::pop() {
+	Idx key = getTopKey_();
+	
+	unlinkFromBucket_(key);
+	--size_;
+	top_key_ = nil_idx;
+	
+	return std::make_pair(key, entries_[key].priority);
+}
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+std::pair<Idx, PriorityT> CalendarQueue<PriorityT, AllocatorT, IndexT>::top() {
+	Idx key = getTopKey_();
+	return std::make_pair(key, entries_[key].priority);
+}
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+bool CalendarQueue<PriorityT, AllocatorT, IndexT>::empty() const {
+	return size_ == 0;
+}
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+void CalendarQueue<PriorityT, AllocatorT, IndexT>::setPriority(Idx key, PriorityT priority) {
+	Entry& entry = entries_[key];
+	if(entry.bucket == nilIndex<IndexT>()) {
+		++size_;
+	} else {
+		unlinkFromBucket_(key);
+	}
+	
+	// Keep the cached top key if it is still known to be the top.
+	if(key == top_key_) {
+		if(entry.priority < priority) top_key_ = nil_idx;
+	} else if(top_key_ != nil_idx && priority < entries_[top_key_].priority) {
+		top_key_ = key;
+	}
+	
+	entry.priority = priority;
+	linkToBucket_(key, getBucket_(priority));
+}
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+void CalendarQueue<PriorityT, AllocatorT, IndexT>::setPriorityNIL(Idx key) {
+	if(entries_[key].bucket == nilIndex<IndexT>()) return;
+	
+	unlinkFromBucket_(key);
+	--size_;
+	if(key == top_key_) top_key_ = nil_idx;
+}
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+MemoryUsage CalendarQueue<PriorityT, AllocatorT, IndexT>::getMemoryUsage() const {
+	return
+		entries_.getMemoryUsage() + bucket_heads_.getMemoryUsage() +
+		bucket_sizes_.getMemoryUsage() + positions_.getMemoryUsage();
+}
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+std::size_t CalendarQueue<PriorityT, AllocatorT, IndexT>::estimateMemoryUsage(Idx size) {
+	Idx max_bucket_count = std::max((size + 1) / 2, (Idx)1);
+	return size * (sizeof(Entry) + sizeof(double)) + max_bucket_count * 2 * sizeof(IndexT);
+}
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+void CalendarQueue<PriorityT, AllocatorT, IndexT>::reset(Idx size) {
+	Idx max_bucket_count = std::max((size + 1) / 2, (Idx)1);
+	entries_.resize(size);
+	bucket_heads_.resize(max_bucket_count);
+	bucket_sizes_.resize(max_bucket_count);
+	positions_.resize(size);
+	for(Idx key = 0; key < size; ++key) {
+		entries_[key].bucket = nilIndex<IndexT>();
+	}
+	for(Idx bucket = 0; bucket < max_bucket_count; ++bucket) {
+		bucket_heads_[bucket] = nilIndex<IndexT>();
+		bucket_sizes_[bucket] = 0;
+	}
+	
+	bucket_count_ = 1;
+	first_bucket_ = 1;
+	origin_ = 0;
+	inv_width_ = 0;
+	search_work_ = 0;
+	top_key_ = nil_idx;
+	size_ = 0;
+	resize_count_ = 0;
+}
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+void CalendarQueue<PriorityT, AllocatorT, IndexT>::setRangeHint(PriorityT min, PriorityT max) {
+	setRange_(
+		CalendarQueuePositionT::getPosition(min),
+		CalendarQueuePositionT::getPosition(max),
+		bucket_heads_.getSize()
+	);
+}
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+Idx CalendarQueue<PriorityT, AllocatorT, IndexT>::getResizeCount() const {
+	return resize_count_;
+}
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+Idx CalendarQueue<PriorityT, AllocatorT, IndexT>::getTopKey_() {
+	if(top_key_ != nil_idx) return top_key_;
+	
+	while(bucket_heads_[first_bucket_] == nilIndex<IndexT>()) ++first_bucket_;
+	
+	// Large buckets are only costly when they are searched here, so the
+	// range is recomputed only when the first bucket is too large and the
+	// searches have cost as much as the recomputation. The priorities beyond
+	// the range are kept in the last bucket until then.
+	search_work_ += bucket_sizes_[first_bucket_];
+	if(bucket_sizes_[first_bucket_] > skew_limit_ && search_work_ >= size_) {
+		resize_();
+		while(bucket_heads_[first_bucket_] == nilIndex<IndexT>()) ++first_bucket_;
+	}
+	
+	// The keys are unsorted in the bucket, so find the minimum.
+	top_key_ = bucket_heads_[first_bucket_];
+	for(Idx key = expandIndex(entries_[top_key_].next); key != nil_idx; key = expandIndex(entries_[key].next)) {
+		if(entries_[key].priority < entries_[top_key_].priority) top_key_ = key;
+	}
+	
+	return top_key_;
+}
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+Idx CalendarQueue<PriorityT, AllocatorT, IndexT>::getBucket_(const PriorityT& priority) const {
+	double offset = (CalendarQueuePositionT::getPosition(priority) - origin_) * inv_width_;
+	
+	// The negation also places NaN offsets to the first bucket.
+	if(!(offset >= 0)) return 0;
+	if(offset >= (double)bucket_count_) return bucket_count_ - 1;
+	return (Idx)offset;
+}
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+void CalendarQueue<PriorityT, AllocatorT, IndexT>::linkToBucket_(Idx key, Idx bucket) {
+	Entry& entry = entries_[key];
+	Idx head = expandIndex(bucket_heads_[bucket]);
+	
+	entry.bucket = compactIndex<IndexT>(bucket);
+	entry.prev = nilIndex<IndexT>();
+	entry.next = compactIndex<IndexT>(head);
+	if(head != nil_idx) entries_[head].prev = compactIndex<IndexT>(key);
+	bucket_heads_[bucket] = compactIndex<IndexT>(key);
+	
+	++bucket_sizes_[bucket];
+	first_bucket_ = std::min(first_bucket_, bucket);
+}
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+void CalendarQueue<PriorityT, AllocatorT, IndexT>::unlinkFromBucket_(Idx key) {
+	Entry& entry = entries_[key];
+	
+	if(entry.prev == nilIndex<IndexT>()) {
+		bucket_heads_[entry.bucket] = entry.next;
+	} else {
+		entries_[entry.prev].next = entry.next;
+	}
+	if(entry.next != nilIndex<IndexT>()) entries_[entry.next].prev = entry.prev;
+	
+	--bucket_sizes_[entry.bucket];
+	entry.bucket = nilIndex<IndexT>();
+}
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+void CalendarQueue<PriorityT, AllocatorT, IndexT>::setRange_(double min, double max, Idx bucket_count) {
+	// Collect all keys to a single list linked by the next fields. The
+	// buckets before first_bucket_ are empty.
+	Idx chain = nil_idx;
+	for(Idx bucket = first_bucket_; bucket < bucket_count_; ++bucket) {
+		Idx key = expandIndex(bucket_heads_[bucket]);
+		while(key != nil_idx) {
+			Idx next = expandIndex(entries_[key].next);
+			entries_[key].next = compactIndex<IndexT>(chain);
+			chain = key;
+			key = next;
+		}
+		bucket_heads_[bucket] = nilIndex<IndexT>();
+		bucket_sizes_[bucket] = 0;
+	}
+	
+	bucket_count_ = bucket_count;
+	first_bucket_ = bucket_count_;
+	origin_ = min;
+	
+	// If the range is empty or not finite, place everything to the first
+	// bucket.
+	double inv_width = (double)bucket_count_ / (max - min);
+	if(max > min && inv_width > 0 && inv_width < std::numeric_limits<double>::infinity()) {
+		inv_width_ = inv_width;
+	} else {
+		origin_ = 0;
+		inv_width_ = 0;
+	}
+	
+	while(chain != nil_idx) {
+		Idx next = expandIndex(entries_[chain].next);
+		linkToBucket_(chain, getBucket_(entries_[chain].priority));
+		chain = next;
+	}
+	
+	search_work_ = 0;
+}
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+void CalendarQueue<PriorityT, AllocatorT, IndexT>::resize_() {
+	Idx count = 0;
+	for(Idx bucket = first_bucket_; bucket < bucket_count_; ++bucket) {
+		for(Idx key = expandIndex(bucket_heads_[bucket]); key != nil_idx; key = expandIndex(entries_[key].next)) {
+			positions_[count++] = CalendarQueuePositionT::getPosition(entries_[key].priority);
+		}
+	}
+	
+	// The width of the buckets is chosen by the lower half of the
+	// priorities, so that outliers far in the future do not make the buckets
+	// too wide. They stay in the last bucket until it is searched.
+	double* positions = &positions_[0];
+	Idx mid = count / 2;
+	std::nth_element(positions, positions + mid, positions + count);
+	double min = *std::min_element(positions, positions + mid + 1);
+	double median = positions[mid];
+	
+	// Use about two buckets per key, so that the lower half of the keys is
+	// spread to the first quarter of the buckets.
+	Idx bucket_count = std::min(std::max(2 * count, (Idx)1), bucket_heads_.getSize());
+	setRange_(min, min + 4 * (median - min), bucket_count);
+	++resize_count_;
+}
+
+}
+}
+}
@@ -0,0 +1,111 @@
+#ifndef FRIVOL_CONTAINERS_PRIORITY_QUEUES_D_ARY_HEAP_HPP
+#define FRIVOL_CONTAINERS_PRIORITY_QUEUES_D_ARY_HEAP_HPP
+
+#include <frivol/common.hpp>
+#include <frivol/containers/dynamic_array.hpp>
+
+#include <boost/concept_check.hpp>
+
+#include <algorithm>
+#include <utility>
+
+namespace frivol {
+namespace containers {
+namespace priority_queues {
+
+/// Implementation of PriorityQueueConcept using a d-ary heap. Unlike
+/// BinaryHeap, the priorities are stored inline in the heap array together
+/// with the keys, so that comparisons do not need to look up the priorities
+/// by key. The heap is lower than a binary heap and the children of a node
+/// are adjacent in memory. Use through the DAryHeap alias.
+/// @tparam PriorityT The priority type. Should be default constructible and
+/// assignable.
+/// @tparam ArityT The number of children of each heap node, at least 2.
+/// @tparam AllocatorT The allocator used for the internal arrays (see Array).
+/// @tparam IndexT The unsigned integer type in which the keys and their heap
+/// positions are stored. The keys must be less than nilIndex<IndexT>().
+template <typename PriorityT, Idx ArityT, typename AllocatorT = DefaultAllocator, typename IndexT = Idx>
+class BasicDAryHeap {
+public:
+	BOOST_CONCEPT_ASSERT((boost::LessThanComparable<PriorityT>));
+	static_assert(ArityT >= 2, "BasicDAryHeap: arity must be at least 2.");
+	
+	BasicDAryHeap(Idx size, const AllocatorT& allocator = AllocatorT());
+	
+	std::pair<Idx, PriorityT> pop();
+	std::pair<Idx, PriorityT> top();
+	
+	bool empty() const;
+	
+	void setPriority(Idx key, PriorityT priority);
+	void setPriorityNIL(Idx key);
+	
+	void reset(Idx size);
+	
+	MemoryUsage getMemoryUsage() const;
+	static std::size_t estimateMemoryUsage(Idx size);
+	
+private:
+	/// Element of the heap.
+	struct Entry {
+		PriorityT priority;
+		IndexT key;
+	};
+	
+	/// Returns the heap index of the parent of given heap index.
+	/// @param heap_idx The heap index.
+	Idx getHeapParent_(Idx heap_idx) const;
+	
+	/// Returns the heap index of the first child of given heap index.
+	/// @param heap_idx The heap index.
+	Idx getHeapFirstChild_(Idx heap_idx) const;
+	
+	/// Removes given element, conserving the heap property.
+	/// @param heap_idx The heap index of the element to remove.
+	void removeFromHeap_(Idx heap_idx);
+	
+	/// Places entry to given heap index and updates its position.
+	/// @param heap_idx The heap index to write.
+	/// @param entry The entry to place.
+	void placeInHeap_(Idx heap_idx, const Entry& entry);
+	
+	/// Moves entry towards the top starting from given heap index (the contents
+	/// of which are overwritten) as long as it has higher priority than the
+	/// parent.
+	/// @param heap_idx The starting heap index.
+	/// @param entry The entry to place.
+	void bubbleUp_(Idx heap_idx, const Entry& entry);
+	
+	/// Moves entry away from the top starting from given heap index (the
+	/// contents of which are overwritten) as long as it has a child with higher
+	/// priority.
+	/// @param heap_idx The starting heap index.
+	/// @param entry The entry to place.
+	void bubbleDown_(Idx heap_idx, const Entry& entry);
+	
+	/// Size of the heap, i.e. the number of keys with non-NIL priorities.
+	Idx heap_size_;
+	
+	/// The heap is stored in heap_[i], i = 0...heap_size_-1.
+	DynamicArray<Entry, AllocatorT> heap_;
+	
+	/// Indices of the elements in the heap by key, nilIndex<IndexT>() for NIL
+	/// priority.
+	DynamicArray<IndexT, AllocatorT> heap_indices_;
+};
+
+/// 4-ary heap, in which the children of a node fit in one cache line for
+/// small priority types (see BasicDAryHeap).
+/// @tparam PriorityT The priority type.
+/// @tparam AllocatorT The allocator used for the internal arrays.
+/// @tparam IndexT The unsigned integer type in which the keys are stored.
+template <typename PriorityT, typename AllocatorT = DefaultAllocator, typename IndexT = Idx>
+using DAryHeap = BasicDAryHeap<PriorityT, 4, AllocatorT, IndexT>;
+
+}
+}
+}
+
+#include "d_ary_heap_impl.hpp"
+
+#endif
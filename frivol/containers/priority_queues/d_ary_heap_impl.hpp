@@ -0,0 +1,150 @@
+namespace frivol {
+namespace containers {
+namespace priority_queues {
+
+template <typename PriorityT, Idx ArityT, typename AllocatorT, typename IndexT>
+BasicDAryHeap<PriorityT, ArityT, AllocatorT, IndexT>::BasicDAryHeap(Idx size, const AllocatorT& allocator)
+	: heap_(allocator),
+	  heap_indices_(allocator)
+{
+	reset(size);
+}
+
+template <typename PriorityT, Idx ArityT, typename AllocatorT, typename IndexT>
+std::pair<Idx, PriorityT> BasicDAryHeap<PriorityT, ArityT, AllocatorT, IndexT>::pop() {
+	std::pair<Idx, PriorityT> top(heap_[0].key, heap_[0].priority);
+	removeFromHeap_(0);
+	return top;
+}
+
+template <typename PriorityT, Idx ArityT, typename AllocatorT, typename IndexT>
+std::pair<Idx, PriorityT> BasicDAryHeap<PriorityT, ArityT, AllocatorT, IndexT>::top() {
+	return std::make_pair(heap_[0].key, heap_[0].priority);
+}
+
+template <typename PriorityT, Idx ArityT, typename AllocatorT, typename IndexT>
+bool BasicDAryHeap<PriorityT, ArityT, AllocatorT, IndexT>::empty() const {
+	return heap_size_ == 0;
+}
+
+template <typename PriorityT, Idx ArityT, typename AllocatorT, typename IndexT>
+void BasicDAryHeap<PriorityT, ArityT, AllocatorT, IndexT>::setPriority(Idx key, PriorityT priority) {
+	Entry entry = {priority, compactIndex<IndexT>(key)};
+	
+	Idx heap_idx = expandIndex(heap_indices_[key]);
+	if(heap_idx == nil_idx) {
+		// Add the element to the end and bubble it to the right place.
+		heap_idx = heap_size_;
+		++heap_size_;
+		bubbleUp_(heap_idx, entry);
+	} else {
+		// Update the element in place. Only one of the bubblings moves it.
+		if(priority < heap_[heap_idx].priority) {
+			bubbleUp_(heap_idx, entry);
+		} else {
+			bubbleDown_(heap_idx, entry);
+		}
+	}
+}
+
+template <typename PriorityT, Idx ArityT, typename AllocatorT, typename IndexT>
+void BasicDAryHeap<PriorityT, ArityT, AllocatorT, IndexT>::setPriorityNIL(Idx key) {
+	Idx heap_idx = expandIndex(heap_indices_[key]);
+	if(heap_idx == nil_idx) return;
+	
+	removeFromHeap_(heap_idx);
+}
+
+template <typename PriorityT, Idx ArityT, typename AllocatorT, typename IndexT>
+MemoryUsage BasicDAryHeap<PriorityT, ArityT, AllocatorT, IndexT>::getMemoryUsage() const {
+	return heap_.getMemoryUsage() + heap_indices_.getMemoryUsage();
+}
+
+template <typename PriorityT, Idx ArityT, typename AllocatorT, typename IndexT>
+std::size_t BasicDAryHeap<PriorityT, ArityT, AllocatorT, IndexT>::estimateMemoryUsage(Idx size) {
+	return size * (sizeof(Entry) + sizeof(IndexT));
+}
+
+template <typename PriorityT, Idx ArityT, typename AllocatorT, typename IndexT>
+void BasicDAryHeap<PriorityT, ArityT, AllocatorT, IndexT>::reset(Idx size) {
+	heap_.resize(size);
+	heap_indices_.resize(size);
+	for(Idx key = 0; key < size; ++key) {
+		heap_indices_[key] = nilIndex<IndexT>();
+	}
+	heap_size_ = 0;
+}
+
+template <typename PriorityT, Idx ArityT, typename AllocatorT, typename IndexT>
+Idx BasicDAryHeap<PriorityT, ArityT, AllocatorT, IndexT>::getHeapParent_(Idx heap_idx) const {
+	return (heap_idx - 1) / ArityT;
+}
+
+template <typename PriorityT, Idx ArityT, typename AllocatorT, typename IndexT>
+Idx BasicDAryHeap<PriorityT, ArityT, AllocatorT, IndexT>::getHeapFirstChild_(Idx heap_idx) const {
+	return ArityT * heap_idx + 1;
+}
+
+template <typename PriorityT, Idx ArityT, typename AllocatorT, typename IndexT>
+void BasicDAryHeap<PriorityT, ArityT, AllocatorT, IndexT>::removeFromHeap_(Idx heap_idx) {
+	heap_indices_[heap_[heap_idx].key] = nilIndex<IndexT>();
+	--heap_size_;
+	
+	if(heap_idx == heap_size_) return;
+	
+	// Move the last element in the place and restore heap property by bubbling.
+	Entry last = heap_[heap_size_];
+	if(heap_idx != 0 && last.priority < heap_[getHeapParent_(heap_idx)].priority) {
+		bubbleUp_(heap_idx, last);
+	} else {
+		bubbleDown_(heap_idx, last);
+	}
+}
+
+template <typename PriorityT, Idx ArityT, typename AllocatorT, typename IndexT>
+void BasicDAryHeap<PriorityT, ArityT, AllocatorT, IndexT>::placeInHeap_(Idx heap_idx, const Entry& entry) {
+	heap_[heap_idx] = entry;
+	heap_indices_[entry.key] = compactIndex<IndexT>(heap_idx);
+}
+
+template <typename PriorityT, Idx ArityT, typename AllocatorT, typename IndexT>
+void BasicDAryHeap<PriorityT, ArityT, AllocatorT, IndexT>::bubbleUp_(Idx heap_idx, const Entry& entry) {
+	// Move the parents down to the hole until the place of entry is found.
+	while(heap_idx != 0) {
+		Idx parent = getHeapParent_(heap_idx);
+		if(!(entry.priority < heap_[parent].priority)) break;
+		placeInHeap_(heap_idx, heap_[parent]);
+		heap_idx = parent;
+	}
+	
+	placeInHeap_(heap_idx, entry);
+}
+
+template <typename PriorityT, Idx ArityT, typename AllocatorT, typename IndexT>
+void BasicDAryHeap<PriorityT, ArityT, AllocatorT, IndexT>::bubbleDown_(Idx heap_idx, const Entry& entry) {
+	// Move the highest priority children up to the hole until the place of
+	// entry is found.
+	while(true) {
+		Idx first = getHeapFirstChild_(heap_idx);
+		if(first >= heap_size_) break;
+		
+		Idx end = std::min(first + ArityT, heap_size_);
+		Idx priority_child = first;
+		for(Idx child = first + 1; child < end; ++child) {
+			if(heap_[child].priority < heap_[priority_child].priority) {
+				priority_child = child;
+			}
+		}
+		
+		if(!(heap_[priority_child].priority < entry.priority)) break;
+		
+		placeInHeap_(heap_idx, heap_[priority_child]);
+		heap_idx = priority_child;
+	}
+	
+	placeInHeap_(heap_idx, entry);
+}
+
+}
+}
+}
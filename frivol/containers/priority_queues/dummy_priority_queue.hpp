@@ -2,7 +2,7 @@
 #define FRIVOL_CONTAINERS_PRIORITY_QUEUES_DUMMY_PRIORITY_QUEUE_HPP
 
 #include <frivol/common.hpp>
-#include <frivol/containers/array.hpp>
+#include <frivol/containers/dynamic_array.hpp>
 
 #include <boost/optional.hpp>
 
@@ -11,25 +11,33 @@ namespace containers {
 namespace priority_queues {
 
 /// Simple implementation of PriorityQueueConcept.
-template <typename PriorityT>
+/// @tparam AllocatorT The allocator used for the internal arrays (see Array).
+/// @tparam IndexT Unused, as no indices are stored.
+template <typename PriorityT, typename AllocatorT = DefaultAllocator, typename IndexT = Idx>
 class DummyPriorityQueue {
 public:
 	BOOST_CONCEPT_ASSERT((boost::LessThanComparable<PriorityT>));
 	
-	DummyPriorityQueue(Idx size);
+	DummyPriorityQueue(Idx size, const AllocatorT& allocator = AllocatorT());
 	
 	std::pair<Idx, PriorityT> pop();
+	std::pair<Idx, PriorityT> top();
 	
 	bool empty() const;
 	
 	void setPriority(Idx key, PriorityT priority);
 	void setPriorityNIL(Idx key);
 	
+	void reset(Idx size);
+	
+	MemoryUsage getMemoryUsage() const;
+	static std::size_t estimateMemoryUsage(Idx size);
+	
 private:
 	typedef boost::optional<PriorityT> OptionalPriorityT;
 	
 	/// Array of priority values (empty in case of NIL).
-	Array<OptionalPriorityT> priorities_;
+	DynamicArray<OptionalPriorityT, AllocatorT> priorities_;
 };
 
 }
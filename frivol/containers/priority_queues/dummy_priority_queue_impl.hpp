@@ -2,13 +2,22 @@ namespace frivol {
 namespace containers {
 namespace priority_queues {
 
-template <typename PriorityT>
-DummyPriorityQueue<PriorityT>::DummyPriorityQueue(Idx size)
-	: priorities_(size)
-{ }
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+DummyPriorityQueue<PriorityT, AllocatorT, IndexT>::DummyPriorityQueue(Idx size, const AllocatorT& allocator)
+	: priorities_(allocator)
+{
+	reset(size);
+}
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+std::pair<Idx, PriorityT> DummyPriorityQueue<PriorityT, AllocatorT, IndexT>::pop() {
+	std::pair<Idx, PriorityT> best = top();
+	priorities_[best.first].reset();
+	return best;
+}
 
-template <typename PriorityT>
-std::pair<Idx, PriorityT> DummyPriorityQueue<PriorityT>::pop() {
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+std::pair<Idx, PriorityT> DummyPriorityQueue<PriorityT, AllocatorT, IndexT>::top() {
 	Idx best = nil_idx;
 	for(Idx key = 0; key < priorities_.getSize(); ++key) {
 		if(priorities_[key].get_ptr() == nullptr) continue;
@@ -18,29 +27,45 @@ std::pair<Idx, PriorityT> DummyPriorityQueue<PriorityT>::pop() {
 		}
 	}
 	
-	PriorityT best_priority = priorities_[best].get();
-	priorities_[best].reset();
-	return std::make_pair(best, best_priority);
+	return std::make_pair(best, priorities_[best].get());
 }
 
-template <typename PriorityT>
-bool DummyPriorityQueue<PriorityT>::empty() const {
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+bool DummyPriorityQueue<PriorityT, AllocatorT, IndexT>::empty() const {
 	for(Idx i = 0; i < priorities_.getSize(); ++i) {
 		if(priorities_[i].get_ptr() != nullptr) return false;
 	}
 	return true;
 }
 
-template <typename PriorityT>
-void DummyPriorityQueue<PriorityT>::setPriority(Idx key, PriorityT priority) {
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+void DummyPriorityQueue<PriorityT, AllocatorT, IndexT>::setPriority(Idx key, PriorityT priority) {
 	priorities_[key] = priority;
 }
 
-template <typename PriorityT>
-void DummyPriorityQueue<PriorityT>::setPriorityNIL(Idx key) {
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+void DummyPriorityQueue<PriorityT, AllocatorT, IndexT>::setPriorityNIL(Idx key) {
 	priorities_[key].reset();
 }
 
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+MemoryUsage DummyPriorityQueue<PriorityT, AllocatorT, IndexT>::getMemoryUsage() const {
+	return priorities_.getMemoryUsage();
+}
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+std::size_t DummyPriorityQueue<PriorityT, AllocatorT, IndexT>::estimateMemoryUsage(Idx size) {
+	return size * sizeof(OptionalPriorityT);
+}
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+void DummyPriorityQueue<PriorityT, AllocatorT, IndexT>::reset(Idx size) {
+	priorities_.resize(size);
+	for(Idx key = 0; key < size; ++key) {
+		priorities_[key].reset();
+	}
+}
+
 }
 }
 }
@@ -0,0 +1,143 @@
+#ifndef FRIVOL_CONTAINERS_PRIORITY_QUEUES_LAZY_HEAP_HPP
+#define FRIVOL_CONTAINERS_PRIORITY_QUEUES_LAZY_HEAP_HPP
+
+#include <frivol/common.hpp>
+#include <frivol/containers/dynamic_array.hpp>
+
+#include <boost/concept_check.hpp>
+
+#include <utility>
+
+namespace frivol {
+namespace containers {
+namespace priority_queues {
+
+/// Implementation of PriorityQueueConcept using a 4-ary heap with lazy
+/// invalidation. Each key has a generation number that is incremented when
+/// its priority is changed or set to NIL, and the heap entries are stamped
+/// with the generation of their key. Instead of removing the old entry from
+/// the heap, setPriorityNIL and setPriority only increment the generation in
+/// constant time, and the stale entries are discarded when they reach the
+/// top of the heap or when the heap is compacted. Has the lazy_invalidation
+/// capability (see IsLazyPriorityQueue).
+/// @tparam PriorityT The priority type. Should be default constructible and
+/// assignable.
+/// @tparam AllocatorT The allocator used for the internal arrays (see Array).
+/// @tparam IndexT The unsigned integer type in which the keys and the
+/// generations are stored. The keys must be less than nilIndex<IndexT>().
+template <typename PriorityT, typename AllocatorT = DefaultAllocator, typename IndexT = Idx>
+class LazyHeap {
+public:
+	BOOST_CONCEPT_ASSERT((boost::LessThanComparable<PriorityT>));
+	
+	static constexpr bool lazy_invalidation = true;
+	
+	LazyHeap(Idx size, const AllocatorT& allocator = AllocatorT());
+	
+	std::pair<Idx, PriorityT> pop();
+	std::pair<Idx, PriorityT> top();
+	
+	bool empty() const;
+	
+	void setPriority(Idx key, PriorityT priority);
+	void setPriorityNIL(Idx key);
+	
+	void reset(Idx size);
+	
+	MemoryUsage getMemoryUsage() const;
+	static std::size_t estimateMemoryUsage(Idx size);
+	
+	/// Returns the number of non-NIL priorities that have been invalidated
+	/// lazily by setPriority or setPriorityNIL. Each of them would have been
+	/// a removal from the heap in an eagerly invalidating heap.
+	Idx getInvalidationCount() const;
+	
+	/// Returns the number of stale entries that have been removed from the
+	/// heap top. Each of them costs as much as a pop.
+	Idx getDiscardCount() const;
+	
+	/// Returns the number of stale entries that have been removed in
+	/// compactions of the heap, in linear time in the heap size.
+	Idx getCompactedCount() const;
+	
+private:
+	/// The number of children of each heap node.
+	static constexpr Idx arity_ = 4;
+	
+	/// Element of the heap.
+	struct Entry {
+		PriorityT priority;
+		IndexT key;
+		
+		/// The generation of the key when the entry was added.
+		IndexT generation;
+	};
+	
+	/// Returns true if the entry is the current priority of its key.
+	/// @param entry The heap entry.
+	bool isCurrent_(const Entry& entry) const;
+	
+	/// Increments the generation of given key, making its entries stale.
+	/// @param key The key.
+	void advanceGeneration_(Idx key);
+	
+	/// Removes the stale entries from the top of the heap.
+	void discardStaleTop_();
+	
+	/// Removes the top entry of the heap.
+	void removeTop_();
+	
+	/// Removes all stale entries from the heap and restores the heap
+	/// property.
+	void compact_();
+	
+	/// Moves entry towards the top starting from given heap index (the contents
+	/// of which are overwritten) as long as it has higher priority than the
+	/// parent.
+	/// @param heap_idx The starting heap index.
+	/// @param entry The entry to place.
+	void bubbleUp_(Idx heap_idx, const Entry& entry);
+	
+	/// Moves entry away from the top starting from given heap index (the
+	/// contents of which are overwritten) as long as it has a child with higher
+	/// priority.
+	/// @param heap_idx The starting heap index.
+	/// @param entry The entry to place.
+	void bubbleDown_(Idx heap_idx, const Entry& entry);
+	
+	/// The current generations of the keys.
+	DynamicArray<IndexT, AllocatorT> generations_;
+	
+	/// True for the keys with non-NIL priority.
+	DynamicArray<bool, AllocatorT> has_priority_;
+	
+	/// The number of keys with non-NIL priorities.
+	Idx priority_count_;
+	
+	/// The number of entries in the heap, including the stale ones.
+	Idx heap_size_;
+	
+	/// The heap is stored in heap_[i], i = 0...heap_size_-1. The capacity is
+	/// twice the number of keys, so that a compaction frees at least half of
+	/// the heap.
+	DynamicArray<Entry, AllocatorT> heap_;
+	
+	/// Counters for getInvalidationCount, getDiscardCount and
+	/// getCompactedCount.
+	Idx invalidation_count_;
+	Idx discard_count_;
+	Idx compacted_count_;
+};
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+constexpr bool LazyHeap<PriorityT, AllocatorT, IndexT>::lazy_invalidation;
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+constexpr Idx LazyHeap<PriorityT, AllocatorT, IndexT>::arity_;
+
+}
+}
+}
+
+#include "lazy_heap_impl.hpp"
+
+#endif
@@ -0,0 +1,198 @@
+#include <algorithm>
+
+namespace frivol {
+namespace containers {
+namespace priority_queues {
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+LazyHeap<PriorityT, AllocatorT, IndexT>::LazyHeap(Idx size, const AllocatorT& allocator)
+	: generations_(allocator),
+	  has_priority_(allocator),
+	  heap_(allocator)
+{
+	reset(size);
+}
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+std::pair<Idx, PriorityT> LazyHeap<PriorityT, AllocatorT, IndexT>::pop() {
+	discardStaleTop_();
+	
+	std::pair<Idx, PriorityT> top(heap_[0].key, heap_[0].priority);
+	has_priority_[top.first] = false;
+	--priority_count_;
+	removeTop_();
+	
+	return top;
+}
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+std::pair<Idx, PriorityT> LazyHeap<PriorityT, AllocatorT, IndexT>::top() {
+	discardStaleTop_();
+	return std::make_pair(heap_[0].key, heap_[0].priority);
+}
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+bool LazyHeap<PriorityT, AllocatorT, IndexT>::empty() const {
+	return priority_count_ == 0;
+}
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+void LazyHeap<PriorityT, AllocatorT, IndexT>::setPriority(Idx key, PriorityT priority) {
+	// Make the possible old entry stale.
+	if(has_priority_[key]) {
+		++invalidation_count_;
+	} else {
+		has_priority_[key] = true;
+		++priority_count_;
+	}
+	advanceGeneration_(key);
+	
+	if(heap_size_ == heap_.getSize()) compact_();
+	
+	Entry entry = {priority, compactIndex<IndexT>(key), generations_[key]};
+	++heap_size_;
+	bubbleUp_(heap_size_ - 1, entry);
+}
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+void LazyHeap<PriorityT, AllocatorT, IndexT>::setPriorityNIL(Idx key) {
+	if(!has_priority_[key]) return;
+	
+	has_priority_[key] = false;
+	--priority_count_;
+	advanceGeneration_(key);
+	++invalidation_count_;
+}
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+MemoryUsage LazyHeap<PriorityT, AllocatorT, IndexT>::getMemoryUsage() const {
+	return generations_.getMemoryUsage() + has_priority_.getMemoryUsage() + heap_.getMemoryUsage();
+}
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+std::size_t LazyHeap<PriorityT, AllocatorT, IndexT>::estimateMemoryUsage(Idx size) {
+	// The heap has room for two entries per key before it is compacted.
+	return size * (sizeof(IndexT) + sizeof(bool) + 2 * sizeof(Entry));
+}
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+void LazyHeap<PriorityT, AllocatorT, IndexT>::reset(Idx size) {
+	generations_.resize(size);
+	has_priority_.resize(size);
+	heap_.resize(2 * size);
+	for(Idx key = 0; key < size; ++key) {
+		generations_[key] = 0;
+		has_priority_[key] = false;
+	}
+	priority_count_ = 0;
+	heap_size_ = 0;
+	invalidation_count_ = 0;
+	discard_count_ = 0;
+	compacted_count_ = 0;
+}
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+Idx LazyHeap<PriorityT, AllocatorT, IndexT>::getInvalidationCount() const {
+	return invalidation_count_;
+}
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+Idx LazyHeap<PriorityT, AllocatorT, IndexT>::getDiscardCount() const {
+	return discard_count_;
+}
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+Idx LazyHeap<PriorityT, AllocatorT, IndexT>::getCompactedCount() const {
+	return compacted_count_;
+}
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+bool LazyHeap<PriorityT, AllocatorT, IndexT>::isCurrent_(const Entry& entry) const {
+	return entry.generation == generations_[entry.key] && has_priority_[entry.key];
+}
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+void LazyHeap<PriorityT, AllocatorT, IndexT>::advanceGeneration_(Idx key) {
+	// When the generation wraps around, old stale entries of the key could
+	// match the new generation, so they are removed first. This happens once
+	// in nilIndex<IndexT>() changes of the key.
+	if(generations_[key] == nilIndex<IndexT>()) compact_();
+	generations_[key] = (IndexT)(generations_[key] + 1);
+}
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+void LazyHeap<PriorityT, AllocatorT, IndexT>::discardStaleTop_() {
+	while(!isCurrent_(heap_[0])) {
+		removeTop_();
+		++discard_count_;
+	}
+}
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+void LazyHeap<PriorityT, AllocatorT, IndexT>::removeTop_() {
+	--heap_size_;
+	if(heap_size_ != 0) bubbleDown_(0, heap_[heap_size_]);
+}
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+void LazyHeap<PriorityT, AllocatorT, IndexT>::compact_() {
+	Idx old_size = heap_size_;
+	
+	heap_size_ = 0;
+	for(Idx i = 0; i < old_size; ++i) {
+		if(isCurrent_(heap_[i])) heap_[heap_size_++] = heap_[i];
+	}
+	compacted_count_ += old_size - heap_size_;
+	
+	// Rebuild the heap bottom-up.
+	if(heap_size_ > 1) {
+		for(Idx i = (heap_size_ - 2) / arity_ + 1; i-- > 0; ) {
+			bubbleDown_(i, heap_[i]);
+		}
+	}
+}
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+void LazyHeap<PriorityT, AllocatorT, IndexT>::bubbleUp_(Idx heap_idx, const Entry& entry) {
+	// Move the parents down to the hole until the place of entry is found.
+	while(heap_idx != 0) {
+		Idx parent = (heap_idx - 1) / arity_;
+		if(!(entry.priority < heap_[parent].priority)) break;
+		heap_[heap_idx] = heap_[parent];
+		heap_idx = parent;
+	}
+	
+	heap_[heap_idx] = entry;
+}
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+void LazyHeap<PriorityT, AllocatorT, IndexT>::bubbleDown_(Idx heap_idx, const Entry& entry) {
+	// Copy the entry first, as it may be in the heap at or below heap_idx.
+	Entry moving = entry;
+	
+	// Move the highest priority children up to the hole until the place of
+	// the entry is found.
+	while(true) {
+		Idx first = arity_ * heap_idx + 1;
+		if(first >= heap_size_) break;
+		
+		Idx end = std::min(first + arity_, heap_size_);
+		Idx priority_child = first;
+		for(Idx child = first + 1; child < end; ++child) {
+			if(heap_[child].priority < heap_[priority_child].priority) {
+				priority_child = child;
+			}
+		}
+		
+		if(!(heap_[priority_child].priority < moving.priority)) break;
+		
+		heap_[heap_idx] = heap_[priority_child];
+		heap_idx = priority_child;
+	}
+	
+	heap_[heap_idx] = moving;
+}
+
+}
+}
+}
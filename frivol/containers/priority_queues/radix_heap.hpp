@@ -0,0 +1,127 @@
+#ifndef FRIVOL_CONTAINERS_PRIORITY_QUEUES_RADIX_HEAP_HPP
+#define FRIVOL_CONTAINERS_PRIORITY_QUEUES_RADIX_HEAP_HPP
+
+#include <frivol/common.hpp>
+#include <frivol/containers/dynamic_array.hpp>
+#include <frivol/containers/ordered_key_traits.hpp>
+
+#include <boost/concept_check.hpp>
+
+#include <utility>
+
+namespace frivol {
+namespace containers {
+namespace priority_queues {
+
+/// Implementation of PriorityQueueConcept using a radix heap, a monotone
+/// priority queue. The priorities are mapped to integer keys using
+/// OrderedKeyTraits, and each key is placed in a bucket according to the
+/// most significant bit in which it differs from the last popped key. Each
+/// key moves only to lower buckets until it is popped, so the operations
+/// take amortized time proportional to the number of bits in the keys
+/// instead of the logarithm of the queue size.
+/// 
+/// The queue is efficient when priorities lower than the last popped
+/// priority are not set, which holds for the events of Fortune's algorithm
+/// apart from ties. Such priorities are still popped in the right order,
+/// but they are kept unsorted in the bucket of the last popped key.
+/// @tparam PriorityT The priority type. Should implement OrderedKeyTraits,
+/// and be default constructible and assignable.
+/// @tparam AllocatorT The allocator used for the internal arrays (see Array).
+/// @tparam IndexT The unsigned integer type in which the keys are stored in
+/// the bucket lists. The keys must be less than nilIndex<IndexT>().
+template <typename PriorityT, typename AllocatorT = DefaultAllocator, typename IndexT = Idx>
+class RadixHeap {
+public:
+	BOOST_CONCEPT_ASSERT((boost::LessThanComparable<PriorityT>));
+	BOOST_CONCEPT_ASSERT((OrderedKeyTraitsImplementedConcept<PriorityT>));
+	
+	RadixHeap(Idx size, const AllocatorT& allocator = AllocatorT());
+	
+	std::pair<Idx, PriorityT> pop();
+	std::pair<Idx, PriorityT> top();
+	
+	bool empty() const;
+	
+	void setPriority(Idx key, PriorityT priority);
+	void setPriorityNIL(Idx key);
+	
+	void reset(Idx size);
+	
+	MemoryUsage getMemoryUsage() const;
+	static std::size_t estimateMemoryUsage(Idx size);
+	
+private:
+	typedef OrderedKeyTraits<PriorityT> OrderedKeyTraitsT;
+	typedef typename OrderedKeyTraitsT::Key OrderedKey;
+	
+	/// The number of buckets. Bucket 0 contains the keys equal to (or less
+	/// than) the last popped key, and bucket i > 0 the keys that differ from
+	/// it first in bit i - 1.
+	static constexpr Idx bucket_count_ = OrderedKeyTraitsT::bits + 1;
+	
+	/// Queue element of a key.
+	struct Entry {
+		/// The priority of the key.
+		PriorityT priority;
+		
+		/// The ordered key of the priority.
+		OrderedKey ordered_key;
+		
+		/// The bucket containing the key, or nilIndex<IndexT>() if the
+		/// priority is NIL.
+		IndexT bucket;
+		
+		/// The previous and the next key in the same bucket, or
+		/// nilIndex<IndexT>().
+		IndexT prev;
+		IndexT next;
+	};
+	
+	/// Returns the key with the lowest priority, refilling bucket 0 if it is
+	/// empty. The queue must be nonempty.
+	Idx getTopKey_();
+	
+	/// Returns the bucket in which given ordered key belongs.
+	/// @param ordered_key The ordered key.
+	Idx getBucket_(const OrderedKey& ordered_key) const;
+	
+	/// Adds key to the beginning of the list of given bucket.
+	/// @param key The key. Must not be in any bucket.
+	/// @param bucket The bucket.
+	void linkToBucket_(Idx key, Idx bucket);
+	
+	/// Removes key from the list of its bucket.
+	/// @param key The key. Must be in a bucket.
+	void unlinkFromBucket_(Idx key);
+	
+	/// Moves the keys in the first nonempty bucket to lower buckets, updating
+	/// the last popped key to the minimum of that bucket. Bucket 0 must be
+	/// empty and the queue nonempty.
+	void refillFirstBucket_();
+	
+	/// The queue elements by key.
+	DynamicArray<Entry, AllocatorT> entries_;
+	
+	/// The first keys of the lists of the buckets, or nilIndex<IndexT>() for
+	/// empty bucket.
+	DynamicArray<IndexT, AllocatorT> bucket_heads_;
+	
+	/// The ordered key of the last popped priority, initially the smallest
+	/// ordered key.
+	OrderedKey last_;
+	
+	/// The number of keys with non-NIL priorities.
+	Idx size_;
+};
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+constexpr Idx RadixHeap<PriorityT, AllocatorT, IndexT>::bucket_count_;
+
+}
+}
+}
+
+#include "radix_heap_impl.hpp"
+
+#endif
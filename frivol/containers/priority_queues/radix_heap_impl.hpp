@@ -0,0 +1,152 @@
+namespace frivol {
+namespace containers {
+namespace priority_queues {
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+RadixHeap<PriorityT, AllocatorT, IndexT>::RadixHeap(Idx size, const AllocatorT& allocator)
+	: entries_(allocator),
+	  bucket_heads_(bucket_count_, allocator)
+{
+	reset(size);
+}
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+std::pair<Idx, PriorityT> RadixHeap<PriorityT, AllocatorT, IndexT>::pop() {
+	Idx top_key = getTopKey_();
+	
+	unlinkFromBucket_(top_key);
+	--size_;
+	
+	return std::make_pair(top_key, entries_[top_key].priority);
+}
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+std::pair<Idx, PriorityT> RadixHeap<PriorityT, AllocatorT, IndexT>::top() {
+	Idx top_key = getTopKey_();
+	return std::make_pair(top_key, entries_[top_key].priority);
+}
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+bool RadixHeap<PriorityT, AllocatorT, IndexT>::empty() const {
+	return size_ == 0;
+}
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+void RadixHeap<PriorityT, AllocatorT, IndexT>::setPriority(Idx key, PriorityT priority) {
+	Entry& entry = entries_[key];
+	if(entry.bucket == nilIndex<IndexT>()) {
+		++size_;
+	} else {
+		unlinkFromBucket_(key);
+	}
+	
+	entry.priority = priority;
+	entry.ordered_key = OrderedKeyTraitsT::getKey(priority);
+	linkToBucket_(key, getBucket_(entry.ordered_key));
+}
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+void RadixHeap<PriorityT, AllocatorT, IndexT>::setPriorityNIL(Idx key) {
+	if(entries_[key].bucket == nilIndex<IndexT>()) return;
+	
+	unlinkFromBucket_(key);
+	--size_;
+}
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+MemoryUsage RadixHeap<PriorityT, AllocatorT, IndexT>::getMemoryUsage() const {
+	return entries_.getMemoryUsage() + bucket_heads_.getMemoryUsage();
+}
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+std::size_t RadixHeap<PriorityT, AllocatorT, IndexT>::estimateMemoryUsage(Idx size) {
+	return size * sizeof(Entry) + bucket_count_ * sizeof(IndexT);
+}
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+void RadixHeap<PriorityT, AllocatorT, IndexT>::reset(Idx size) {
+	entries_.resize(size);
+	for(Idx key = 0; key < size; ++key) {
+		entries_[key].bucket = nilIndex<IndexT>();
+	}
+	for(Idx bucket = 0; bucket < bucket_count_; ++bucket) {
+		bucket_heads_[bucket] = nilIndex<IndexT>();
+	}
+	last_ = OrderedKey();
+	size_ = 0;
+}
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+Idx RadixHeap<PriorityT, AllocatorT, IndexT>::getTopKey_() {
+	if(bucket_heads_[0] == nilIndex<IndexT>()) refillFirstBucket_();
+	
+	// The keys in bucket 0 are usually equal to last_, but may also be less
+	// than it, so find the minimum.
+	Idx top_key = bucket_heads_[0];
+	for(Idx key = expandIndex(entries_[top_key].next); key != nil_idx; key = expandIndex(entries_[key].next)) {
+		if(entries_[key].ordered_key < entries_[top_key].ordered_key) {
+			top_key = key;
+		}
+	}
+	
+	return top_key;
+}
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+Idx RadixHeap<PriorityT, AllocatorT, IndexT>::getBucket_(const OrderedKey& ordered_key) const {
+	if(ordered_key < last_) return 0;
+	return OrderedKeyTraitsT::getDifferingBitCount(last_, ordered_key);
+}
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+void RadixHeap<PriorityT, AllocatorT, IndexT>::linkToBucket_(Idx key, Idx bucket) {
+	Entry& entry = entries_[key];
+	Idx head = expandIndex(bucket_heads_[bucket]);
+	
+	entry.bucket = compactIndex<IndexT>(bucket);
+	entry.prev = nilIndex<IndexT>();
+	entry.next = compactIndex<IndexT>(head);
+	if(head != nil_idx) entries_[head].prev = compactIndex<IndexT>(key);
+	bucket_heads_[bucket] = compactIndex<IndexT>(key);
+}
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+void RadixHeap<PriorityT, AllocatorT, IndexT>::unlinkFromBucket_(Idx key) {
+	Entry& entry = entries_[key];
+	
+	if(entry.prev == nilIndex<IndexT>()) {
+		bucket_heads_[entry.bucket] = entry.next;
+	} else {
+		entries_[entry.prev].next = entry.next;
+	}
+	if(entry.next != nilIndex<IndexT>()) entries_[entry.next].prev = entry.prev;
+	
+	entry.bucket = nilIndex<IndexT>();
+}
+
+template <typename PriorityT, typename AllocatorT, typename IndexT>
+void RadixHeap<PriorityT, AllocatorT, IndexT>::refillFirstBucket_() {
+	Idx bucket = 1;
+	while(bucket_heads_[bucket] == nilIndex<IndexT>()) ++bucket;
+	
+	// The new last key is the minimum of the bucket.
+	Idx head = bucket_heads_[bucket];
+	last_ = entries_[head].ordered_key;
+	for(Idx key = expandIndex(entries_[head].next); key != nil_idx; key = expandIndex(entries_[key].next)) {
+		if(entries_[key].ordered_key < last_) last_ = entries_[key].ordered_key;
+	}
+	
+	// Redistribute the keys. All of them go to lower buckets because they
+	// agree with the new last key in the bits above bucket - 1.
+	bucket_heads_[bucket] = nilIndex<IndexT>();
+	Idx key = head;
+	while(key != nil_idx) {
+		Idx next = expandIndex(entries_[key].next);
+		linkToBucket_(key, getBucket_(entries_[key].ordered_key));
+		key = next;
+	}
+}
+
+}
+}
+}
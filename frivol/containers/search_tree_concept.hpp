@@ -1,16 +1,26 @@
 #ifndef FRIVOL_CONTAINERS_SEARCH_TREE_CONCEPT_HPP
 #define FRIVOL_CONTAINERS_SEARCH_TREE_CONCEPT_HPP
 
+#include <frivol/common.hpp>
+#include <frivol/memory_usage.hpp>
+
 #include <boost/concept_check.hpp>
 
+#include <memory>
+#include <type_traits>
+
 namespace frivol {
 namespace containers {
 
-/// Concept checking class for search trees X for elements of type ElementT.
+/// Concept checking class for search trees X for elements of type ElementT,
+/// allocating memory through allocators of type AllocatorT.
 /// Search trees are sequence containers, the elements of which are iterated
 /// using iterator objects of type X::Iterator. The iterator must be a
 /// standard bidirectional iterator. X must support the following operations:
-///  - <construct>() creates empty search tree.
+///  - <construct>(const AllocatorT& allocator) creates empty search tree,
+///    allocating all memory through 'allocator'.
+///  - <construct>() does the same with a default constructed allocator. Only
+///    required if AllocatorT is default constructible.
 ///  - bool empty() const retuns true if the search tree is empty.
 ///  - Iterator begin() returns the iterator of the first element (or past-the-end
 ///    if empty).
@@ -21,14 +31,34 @@ namespace containers {
 ///    positive if it is after iter, and 0 if iter is the right element.
 ///    If an element such that func returns 0 is found, it is returned,
 ///    otherwise end() is returned.
+///  - template<typename FuncT> Iterator search(Iterator hint, FuncT func)
+///    works like search(func), but starts the search from hint (which may be
+///    end(), in which case the search is not hinted). The hint is advisory:
+///    the result is the same as without it, and the tree need not be faster
+///    when the searched element is close to hint. Of the trees included
+///    here, only FlatSearchTree, whose search is logarithmic in the distance
+///    between the elements, and BTree, whose high fanout keeps most searches
+///    within the leaf of the hint, benefit from hints. The AVL trees have no
+///    level links, so their hinted search may climb to the root and takes
+///    O(log n) time.
 ///  - void erase(Iterator iter) removes element at iter. Other iterators
 ///    should not be invalidated.
 ///  - Iterator insert(Iterator iter, const ElementT& elem) inserts elem before
 ///    iter and returns the iterator of the new element. Does not invalidate any
 ///    iterators.
+///  - void reserve(Idx size) tells that the tree is going to contain at most
+///    'size' elements at a time. The tree may preallocate storage for them.
+///  - void clear() removes all elements. The storage reserved or allocated
+///    for the elements should be kept for reuse.
+///  - MemoryUsage getMemoryUsage() const returns the memory allocated by the
+///    tree.
+///  - static std::size_t estimateMemoryUsage(Idx size) returns an upper bound
+///    of the number of bytes allocated by an empty tree after reserve(size)
+///    and insertion of at most 'size' elements, excluding the bookkeeping of
+///    the allocator.
 /// 
 /// X may assume that ElementT is copy constructible.
-template <typename X, typename ElementT>
+template <typename X, typename ElementT, typename AllocatorT = std::allocator<char>>
 class SearchTreeConcept {
 public:
 	typedef typename X::Iterator IteratorT;
@@ -36,18 +66,31 @@ public:
 	BOOST_CONCEPT_ASSERT((boost::BidirectionalIterator<IteratorT>));
 	
 	BOOST_CONCEPT_USAGE(SearchTreeConcept) {
-		X x;
+		X x(allocator);
+		constructDefault_(std::is_default_constructible<AllocatorT>());
 		IteratorT iter;
 		sameType(x.empty(), bool());
 		sameType(x.begin(), iter);
 		sameType(x.end(), iter);
 		x.erase(iter);
 		sameType(x.insert(iter, elem), iter);
+		x.reserve(size);
+		x.clear();
+		sameType(x.getMemoryUsage(), MemoryUsage());
+		sameType(X::estimateMemoryUsage(size), std::size_t());
 		x.search([](IteratorT iter) -> int { return 0; });
+		x.search(iter, [](IteratorT iter) -> int { return 0; });
 	}
 	
 private:
 	ElementT elem;
+	Idx size;
+	AllocatorT allocator;
+	
+	void constructDefault_(std::true_type) {
+		X x;
+	}
+	void constructDefault_(std::false_type) { }
 	
 	/// Function that causes compile time error if called with parameters of
 	/// different types.
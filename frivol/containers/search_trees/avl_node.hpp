@@ -4,40 +4,72 @@
 #include <frivol/common.hpp>
 
 #include <memory>
+#include <type_traits>
 
 namespace frivol {
 namespace containers {
 namespace search_trees {
 
-/// AVL tree node. Nodes form a rooted binary tree.
+/// AVL tree node. Nodes form a rooted binary tree, threaded with links to the
+/// in-order previous and next nodes.
 /// @tparam ElementT The element type stored in the nodes.
-template <typename ElementT>
+/// @tparam DeleterT The deleter template used in the unique_ptrs owning the
+/// nodes. The default deletes nodes allocated with new, but the nodes can also
+/// be allocated elsewhere, e.g. from a Pool or with allocateObject, using a
+/// different deleter.
+template <
+	typename ElementT,
+	template <typename T> class DeleterT = std::default_delete
+>
 class AVLNode {
 public:
-	typedef AVLNode<ElementT> Node;
+	typedef AVLNode<ElementT, DeleterT> Node;
+	
+	/// Owning pointer to a node.
+	typedef std::unique_ptr<Node, DeleterT<Node>> NodePtr;
 	
 	/// Constructs an AVL root node with no children.
-	AVLNode(const ElementT& element);
+	/// @param element The element stored in the node.
+	/// @param deleter The deleter of the empty child pointers, which is moved
+	/// along when children are set, so that it can carry the allocator of the
+	/// nodes.
+	AVLNode(const ElementT& element, const DeleterT<Node>& deleter = DeleterT<Node>());
 	
 	/// Returns reference to the element stored in the node.
 	ElementT& getElement();
 	
-	/// Create a new node and place it as the left child of this node.
+	/// Create a new node with new and place it as the left child of this node.
+	/// Only for the default deleter, which is checked at compile time, as other
+	/// deleters do not free memory allocated with new.
 	/// @param element The element stored in the new node.
 	/// @returns pointer to the added node.
 	Node* createLeftChild(const ElementT& element);
 	
-	/// Create a new node and place it as the right child of this node.
+	/// Create a new node with new and place it as the right child of this node.
+	/// Only for the default deleter, which is checked at compile time.
 	/// @param element The element stored in the new node.
 	/// @returns pointer to the added node.
 	Node* createRightChild(const ElementT& element);
 	
+	/// Place a root node without children as the left child of this node.
+	/// @param child Owning pointer to the node. The node must not have a
+	/// parent or children.
+	/// @returns pointer to the added node.
+	Node* setLeftChild(NodePtr child);
+	
+	/// Place a root node without children as the right child of this node.
+	/// @param child Owning pointer to the node. The node must not have a
+	/// parent or children.
+	/// @returns pointer to the added node.
+	Node* setRightChild(NodePtr child);
+	
 	/// Remove the node from the tree if it has at most one child. It will be
-	/// replaced by the child.
+	/// replaced by the child. The node is destroyed through the deleter of its
+	/// owner, so it must not be accessed after successful removal.
 	/// @param root_ptr This unique pointer should own the root node of the
 	/// tree, and will be set to the new root if the root changes.
 	/// @returns true if the node was removed, false if the node had both children.
-	bool remove(std::unique_ptr<Node>& root_ptr);
+	bool remove(NodePtr& root_ptr);
 	
 	/// Returns pointer to the left child or nullptr if none.
 	Node* getLeftChild();
@@ -59,11 +91,11 @@ public:
 	Node* getRightmostDescendant();
 	
 	/// Returns the in-order previous node in the tree, or nullptr if the node
-	/// is the leftmost.
+	/// is the leftmost. Constant time.
 	Node* getPreviousNode();
 	
 	/// Returns the in-order next node in the tree, or nullptr if the node
-	/// is the rightmost.
+	/// is the rightmost. Constant time.
 	Node* getNextNode();
 	
 	/// Returns the balance factor of the node, i.e. difference of the heights
@@ -75,19 +107,19 @@ public:
 	/// left child.
 	/// @param root_ptr This unique pointer should own the root node of the
 	/// tree, and will be set to the new root if the root changes.
-	void rotateRight(std::unique_ptr<Node>& root_ptr);
+	void rotateRight(NodePtr& root_ptr);
 	
 	/// Perform left-rotation rooted in this node. Assumes that the node has a
 	/// right child.
 	/// @param root_ptr This unique pointer should own the root node of the
 	/// tree, and will be set to the new root if the root changes.
-	void rotateLeft(std::unique_ptr<Node>& root_ptr);
+	void rotateLeft(NodePtr& root_ptr);
 	
 	/// Swap the positions of two nodes in the tree.
 	/// @param node1,node2 Pointers to the nodes to swap.
 	/// @param root_ptr This unique pointer should own the root node of the
 	/// tree, and will be set to the new root if the root changes.
-	static void swapNodes(Node* node1, Node* node2, std::unique_ptr<Node>& root_ptr);
+	static void swapNodes(Node* node1, Node* node2, NodePtr& root_ptr);
 	
 private:
 	/// Recalculates the height from the heights of the children, and if it
@@ -97,7 +129,10 @@ private:
 	/// Returns the unique_ptr owning this node in the tree, or root_ptr if this
 	/// is the root.
 	/// @param root_ptr The reference returned if the node is root.
-	std::unique_ptr<AVLNode>& getOwner_(std::unique_ptr<Node>& root_ptr);
+	NodePtr& getOwner_(NodePtr& root_ptr);
+	
+	/// Links the in-order neighbours of this node to the node itself.
+	void linkThread_();
 	
 	/// The element stored in the node.
 	ElementT element_;
@@ -106,10 +141,16 @@ private:
 	Node* parent_;
 	
 	/// Left child or nullptr if none.
-	std::unique_ptr<Node> left_;
+	NodePtr left_;
 	
 	/// Right child or nullptr if none.
-	std::unique_ptr<Node> right_;
+	NodePtr right_;
+	
+	/// In-order previous node in the tree or nullptr if none.
+	Node* prev_;
+	
+	/// In-order next node in the tree or nullptr if none.
+	Node* next_;
 	
 	/// Height of the subtree, including this node.
 	Idx height_;
@@ -2,41 +2,72 @@ namespace frivol {
 namespace containers {
 namespace search_trees {
 
-template <typename ElementT>
-AVLNode<ElementT>::AVLNode(const ElementT& element)
+template <typename ElementT, template <typename T> class DeleterT>
+AVLNode<ElementT, DeleterT>::AVLNode(const ElementT& element, const DeleterT<Node>& deleter)
 	: element_(element),
 	  parent_(nullptr),
+	  left_(nullptr, deleter),
+	  right_(nullptr, deleter),
+	  prev_(nullptr),
+	  next_(nullptr),
 	  height_(1)
 { }
 
-template <typename ElementT>
-ElementT& AVLNode<ElementT>::getElement() {
+template <typename ElementT, template <typename T> class DeleterT>
+ElementT& AVLNode<ElementT, DeleterT>::getElement() {
 	return element_;
 }
 
-template <typename ElementT>
-AVLNode<ElementT>* AVLNode<ElementT>::createLeftChild(const ElementT& element) {
-	left_.reset(new AVLNode(element));
+template <typename ElementT, template <typename T> class DeleterT>
+AVLNode<ElementT, DeleterT>* AVLNode<ElementT, DeleterT>::createLeftChild(const ElementT& element) {
+	static_assert(
+		std::is_same<DeleterT<Node>, std::default_delete<Node>>::value,
+		"AVLNode: createLeftChild requires the default deleter."
+	);
+	return setLeftChild(NodePtr(new AVLNode(element)));
+}
+
+template <typename ElementT, template <typename T> class DeleterT>
+AVLNode<ElementT, DeleterT>* AVLNode<ElementT, DeleterT>::createRightChild(const ElementT& element) {
+	static_assert(
+		std::is_same<DeleterT<Node>, std::default_delete<Node>>::value,
+		"AVLNode: createRightChild requires the default deleter."
+	);
+	return setRightChild(NodePtr(new AVLNode(element)));
+}
+
+template <typename ElementT, template <typename T> class DeleterT>
+AVLNode<ElementT, DeleterT>* AVLNode<ElementT, DeleterT>::setLeftChild(NodePtr child) {
+	left_ = std::move(child);
 	left_->parent_ = this;
+	left_->prev_ = prev_;
+	left_->next_ = this;
+	left_->linkThread_();
 	updateHeight_();
 	return left_.get();
 }
 
-template <typename ElementT>
-AVLNode<ElementT>* AVLNode<ElementT>::createRightChild(const ElementT& element) {
-	right_.reset(new AVLNode(element));
+template <typename ElementT, template <typename T> class DeleterT>
+AVLNode<ElementT, DeleterT>* AVLNode<ElementT, DeleterT>::setRightChild(NodePtr child) {
+	right_ = std::move(child);
 	right_->parent_ = this;
+	right_->prev_ = this;
+	right_->next_ = next_;
+	right_->linkThread_();
 	updateHeight_();
 	return right_.get();
 }
 
-template <typename ElementT>
-bool AVLNode<ElementT>::remove(std::unique_ptr<Node>& root_ptr) {
+template <typename ElementT, template <typename T> class DeleterT>
+bool AVLNode<ElementT, DeleterT>::remove(NodePtr& root_ptr) {
 	if(left_ != nullptr && right_ != nullptr) return false;
 	
-	std::unique_ptr<Node>& owner = getOwner_(root_ptr);
+	NodePtr& owner = getOwner_(root_ptr);
 	Node* parent = parent_;
 	
+	if(prev_ != nullptr) prev_->next_ = next_;
+	if(next_ != nullptr) next_->prev_ = prev_;
+	
 	if(left_ != nullptr) {
 		left_->parent_ = parent;
 		owner = std::move(left_);
@@ -52,28 +83,28 @@ bool AVLNode<ElementT>::remove(std::unique_ptr<Node>& root_ptr) {
 	return true;
 }
 
-template <typename ElementT>
-AVLNode<ElementT>* AVLNode<ElementT>::getLeftChild() {
+template <typename ElementT, template <typename T> class DeleterT>
+AVLNode<ElementT, DeleterT>* AVLNode<ElementT, DeleterT>::getLeftChild() {
 	return left_.get();
 }
 
-template <typename ElementT>
-AVLNode<ElementT>* AVLNode<ElementT>::getRightChild() {
+template <typename ElementT, template <typename T> class DeleterT>
+AVLNode<ElementT, DeleterT>* AVLNode<ElementT, DeleterT>::getRightChild() {
 	return right_.get();
 }
 
-template <typename ElementT>
-AVLNode<ElementT>* AVLNode<ElementT>::getParent() {
+template <typename ElementT, template <typename T> class DeleterT>
+AVLNode<ElementT, DeleterT>* AVLNode<ElementT, DeleterT>::getParent() {
 	return parent_;
 }
 
-template <typename ElementT>
-Idx AVLNode<ElementT>::getHeight() const {
+template <typename ElementT, template <typename T> class DeleterT>
+Idx AVLNode<ElementT, DeleterT>::getHeight() const {
 	return height_;
 }
 
-template <typename ElementT>
-AVLNode<ElementT>* AVLNode<ElementT>::getLeftmostDescendant() {
+template <typename ElementT, template <typename T> class DeleterT>
+AVLNode<ElementT, DeleterT>* AVLNode<ElementT, DeleterT>::getLeftmostDescendant() {
 	Node* node = this;
 	while(node->left_ != nullptr) {
 		node = node->left_.get();
@@ -81,8 +112,8 @@ AVLNode<ElementT>* AVLNode<ElementT>::getLeftmostDescendant() {
 	return node;
 }
 
-template <typename ElementT>
-AVLNode<ElementT>* AVLNode<ElementT>::getRightmostDescendant() {
+template <typename ElementT, template <typename T> class DeleterT>
+AVLNode<ElementT, DeleterT>* AVLNode<ElementT, DeleterT>::getRightmostDescendant() {
 	Node* node = this;
 	while(node->right_ != nullptr) {
 		node = node->right_.get();
@@ -90,44 +121,18 @@ AVLNode<ElementT>* AVLNode<ElementT>::getRightmostDescendant() {
 	return node;
 }
 
-template <typename ElementT>
-AVLNode<ElementT>* AVLNode<ElementT>::getPreviousNode() {
-	if(left_ != nullptr) {
-		return left_->getRightmostDescendant();
-	} else {
-		Node* node = this;
-		while(true) {
-			if(node->parent_ == nullptr) return nullptr;
-			
-			if(node->parent_->right_.get() == node) {
-				return node->parent_;
-			}
-			
-			node = node->parent_;
-		}
-	}
+template <typename ElementT, template <typename T> class DeleterT>
+AVLNode<ElementT, DeleterT>* AVLNode<ElementT, DeleterT>::getPreviousNode() {
+	return prev_;
 }
 
-template <typename ElementT>
-AVLNode<ElementT>* AVLNode<ElementT>::getNextNode() {
-	if(right_ != nullptr) {
-		return right_->getLeftmostDescendant();
-	} else {
-		Node* node = this;
-		while(true) {
-			if(node->parent_ == nullptr) return nullptr;
-			
-			if(node->parent_->left_.get() == node) {
-				return node->parent_;
-			}
-			
-			node = node->parent_;
-		}
-	}
+template <typename ElementT, template <typename T> class DeleterT>
+AVLNode<ElementT, DeleterT>* AVLNode<ElementT, DeleterT>::getNextNode() {
+	return next_;
 }
 
-template <typename ElementT>
-int AVLNode<ElementT>::getBalanceFactor() {
+template <typename ElementT, template <typename T> class DeleterT>
+int AVLNode<ElementT, DeleterT>::getBalanceFactor() {
 	Idx left_height = 0;
 	if(left_ != nullptr) left_height = left_->getHeight();
 	Idx right_height = 0;
@@ -140,19 +145,19 @@ int AVLNode<ElementT>::getBalanceFactor() {
 	}
 }
 
-template <typename ElementT>
-void AVLNode<ElementT>::rotateRight(std::unique_ptr<Node>& root_ptr) {
+template <typename ElementT, template <typename T> class DeleterT>
+void AVLNode<ElementT, DeleterT>::rotateRight(NodePtr& root_ptr) {
 	Node* top_node = parent_;
-	std::unique_ptr<Node>& top = getOwner_(root_ptr);
+	NodePtr& top = getOwner_(root_ptr);
 	
 	//     X          Y     //
 	//    / \        / \    //
 	//   Y   C  ->  A   X   //
 	//  / \            / \  //
 	// A  B           B   C //
-	std::unique_ptr<Node> X = std::move(top);
-	std::unique_ptr<Node> Y = std::move(X->left_);
-	std::unique_ptr<Node> B = std::move(Y->right_);
+	NodePtr X = std::move(top);
+	NodePtr Y = std::move(X->left_);
+	NodePtr B = std::move(Y->right_);
 	
 	top = std::move(Y);
 	top->right_ = std::move(X);
@@ -169,15 +174,15 @@ void AVLNode<ElementT>::rotateRight(std::unique_ptr<Node>& root_ptr) {
 	if(top_node != nullptr) top_node->updateHeight_();
 }
 
-template <typename ElementT>
-void AVLNode<ElementT>::rotateLeft(std::unique_ptr<Node>& root_ptr) {
+template <typename ElementT, template <typename T> class DeleterT>
+void AVLNode<ElementT, DeleterT>::rotateLeft(NodePtr& root_ptr) {
 	Node* top_node = parent_;
-	std::unique_ptr<Node>& top = getOwner_(root_ptr);
+	NodePtr& top = getOwner_(root_ptr);
 	
 	// Analogous to rotateRight, see comments there.
-	std::unique_ptr<Node> X = std::move(top);
-	std::unique_ptr<Node> Y = std::move(X->right_);
-	std::unique_ptr<Node> B = std::move(Y->left_);
+	NodePtr X = std::move(top);
+	NodePtr Y = std::move(X->right_);
+	NodePtr B = std::move(Y->left_);
 	
 	top = std::move(Y);
 	top->left_ = std::move(X);
@@ -194,14 +199,14 @@ void AVLNode<ElementT>::rotateLeft(std::unique_ptr<Node>& root_ptr) {
 	if(top_node != nullptr) top_node->updateHeight_();
 }
 
-template <typename ElementT>
-void AVLNode<ElementT>::swapNodes(
+template <typename ElementT, template <typename T> class DeleterT>
+void AVLNode<ElementT, DeleterT>::swapNodes(
 	Node* node1,
 	Node* node2,
-	std::unique_ptr<Node>& root_ptr
+	NodePtr& root_ptr
 ) {
-	std::unique_ptr<Node>& top1 = node1->getOwner_(root_ptr);
-	std::unique_ptr<Node>& top2 = node2->getOwner_(root_ptr);
+	NodePtr& top1 = node1->getOwner_(root_ptr);
+	NodePtr& top2 = node2->getOwner_(root_ptr);
 	
 	std::swap(top1, top2);
 	std::swap(node1->parent_, node2->parent_);
@@ -213,10 +218,26 @@ void AVLNode<ElementT>::swapNodes(
 	if(node1->right_ != nullptr) node1->right_->parent_ = node1;
 	if(node2->left_ != nullptr) node2->left_->parent_ = node2;
 	if(node2->right_ != nullptr) node2->right_->parent_ = node2;
+	
+	// Swap the positions in the in-order thread. If the nodes are adjacent,
+	// swapping the links would make the nodes point to themselves, so then we
+	// order them such that node1 is directly followed by node2.
+	if(node2->next_ == node1) std::swap(node1, node2);
+	if(node1->next_ == node2) {
+		node2->prev_ = node1->prev_;
+		node1->next_ = node2->next_;
+		node2->next_ = node1;
+		node1->prev_ = node2;
+	} else {
+		std::swap(node1->prev_, node2->prev_);
+		std::swap(node1->next_, node2->next_);
+	}
+	node1->linkThread_();
+	node2->linkThread_();
 }
 
-template <typename ElementT>
-void AVLNode<ElementT>::updateHeight_() {
+template <typename ElementT, template <typename T> class DeleterT>
+void AVLNode<ElementT, DeleterT>::updateHeight_() {
 	Idx new_height = 1;
 	if(left_ != nullptr) new_height = std::max(new_height, left_->getHeight() + 1);
 	if(right_ != nullptr) new_height = std::max(new_height, right_->getHeight() + 1);
@@ -228,9 +249,9 @@ void AVLNode<ElementT>::updateHeight_() {
 	}
 }
 
-template <typename ElementT>
-std::unique_ptr<AVLNode<ElementT>>& AVLNode<ElementT>::getOwner_(
-	std::unique_ptr<Node>& root_ptr
+template <typename ElementT, template <typename T> class DeleterT>
+typename AVLNode<ElementT, DeleterT>::NodePtr& AVLNode<ElementT, DeleterT>::getOwner_(
+	NodePtr& root_ptr
 ) {
 	if(parent_ == nullptr) return root_ptr;
 	
@@ -241,6 +262,12 @@ std::unique_ptr<AVLNode<ElementT>>& AVLNode<ElementT>::getOwner_(
 	}
 }
 
+template <typename ElementT, template <typename T> class DeleterT>
+void AVLNode<ElementT, DeleterT>::linkThread_() {
+	if(prev_ != nullptr) prev_->next_ = this;
+	if(next_ != nullptr) next_->prev_ = this;
+}
+
 }
 }
 }
@@ -2,68 +2,129 @@
 #define FRIVOL_CONTAINERS_SEARCH_TREES_AVL_TREE_HPP
 
 #include <frivol/common.hpp>
+#include <frivol/containers/allocator.hpp>
+#include <frivol/containers/pool.hpp>
 #include <frivol/containers/search_trees/avl_node.hpp>
 
+#include <type_traits>
+
 namespace frivol {
 namespace containers {
 namespace search_trees {
 
 // Forward declarations.
-template <typename ElementT>
-class AVLTree;
+template <typename ElementT, bool PooledT, typename AllocatorT>
+class BasicAVLTree;
 
+/// Node type used by BasicAVLTree.
+/// @tparam ElementT Type of elements stored in the search tree.
+/// @tparam PooledT True if the nodes are allocated from a Pool.
+/// @tparam AllocatorT The allocator of the tree.
+template <typename ElementT, bool PooledT, typename AllocatorT>
+using AVLTreeNode = typename std::conditional<
+	PooledT,
+	AVLNode<ElementT, DestroyingDeleter>,
+	AVLNode<ElementT, AllocatorDeleteFor<AllocatorT>::template Type>
+>::type;
+
+/// Root of a BasicAVLTree with cached pointers to the in-order extreme nodes.
+/// Iterators point to the header, so it is allocated separately to keep them
+/// valid when the tree is moved.
+/// @tparam ElementT Type of elements stored in the search tree.
+/// @tparam PooledT The PooledT parameter of the tree.
+/// @tparam AllocatorT The AllocatorT parameter of the tree.
+template <typename ElementT, bool PooledT, typename AllocatorT>
+struct AVLTreeHeader {
+	typedef AVLTreeNode<ElementT, PooledT, AllocatorT> Node;
+	
+	/// Constructs the header of an empty tree.
+	/// @param deleter The deleter of the nodes (see AVLNode).
+	explicit AVLTreeHeader(const typename Node::NodePtr::deleter_type& deleter)
+		: root(nullptr, deleter),
+		  leftmost(nullptr),
+		  rightmost(nullptr),
+		  size(0)
+	{ }
+	
+	/// The root node of the tree.
+	typename Node::NodePtr root;
+	
+	/// The in-order first node in the tree, or nullptr if the tree is empty.
+	Node* leftmost;
+	
+	/// The in-order last node in the tree, or nullptr if the tree is empty.
+	Node* rightmost;
+	
+	/// The number of nodes in the tree.
+	Idx size;
+};
 
-/// Standard bidirectional iterator for iterating over the elements of an AVLTree.
+/// Standard bidirectional iterator for iterating over the elements of a
+/// BasicAVLTree. All operations take constant time.
 /// @tparam ElementT Type of elements stored in the search tree.
-template <typename ElementT>
+/// @tparam PooledT The PooledT parameter of the tree.
+/// @tparam AllocatorT The AllocatorT parameter of the tree.
+template <typename ElementT, bool PooledT = false, typename AllocatorT = DefaultAllocator>
 class AVLIterator {
 public:
 	/// Constructs an invalid iterator.
 	AVLIterator() { }
-
+	
 	typedef ElementT value_type;
 	typedef ElementT* pointer;
 	typedef ElementT& reference;
 	typedef ptrdiff_t difference_type;
 	typedef std::bidirectional_iterator_tag iterator_category;
-
-	bool operator==(const AVLIterator<ElementT>& other) const;
-	bool operator!=(const AVLIterator<ElementT>& other) const;
-
+	
+	bool operator==(const AVLIterator<ElementT, PooledT, AllocatorT>& other) const;
+	bool operator!=(const AVLIterator<ElementT, PooledT, AllocatorT>& other) const;
+	
 	ElementT& operator*();
 	ElementT* operator->();
-
-	AVLIterator<ElementT>& operator++();
-	AVLIterator<ElementT>& operator--();
-
-	AVLIterator<ElementT> operator++(int);
-	AVLIterator<ElementT> operator--(int);
+	
+	AVLIterator<ElementT, PooledT, AllocatorT>& operator++();
+	AVLIterator<ElementT, PooledT, AllocatorT>& operator--();
+	
+	AVLIterator<ElementT, PooledT, AllocatorT> operator++(int);
+	AVLIterator<ElementT, PooledT, AllocatorT> operator--(int);
 
 private:
-	typedef AVLNode<ElementT> Node;
+	typedef AVLTreeNode<ElementT, PooledT, AllocatorT> Node;
+	typedef AVLTreeHeader<ElementT, PooledT, AllocatorT> Header;
 	
 	/// Constructs AVL tree iterator.
-	/// @param tree Reference to the unique_ptr storing the root node of the tree.
+	/// @param header Reference to the header of the tree.
 	/// @param node Pointer to the current node, or nullptr for past the end.
-	AVLIterator(const std::unique_ptr<Node>& root, Node* node = nullptr);
-
-	/// Pointer to the unique_ptr storing the root node of the tree.
-	const std::unique_ptr<Node>* root_;
-
+	AVLIterator(const Header& header, Node* node = nullptr);
+	
+	/// Pointer to the header of the tree.
+	const Header* header_;
+	
 	/// Pointer to the current node, or nullptr if we are past the end.
 	Node* node_;
 	
-	friend class AVLTree<ElementT>;
+	friend class BasicAVLTree<ElementT, PooledT, AllocatorT>;
 };
 
-/// Implementation of SearchTreeConcept using AVL tree.
+/// Implementation of SearchTreeConcept using AVL tree. Use through the AVLTree
+/// and PooledAVLTree aliases. Hinted search climbs from the hint to the
+/// lowest ancestor that bounds the searched element and descends from
+/// there, which may be the root even for neighbouring elements, so it is
+/// not faster than search from the root in the worst case.
 /// @tparam ElementT Type of elements stored in the search tree.
-template <typename ElementT>
-class AVLTree {
+/// @tparam PooledT If true, the nodes are allocated from a Pool owned by the
+/// tree and recycled through its free list, so that no memory is allocated
+/// per insertion once the tree has been reserved. Otherwise every node is
+/// allocated separately.
+/// @tparam AllocatorT The allocator used for the nodes, the pool and the
+/// header. Without the pool, every node pointer keeps a copy of it, so a
+/// stateful allocator makes the nodes larger.
+template <typename ElementT, bool PooledT, typename AllocatorT = DefaultAllocator>
+class BasicAVLTree {
 public:
-	typedef AVLIterator<ElementT> Iterator;
+	typedef AVLIterator<ElementT, PooledT, AllocatorT> Iterator;
 	
-	AVLTree();
+	explicit BasicAVLTree(const AllocatorT& allocator = AllocatorT());
 	
 	bool empty() const;
 	
@@ -73,22 +134,86 @@ public:
 	template <typename FuncT>
 	Iterator search(FuncT func);
 	
+	template <typename FuncT>
+	Iterator search(Iterator hint, FuncT func);
+	
 	void erase(Iterator iter);
 	Iterator insert(Iterator iter, const ElementT& element);
 	
+	void reserve(Idx size);
+	void clear();
+	
+	MemoryUsage getMemoryUsage() const;
+	static std::size_t estimateMemoryUsage(Idx size);
+	
 private:
-	typedef AVLNode<ElementT> Node;
+	typedef AVLTreeNode<ElementT, PooledT, AllocatorT> Node;
+	typedef typename Node::NodePtr NodePtr;
+	typedef typename NodePtr::deleter_type NodeDeleter;
+	typedef AVLTreeHeader<ElementT, PooledT, AllocatorT> Header;
+	typedef std::integral_constant<bool, PooledT> IsPooled;
+	
+	/// Searches the subtree of a node like search.
+	/// @param node The root of the subtree, or nullptr for empty subtree.
+	template <typename FuncT>
+	Iterator searchSubtree_(Node* node, FuncT func);
 	
 	/// Balance a node after erase or insertion to its subtree.
 	/// @returns true if the tree had to be balanced, false if it was already
 	/// balanced.
 	bool balanceNode_(Node* node);
 	
-	/// The root node of the tree. The pointer is nested through two unique_ptrs
-	/// to support moving because iterators must stay valid after move too.
-	std::unique_ptr<std::unique_ptr<Node>> root_;
+	/// @{
+	/// Returns the deleter of the node pointers, which releases the nodes
+	/// through the allocator unless they are in the pool.
+	static NodeDeleter createNodeDeleter_(const AllocatorT& allocator, std::false_type);
+	static NodeDeleter createNodeDeleter_(const AllocatorT& allocator, std::true_type);
+	/// @}
+	
+	/// @{
+	/// Creates a new root node without children.
+	/// @param element The element stored in the new node.
+	NodePtr createNode_(const ElementT& element, std::false_type);
+	NodePtr createNode_(const ElementT& element, std::true_type);
+	/// @}
+	
+	/// @{
+	/// Releases the memory of a node destroyed by AVLNode::remove.
+	/// @param node Pointer to the destroyed node.
+	void releaseNode_(Node* node, std::false_type);
+	void releaseNode_(Node* node, std::true_type);
+	/// @}
+	
+	/// @{
+	/// Returns the memory of the nodes.
+	MemoryUsage getNodeMemoryUsage_(std::false_type) const;
+	MemoryUsage getNodeMemoryUsage_(std::true_type) const;
+	/// @}
+	
+	/// The pool from which the nodes are allocated if PooledT is true. Must be
+	/// declared before header_ so that the nodes are destroyed before the pool.
+	Pool<Node, AllocatorT> pool_;
+	
+	/// The root node and the extreme nodes of the tree. The header is behind a
+	/// unique_ptr to support moving because iterators must stay valid after
+	/// move too.
+	AllocatorPtr<Header, AllocatorT> header_;
 };
 
+/// AVL tree with every node allocated separately (see BasicAVLTree).
+/// @tparam ElementT Type of elements stored in the search tree.
+/// @tparam AllocatorT The allocator used for the nodes.
+/// @tparam IndexT Unused, as the nodes are linked with pointers.
+template <typename ElementT, typename AllocatorT = DefaultAllocator, typename IndexT = Idx>
+using AVLTree = BasicAVLTree<ElementT, false, AllocatorT>;
+
+/// AVL tree with the nodes allocated from a pool (see BasicAVLTree).
+/// @tparam ElementT Type of elements stored in the search tree.
+/// @tparam AllocatorT The allocator used for the pool.
+/// @tparam IndexT Unused, as the nodes are linked with pointers.
+template <typename ElementT, typename AllocatorT = DefaultAllocator, typename IndexT = Idx>
+using PooledAVLTree = BasicAVLTree<ElementT, true, AllocatorT>;
+
 }
 }
 }
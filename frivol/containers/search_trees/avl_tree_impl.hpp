@@ -1,94 +1,134 @@
+#include <new>
+
 namespace frivol {
 namespace containers {
 namespace search_trees {
 
-template <typename ElementT>
-bool AVLIterator<ElementT>::operator==(const AVLIterator<ElementT>& other) const {
+template <typename ElementT, bool PooledT, typename AllocatorT>
+bool AVLIterator<ElementT, PooledT, AllocatorT>::operator==(const AVLIterator<ElementT, PooledT, AllocatorT>& other) const {
 	return node_ == other.node_;
 }
 
-template <typename ElementT>
-bool AVLIterator<ElementT>::operator!=(const AVLIterator<ElementT>& other) const {
+template <typename ElementT, bool PooledT, typename AllocatorT>
+bool AVLIterator<ElementT, PooledT, AllocatorT>::operator!=(const AVLIterator<ElementT, PooledT, AllocatorT>& other) const {
 	return node_ != other.node_;
 }
 
-template <typename ElementT>
-ElementT& AVLIterator<ElementT>::operator*() {
+template <typename ElementT, bool PooledT, typename AllocatorT>
+ElementT& AVLIterator<ElementT, PooledT, AllocatorT>::operator*() {
 	return node_->getElement();
 }
 
-template <typename ElementT>
-ElementT* AVLIterator<ElementT>::operator->(){
+template <typename ElementT, bool PooledT, typename AllocatorT>
+ElementT* AVLIterator<ElementT, PooledT, AllocatorT>::operator->(){
 	return &node_->getElement();
 }
 
-template <typename ElementT>
-AVLIterator<ElementT>& AVLIterator<ElementT>::operator++() {
+template <typename ElementT, bool PooledT, typename AllocatorT>
+AVLIterator<ElementT, PooledT, AllocatorT>& AVLIterator<ElementT, PooledT, AllocatorT>::operator++() {
 	node_ = node_->getNextNode();
 	return *this;
 }
 
-template <typename ElementT>
-AVLIterator<ElementT>& AVLIterator<ElementT>::operator--() {
+template <typename ElementT, bool PooledT, typename AllocatorT>
+AVLIterator<ElementT, PooledT, AllocatorT>& AVLIterator<ElementT, PooledT, AllocatorT>::operator--() {
 	if(node_ == nullptr) {
-		node_ = (*root_)->getRightmostDescendant();
+		node_ = header_->rightmost;
 	} else {
 		node_ = node_->getPreviousNode();
 	}
 	return *this;
 }
 
-template <typename ElementT>
-AVLIterator<ElementT> AVLIterator<ElementT>::operator++(int) {
-	AVLIterator<ElementT> ret = *this;
+template <typename ElementT, bool PooledT, typename AllocatorT>
+AVLIterator<ElementT, PooledT, AllocatorT> AVLIterator<ElementT, PooledT, AllocatorT>::operator++(int) {
+	AVLIterator<ElementT, PooledT, AllocatorT> ret = *this;
 	++(*this);
 	return ret;
 }
 
-template <typename ElementT>
-AVLIterator<ElementT> AVLIterator<ElementT>::operator--(int) {
-	AVLIterator<ElementT> ret = *this;
+template <typename ElementT, bool PooledT, typename AllocatorT>
+AVLIterator<ElementT, PooledT, AllocatorT> AVLIterator<ElementT, PooledT, AllocatorT>::operator--(int) {
+	AVLIterator<ElementT, PooledT, AllocatorT> ret = *this;
 	--(*this);
 	return ret;
 }
 
-template <typename ElementT>
-AVLIterator<ElementT>::AVLIterator(const std::unique_ptr<Node>& root, Node* node)
-	: root_(&root),
+template <typename ElementT, bool PooledT, typename AllocatorT>
+AVLIterator<ElementT, PooledT, AllocatorT>::AVLIterator(const Header& header, Node* node)
+	: header_(&header),
 	  node_(node)
 { }
 
-template <typename ElementT>
-AVLTree<ElementT>::AVLTree()
-	: root_(new std::unique_ptr<Node>)
+template <typename ElementT, bool PooledT, typename AllocatorT>
+BasicAVLTree<ElementT, PooledT, AllocatorT>::BasicAVLTree(const AllocatorT& allocator)
+	: pool_(allocator),
+	  header_(allocateObject<Header>(allocator, createNodeDeleter_(allocator, IsPooled())))
 { }
 
-template <typename ElementT>
-bool AVLTree<ElementT>::empty() const {
-	return root_->get() == nullptr;
+template <typename ElementT, bool PooledT, typename AllocatorT>
+bool BasicAVLTree<ElementT, PooledT, AllocatorT>::empty() const {
+	return header_->root == nullptr;
 }
 
-template <typename ElementT>
-AVLIterator<ElementT> AVLTree<ElementT>::begin() {
-	if(empty()) return end();
-	
-	return Iterator(*root_, root_->get()->getLeftmostDescendant());
+template <typename ElementT, bool PooledT, typename AllocatorT>
+AVLIterator<ElementT, PooledT, AllocatorT> BasicAVLTree<ElementT, PooledT, AllocatorT>::begin() {
+	return Iterator(*header_, header_->leftmost);
+}
+
+template <typename ElementT, bool PooledT, typename AllocatorT>
+AVLIterator<ElementT, PooledT, AllocatorT> BasicAVLTree<ElementT, PooledT, AllocatorT>::end() {
+	return Iterator(*header_);
 }
 
-template <typename ElementT>
-AVLIterator<ElementT> AVLTree<ElementT>::end() {
-	return Iterator(*root_);
+template <typename ElementT, bool PooledT, typename AllocatorT>
+template <typename FuncT>
+AVLIterator<ElementT, PooledT, AllocatorT> BasicAVLTree<ElementT, PooledT, AllocatorT>::search(FuncT func) {
+	return searchSubtree_(header_->root.get(), func);
 }
 
-template <typename ElementT>
+template <typename ElementT, bool PooledT, typename AllocatorT>
 template <typename FuncT>
-AVLIterator<ElementT> AVLTree<ElementT>::search(FuncT func) {
-	Node* node = root_->get();
+AVLIterator<ElementT, PooledT, AllocatorT> BasicAVLTree<ElementT, PooledT, AllocatorT>::search(Iterator hint, FuncT func) {
+	Node* node = hint.node_;
+	if(node == nullptr) return search(func);
+	
+	int direction = func(Iterator(*header_, node));
+	if(direction == 0) return hint;
+	
+	// Climb until we find an ancestor such that the searched element is
+	// between it and the hint. Then the element is in the subtree of the child
+	// of that ancestor. Ancestors reached from the side of the searched element
+	// are on the wrong side of the hint, so they need not be compared. In all
+	// cases the searched element is in 'direction' from the node where we stop.
+	while(node->getParent() != nullptr) {
+		Node* parent = node->getParent();
+		bool from_left = parent->getLeftChild() == node;
+		
+		if(from_left == (direction > 0)) {
+			int parent_direction = func(Iterator(*header_, parent));
+			if(parent_direction == 0) return Iterator(*header_, parent);
+			if((parent_direction > 0) != (direction > 0)) break;
+		}
+		
+		node = parent;
+	}
+	
+	if(direction < 0) {
+		return searchSubtree_(node->getLeftChild(), func);
+	} else {
+		return searchSubtree_(node->getRightChild(), func);
+	}
+}
+
+template <typename ElementT, bool PooledT, typename AllocatorT>
+template <typename FuncT>
+AVLIterator<ElementT, PooledT, AllocatorT> BasicAVLTree<ElementT, PooledT, AllocatorT>::searchSubtree_(Node* node, FuncT func) {
 	while(node != nullptr) {
-		int direction = func(Iterator(*root_, node));
+		int direction = func(Iterator(*header_, node));
 		
 		if(direction == 0) {
-			return Iterator(*root_, node);
+			return Iterator(*header_, node);
 		}
 		
 		if(direction < 0) {
@@ -101,44 +141,60 @@ AVLIterator<ElementT> AVLTree<ElementT>::search(FuncT func) {
 	return end();
 }
 
-template <typename ElementT>
-void AVLTree<ElementT>::erase(Iterator iter) {
+template <typename ElementT, bool PooledT, typename AllocatorT>
+void BasicAVLTree<ElementT, PooledT, AllocatorT>::erase(Iterator iter) {
 	Node* node = iter.node_;
 	
-	// If the node has at most one child, remove it. Otherwise swap with
-	// successor and retry.
-	while(!node->remove(*root_)) {
-		Node::swapNodes(node, node->getNextNode(), *root_);
+	// If the node has two children, swap it with its successor, which has at
+	// most one child. Then the node can be removed.
+	if(node->getLeftChild() != nullptr && node->getRightChild() != nullptr) {
+		Node::swapNodes(node, node->getNextNode(), header_->root);
 	}
 	
+	// Update the cached extreme nodes if the node is at either end.
+	if(node->getPreviousNode() == nullptr) header_->leftmost = node->getNextNode();
+	if(node->getNextNode() == nullptr) header_->rightmost = node->getPreviousNode();
+	
+	// The removal destroys the node, so we need to get the parent first.
+	Node* parent = node->getParent();
+	node->remove(header_->root);
+	releaseNode_(node, IsPooled());
+	--header_->size;
+	
 	// Rebalance the tree.
-	node = node->getParent();
+	node = parent;
 	while(node != nullptr) {
 		if(balanceNode_(node)) break;
 		node = node->getParent();
 	}
 }
 
-template <typename ElementT>
-AVLIterator<ElementT> AVLTree<ElementT>::insert(Iterator iter, const ElementT& element) {
+template <typename ElementT, bool PooledT, typename AllocatorT>
+AVLIterator<ElementT, PooledT, AllocatorT> BasicAVLTree<ElementT, PooledT, AllocatorT>::insert(Iterator iter, const ElementT& element) {
 	Node* new_node;
 	if(empty()) {
-		root_->reset(new Node(element));
-		new_node = root_->get();
+		header_->root = createNode_(element, IsPooled());
+		new_node = header_->root.get();
+		header_->leftmost = new_node;
+		header_->rightmost = new_node;
 	} else if(iter.node_ == nullptr) {
 		// Add to end.
-		new_node = root_->get()->getRightmostDescendant()->createRightChild(element);
+		Node* base = header_->rightmost;
+		new_node = base->setRightChild(createNode_(element, IsPooled()));
+		header_->rightmost = new_node;
 	} else {
 		// Add before node.
 		Node* node = iter.node_;
 		
 		if(node->getLeftChild() == nullptr) {
-			new_node = node->createLeftChild(element);
+			new_node = node->setLeftChild(createNode_(element, IsPooled()));
 		} else {
-			Node* base = node->getLeftChild()->getRightmostDescendant();
-			new_node = base->createRightChild(element);
+			Node* base = node->getPreviousNode();
+			new_node = base->setRightChild(createNode_(element, IsPooled()));
 		}
+		if(node == header_->leftmost) header_->leftmost = new_node;
 	}
+	++header_->size;
 	
 	// Rebalance the tree.
 	Node* node = new_node;
@@ -147,26 +203,52 @@ AVLIterator<ElementT> AVLTree<ElementT>::insert(Iterator iter, const ElementT& e
 		node = node->getParent();
 	}
 	
-	return Iterator(*root_, new_node);
+	return Iterator(*header_, new_node);
+}
+
+template <typename ElementT, bool PooledT, typename AllocatorT>
+void BasicAVLTree<ElementT, PooledT, AllocatorT>::reserve(Idx size) {
+	if(PooledT) pool_.reserve(size);
+}
+
+template <typename ElementT, bool PooledT, typename AllocatorT>
+void BasicAVLTree<ElementT, PooledT, AllocatorT>::clear() {
+	while(!empty()) erase(--end());
 }
 
-template <typename ElementT>
-bool AVLTree<ElementT>::balanceNode_(Node* node) {
+template <typename ElementT, bool PooledT, typename AllocatorT>
+MemoryUsage BasicAVLTree<ElementT, PooledT, AllocatorT>::getMemoryUsage() const {
+	return getNodeMemoryUsage_(IsPooled()) + MemoryUsage(sizeof(Header), sizeof(Header));
+}
+
+template <typename ElementT, bool PooledT, typename AllocatorT>
+std::size_t BasicAVLTree<ElementT, PooledT, AllocatorT>::estimateMemoryUsage(Idx size) {
+	std::size_t node_bytes;
+	if(PooledT) {
+		node_bytes = Pool<Node, AllocatorT>::estimateMemoryUsage(size);
+	} else {
+		node_bytes = size * sizeof(Node);
+	}
+	return node_bytes + sizeof(Header);
+}
+
+template <typename ElementT, bool PooledT, typename AllocatorT>
+bool BasicAVLTree<ElementT, PooledT, AllocatorT>::balanceNode_(Node* node) {
 	int balance_factor = node->getBalanceFactor();
 	if(balance_factor == 2) {
 		if(node->getLeftChild()->getBalanceFactor() < 0) {
-			node->getLeftChild()->rotateLeft(*root_);
+			node->getLeftChild()->rotateLeft(header_->root);
 		}
-		node->rotateRight(*root_);
+		node->rotateRight(header_->root);
 		
 		return true;
 	}
 	
 	if(balance_factor == -2) {
 		if(node->getRightChild()->getBalanceFactor() > 0) {
-			node->getRightChild()->rotateRight(*root_);
+			node->getRightChild()->rotateRight(header_->root);
 		}
-		node->rotateLeft(*root_);
+		node->rotateLeft(header_->root);
 		
 		return true;
 	}
@@ -174,6 +256,67 @@ bool AVLTree<ElementT>::balanceNode_(Node* node) {
 	return false;
 }
 
+template <typename ElementT, bool PooledT, typename AllocatorT>
+typename BasicAVLTree<ElementT, PooledT, AllocatorT>::NodeDeleter BasicAVLTree<ElementT, PooledT, AllocatorT>::createNodeDeleter_(
+	const AllocatorT& allocator,
+	std::false_type
+) {
+	return NodeDeleter(allocator);
+}
+
+template <typename ElementT, bool PooledT, typename AllocatorT>
+typename BasicAVLTree<ElementT, PooledT, AllocatorT>::NodeDeleter BasicAVLTree<ElementT, PooledT, AllocatorT>::createNodeDeleter_(
+	const AllocatorT&,
+	std::true_type
+) {
+	return NodeDeleter();
+}
+
+template <typename ElementT, bool PooledT, typename AllocatorT>
+typename BasicAVLTree<ElementT, PooledT, AllocatorT>::NodePtr BasicAVLTree<ElementT, PooledT, AllocatorT>::createNode_(
+	const ElementT& element,
+	std::false_type
+) {
+	// The header was allocated through the allocator of the tree.
+	AllocatorT allocator = header_.get_deleter().getAllocator();
+	return allocateObject<Node>(allocator, element, header_->root.get_deleter());
+}
+
+template <typename ElementT, bool PooledT, typename AllocatorT>
+typename BasicAVLTree<ElementT, PooledT, AllocatorT>::NodePtr BasicAVLTree<ElementT, PooledT, AllocatorT>::createNode_(
+	const ElementT& element,
+	std::true_type
+) {
+	Node* node = pool_.allocate();
+	try {
+		new(node) Node(element, header_->root.get_deleter());
+	} catch(...) {
+		pool_.deallocate(node);
+		throw;
+	}
+	return NodePtr(node);
+}
+
+template <typename ElementT, bool PooledT, typename AllocatorT>
+MemoryUsage BasicAVLTree<ElementT, PooledT, AllocatorT>::getNodeMemoryUsage_(std::false_type) const {
+	return MemoryUsage(header_->size * sizeof(Node), header_->size * sizeof(Node));
+}
+
+template <typename ElementT, bool PooledT, typename AllocatorT>
+MemoryUsage BasicAVLTree<ElementT, PooledT, AllocatorT>::getNodeMemoryUsage_(std::true_type) const {
+	return pool_.getMemoryUsage();
+}
+
+template <typename ElementT, bool PooledT, typename AllocatorT>
+void BasicAVLTree<ElementT, PooledT, AllocatorT>::releaseNode_(Node* node, std::false_type) {
+	// The node was deleted by its unique_ptr.
+}
+
+template <typename ElementT, bool PooledT, typename AllocatorT>
+void BasicAVLTree<ElementT, PooledT, AllocatorT>::releaseNode_(Node* node, std::true_type) {
+	pool_.deallocate(node);
+}
+
 }
 }
 }
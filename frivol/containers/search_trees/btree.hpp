@@ -0,0 +1,126 @@
+#ifndef FRIVOL_CONTAINERS_SEARCH_TREES_BTREE_HPP
+#define FRIVOL_CONTAINERS_SEARCH_TREES_BTREE_HPP
+
+#include <frivol/common.hpp>
+#include <frivol/containers/allocator.hpp>
+#include <frivol/containers/search_trees/btree_nodes.hpp>
+
+#include <iterator>
+#include <memory>
+
+namespace frivol {
+namespace containers {
+namespace search_trees {
+
+// Forward declarations.
+template <typename ElementT, Idx NodeCapacityT, typename AllocatorT>
+class BasicBTree;
+
+
+/// Standard bidirectional iterator for iterating over the elements of a
+/// BasicBTree.
+/// @tparam ElementT Type of elements stored in the search tree.
+/// @tparam NodeCapacityT The NodeCapacityT parameter of the tree.
+/// @tparam AllocatorT The AllocatorT parameter of the tree.
+template <typename ElementT, Idx NodeCapacityT, typename AllocatorT>
+class BTreeIterator {
+public:
+	/// Constructs an invalid iterator.
+	BTreeIterator() { }
+	
+	typedef ElementT value_type;
+	typedef ElementT* pointer;
+	typedef ElementT& reference;
+	typedef ptrdiff_t difference_type;
+	typedef std::bidirectional_iterator_tag iterator_category;
+	
+	bool operator==(const BTreeIterator<ElementT, NodeCapacityT, AllocatorT>& other) const;
+	bool operator!=(const BTreeIterator<ElementT, NodeCapacityT, AllocatorT>& other) const;
+	
+	ElementT& operator*();
+	ElementT* operator->();
+	
+	BTreeIterator<ElementT, NodeCapacityT, AllocatorT>& operator++();
+	BTreeIterator<ElementT, NodeCapacityT, AllocatorT>& operator--();
+	
+	BTreeIterator<ElementT, NodeCapacityT, AllocatorT> operator++(int);
+	BTreeIterator<ElementT, NodeCapacityT, AllocatorT> operator--(int);
+	
+private:
+	typedef BTreeNodes<ElementT, NodeCapacityT, AllocatorT> Nodes;
+	typedef typename Nodes::Entry Entry;
+	
+	/// Constructs B-tree iterator.
+	/// @param nodes The node storage of the tree.
+	/// @param entry The current entry, or nullptr for past the end.
+	BTreeIterator(Nodes& nodes, Entry* entry = nullptr);
+	
+	/// Pointer to the node storage of the tree.
+	Nodes* nodes_;
+	
+	/// The current entry, or nullptr if we are past the end.
+	Entry* entry_;
+	
+	friend class BasicBTree<ElementT, NodeCapacityT, AllocatorT>;
+};
+
+/// Implementation of SearchTreeConcept using B+-tree (see BTreeNodes). The
+/// tree is much lower than a binary tree, and the items of each node are
+/// stored in contiguous arrays, so that a search touches fewer cache lines
+/// than in AVLTree. Use through the BTree alias.
+/// @tparam ElementT Type of elements stored in the search tree.
+/// @tparam NodeCapacityT The maximum number of items in a node, at least 4.
+/// The nodes other than the root are kept at least half full.
+/// @tparam AllocatorT The allocator used for the nodes.
+template <typename ElementT, Idx NodeCapacityT, typename AllocatorT = DefaultAllocator>
+class BasicBTree {
+public:
+	typedef BTreeIterator<ElementT, NodeCapacityT, AllocatorT> Iterator;
+	
+	explicit BasicBTree(const AllocatorT& allocator = AllocatorT());
+	
+	bool empty() const;
+	
+	Iterator begin();
+	Iterator end();
+	
+	template <typename FuncT>
+	Iterator search(FuncT func);
+	
+	template <typename FuncT>
+	Iterator search(Iterator hint, FuncT func);
+	
+	void erase(Iterator iter);
+	Iterator insert(Iterator iter, const ElementT& element);
+	
+	void reserve(Idx size);
+	void clear();
+	
+	MemoryUsage getMemoryUsage() const;
+	static std::size_t estimateMemoryUsage(Idx size);
+	
+	/// Returns the number of levels in the tree, 0 if the tree is empty.
+	Idx getHeight() const;
+	
+private:
+	typedef BTreeNodes<ElementT, NodeCapacityT, AllocatorT> Nodes;
+	
+	/// The node storage. Stored through unique_ptr so that iterators stay
+	/// valid when the tree is moved.
+	AllocatorPtr<Nodes, AllocatorT> nodes_;
+};
+
+/// B+-tree with 8 to 16 elements per leaf (see BasicBTree).
+/// @tparam ElementT Type of elements stored in the search tree.
+/// @tparam AllocatorT The allocator used for the nodes.
+/// @tparam IndexT Unused, as the nodes are linked with pointers.
+template <typename ElementT, typename AllocatorT = DefaultAllocator, typename IndexT = Idx>
+using BTree = BasicBTree<ElementT, 16, AllocatorT>;
+
+}
+}
+}
+
+#include "btree_impl.hpp"
+
+#endif
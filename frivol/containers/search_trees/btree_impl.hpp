@@ -0,0 +1,141 @@
+namespace frivol {
+namespace containers {
+namespace search_trees {
+
+template <typename ElementT, Idx NodeCapacityT, typename AllocatorT>
+bool BTreeIterator<ElementT, NodeCapacityT, AllocatorT>::operator==(const BTreeIterator<ElementT, NodeCapacityT, AllocatorT>& other) const {
+	return entry_ == other.entry_;
+}
+
+template <typename ElementT, Idx NodeCapacityT, typename AllocatorT>
+bool BTreeIterator<ElementT, NodeCapacityT, AllocatorT>::operator!=(const BTreeIterator<ElementT, NodeCapacityT, AllocatorT>& other) const {
+	return entry_ != other.entry_;
+}
+
+template <typename ElementT, Idx NodeCapacityT, typename AllocatorT>
+ElementT& BTreeIterator<ElementT, NodeCapacityT, AllocatorT>::operator*() {
+	return entry_->element;
+}
+
+template <typename ElementT, Idx NodeCapacityT, typename AllocatorT>
+ElementT* BTreeIterator<ElementT, NodeCapacityT, AllocatorT>::operator->() {
+	return &entry_->element;
+}
+
+template <typename ElementT, Idx NodeCapacityT, typename AllocatorT>
+BTreeIterator<ElementT, NodeCapacityT, AllocatorT>& BTreeIterator<ElementT, NodeCapacityT, AllocatorT>::operator++() {
+	entry_ = nodes_->getNextEntry(entry_);
+	return *this;
+}
+
+template <typename ElementT, Idx NodeCapacityT, typename AllocatorT>
+BTreeIterator<ElementT, NodeCapacityT, AllocatorT>& BTreeIterator<ElementT, NodeCapacityT, AllocatorT>::operator--() {
+	if(entry_ == nullptr) {
+		entry_ = nodes_->getLastEntry();
+	} else {
+		entry_ = nodes_->getPreviousEntry(entry_);
+	}
+	return *this;
+}
+
+template <typename ElementT, Idx NodeCapacityT, typename AllocatorT>
+BTreeIterator<ElementT, NodeCapacityT, AllocatorT> BTreeIterator<ElementT, NodeCapacityT, AllocatorT>::operator++(int) {
+	BTreeIterator<ElementT, NodeCapacityT, AllocatorT> ret = *this;
+	++(*this);
+	return ret;
+}
+
+template <typename ElementT, Idx NodeCapacityT, typename AllocatorT>
+BTreeIterator<ElementT, NodeCapacityT, AllocatorT> BTreeIterator<ElementT, NodeCapacityT, AllocatorT>::operator--(int) {
+	BTreeIterator<ElementT, NodeCapacityT, AllocatorT> ret = *this;
+	--(*this);
+	return ret;
+}
+
+template <typename ElementT, Idx NodeCapacityT, typename AllocatorT>
+BTreeIterator<ElementT, NodeCapacityT, AllocatorT>::BTreeIterator(Nodes& nodes, Entry* entry)
+	: nodes_(&nodes),
+	  entry_(entry)
+{ }
+
+template <typename ElementT, Idx NodeCapacityT, typename AllocatorT>
+BasicBTree<ElementT, NodeCapacityT, AllocatorT>::BasicBTree(const AllocatorT& allocator)
+	: nodes_(allocateObject<Nodes>(allocator, allocator))
+{ }
+
+template <typename ElementT, Idx NodeCapacityT, typename AllocatorT>
+bool BasicBTree<ElementT, NodeCapacityT, AllocatorT>::empty() const {
+	return nodes_->empty();
+}
+
+template <typename ElementT, Idx NodeCapacityT, typename AllocatorT>
+BTreeIterator<ElementT, NodeCapacityT, AllocatorT> BasicBTree<ElementT, NodeCapacityT, AllocatorT>::begin() {
+	return Iterator(*nodes_, nodes_->getFirstEntry());
+}
+
+template <typename ElementT, Idx NodeCapacityT, typename AllocatorT>
+BTreeIterator<ElementT, NodeCapacityT, AllocatorT> BasicBTree<ElementT, NodeCapacityT, AllocatorT>::end() {
+	return Iterator(*nodes_);
+}
+
+template <typename ElementT, Idx NodeCapacityT, typename AllocatorT>
+template <typename FuncT>
+BTreeIterator<ElementT, NodeCapacityT, AllocatorT> BasicBTree<ElementT, NodeCapacityT, AllocatorT>::search(FuncT func) {
+	Nodes& nodes = *nodes_;
+	return Iterator(nodes, nodes.search([&](typename Nodes::Entry* entry) {
+		return func(Iterator(nodes, entry));
+	}));
+}
+
+template <typename ElementT, Idx NodeCapacityT, typename AllocatorT>
+template <typename FuncT>
+BTreeIterator<ElementT, NodeCapacityT, AllocatorT> BasicBTree<ElementT, NodeCapacityT, AllocatorT>::search(
+	Iterator hint,
+	FuncT func
+) {
+	if(hint.entry_ == nullptr) return search(func);
+	
+	Nodes& nodes = *nodes_;
+	return Iterator(nodes, nodes.search(hint.entry_, [&](typename Nodes::Entry* entry) {
+		return func(Iterator(nodes, entry));
+	}));
+}
+
+template <typename ElementT, Idx NodeCapacityT, typename AllocatorT>
+void BasicBTree<ElementT, NodeCapacityT, AllocatorT>::erase(Iterator iter) {
+	nodes_->erase(iter.entry_);
+}
+
+template <typename ElementT, Idx NodeCapacityT, typename AllocatorT>
+BTreeIterator<ElementT, NodeCapacityT, AllocatorT> BasicBTree<ElementT, NodeCapacityT, AllocatorT>::insert(Iterator iter, const ElementT& element) {
+	return Iterator(*nodes_, nodes_->insert(iter.entry_, element));
+}
+
+template <typename ElementT, Idx NodeCapacityT, typename AllocatorT>
+void BasicBTree<ElementT, NodeCapacityT, AllocatorT>::reserve(Idx size) {
+	nodes_->reserve(size);
+}
+
+template <typename ElementT, Idx NodeCapacityT, typename AllocatorT>
+MemoryUsage BasicBTree<ElementT, NodeCapacityT, AllocatorT>::getMemoryUsage() const {
+	return nodes_->getMemoryUsage() + MemoryUsage(sizeof(Nodes), sizeof(Nodes));
+}
+
+template <typename ElementT, Idx NodeCapacityT, typename AllocatorT>
+std::size_t BasicBTree<ElementT, NodeCapacityT, AllocatorT>::estimateMemoryUsage(Idx size) {
+	return Nodes::estimateMemoryUsage(size) + sizeof(Nodes);
+}
+
+template <typename ElementT, Idx NodeCapacityT, typename AllocatorT>
+void BasicBTree<ElementT, NodeCapacityT, AllocatorT>::clear() {
+	while(!empty()) erase(--end());
+}
+
+template <typename ElementT, Idx NodeCapacityT, typename AllocatorT>
+Idx BasicBTree<ElementT, NodeCapacityT, AllocatorT>::getHeight() const {
+	return nodes_->getHeight();
+}
+
+}
+}
+}
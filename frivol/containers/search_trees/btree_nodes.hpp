@@ -0,0 +1,236 @@
+#ifndef FRIVOL_CONTAINERS_SEARCH_TREES_BTREE_NODES_HPP
+#define FRIVOL_CONTAINERS_SEARCH_TREES_BTREE_NODES_HPP
+
+#include <frivol/common.hpp>
+#include <frivol/containers/pool.hpp>
+
+#include <utility>
+
+namespace frivol {
+namespace containers {
+namespace search_trees {
+
+/// Node storage of a B+-tree for BasicBTree. The elements are stored in
+/// separately allocated entries that never move, so that pointers to the
+/// entries can be used as stable iterators. The leaves store sorted arrays of
+/// entry pointers and are linked to a list in order, and the internal nodes
+/// store their children together with the first entry of each child, so that
+/// searching reads the separators of a node from one contiguous array.
+///
+/// All nodes except the root have between NodeCapacityT / 2 and NodeCapacityT
+/// items. The nodes and entries are allocated from Pools.
+/// @tparam ElementT The element type stored in the tree.
+/// @tparam NodeCapacityT The maximum number of items in a node, at least 4.
+/// @tparam AllocatorT The allocator used for the node pools.
+template <typename ElementT, Idx NodeCapacityT, typename AllocatorT = DefaultAllocator>
+class BTreeNodes {
+private:
+	struct Leaf;
+	
+public:
+	static_assert(NodeCapacityT >= 4, "BTreeNodes: node capacity must be at least 4.");
+	
+	/// Storage of one element of the tree.
+	struct Entry {
+		Entry(const ElementT& element) : element(element) { }
+		
+		/// The element stored in the entry.
+		ElementT element;
+		
+		/// The leaf containing the entry.
+		Leaf* leaf;
+		
+		/// The position of the entry in the leaf.
+		Idx pos;
+	};
+	
+	/// Constructs empty tree.
+	/// @param allocator The allocator used for the nodes.
+	explicit BTreeNodes(const AllocatorT& allocator);
+	
+	BTreeNodes(const BTreeNodes&) = delete;
+	BTreeNodes& operator=(const BTreeNodes&) = delete;
+	
+	/// Destroys the elements.
+	~BTreeNodes();
+	
+	/// Returns true if the tree has no elements.
+	bool empty() const;
+	
+	/// Returns the in-order first entry of the tree, or nullptr if empty.
+	Entry* getFirstEntry();
+	
+	/// Returns the in-order last entry of the tree, or nullptr if empty.
+	Entry* getLastEntry();
+	
+	/// Returns the in-order next entry, or nullptr if entry is the last.
+	Entry* getNextEntry(Entry* entry);
+	
+	/// Returns the in-order previous entry, or nullptr if entry is the first.
+	Entry* getPreviousEntry(Entry* entry);
+	
+	/// Searches the tree using function that returns negative, zero or
+	/// positive if the searched element is before, at or after given entry.
+	/// Within each node the separators are searched using binary search.
+	/// @returns the entry for which func returned 0, or nullptr if not found.
+	template <typename FuncT>
+	Entry* search(FuncT func);
+	
+	/// Searches the tree like search(func), starting from a hint entry. The
+	/// search climbs from the leaf of the hint until the searched element is
+	/// known to be in the subtree, so the cost depends on the distance to the
+	/// hint rather than the size of the tree.
+	/// @param hint The entry from which to start.
+	/// @param func The search function as in search(func).
+	template <typename FuncT>
+	Entry* search(Entry* hint, FuncT func);
+	
+	/// Inserts new element to the tree.
+	/// @param before The entry before which the element is inserted, or
+	/// nullptr to insert to the end.
+	/// @param element The element to insert.
+	/// @returns the entry of the new element.
+	Entry* insert(Entry* before, const ElementT& element);
+	
+	/// Removes an entry from the tree.
+	/// @param entry The entry to remove.
+	void erase(Entry* entry);
+	
+	/// Allocates storage for 'size' elements and the nodes needed for them.
+	void reserve(Idx size);
+	
+	/// Returns the memory of the pools of the entries and the nodes.
+	MemoryUsage getMemoryUsage() const;
+	
+	/// Returns the number of bytes reserve(size) allocates for empty nodes.
+	/// @param size The number of elements.
+	static std::size_t estimateMemoryUsage(Idx size);
+	
+	/// Returns the number of levels in the tree, 0 if the tree is empty.
+	Idx getHeight() const;
+	
+private:
+	/// Minimum number of items in a non-root node.
+	static const Idx min_count_ = NodeCapacityT / 2;
+	
+	struct Internal;
+	
+	/// Common part of leaves and internal nodes.
+	struct Node {
+		Node(bool is_leaf) : parent(nullptr), count(0), is_leaf(is_leaf) { }
+		
+		/// The parent node, or nullptr for the root.
+		Internal* parent;
+		
+		/// The number of items (entries or children) in the node.
+		Idx count;
+		
+		/// True if the node is a Leaf, false if it is an Internal node.
+		bool is_leaf;
+	};
+	
+	struct Leaf : Node {
+		Leaf() : Node(true), prev(nullptr), next(nullptr) { }
+		
+		/// The entries of the leaf in order.
+		Entry* entries[NodeCapacityT];
+		
+		/// The previous and the next leaf in order, or nullptr if none.
+		Leaf* prev;
+		Leaf* next;
+	};
+	
+	struct Internal : Node {
+		Internal() : Node(false) { }
+		
+		/// The first entry in the subtree of each child.
+		Entry* keys[NodeCapacityT];
+		
+		/// The children in order.
+		Node* children[NodeCapacityT];
+	};
+	
+	/// Searches the subtree of a node like search.
+	/// @param node The root of the subtree.
+	/// @param known The number of first items of the node known to be before
+	/// the searched element.
+	template <typename FuncT>
+	static Entry* searchSubtree_(Node* node, Idx known, FuncT func);
+	
+	/// Returns the entry of an item of a node: the entry itself in leaves and
+	/// the first entry of the subtree of the child in internal nodes.
+	static Entry* getItemEntry_(Node* node, Idx pos);
+	
+	/// Returns the first entry in the subtree of a node.
+	static Entry* getFirstEntry_(Node* node);
+	
+	/// Returns the position of a child in its parent.
+	static Idx getChildPos_(Node* child);
+	
+	/// Copies an item between positions in nodes of the same kind, updating
+	/// the back pointers of the item.
+	/// @param dest,dest_pos The target node and position.
+	/// @param src,src_pos The source node and position.
+	static void copyItem_(Node* dest, Idx dest_pos, Node* src, Idx src_pos);
+	
+	/// Moves the items of a node from position 'pos' onwards by 'count'
+	/// positions to the right, leaving a gap. The node count is updated.
+	static void openGap_(Node* node, Idx pos, Idx count);
+	
+	/// Moves the items of a node after position 'pos' by 'count' positions to
+	/// the left, overwriting the items in the gap. The node count is updated.
+	static void closeGap_(Node* node, Idx pos, Idx count);
+	
+	/// Updates the keys of the ancestors after the first entry of the subtree
+	/// of 'node' has changed.
+	static void updateKeys_(Node* node);
+	
+	/// Splits full node to two, adding the new right half to the parent.
+	/// @returns the new node.
+	Node* split_(Node* node);
+	
+	/// Inserts 'right' after 'left' to the parent of 'left', growing the tree
+	/// if 'left' is the root.
+	void insertChild_(Node* left, Node* right);
+	
+	/// Restores the node count invariant of a non-root node that has one item
+	/// too few, by borrowing from or merging with a sibling.
+	void rebalance_(Node* node);
+	
+	/// Moves the items of 'right' to the end of its left sibling 'left' and
+	/// removes 'right' from the parent.
+	void merge_(Node* left, Node* right);
+	
+	/// Unlinks and releases an empty node.
+	void releaseNode_(Node* node);
+	
+	Leaf* allocateLeaf_();
+	Internal* allocateInternal_();
+	
+	/// Returns the numbers of leaves and internal nodes that are enough for
+	/// 'size' elements.
+	static std::pair<Idx, Idx> getNodeCounts_(Idx size);
+	
+	/// The memory of the entries, leaves and internal nodes.
+	Pool<Entry, AllocatorT> entry_pool_;
+	Pool<Leaf, AllocatorT> leaf_pool_;
+	Pool<Internal, AllocatorT> internal_pool_;
+	
+	/// The root node, or nullptr if the tree is empty.
+	Node* root_;
+	
+	/// Number of levels in the tree.
+	Idx height_;
+	
+	/// The first and the last leaf in the leaf list.
+	Leaf* first_leaf_;
+	Leaf* last_leaf_;
+};
+
+}
+}
+}
+
+#include "btree_nodes_impl.hpp"
+
+#endif
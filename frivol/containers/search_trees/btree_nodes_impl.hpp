@@ -0,0 +1,530 @@
+#include <new>
+
+namespace frivol {
+namespace containers {
+namespace search_trees {
+
+template <typename ElementT, Idx NodeCapacityT, typename AllocatorT>
+BTreeNodes<ElementT, NodeCapacityT, AllocatorT>::BTreeNodes(const AllocatorT& allocator)
+	: entry_pool_(allocator),
+	  leaf_pool_(allocator),
+	  internal_pool_(allocator),
+	  root_(nullptr),
+	  height_(0),
+	  first_leaf_(nullptr),
+	  last_leaf_(nullptr)
+{ }
+
+template <typename ElementT, Idx NodeCapacityT, typename AllocatorT>
+BTreeNodes<ElementT, NodeCapacityT, AllocatorT>::~BTreeNodes() {
+	// The nodes are trivially destructible and their memory is released with
+	// the pools, so only the elements need to be destroyed.
+	for(Leaf* leaf = first_leaf_; leaf != nullptr; leaf = leaf->next) {
+		for(Idx i = 0; i < leaf->count; ++i) {
+			leaf->entries[i]->~Entry();
+		}
+	}
+}
+
+template <typename ElementT, Idx NodeCapacityT, typename AllocatorT>
+bool BTreeNodes<ElementT, NodeCapacityT, AllocatorT>::empty() const {
+	return root_ == nullptr;
+}
+
+template <typename ElementT, Idx NodeCapacityT, typename AllocatorT>
+typename BTreeNodes<ElementT, NodeCapacityT, AllocatorT>::Entry* BTreeNodes<ElementT, NodeCapacityT, AllocatorT>::getFirstEntry() {
+	if(first_leaf_ == nullptr) return nullptr;
+	return first_leaf_->entries[0];
+}
+
+template <typename ElementT, Idx NodeCapacityT, typename AllocatorT>
+typename BTreeNodes<ElementT, NodeCapacityT, AllocatorT>::Entry* BTreeNodes<ElementT, NodeCapacityT, AllocatorT>::getLastEntry() {
+	if(last_leaf_ == nullptr) return nullptr;
+	return last_leaf_->entries[last_leaf_->count - 1];
+}
+
+template <typename ElementT, Idx NodeCapacityT, typename AllocatorT>
+typename BTreeNodes<ElementT, NodeCapacityT, AllocatorT>::Entry* BTreeNodes<ElementT, NodeCapacityT, AllocatorT>::getNextEntry(
+	Entry* entry
+) {
+	Leaf* leaf = entry->leaf;
+	if(entry->pos + 1 < leaf->count) return leaf->entries[entry->pos + 1];
+	
+	if(leaf->next == nullptr) return nullptr;
+	return leaf->next->entries[0];
+}
+
+template <typename ElementT, Idx NodeCapacityT, typename AllocatorT>
+typename BTreeNodes<ElementT, NodeCapacityT, AllocatorT>::Entry* BTreeNodes<ElementT, NodeCapacityT, AllocatorT>::getPreviousEntry(
+	Entry* entry
+) {
+	Leaf* leaf = entry->leaf;
+	if(entry->pos != 0) return leaf->entries[entry->pos - 1];
+	
+	if(leaf->prev == nullptr) return nullptr;
+	return leaf->prev->entries[leaf->prev->count - 1];
+}
+
+template <typename ElementT, Idx NodeCapacityT, typename AllocatorT>
+template <typename FuncT>
+typename BTreeNodes<ElementT, NodeCapacityT, AllocatorT>::Entry* BTreeNodes<ElementT, NodeCapacityT, AllocatorT>::search(
+	FuncT func
+) {
+	if(root_ == nullptr) return nullptr;
+	return searchSubtree_(root_, 0, func);
+}
+
+template <typename ElementT, Idx NodeCapacityT, typename AllocatorT>
+template <typename FuncT>
+typename BTreeNodes<ElementT, NodeCapacityT, AllocatorT>::Entry* BTreeNodes<ElementT, NodeCapacityT, AllocatorT>::search(
+	Entry* hint,
+	FuncT func
+) {
+	int direction = func(hint);
+	if(direction == 0) return hint;
+	
+	Node* node = hint->leaf;
+	
+	if(direction > 0) {
+		// Climb until the first entry of the next sibling subtree is after the
+		// searched element.
+		while(node->parent != nullptr) {
+			Internal* parent = node->parent;
+			Idx pos = getChildPos_(node);
+			
+			if(pos + 1 < parent->count) {
+				Entry* bound = parent->keys[pos + 1];
+				int bound_direction = func(bound);
+				
+				if(bound_direction == 0) return bound;
+				if(bound_direction < 0) break;
+			}
+			
+			node = parent;
+		}
+		
+		// The first entry of the subtree is not after the hint.
+		return searchSubtree_(node, 1, func);
+	} else {
+		// Climb until the first entry of the subtree is before the searched
+		// element. The first entry stays the same when climbing from a first
+		// child, so it is compared only once.
+		Entry* compared = hint;
+		while(true) {
+			Entry* first = getFirstEntry_(node);
+			
+			if(first != compared) {
+				int first_direction = func(first);
+				
+				if(first_direction == 0) return first;
+				if(first_direction > 0) return searchSubtree_(node, 1, func);
+				
+				compared = first;
+			}
+			
+			if(node->parent == nullptr) return nullptr;
+			node = node->parent;
+		}
+	}
+}
+
+template <typename ElementT, Idx NodeCapacityT, typename AllocatorT>
+template <typename FuncT>
+typename BTreeNodes<ElementT, NodeCapacityT, AllocatorT>::Entry* BTreeNodes<ElementT, NodeCapacityT, AllocatorT>::searchSubtree_(
+	Node* node,
+	Idx known,
+	FuncT func
+) {
+	// When descending to a child, its first entry is the separator that was
+	// already found to be before the element, so it is known too.
+	while(true) {
+		// Binary search for the first item not before the searched element.
+		Idx low = known;
+		Idx high = node->count;
+		while(low < high) {
+			Idx mid = low + (high - low) / 2;
+			Entry* entry = getItemEntry_(node, mid);
+			int direction = func(entry);
+			
+			if(direction == 0) return entry;
+			
+			if(direction < 0) {
+				high = mid;
+			} else {
+				low = mid + 1;
+			}
+		}
+		
+		// The element is in the subtree of the last item before it, if any.
+		if(low == 0 || node->is_leaf) return nullptr;
+		
+		node = static_cast<Internal*>(node)->children[low - 1];
+		known = 1;
+	}
+}
+
+template <typename ElementT, Idx NodeCapacityT, typename AllocatorT>
+typename BTreeNodes<ElementT, NodeCapacityT, AllocatorT>::Entry* BTreeNodes<ElementT, NodeCapacityT, AllocatorT>::insert(
+	Entry* before,
+	const ElementT& element
+) {
+	Entry* entry = entry_pool_.allocate();
+	try {
+		new(entry) Entry(element);
+	} catch(...) {
+		entry_pool_.deallocate(entry);
+		throw;
+	}
+	
+	Leaf* leaf;
+	Idx pos;
+	if(root_ == nullptr) {
+		leaf = allocateLeaf_();
+		root_ = leaf;
+		height_ = 1;
+		first_leaf_ = leaf;
+		last_leaf_ = leaf;
+		pos = 0;
+	} else if(before == nullptr) {
+		leaf = last_leaf_;
+		pos = leaf->count;
+	} else {
+		leaf = before->leaf;
+		pos = before->pos;
+	}
+	
+	if(leaf->count == NodeCapacityT) {
+		Leaf* right = static_cast<Leaf*>(split_(leaf));
+		if(pos > leaf->count) {
+			pos -= leaf->count;
+			leaf = right;
+		}
+	}
+	
+	openGap_(leaf, pos, 1);
+	leaf->entries[pos] = entry;
+	entry->leaf = leaf;
+	entry->pos = pos;
+	
+	if(pos == 0) updateKeys_(leaf);
+	
+	return entry;
+}
+
+template <typename ElementT, Idx NodeCapacityT, typename AllocatorT>
+void BTreeNodes<ElementT, NodeCapacityT, AllocatorT>::erase(Entry* entry) {
+	Leaf* leaf = entry->leaf;
+	Idx pos = entry->pos;
+	
+	closeGap_(leaf, pos, 1);
+	entry->~Entry();
+	entry_pool_.deallocate(entry);
+	
+	if(leaf == root_) {
+		if(leaf->count == 0) {
+			releaseNode_(leaf);
+			root_ = nullptr;
+			height_ = 0;
+		}
+		return;
+	}
+	
+	// Non-root leaves have at least one entry left because min_count_ >= 2.
+	if(pos == 0) updateKeys_(leaf);
+	
+	if(leaf->count < min_count_) rebalance_(leaf);
+}
+
+template <typename ElementT, Idx NodeCapacityT, typename AllocatorT>
+void BTreeNodes<ElementT, NodeCapacityT, AllocatorT>::reserve(Idx size) {
+	std::pair<Idx, Idx> node_counts = getNodeCounts_(size);
+	entry_pool_.reserve(size);
+	leaf_pool_.reserve(node_counts.first);
+	internal_pool_.reserve(node_counts.second);
+}
+
+template <typename ElementT, Idx NodeCapacityT, typename AllocatorT>
+MemoryUsage BTreeNodes<ElementT, NodeCapacityT, AllocatorT>::getMemoryUsage() const {
+	return
+		entry_pool_.getMemoryUsage() + leaf_pool_.getMemoryUsage() +
+		internal_pool_.getMemoryUsage();
+}
+
+template <typename ElementT, Idx NodeCapacityT, typename AllocatorT>
+std::size_t BTreeNodes<ElementT, NodeCapacityT, AllocatorT>::estimateMemoryUsage(Idx size) {
+	std::pair<Idx, Idx> node_counts = getNodeCounts_(size);
+	return
+		Pool<Entry, AllocatorT>::estimateMemoryUsage(size) +
+		Pool<Leaf, AllocatorT>::estimateMemoryUsage(node_counts.first) +
+		Pool<Internal, AllocatorT>::estimateMemoryUsage(node_counts.second);
+}
+
+template <typename ElementT, Idx NodeCapacityT, typename AllocatorT>
+std::pair<Idx, Idx> BTreeNodes<ElementT, NodeCapacityT, AllocatorT>::getNodeCounts_(Idx size) {
+	// All leaves except the root have at least min_count_ entries, and all
+	// internal nodes except the root have at least min_count_ children.
+	Idx count = size / min_count_ + 1;
+	Idx leaf_count = count;
+	
+	Idx internal_count = 0;
+	while(count > 1) {
+		count = (count + min_count_ - 1) / min_count_;
+		internal_count += count;
+	}
+	return std::make_pair(leaf_count, internal_count);
+}
+
+template <typename ElementT, Idx NodeCapacityT, typename AllocatorT>
+Idx BTreeNodes<ElementT, NodeCapacityT, AllocatorT>::getHeight() const {
+	return height_;
+}
+
+template <typename ElementT, Idx NodeCapacityT, typename AllocatorT>
+typename BTreeNodes<ElementT, NodeCapacityT, AllocatorT>::Entry* BTreeNodes<ElementT, NodeCapacityT, AllocatorT>::getItemEntry_(
+	Node* node,
+	Idx pos
+) {
+	if(node->is_leaf) {
+		return static_cast<Leaf*>(node)->entries[pos];
+	} else {
+		return static_cast<Internal*>(node)->keys[pos];
+	}
+}
+
+template <typename ElementT, Idx NodeCapacityT, typename AllocatorT>
+typename BTreeNodes<ElementT, NodeCapacityT, AllocatorT>::Entry* BTreeNodes<ElementT, NodeCapacityT, AllocatorT>::getFirstEntry_(
+	Node* node
+) {
+	return getItemEntry_(node, 0);
+}
+
+template <typename ElementT, Idx NodeCapacityT, typename AllocatorT>
+Idx BTreeNodes<ElementT, NodeCapacityT, AllocatorT>::getChildPos_(Node* child) {
+	Internal* parent = child->parent;
+	Idx pos = 0;
+	while(parent->children[pos] != child) ++pos;
+	return pos;
+}
+
+template <typename ElementT, Idx NodeCapacityT, typename AllocatorT>
+void BTreeNodes<ElementT, NodeCapacityT, AllocatorT>::copyItem_(
+	Node* dest,
+	Idx dest_pos,
+	Node* src,
+	Idx src_pos
+) {
+	if(dest->is_leaf) {
+		Leaf* dest_leaf = static_cast<Leaf*>(dest);
+		Entry* entry = static_cast<Leaf*>(src)->entries[src_pos];
+		
+		dest_leaf->entries[dest_pos] = entry;
+		entry->leaf = dest_leaf;
+		entry->pos = dest_pos;
+	} else {
+		Internal* dest_internal = static_cast<Internal*>(dest);
+		Internal* src_internal = static_cast<Internal*>(src);
+		Node* child = src_internal->children[src_pos];
+		
+		dest_internal->keys[dest_pos] = src_internal->keys[src_pos];
+		dest_internal->children[dest_pos] = child;
+		child->parent = dest_internal;
+	}
+}
+
+template <typename ElementT, Idx NodeCapacityT, typename AllocatorT>
+void BTreeNodes<ElementT, NodeCapacityT, AllocatorT>::openGap_(Node* node, Idx pos, Idx count) {
+	for(Idx i = node->count; i > pos; --i) {
+		copyItem_(node, i - 1 + count, node, i - 1);
+	}
+	node->count += count;
+}
+
+template <typename ElementT, Idx NodeCapacityT, typename AllocatorT>
+void BTreeNodes<ElementT, NodeCapacityT, AllocatorT>::closeGap_(Node* node, Idx pos, Idx count) {
+	for(Idx i = pos + count; i < node->count; ++i) {
+		copyItem_(node, i - count, node, i);
+	}
+	node->count -= count;
+}
+
+template <typename ElementT, Idx NodeCapacityT, typename AllocatorT>
+void BTreeNodes<ElementT, NodeCapacityT, AllocatorT>::updateKeys_(Node* node) {
+	Entry* first = getFirstEntry_(node);
+	
+	// The key changes in the parent, and if the node is the first child, also
+	// in the grandparent and so on.
+	while(node->parent != nullptr) {
+		Idx pos = getChildPos_(node);
+		node->parent->keys[pos] = first;
+		if(pos != 0) break;
+		
+		node = node->parent;
+	}
+}
+
+template <typename ElementT, Idx NodeCapacityT, typename AllocatorT>
+typename BTreeNodes<ElementT, NodeCapacityT, AllocatorT>::Node* BTreeNodes<ElementT, NodeCapacityT, AllocatorT>::split_(
+	Node* node
+) {
+	Node* right;
+	if(node->is_leaf) {
+		Leaf* left_leaf = static_cast<Leaf*>(node);
+		Leaf* right_leaf = allocateLeaf_();
+		
+		right_leaf->prev = left_leaf;
+		right_leaf->next = left_leaf->next;
+		if(left_leaf->next == nullptr) {
+			last_leaf_ = right_leaf;
+		} else {
+			left_leaf->next->prev = right_leaf;
+		}
+		left_leaf->next = right_leaf;
+		
+		right = right_leaf;
+	} else {
+		right = allocateInternal_();
+	}
+	
+	Idx keep = node->count / 2;
+	for(Idx i = keep; i < node->count; ++i) {
+		copyItem_(right, i - keep, node, i);
+	}
+	right->count = node->count - keep;
+	node->count = keep;
+	
+	insertChild_(node, right);
+	
+	return right;
+}
+
+template <typename ElementT, Idx NodeCapacityT, typename AllocatorT>
+void BTreeNodes<ElementT, NodeCapacityT, AllocatorT>::insertChild_(Node* left, Node* right) {
+	if(left->parent == nullptr) {
+		// Splitting the root, add new root above.
+		Internal* root = allocateInternal_();
+		root->keys[0] = getFirstEntry_(left);
+		root->children[0] = left;
+		root->keys[1] = getFirstEntry_(right);
+		root->children[1] = right;
+		root->count = 2;
+		
+		left->parent = root;
+		right->parent = root;
+		
+		root_ = root;
+		++height_;
+		return;
+	}
+	
+	// Make room in the parent. Splitting may move 'left' to the new half.
+	if(left->parent->count == NodeCapacityT) split_(left->parent);
+	
+	Internal* parent = left->parent;
+	Idx pos = getChildPos_(left) + 1;
+	
+	openGap_(parent, pos, 1);
+	parent->keys[pos] = getFirstEntry_(right);
+	parent->children[pos] = right;
+	right->parent = parent;
+}
+
+template <typename ElementT, Idx NodeCapacityT, typename AllocatorT>
+void BTreeNodes<ElementT, NodeCapacityT, AllocatorT>::rebalance_(Node* node) {
+	Internal* parent = node->parent;
+	Idx pos = getChildPos_(node);
+	
+	if(pos != 0) {
+		Node* left = parent->children[pos - 1];
+		
+		if(left->count > min_count_) {
+			// Move the last item of the left sibling to the front of the node.
+			openGap_(node, 0, 1);
+			copyItem_(node, 0, left, left->count - 1);
+			--left->count;
+			parent->keys[pos] = getFirstEntry_(node);
+		} else {
+			merge_(left, node);
+		}
+	} else {
+		Node* right = parent->children[1];
+		
+		if(right->count > min_count_) {
+			// Move the first item of the right sibling to the end of the node.
+			copyItem_(node, node->count, right, 0);
+			++node->count;
+			closeGap_(right, 0, 1);
+			parent->keys[1] = getFirstEntry_(right);
+		} else {
+			merge_(node, right);
+		}
+	}
+}
+
+template <typename ElementT, Idx NodeCapacityT, typename AllocatorT>
+void BTreeNodes<ElementT, NodeCapacityT, AllocatorT>::merge_(Node* left, Node* right) {
+	Internal* parent = left->parent;
+	
+	for(Idx i = 0; i < right->count; ++i) {
+		copyItem_(left, left->count + i, right, i);
+	}
+	left->count += right->count;
+	right->count = 0;
+	
+	closeGap_(parent, getChildPos_(right), 1);
+	releaseNode_(right);
+	
+	if(parent == root_) {
+		// Shrink the tree if the root has only one child left.
+		if(parent->count == 1) {
+			root_ = left;
+			left->parent = nullptr;
+			releaseNode_(parent);
+			--height_;
+		}
+	} else if(parent->count < min_count_) {
+		rebalance_(parent);
+	}
+}
+
+template <typename ElementT, Idx NodeCapacityT, typename AllocatorT>
+void BTreeNodes<ElementT, NodeCapacityT, AllocatorT>::releaseNode_(Node* node) {
+	if(node->is_leaf) {
+		Leaf* leaf = static_cast<Leaf*>(node);
+		
+		if(leaf->prev == nullptr) {
+			first_leaf_ = leaf->next;
+		} else {
+			leaf->prev->next = leaf->next;
+		}
+		if(leaf->next == nullptr) {
+			last_leaf_ = leaf->prev;
+		} else {
+			leaf->next->prev = leaf->prev;
+		}
+		
+		leaf->~Leaf();
+		leaf_pool_.deallocate(leaf);
+	} else {
+		Internal* internal = static_cast<Internal*>(node);
+		internal->~Internal();
+		internal_pool_.deallocate(internal);
+	}
+}
+
+template <typename ElementT, Idx NodeCapacityT, typename AllocatorT>
+typename BTreeNodes<ElementT, NodeCapacityT, AllocatorT>::Leaf* BTreeNodes<ElementT, NodeCapacityT, AllocatorT>::allocateLeaf_() {
+	Leaf* leaf = leaf_pool_.allocate();
+	new(leaf) Leaf();
+	return leaf;
+}
+
+template <typename ElementT, Idx NodeCapacityT, typename AllocatorT>
+typename BTreeNodes<ElementT, NodeCapacityT, AllocatorT>::Internal* BTreeNodes<ElementT, NodeCapacityT, AllocatorT>::allocateInternal_() {
+	Internal* internal = internal_pool_.allocate();
+	new(internal) Internal();
+	return internal;
+}
+
+}
+}
+}
@@ -0,0 +1,189 @@
+#ifndef FRIVOL_CONTAINERS_SEARCH_TREES_COMPACT_AVL_NODES_HPP
+#define FRIVOL_CONTAINERS_SEARCH_TREES_COMPACT_AVL_NODES_HPP
+
+#include <frivol/common.hpp>
+#include <frivol/containers/array.hpp>
+
+#include <cstdint>
+
+namespace frivol {
+namespace containers {
+namespace search_trees {
+
+/// Node storage of CompactAVLTree. The nodes of the tree are stored in one
+/// contiguous array and they are linked together with 32-bit indices to the
+/// array instead of pointers. Unused nodes are kept in a free list for reuse.
+/// Indices of the nodes stay the same as long as the nodes are in the tree,
+/// even if the array has to be grown.
+/// @tparam ElementT The element type stored in the nodes. Should be default
+/// constructible and assignable.
+/// @tparam AllocatorT The allocator used for the node array.
+template <typename ElementT, typename AllocatorT = DefaultAllocator>
+class CompactAVLNodes {
+public:
+	/// Index of a node in the node array.
+	typedef std::uint32_t NodeIdx;
+	
+	/// NodeIdx value used for missing nodes.
+	static constexpr NodeIdx nil_node = (NodeIdx)-1;
+	
+	/// Constructs empty tree.
+	/// @param allocator The allocator used for the node array.
+	explicit CompactAVLNodes(const AllocatorT& allocator);
+	
+	/// Returns reference to the element stored in the node.
+	/// @param node Index of the node.
+	ElementT& getElement(NodeIdx node);
+	
+	/// Returns index of the root node or nil_node if the tree is empty.
+	NodeIdx getRoot() const;
+	
+	/// Returns index of the left child or nil_node if none.
+	/// @param node Index of the node.
+	NodeIdx getLeftChild(NodeIdx node) const;
+	
+	/// Returns index of the right child or nil_node if none.
+	/// @param node Index of the node.
+	NodeIdx getRightChild(NodeIdx node) const;
+	
+	/// Returns index of the parent or nil_node if the node is the root.
+	/// @param node Index of the node.
+	NodeIdx getParent(NodeIdx node) const;
+	
+	/// Returns the in-order leftmost node in the subtree from node.
+	/// @param node Index of the node.
+	NodeIdx getLeftmostDescendant(NodeIdx node) const;
+	
+	/// Returns the in-order rightmost node in the subtree from node.
+	/// @param node Index of the node.
+	NodeIdx getRightmostDescendant(NodeIdx node) const;
+	
+	/// Returns the in-order previous node in the tree, or nil_node if the node
+	/// is the leftmost.
+	/// @param node Index of the node.
+	NodeIdx getPreviousNode(NodeIdx node) const;
+	
+	/// Returns the in-order next node in the tree, or nil_node if the node
+	/// is the rightmost.
+	/// @param node Index of the node.
+	NodeIdx getNextNode(NodeIdx node) const;
+	
+	/// Creates a new node and places it to the tree as the root (if parent is
+	/// nil_node) or a child of an existing node, and rebalances the tree.
+	/// @param parent The parent of the new node or nil_node if the tree is
+	/// empty.
+	/// @param left If true, the new node is placed as the left child of parent,
+	/// otherwise as the right child. The child must be missing.
+	/// @param element The element stored in the new node.
+	/// @returns index of the new node.
+	/// @throws std::length_error if the number of nodes would not fit in NodeIdx.
+	NodeIdx insert(NodeIdx parent, bool left, const ElementT& element);
+	
+	/// Removes node from the tree and rebalances the tree. If the node has two
+	/// children, it is first swapped with its successor.
+	/// @param node Index of the node.
+	void erase(NodeIdx node);
+	
+	/// Makes sure that the node array has room for at least size nodes.
+	/// @param size The number of nodes.
+	/// @throws std::length_error if size does not fit in NodeIdx.
+	void reserve(Idx size);
+	
+	/// Returns the memory of the node array, of which the nodes in the tree
+	/// are in use.
+	MemoryUsage getMemoryUsage() const;
+	
+	/// Returns the number of bytes reserve(size) allocates for empty nodes.
+	/// @param size The number of nodes.
+	static std::size_t estimateMemoryUsage(Idx size);
+	
+private:
+	/// Data stored for each node.
+	struct Node {
+		/// The element stored in the node.
+		ElementT element;
+		
+		/// Index of the parent node or nil_node if the node is the root.
+		NodeIdx parent;
+		
+		/// Index of the left child or nil_node if none. For free nodes, the
+		/// next node in the free list.
+		NodeIdx left;
+		
+		/// Index of the right child or nil_node if none.
+		NodeIdx right;
+		
+		/// Height of the subtree, including this node.
+		std::int8_t height;
+	};
+	
+	/// Returns the height of the subtree from node, 0 for nil_node.
+	/// @param node Index of the node or nil_node.
+	int getHeight_(NodeIdx node) const;
+	
+	/// Returns the balance factor of the node, i.e. difference of the heights
+	/// of the subtrees from the left node and the right node.
+	/// @param node Index of the node.
+	int getBalanceFactor_(NodeIdx node) const;
+	
+	/// Recalculates the height of a node from the heights of its children.
+	/// @param node Index of the node.
+	/// @returns true if the height changed.
+	bool updateHeight_(NodeIdx node);
+	
+	/// Replaces the link from the parent of a node (or the root link) to
+	/// point to another node.
+	/// @param parent The parent of old_node, or nil_node if old_node is root.
+	/// @param old_node The node currently linked.
+	/// @param new_node The node to link instead.
+	void replaceChild_(NodeIdx parent, NodeIdx old_node, NodeIdx new_node);
+	
+	/// Perform right-rotation rooted in a node that has a left child.
+	/// @param node Index of the node.
+	/// @returns the new root of the rotated subtree.
+	NodeIdx rotateRight_(NodeIdx node);
+	
+	/// Perform left-rotation rooted in a node that has a right child.
+	/// @param node Index of the node.
+	/// @returns the new root of the rotated subtree.
+	NodeIdx rotateLeft_(NodeIdx node);
+	
+	/// Update heights and balance the tree from a node towards the root.
+	/// @param node Index of the first node to balance or nil_node.
+	void rebalance_(NodeIdx node);
+	
+	/// Swaps the positions of a node with two children and its in-order
+	/// successor in the tree.
+	/// @param node Index of the node.
+	void swapWithSuccessor_(NodeIdx node);
+	
+	/// Returns an unused node, growing the node array if needed.
+	NodeIdx allocateNode_();
+	
+	/// The array of all nodes, including unused ones.
+	Array<Node, AllocatorT> nodes_;
+	
+	/// Index of the root node or nil_node if the tree is empty.
+	NodeIdx root_;
+	
+	/// First node in the free list of unused nodes in nodes_[0...used_-1], or
+	/// nil_node if none.
+	NodeIdx free_list_;
+	
+	/// Number of nodes in free_list_.
+	NodeIdx free_count_;
+	
+	/// Number of nodes in the beginning of nodes_ that have been used.
+	NodeIdx used_;
+};
+
+template <typename ElementT, typename AllocatorT>
+constexpr typename CompactAVLNodes<ElementT, AllocatorT>::NodeIdx CompactAVLNodes<ElementT, AllocatorT>::nil_node;
+
+}
+}
+}
+
+#include "compact_avl_nodes_impl.hpp"
+
+#endif
@@ -0,0 +1,334 @@
+#include <algorithm>
+#include <stdexcept>
+
+namespace frivol {
+namespace containers {
+namespace search_trees {
+
+template <typename ElementT, typename AllocatorT>
+CompactAVLNodes<ElementT, AllocatorT>::CompactAVLNodes(const AllocatorT& allocator)
+	: nodes_(allocator),
+	  root_(nil_node),
+	  free_list_(nil_node),
+	  free_count_(0),
+	  used_(0)
+{ }
+
+template <typename ElementT, typename AllocatorT>
+ElementT& CompactAVLNodes<ElementT, AllocatorT>::getElement(NodeIdx node) {
+	return nodes_[node].element;
+}
+
+template <typename ElementT, typename AllocatorT>
+typename CompactAVLNodes<ElementT, AllocatorT>::NodeIdx CompactAVLNodes<ElementT, AllocatorT>::getRoot() const {
+	return root_;
+}
+
+template <typename ElementT, typename AllocatorT>
+typename CompactAVLNodes<ElementT, AllocatorT>::NodeIdx
+CompactAVLNodes<ElementT, AllocatorT>::getLeftChild(NodeIdx node) const {
+	return nodes_[node].left;
+}
+
+template <typename ElementT, typename AllocatorT>
+typename CompactAVLNodes<ElementT, AllocatorT>::NodeIdx
+CompactAVLNodes<ElementT, AllocatorT>::getRightChild(NodeIdx node) const {
+	return nodes_[node].right;
+}
+
+template <typename ElementT, typename AllocatorT>
+typename CompactAVLNodes<ElementT, AllocatorT>::NodeIdx
+CompactAVLNodes<ElementT, AllocatorT>::getParent(NodeIdx node) const {
+	return nodes_[node].parent;
+}
+
+template <typename ElementT, typename AllocatorT>
+typename CompactAVLNodes<ElementT, AllocatorT>::NodeIdx
+CompactAVLNodes<ElementT, AllocatorT>::getLeftmostDescendant(NodeIdx node) const {
+	while(nodes_[node].left != nil_node) {
+		node = nodes_[node].left;
+	}
+	return node;
+}
+
+template <typename ElementT, typename AllocatorT>
+typename CompactAVLNodes<ElementT, AllocatorT>::NodeIdx
+CompactAVLNodes<ElementT, AllocatorT>::getRightmostDescendant(NodeIdx node) const {
+	while(nodes_[node].right != nil_node) {
+		node = nodes_[node].right;
+	}
+	return node;
+}
+
+template <typename ElementT, typename AllocatorT>
+typename CompactAVLNodes<ElementT, AllocatorT>::NodeIdx
+CompactAVLNodes<ElementT, AllocatorT>::getPreviousNode(NodeIdx node) const {
+	if(nodes_[node].left != nil_node) {
+		return getRightmostDescendant(nodes_[node].left);
+	}
+	
+	while(true) {
+		NodeIdx parent = nodes_[node].parent;
+		if(parent == nil_node) return nil_node;
+		if(nodes_[parent].right == node) return parent;
+		node = parent;
+	}
+}
+
+template <typename ElementT, typename AllocatorT>
+typename CompactAVLNodes<ElementT, AllocatorT>::NodeIdx
+CompactAVLNodes<ElementT, AllocatorT>::getNextNode(NodeIdx node) const {
+	if(nodes_[node].right != nil_node) {
+		return getLeftmostDescendant(nodes_[node].right);
+	}
+	
+	while(true) {
+		NodeIdx parent = nodes_[node].parent;
+		if(parent == nil_node) return nil_node;
+		if(nodes_[parent].left == node) return parent;
+		node = parent;
+	}
+}
+
+template <typename ElementT, typename AllocatorT>
+typename CompactAVLNodes<ElementT, AllocatorT>::NodeIdx CompactAVLNodes<ElementT, AllocatorT>::insert(
+	NodeIdx parent,
+	bool left,
+	const ElementT& element
+) {
+	NodeIdx node = allocateNode_();
+	nodes_[node].element = element;
+	nodes_[node].parent = parent;
+	nodes_[node].left = nil_node;
+	nodes_[node].right = nil_node;
+	nodes_[node].height = 1;
+	
+	if(parent == nil_node) {
+		root_ = node;
+	} else if(left) {
+		nodes_[parent].left = node;
+	} else {
+		nodes_[parent].right = node;
+	}
+	
+	rebalance_(parent);
+	
+	return node;
+}
+
+template <typename ElementT, typename AllocatorT>
+void CompactAVLNodes<ElementT, AllocatorT>::erase(NodeIdx node) {
+	if(nodes_[node].left != nil_node && nodes_[node].right != nil_node) {
+		swapWithSuccessor_(node);
+	}
+	
+	// Now the node has at most one child that replaces it.
+	NodeIdx parent = nodes_[node].parent;
+	NodeIdx child = nodes_[node].left;
+	if(child == nil_node) child = nodes_[node].right;
+	
+	replaceChild_(parent, node, child);
+	if(child != nil_node) nodes_[child].parent = parent;
+	
+	nodes_[node].left = free_list_;
+	free_list_ = node;
+	++free_count_;
+	
+	rebalance_(parent);
+}
+
+template <typename ElementT, typename AllocatorT>
+void CompactAVLNodes<ElementT, AllocatorT>::reserve(Idx size) {
+	if(size >= (Idx)nil_node) {
+		throw std::length_error("CompactAVLNodes::reserve: too many nodes.");
+	}
+	if(nodes_.getSize() < size) {
+		// The nodes from used_ on are not in use, so they need not be moved.
+		nodes_.resize(size, used_);
+	}
+}
+
+template <typename ElementT, typename AllocatorT>
+MemoryUsage CompactAVLNodes<ElementT, AllocatorT>::getMemoryUsage() const {
+	return MemoryUsage(nodes_.getSize() * sizeof(Node), (used_ - free_count_) * sizeof(Node));
+}
+
+template <typename ElementT, typename AllocatorT>
+std::size_t CompactAVLNodes<ElementT, AllocatorT>::estimateMemoryUsage(Idx size) {
+	return size * sizeof(Node);
+}
+
+template <typename ElementT, typename AllocatorT>
+int CompactAVLNodes<ElementT, AllocatorT>::getHeight_(NodeIdx node) const {
+	if(node == nil_node) return 0;
+	return nodes_[node].height;
+}
+
+template <typename ElementT, typename AllocatorT>
+int CompactAVLNodes<ElementT, AllocatorT>::getBalanceFactor_(NodeIdx node) const {
+	return getHeight_(nodes_[node].left) - getHeight_(nodes_[node].right);
+}
+
+template <typename ElementT, typename AllocatorT>
+bool CompactAVLNodes<ElementT, AllocatorT>::updateHeight_(NodeIdx node) {
+	int new_height = 1 + std::max(
+		getHeight_(nodes_[node].left),
+		getHeight_(nodes_[node].right)
+	);
+	
+	if(nodes_[node].height == new_height) return false;
+	nodes_[node].height = (std::int8_t)new_height;
+	return true;
+}
+
+template <typename ElementT, typename AllocatorT>
+void CompactAVLNodes<ElementT, AllocatorT>::replaceChild_(
+	NodeIdx parent,
+	NodeIdx old_node,
+	NodeIdx new_node
+) {
+	if(parent == nil_node) {
+		root_ = new_node;
+	} else if(nodes_[parent].left == old_node) {
+		nodes_[parent].left = new_node;
+	} else {
+		nodes_[parent].right = new_node;
+	}
+}
+
+template <typename ElementT, typename AllocatorT>
+typename CompactAVLNodes<ElementT, AllocatorT>::NodeIdx
+CompactAVLNodes<ElementT, AllocatorT>::rotateRight_(NodeIdx node) {
+	//     X          Y     //
+	//    / \        / \    //
+	//   Y   C  ->  A   X   //
+	//  / \            / \  //
+	// A  B           B   C //
+	NodeIdx X = node;
+	NodeIdx Y = nodes_[X].left;
+	NodeIdx B = nodes_[Y].right;
+	NodeIdx top = nodes_[X].parent;
+	
+	nodes_[X].left = B;
+	if(B != nil_node) nodes_[B].parent = X;
+	
+	nodes_[Y].right = X;
+	nodes_[X].parent = Y;
+	
+	nodes_[Y].parent = top;
+	replaceChild_(top, X, Y);
+	
+	updateHeight_(X);
+	updateHeight_(Y);
+	
+	return Y;
+}
+
+template <typename ElementT, typename AllocatorT>
+typename CompactAVLNodes<ElementT, AllocatorT>::NodeIdx
+CompactAVLNodes<ElementT, AllocatorT>::rotateLeft_(NodeIdx node) {
+	// Analogous to rotateRight_, see comments there.
+	NodeIdx X = node;
+	NodeIdx Y = nodes_[X].right;
+	NodeIdx B = nodes_[Y].left;
+	NodeIdx top = nodes_[X].parent;
+	
+	nodes_[X].right = B;
+	if(B != nil_node) nodes_[B].parent = X;
+	
+	nodes_[Y].left = X;
+	nodes_[X].parent = Y;
+	
+	nodes_[Y].parent = top;
+	replaceChild_(top, X, Y);
+	
+	updateHeight_(X);
+	updateHeight_(Y);
+	
+	return Y;
+}
+
+template <typename ElementT, typename AllocatorT>
+void CompactAVLNodes<ElementT, AllocatorT>::rebalance_(NodeIdx node) {
+	while(node != nil_node) {
+		bool changed = updateHeight_(node);
+		
+		int balance_factor = getBalanceFactor_(node);
+		if(balance_factor == 2) {
+			if(getBalanceFactor_(nodes_[node].left) < 0) {
+				rotateLeft_(nodes_[node].left);
+			}
+			node = rotateRight_(node);
+			changed = true;
+		} else if(balance_factor == -2) {
+			if(getBalanceFactor_(nodes_[node].right) > 0) {
+				rotateRight_(nodes_[node].right);
+			}
+			node = rotateLeft_(node);
+			changed = true;
+		}
+		
+		// If the subtree did not change, the ancestors are unaffected.
+		if(!changed) break;
+		
+		node = nodes_[node].parent;
+	}
+}
+
+template <typename ElementT, typename AllocatorT>
+void CompactAVLNodes<ElementT, AllocatorT>::swapWithSuccessor_(NodeIdx node) {
+	NodeIdx succ = getLeftmostDescendant(nodes_[node].right);
+	
+	NodeIdx parent = nodes_[node].parent;
+	NodeIdx left = nodes_[node].left;
+	NodeIdx right = nodes_[node].right;
+	NodeIdx succ_parent = nodes_[succ].parent;
+	NodeIdx succ_right = nodes_[succ].right;
+	
+	// The successor takes the place of the node.
+	replaceChild_(parent, node, succ);
+	nodes_[succ].parent = parent;
+	nodes_[succ].left = left;
+	nodes_[left].parent = succ;
+	
+	if(succ == right) {
+		// The successor was the right child of the node.
+		nodes_[succ].right = node;
+		nodes_[node].parent = succ;
+	} else {
+		nodes_[succ].right = right;
+		nodes_[right].parent = succ;
+		nodes_[succ_parent].left = node;
+		nodes_[node].parent = succ_parent;
+	}
+	
+	// The node takes the place of the successor, which had no left child.
+	nodes_[node].left = nil_node;
+	nodes_[node].right = succ_right;
+	if(succ_right != nil_node) nodes_[succ_right].parent = node;
+	
+	std::swap(nodes_[node].height, nodes_[succ].height);
+}
+
+template <typename ElementT, typename AllocatorT>
+typename CompactAVLNodes<ElementT, AllocatorT>::NodeIdx CompactAVLNodes<ElementT, AllocatorT>::allocateNode_() {
+	if(free_list_ != nil_node) {
+		NodeIdx node = free_list_;
+		free_list_ = nodes_[node].left;
+		--free_count_;
+		return node;
+	}
+	
+	if(used_ == nodes_.getSize()) {
+		if(used_ == nil_node - 1) {
+			throw std::length_error("CompactAVLNodes: too many nodes.");
+		}
+		reserve(std::min(std::max(2 * nodes_.getSize(), (Idx)16), (Idx)nil_node - 1));
+	}
+	
+	return used_++;
+}
+
+}
+}
+}
@@ -0,0 +1,124 @@
+#ifndef FRIVOL_CONTAINERS_SEARCH_TREES_COMPACT_AVL_TREE_HPP
+#define FRIVOL_CONTAINERS_SEARCH_TREES_COMPACT_AVL_TREE_HPP
+
+#include <frivol/common.hpp>
+#include <frivol/containers/allocator.hpp>
+#include <frivol/containers/search_trees/compact_avl_nodes.hpp>
+
+#include <iterator>
+#include <memory>
+
+namespace frivol {
+namespace containers {
+namespace search_trees {
+
+// Forward declarations.
+template <typename ElementT, typename AllocatorT, typename IndexT>
+class CompactAVLTree;
+
+
+/// Standard bidirectional iterator for iterating over the elements of a
+/// CompactAVLTree.
+/// @tparam ElementT Type of elements stored in the search tree.
+/// @tparam AllocatorT The AllocatorT parameter of the tree.
+/// @tparam IndexT The IndexT parameter of the tree.
+template <typename ElementT, typename AllocatorT, typename IndexT>
+class CompactAVLIterator {
+public:
+	/// Constructs an invalid iterator.
+	CompactAVLIterator() { }
+	
+	typedef ElementT value_type;
+	typedef ElementT* pointer;
+	typedef ElementT& reference;
+	typedef ptrdiff_t difference_type;
+	typedef std::bidirectional_iterator_tag iterator_category;
+	
+	bool operator==(const CompactAVLIterator<ElementT, AllocatorT, IndexT>& other) const;
+	bool operator!=(const CompactAVLIterator<ElementT, AllocatorT, IndexT>& other) const;
+	
+	ElementT& operator*();
+	ElementT* operator->();
+	
+	CompactAVLIterator<ElementT, AllocatorT, IndexT>& operator++();
+	CompactAVLIterator<ElementT, AllocatorT, IndexT>& operator--();
+	
+	CompactAVLIterator<ElementT, AllocatorT, IndexT> operator++(int);
+	CompactAVLIterator<ElementT, AllocatorT, IndexT> operator--(int);
+	
+private:
+	typedef CompactAVLNodes<ElementT, AllocatorT> Nodes;
+	typedef typename Nodes::NodeIdx NodeIdx;
+	
+	/// Constructs compact AVL tree iterator.
+	/// @param nodes The node storage of the tree.
+	/// @param node Index of the current node, or nil_node for past the end.
+	CompactAVLIterator(Nodes& nodes, NodeIdx node = Nodes::nil_node);
+	
+	/// Pointer to the node storage of the tree.
+	Nodes* nodes_;
+	
+	/// Index of the current node, or nil_node if we are past the end.
+	NodeIdx node_;
+	
+	friend class CompactAVLTree<ElementT, AllocatorT, IndexT>;
+};
+
+/// Implementation of SearchTreeConcept using AVL tree, the nodes of which are
+/// stored contiguously in an array and linked with 32-bit indices (see
+/// CompactAVLNodes). Compared to AVLTree, the nodes are smaller and close to
+/// each other in memory, and the node array is reused without allocations.
+/// The tree can contain at most 2^32 - 2 elements. Hinted search works as in
+/// BasicAVLTree and takes O(log n) time in the worst case.
+/// @tparam ElementT Type of elements stored in the search tree. Should be
+/// default constructible and assignable.
+/// @tparam AllocatorT The allocator used for the node storage.
+/// @tparam IndexT Unused, as the nodes are always linked with 32-bit indices.
+template <typename ElementT, typename AllocatorT = DefaultAllocator, typename IndexT = Idx>
+class CompactAVLTree {
+public:
+	typedef CompactAVLIterator<ElementT, AllocatorT, IndexT> Iterator;
+	
+	explicit CompactAVLTree(const AllocatorT& allocator = AllocatorT());
+	
+	bool empty() const;
+	
+	Iterator begin();
+	Iterator end();
+	
+	template <typename FuncT>
+	Iterator search(FuncT func);
+	
+	template <typename FuncT>
+	Iterator search(Iterator hint, FuncT func);
+	
+	void erase(Iterator iter);
+	Iterator insert(Iterator iter, const ElementT& element);
+	
+	void reserve(Idx size);
+	void clear();
+	
+	MemoryUsage getMemoryUsage() const;
+	static std::size_t estimateMemoryUsage(Idx size);
+	
+private:
+	typedef CompactAVLNodes<ElementT, AllocatorT> Nodes;
+	typedef typename Nodes::NodeIdx NodeIdx;
+	
+	/// Searches the subtree of a node like search.
+	/// @param node The root of the subtree, or nil_node for empty subtree.
+	template <typename FuncT>
+	Iterator searchSubtree_(NodeIdx node, FuncT func);
+	
+	/// The node storage. Stored through unique_ptr so that iterators stay
+	/// valid when the tree is moved.
+	AllocatorPtr<Nodes, AllocatorT> nodes_;
+};
+
+}
+}
+}
+
+#include "compact_avl_tree_impl.hpp"
+
+#endif
@@ -0,0 +1,196 @@
+namespace frivol {
+namespace containers {
+namespace search_trees {
+
+template <typename ElementT, typename AllocatorT, typename IndexT>
+bool CompactAVLIterator<ElementT, AllocatorT, IndexT>::operator==(const CompactAVLIterator<ElementT, AllocatorT, IndexT>& other) const {
+	return node_ == other.node_;
+}
+
+template <typename ElementT, typename AllocatorT, typename IndexT>
+bool CompactAVLIterator<ElementT, AllocatorT, IndexT>::operator!=(const CompactAVLIterator<ElementT, AllocatorT, IndexT>& other) const {
+	return node_ != other.node_;
+}
+
+template <typename ElementT, typename AllocatorT, typename IndexT>
+ElementT& CompactAVLIterator<ElementT, AllocatorT, IndexT>::operator*() {
+	return nodes_->getElement(node_);
+}
+
+template <typename ElementT, typename AllocatorT, typename IndexT>
+ElementT* CompactAVLIterator<ElementT, AllocatorT, IndexT>::operator->() {
+	return &nodes_->getElement(node_);
+}
+
+template <typename ElementT, typename AllocatorT, typename IndexT>
+CompactAVLIterator<ElementT, AllocatorT, IndexT>& CompactAVLIterator<ElementT, AllocatorT, IndexT>::operator++() {
+	node_ = nodes_->getNextNode(node_);
+	return *this;
+}
+
+template <typename ElementT, typename AllocatorT, typename IndexT>
+CompactAVLIterator<ElementT, AllocatorT, IndexT>& CompactAVLIterator<ElementT, AllocatorT, IndexT>::operator--() {
+	if(node_ == Nodes::nil_node) {
+		node_ = nodes_->getRightmostDescendant(nodes_->getRoot());
+	} else {
+		node_ = nodes_->getPreviousNode(node_);
+	}
+	return *this;
+}
+
+template <typename ElementT, typename AllocatorT, typename IndexT>
+CompactAVLIterator<ElementT, AllocatorT, IndexT> CompactAVLIterator<ElementT, AllocatorT, IndexT>::operator++(int) {
+	CompactAVLIterator<ElementT, AllocatorT, IndexT> ret = *this;
+	++(*this);
+	return ret;
+}
+
+template <typename ElementT, typename AllocatorT, typename IndexT>
+CompactAVLIterator<ElementT, AllocatorT, IndexT> CompactAVLIterator<ElementT, AllocatorT, IndexT>::operator--(int) {
+	CompactAVLIterator<ElementT, AllocatorT, IndexT> ret = *this;
+	--(*this);
+	return ret;
+}
+
+template <typename ElementT, typename AllocatorT, typename IndexT>
+CompactAVLIterator<ElementT, AllocatorT, IndexT>::CompactAVLIterator(Nodes& nodes, NodeIdx node)
+	: nodes_(&nodes),
+	  node_(node)
+{ }
+
+template <typename ElementT, typename AllocatorT, typename IndexT>
+CompactAVLTree<ElementT, AllocatorT, IndexT>::CompactAVLTree(const AllocatorT& allocator)
+	: nodes_(allocateObject<Nodes>(allocator, allocator))
+{ }
+
+template <typename ElementT, typename AllocatorT, typename IndexT>
+bool CompactAVLTree<ElementT, AllocatorT, IndexT>::empty() const {
+	return nodes_->getRoot() == Nodes::nil_node;
+}
+
+template <typename ElementT, typename AllocatorT, typename IndexT>
+CompactAVLIterator<ElementT, AllocatorT, IndexT> CompactAVLTree<ElementT, AllocatorT, IndexT>::begin() {
+	if(empty()) return end();
+	
+	return Iterator(*nodes_, nodes_->getLeftmostDescendant(nodes_->getRoot()));
+}
+
+template <typename ElementT, typename AllocatorT, typename IndexT>
+CompactAVLIterator<ElementT, AllocatorT, IndexT> CompactAVLTree<ElementT, AllocatorT, IndexT>::end() {
+	return Iterator(*nodes_);
+}
+
+template <typename ElementT, typename AllocatorT, typename IndexT>
+template <typename FuncT>
+CompactAVLIterator<ElementT, AllocatorT, IndexT> CompactAVLTree<ElementT, AllocatorT, IndexT>::search(FuncT func) {
+	return searchSubtree_(nodes_->getRoot(), func);
+}
+
+template <typename ElementT, typename AllocatorT, typename IndexT>
+template <typename FuncT>
+CompactAVLIterator<ElementT, AllocatorT, IndexT> CompactAVLTree<ElementT, AllocatorT, IndexT>::search(Iterator hint, FuncT func) {
+	NodeIdx node = hint.node_;
+	if(node == Nodes::nil_node) return search(func);
+	
+	int direction = func(hint);
+	if(direction == 0) return hint;
+	
+	// Climb until the searched element is between an ancestor and the hint,
+	// comparing only the ancestors on the side of the searched element (see
+	// BasicAVLTree::search).
+	while(nodes_->getParent(node) != Nodes::nil_node) {
+		NodeIdx parent = nodes_->getParent(node);
+		bool from_left = nodes_->getLeftChild(parent) == node;
+		
+		if(from_left == (direction > 0)) {
+			int parent_direction = func(Iterator(*nodes_, parent));
+			if(parent_direction == 0) return Iterator(*nodes_, parent);
+			if((parent_direction > 0) != (direction > 0)) break;
+		}
+		
+		node = parent;
+	}
+	
+	if(direction < 0) {
+		return searchSubtree_(nodes_->getLeftChild(node), func);
+	} else {
+		return searchSubtree_(nodes_->getRightChild(node), func);
+	}
+}
+
+template <typename ElementT, typename AllocatorT, typename IndexT>
+template <typename FuncT>
+CompactAVLIterator<ElementT, AllocatorT, IndexT> CompactAVLTree<ElementT, AllocatorT, IndexT>::searchSubtree_(NodeIdx node, FuncT func) {
+	while(node != Nodes::nil_node) {
+		int direction = func(Iterator(*nodes_, node));
+		
+		if(direction == 0) {
+			return Iterator(*nodes_, node);
+		}
+		
+		if(direction < 0) {
+			node = nodes_->getLeftChild(node);
+		} else {
+			node = nodes_->getRightChild(node);
+		}
+	}
+	
+	return end();
+}
+
+template <typename ElementT, typename AllocatorT, typename IndexT>
+void CompactAVLTree<ElementT, AllocatorT, IndexT>::erase(Iterator iter) {
+	nodes_->erase(iter.node_);
+}
+
+template <typename ElementT, typename AllocatorT, typename IndexT>
+CompactAVLIterator<ElementT, AllocatorT, IndexT> CompactAVLTree<ElementT, AllocatorT, IndexT>::insert(
+	Iterator iter,
+	const ElementT& element
+) {
+	NodeIdx new_node;
+	if(empty()) {
+		new_node = nodes_->insert(Nodes::nil_node, false, element);
+	} else if(iter.node_ == Nodes::nil_node) {
+		// Add to end.
+		NodeIdx base = nodes_->getRightmostDescendant(nodes_->getRoot());
+		new_node = nodes_->insert(base, false, element);
+	} else {
+		// Add before node.
+		NodeIdx node = iter.node_;
+		NodeIdx left = nodes_->getLeftChild(node);
+		
+		if(left == Nodes::nil_node) {
+			new_node = nodes_->insert(node, true, element);
+		} else {
+			NodeIdx base = nodes_->getRightmostDescendant(left);
+			new_node = nodes_->insert(base, false, element);
+		}
+	}
+	
+	return Iterator(*nodes_, new_node);
+}
+
+template <typename ElementT, typename AllocatorT, typename IndexT>
+void CompactAVLTree<ElementT, AllocatorT, IndexT>::reserve(Idx size) {
+	nodes_->reserve(size);
+}
+
+template <typename ElementT, typename AllocatorT, typename IndexT>
+MemoryUsage CompactAVLTree<ElementT, AllocatorT, IndexT>::getMemoryUsage() const {
+	return nodes_->getMemoryUsage() + MemoryUsage(sizeof(Nodes), sizeof(Nodes));
+}
+
+template <typename ElementT, typename AllocatorT, typename IndexT>
+std::size_t CompactAVLTree<ElementT, AllocatorT, IndexT>::estimateMemoryUsage(Idx size) {
+	return Nodes::estimateMemoryUsage(size) + sizeof(Nodes);
+}
+
+template <typename ElementT, typename AllocatorT, typename IndexT>
+void CompactAVLTree<ElementT, AllocatorT, IndexT>::clear() {
+	while(!empty()) erase(--end());
+}
+
+}
+}
+}
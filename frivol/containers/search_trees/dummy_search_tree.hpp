@@ -1,6 +1,10 @@
 #ifndef FRIVOL_CONTAINERS_SEARCH_TREES_DUMMY_SEARCH_TREE_HPP
 #define FRIVOL_CONTAINERS_SEARCH_TREES_DUMMY_SEARCH_TREE_HPP
 
+#include <frivol/common.hpp>
+#include <frivol/containers/allocator.hpp>
+#include <frivol/memory_usage.hpp>
+
 #include <list>
 
 namespace frivol {
@@ -8,16 +12,37 @@ namespace containers {
 namespace search_trees {
 
 /// Simple implementation of SearchTreeConcept (a wrapper around std::list).
-template <typename ElementT>
-class DummySearchTree : private std::list<ElementT> {
+/// @tparam IndexT Unused, as no indices are stored.
+template <typename ElementT, typename AllocatorT = DefaultAllocator, typename IndexT = Idx>
+class DummySearchTree : private std::list<ElementT, RebindAllocator<AllocatorT, ElementT>> {
+	typedef std::list<ElementT, RebindAllocator<AllocatorT, ElementT>> List;
+	
 public:
-	typedef typename std::list<ElementT>::iterator Iterator;
+	typedef typename List::iterator Iterator;
+	
+	explicit DummySearchTree(const AllocatorT& allocator = AllocatorT())
+		: List(RebindAllocator<AllocatorT, ElementT>(allocator))
+	{ }
+	
+	using List::empty;
+	using List::begin;
+	using List::end;
+	using List::insert;
+	using List::erase;
+	using List::clear;
 	
-	using std::list<ElementT>::empty;
-	using std::list<ElementT>::begin;
-	using std::list<ElementT>::end;
-	using std::list<ElementT>::insert;
-	using std::list<ElementT>::erase;
+	void reserve(Idx size) { }
+	
+	/// The memory usage is estimated from the size of the list, assuming
+	/// that each node has two pointers in addition to the element.
+	MemoryUsage getMemoryUsage() const {
+		std::size_t bytes = estimateMemoryUsage(List::size());
+		return MemoryUsage(bytes, bytes);
+	}
+	
+	static std::size_t estimateMemoryUsage(Idx size) {
+		return size * (sizeof(ElementT) + 2 * sizeof(void*));
+	}
 	
 	template <typename FuncT>
 	Iterator search(FuncT func) {
@@ -31,6 +56,32 @@ public:
 		
 		return end();
 	}
+	
+	template <typename FuncT>
+	Iterator search(Iterator hint, FuncT func) {
+		BOOST_CONCEPT_ASSERT((boost::UnaryFunction<FuncT, int, Iterator>));
+		
+		if(hint == end()) return search(func);
+		
+		// Walk from the hint towards the searched element.
+		int direction = func(hint);
+		Iterator iter = hint;
+		while(direction != 0) {
+			if(direction < 0) {
+				if(iter == begin()) return end();
+				--iter;
+				direction = func(iter);
+				if(direction > 0) return end();
+			} else {
+				++iter;
+				if(iter == end()) return end();
+				direction = func(iter);
+				if(direction < 0) return end();
+			}
+		}
+		
+		return iter;
+	}
 };
 
 }
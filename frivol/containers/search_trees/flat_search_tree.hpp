@@ -0,0 +1,122 @@
+#ifndef FRIVOL_CONTAINERS_SEARCH_TREES_FLAT_SEARCH_TREE_HPP
+#define FRIVOL_CONTAINERS_SEARCH_TREES_FLAT_SEARCH_TREE_HPP
+
+#include <frivol/common.hpp>
+#include <frivol/containers/allocator.hpp>
+#include <frivol/containers/search_trees/flat_tree_array.hpp>
+
+#include <iterator>
+#include <memory>
+
+namespace frivol {
+namespace containers {
+namespace search_trees {
+
+// Forward declarations.
+template <typename ElementT, typename AllocatorT, typename IndexT>
+class FlatSearchTree;
+
+
+/// Standard bidirectional iterator for iterating over the elements of a
+/// FlatSearchTree.
+/// @tparam ElementT Type of elements stored in the search tree.
+/// @tparam AllocatorT The AllocatorT parameter of the tree.
+/// @tparam IndexT The IndexT parameter of the tree.
+template <typename ElementT, typename AllocatorT, typename IndexT>
+class FlatSearchTreeIterator {
+public:
+	/// Constructs an invalid iterator.
+	FlatSearchTreeIterator() { }
+	
+	typedef ElementT value_type;
+	typedef ElementT* pointer;
+	typedef ElementT& reference;
+	typedef ptrdiff_t difference_type;
+	typedef std::bidirectional_iterator_tag iterator_category;
+	
+	bool operator==(const FlatSearchTreeIterator<ElementT, AllocatorT, IndexT>& other) const;
+	bool operator!=(const FlatSearchTreeIterator<ElementT, AllocatorT, IndexT>& other) const;
+	
+	ElementT& operator*();
+	ElementT* operator->();
+	
+	FlatSearchTreeIterator<ElementT, AllocatorT, IndexT>& operator++();
+	FlatSearchTreeIterator<ElementT, AllocatorT, IndexT>& operator--();
+	
+	FlatSearchTreeIterator<ElementT, AllocatorT, IndexT> operator++(int);
+	FlatSearchTreeIterator<ElementT, AllocatorT, IndexT> operator--(int);
+	
+private:
+	typedef FlatTreeArray<ElementT, AllocatorT, IndexT> Elements;
+	
+	/// Constructs flat search tree iterator.
+	/// @param elements The element storage of the tree.
+	/// @param id The ID of the current element, or nil_idx for past the end.
+	FlatSearchTreeIterator(Elements& elements, Idx id = nil_idx);
+	
+	/// Pointer to the element storage of the tree.
+	Elements* elements_;
+	
+	/// The ID of the current element, or nil_idx if we are past the end.
+	Idx id_;
+	
+	friend class FlatSearchTree<ElementT, AllocatorT, IndexT>;
+};
+
+/// Implementation of SearchTreeConcept using a sorted contiguous array (see
+/// FlatTreeArray). Search is binary search over the array (galloping search
+/// from the hint in hinted search), and insertion and
+/// erasure move the elements after the position, so the operations take
+/// linear time but have very small constant factors. Faster than the AVL
+/// trees for small sequences.
+/// @tparam ElementT Type of elements stored in the search tree. Should be
+/// default constructible and assignable.
+/// @tparam AllocatorT The allocator used for the element storage.
+/// @tparam IndexT The integer type used for the element IDs and positions
+/// (see FlatTreeArray).
+template <typename ElementT, typename AllocatorT = DefaultAllocator, typename IndexT = Idx>
+class FlatSearchTree {
+public:
+	typedef FlatSearchTreeIterator<ElementT, AllocatorT, IndexT> Iterator;
+	
+	explicit FlatSearchTree(const AllocatorT& allocator = AllocatorT());
+	
+	bool empty() const;
+	
+	Iterator begin();
+	Iterator end();
+	
+	template <typename FuncT>
+	Iterator search(FuncT func);
+	
+	template <typename FuncT>
+	Iterator search(Iterator hint, FuncT func);
+	
+	void erase(Iterator iter);
+	Iterator insert(Iterator iter, const ElementT& element);
+	
+	void reserve(Idx size);
+	void clear();
+	
+	MemoryUsage getMemoryUsage() const;
+	static std::size_t estimateMemoryUsage(Idx size);
+	
+private:
+	typedef FlatTreeArray<ElementT, AllocatorT, IndexT> Elements;
+	
+	/// Binary searches the positions low, ..., high - 1 like search.
+	template <typename FuncT>
+	Iterator searchRange_(Idx low, Idx high, FuncT func);
+	
+	/// The element storage. Stored through unique_ptr so that iterators stay
+	/// valid when the tree is moved.
+	AllocatorPtr<Elements, AllocatorT> elements_;
+};
+
+}
+}
+}
+
+#include "flat_search_tree_impl.hpp"
+
+#endif
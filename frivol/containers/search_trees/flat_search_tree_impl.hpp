@@ -0,0 +1,218 @@
+namespace frivol {
+namespace containers {
+namespace search_trees {
+
+template <typename ElementT, typename AllocatorT, typename IndexT>
+bool FlatSearchTreeIterator<ElementT, AllocatorT, IndexT>::operator==(const FlatSearchTreeIterator<ElementT, AllocatorT, IndexT>& other) const {
+	return id_ == other.id_;
+}
+
+template <typename ElementT, typename AllocatorT, typename IndexT>
+bool FlatSearchTreeIterator<ElementT, AllocatorT, IndexT>::operator!=(const FlatSearchTreeIterator<ElementT, AllocatorT, IndexT>& other) const {
+	return id_ != other.id_;
+}
+
+template <typename ElementT, typename AllocatorT, typename IndexT>
+ElementT& FlatSearchTreeIterator<ElementT, AllocatorT, IndexT>::operator*() {
+	return elements_->getElement(id_);
+}
+
+template <typename ElementT, typename AllocatorT, typename IndexT>
+ElementT* FlatSearchTreeIterator<ElementT, AllocatorT, IndexT>::operator->() {
+	return &elements_->getElement(id_);
+}
+
+template <typename ElementT, typename AllocatorT, typename IndexT>
+FlatSearchTreeIterator<ElementT, AllocatorT, IndexT>& FlatSearchTreeIterator<ElementT, AllocatorT, IndexT>::operator++() {
+	Idx pos = elements_->getPosition(id_) + 1;
+	if(pos == elements_->getSize()) {
+		id_ = nil_idx;
+	} else {
+		id_ = elements_->getId(pos);
+	}
+	return *this;
+}
+
+template <typename ElementT, typename AllocatorT, typename IndexT>
+FlatSearchTreeIterator<ElementT, AllocatorT, IndexT>& FlatSearchTreeIterator<ElementT, AllocatorT, IndexT>::operator--() {
+	Idx pos;
+	if(id_ == nil_idx) {
+		pos = elements_->getSize();
+	} else {
+		pos = elements_->getPosition(id_);
+	}
+	id_ = elements_->getId(pos - 1);
+	return *this;
+}
+
+template <typename ElementT, typename AllocatorT, typename IndexT>
+FlatSearchTreeIterator<ElementT, AllocatorT, IndexT> FlatSearchTreeIterator<ElementT, AllocatorT, IndexT>::operator++(int) {
+	FlatSearchTreeIterator<ElementT, AllocatorT, IndexT> ret = *this;
+	++(*this);
+	return ret;
+}
+
+template <typename ElementT, typename AllocatorT, typename IndexT>
+FlatSearchTreeIterator<ElementT, AllocatorT, IndexT> FlatSearchTreeIterator<ElementT, AllocatorT, IndexT>::operator--(int) {
+	FlatSearchTreeIterator<ElementT, AllocatorT, IndexT> ret = *this;
+	--(*this);
+	return ret;
+}
+
+template <typename ElementT, typename AllocatorT, typename IndexT>
+FlatSearchTreeIterator<ElementT, AllocatorT, IndexT>::FlatSearchTreeIterator(Elements& elements, Idx id)
+	: elements_(&elements),
+	  id_(id)
+{ }
+
+template <typename ElementT, typename AllocatorT, typename IndexT>
+FlatSearchTree<ElementT, AllocatorT, IndexT>::FlatSearchTree(const AllocatorT& allocator)
+	: elements_(allocateObject<Elements>(allocator, allocator))
+{ }
+
+template <typename ElementT, typename AllocatorT, typename IndexT>
+bool FlatSearchTree<ElementT, AllocatorT, IndexT>::empty() const {
+	return elements_->getSize() == 0;
+}
+
+template <typename ElementT, typename AllocatorT, typename IndexT>
+FlatSearchTreeIterator<ElementT, AllocatorT, IndexT> FlatSearchTree<ElementT, AllocatorT, IndexT>::begin() {
+	if(empty()) return end();
+	
+	return Iterator(*elements_, elements_->getId(0));
+}
+
+template <typename ElementT, typename AllocatorT, typename IndexT>
+FlatSearchTreeIterator<ElementT, AllocatorT, IndexT> FlatSearchTree<ElementT, AllocatorT, IndexT>::end() {
+	return Iterator(*elements_);
+}
+
+template <typename ElementT, typename AllocatorT, typename IndexT>
+template <typename FuncT>
+FlatSearchTreeIterator<ElementT, AllocatorT, IndexT> FlatSearchTree<ElementT, AllocatorT, IndexT>::search(FuncT func) {
+	return searchRange_(0, elements_->getSize(), func);
+}
+
+template <typename ElementT, typename AllocatorT, typename IndexT>
+template <typename FuncT>
+FlatSearchTreeIterator<ElementT, AllocatorT, IndexT> FlatSearchTree<ElementT, AllocatorT, IndexT>::search(Iterator hint, FuncT func) {
+	if(hint.id_ == nil_idx) return search(func);
+	
+	int direction = func(hint);
+	if(direction == 0) return hint;
+	
+	// Galloping search: double the step from the hint until the searched
+	// element is passed, then binary search the last step.
+	Idx pos = elements_->getPosition(hint.id_);
+	Idx size = elements_->getSize();
+	Idx low;
+	Idx high;
+	Idx step = 1;
+	if(direction > 0) {
+		low = pos + 1;
+		while(true) {
+			if(step >= size - pos) {
+				high = size;
+				break;
+			}
+			Iterator iter(*elements_, elements_->getId(pos + step));
+			int probe_direction = func(iter);
+			
+			if(probe_direction == 0) return iter;
+			if(probe_direction < 0) {
+				high = pos + step;
+				break;
+			}
+			
+			low = pos + step + 1;
+			step *= 2;
+		}
+	} else {
+		high = pos;
+		while(true) {
+			if(step > pos) {
+				low = 0;
+				break;
+			}
+			Iterator iter(*elements_, elements_->getId(pos - step));
+			int probe_direction = func(iter);
+			
+			if(probe_direction == 0) return iter;
+			if(probe_direction > 0) {
+				low = pos - step + 1;
+				break;
+			}
+			
+			high = pos - step;
+			step *= 2;
+		}
+	}
+	
+	return searchRange_(low, high, func);
+}
+
+template <typename ElementT, typename AllocatorT, typename IndexT>
+template <typename FuncT>
+FlatSearchTreeIterator<ElementT, AllocatorT, IndexT> FlatSearchTree<ElementT, AllocatorT, IndexT>::searchRange_(
+	Idx low,
+	Idx high,
+	FuncT func
+) {
+	while(low < high) {
+		Idx mid = low + (high - low) / 2;
+		Iterator iter(*elements_, elements_->getId(mid));
+		int direction = func(iter);
+		
+		if(direction == 0) return iter;
+		
+		if(direction < 0) {
+			high = mid;
+		} else {
+			low = mid + 1;
+		}
+	}
+	
+	return end();
+}
+
+template <typename ElementT, typename AllocatorT, typename IndexT>
+void FlatSearchTree<ElementT, AllocatorT, IndexT>::erase(Iterator iter) {
+	elements_->erase(iter.id_);
+}
+
+template <typename ElementT, typename AllocatorT, typename IndexT>
+FlatSearchTreeIterator<ElementT, AllocatorT, IndexT> FlatSearchTree<ElementT, AllocatorT, IndexT>::insert(Iterator iter, const ElementT& element) {
+	Idx pos;
+	if(iter.id_ == nil_idx) {
+		pos = elements_->getSize();
+	} else {
+		pos = elements_->getPosition(iter.id_);
+	}
+	
+	return Iterator(*elements_, elements_->insert(pos, element));
+}
+
+template <typename ElementT, typename AllocatorT, typename IndexT>
+void FlatSearchTree<ElementT, AllocatorT, IndexT>::reserve(Idx size) {
+	elements_->reserve(size);
+}
+
+template <typename ElementT, typename AllocatorT, typename IndexT>
+MemoryUsage FlatSearchTree<ElementT, AllocatorT, IndexT>::getMemoryUsage() const {
+	return elements_->getMemoryUsage() + MemoryUsage(sizeof(Elements), sizeof(Elements));
+}
+
+template <typename ElementT, typename AllocatorT, typename IndexT>
+std::size_t FlatSearchTree<ElementT, AllocatorT, IndexT>::estimateMemoryUsage(Idx size) {
+	return Elements::estimateMemoryUsage(size) + sizeof(Elements);
+}
+
+template <typename ElementT, typename AllocatorT, typename IndexT>
+void FlatSearchTree<ElementT, AllocatorT, IndexT>::clear() {
+	// Erasing from the end does not shift the other elements.
+	while(!empty()) erase(--end());
+}
+
+}
+}
+}
@@ -0,0 +1,87 @@
+#ifndef FRIVOL_CONTAINERS_SEARCH_TREES_FLAT_TREE_ARRAY_HPP
+#define FRIVOL_CONTAINERS_SEARCH_TREES_FLAT_TREE_ARRAY_HPP
+
+#include <frivol/common.hpp>
+#include <frivol/containers/array.hpp>
+
+namespace frivol {
+namespace containers {
+namespace search_trees {
+
+/// Sequence of elements stored in order in one contiguous array, used as
+/// storage of FlatSearchTree. Each element has an ID that stays the same
+/// while the element is in the array, even though the position of the element
+/// changes when elements are inserted or erased before it. The positions of
+/// the IDs are kept up to date in a separate array.
+///
+/// The IDs are a permutation of 0, ..., capacity - 1 stored in the same order
+/// as the elements, so that the IDs after the last element are the free IDs.
+/// @tparam ElementT The element type. Should be default constructible and
+/// assignable.
+/// @tparam AllocatorT The allocator used for the arrays.
+/// @tparam IndexT The unsigned integer type in which the IDs and positions
+/// are stored. The array holds at most nilIndex<IndexT>() elements.
+template <typename ElementT, typename AllocatorT = DefaultAllocator, typename IndexT = Idx>
+class FlatTreeArray {
+public:
+	/// Constructs empty array.
+	/// @param allocator The allocator used for the storage.
+	explicit FlatTreeArray(const AllocatorT& allocator);
+	
+	/// Returns the number of elements.
+	Idx getSize() const;
+	
+	/// Returns reference to the element with given ID.
+	ElementT& getElement(Idx id);
+	
+	/// Returns the current position of the element with given ID.
+	Idx getPosition(Idx id) const;
+	
+	/// Returns the ID of the element in given position.
+	Idx getId(Idx pos) const;
+	
+	/// Inserts an element to given position, moving the elements from that
+	/// position onwards by one.
+	/// @param pos The position of the new element, at most getSize().
+	/// @param element The element to insert.
+	/// @returns the ID of the new element.
+	Idx insert(Idx pos, const ElementT& element);
+	
+	/// Erases an element, moving the elements after it by one.
+	/// @param id The ID of the element to erase.
+	void erase(Idx id);
+	
+	/// Makes sure that there is room for 'size' elements.
+	void reserve(Idx size);
+	
+	/// Returns the memory of the arrays, of which the first getSize()
+	/// elements and their IDs are in use.
+	MemoryUsage getMemoryUsage() const;
+	
+	/// Returns the number of bytes reserve(size) allocates for an empty
+	/// array.
+	/// @param size The number of elements.
+	static std::size_t estimateMemoryUsage(Idx size);
+	
+private:
+	/// The elements in order. Only the first size_ elements are used.
+	Array<ElementT, AllocatorT> elements_;
+	
+	/// The IDs of the elements in the same order as elements_, followed by the
+	/// free IDs.
+	Array<IndexT, AllocatorT> ids_;
+	
+	/// The positions of the elements by ID.
+	Array<IndexT, AllocatorT> positions_;
+	
+	/// The number of elements.
+	Idx size_;
+};
+
+}
+}
+}
+
+#include "flat_tree_array_impl.hpp"
+
+#endif
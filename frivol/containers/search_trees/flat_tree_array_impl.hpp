@@ -0,0 +1,110 @@
+#include <algorithm>
+
+namespace frivol {
+namespace containers {
+namespace search_trees {
+
+template <typename ElementT, typename AllocatorT, typename IndexT>
+FlatTreeArray<ElementT, AllocatorT, IndexT>::FlatTreeArray(const AllocatorT& allocator)
+	: elements_(allocator),
+	  ids_(allocator),
+	  positions_(allocator),
+	  size_(0)
+{ }
+
+template <typename ElementT, typename AllocatorT, typename IndexT>
+Idx FlatTreeArray<ElementT, AllocatorT, IndexT>::getSize() const {
+	return size_;
+}
+
+template <typename ElementT, typename AllocatorT, typename IndexT>
+ElementT& FlatTreeArray<ElementT, AllocatorT, IndexT>::getElement(Idx id) {
+	return elements_[positions_[id]];
+}
+
+template <typename ElementT, typename AllocatorT, typename IndexT>
+Idx FlatTreeArray<ElementT, AllocatorT, IndexT>::getPosition(Idx id) const {
+	return positions_[id];
+}
+
+template <typename ElementT, typename AllocatorT, typename IndexT>
+Idx FlatTreeArray<ElementT, AllocatorT, IndexT>::getId(Idx pos) const {
+	return ids_[pos];
+}
+
+template <typename ElementT, typename AllocatorT, typename IndexT>
+Idx FlatTreeArray<ElementT, AllocatorT, IndexT>::insert(Idx pos, const ElementT& element) {
+	if(size_ == elements_.getSize()) {
+		reserve(std::min(std::max(2 * size_, (Idx)16), (Idx)nilIndex<IndexT>()));
+	}
+	
+	// Take the first free ID, which is overwritten by the shift.
+	Idx id = ids_[size_];
+	
+	ElementT* elements = &elements_[0];
+	IndexT* ids = &ids_[0];
+	std::copy_backward(elements + pos, elements + size_, elements + size_ + 1);
+	std::copy_backward(ids + pos, ids + size_, ids + size_ + 1);
+	++size_;
+	
+	for(Idx i = pos + 1; i < size_; ++i) {
+		positions_[ids[i]] = compactIndex<IndexT>(i);
+	}
+	
+	elements[pos] = element;
+	ids[pos] = compactIndex<IndexT>(id);
+	positions_[id] = compactIndex<IndexT>(pos);
+	
+	return id;
+}
+
+template <typename ElementT, typename AllocatorT, typename IndexT>
+void FlatTreeArray<ElementT, AllocatorT, IndexT>::erase(Idx id) {
+	Idx pos = positions_[id];
+	
+	ElementT* elements = &elements_[0];
+	IndexT* ids = &ids_[0];
+	std::copy(elements + pos + 1, elements + size_, elements + pos);
+	std::copy(ids + pos + 1, ids + size_, ids + pos);
+	--size_;
+	
+	for(Idx i = pos; i < size_; ++i) {
+		positions_[ids[i]] = compactIndex<IndexT>(i);
+	}
+	
+	// Release the element and return the ID to the free IDs.
+	elements[size_] = ElementT();
+	ids[size_] = compactIndex<IndexT>(id);
+}
+
+template <typename ElementT, typename AllocatorT, typename IndexT>
+MemoryUsage FlatTreeArray<ElementT, AllocatorT, IndexT>::getMemoryUsage() const {
+	MemoryUsage usage = elements_.getMemoryUsage() + ids_.getMemoryUsage() + positions_.getMemoryUsage();
+	usage.used = size_ * (sizeof(ElementT) + 2 * sizeof(IndexT));
+	return usage;
+}
+
+template <typename ElementT, typename AllocatorT, typename IndexT>
+std::size_t FlatTreeArray<ElementT, AllocatorT, IndexT>::estimateMemoryUsage(Idx size) {
+	return size * (sizeof(ElementT) + 2 * sizeof(IndexT));
+}
+
+template <typename ElementT, typename AllocatorT, typename IndexT>
+void FlatTreeArray<ElementT, AllocatorT, IndexT>::reserve(Idx size) {
+	Idx old_capacity = elements_.getSize();
+	if(size <= old_capacity) return;
+	
+	// Only the elements in use are moved, but all IDs are kept, as the free
+	// IDs are stored past size_.
+	elements_.resize(size, size_);
+	ids_.resize(size, old_capacity);
+	positions_.resize(size, old_capacity);
+	
+	for(Idx id = old_capacity; id < size; ++id) {
+		ids_[id] = compactIndex<IndexT>(id);
+	}
+}
+
+}
+}
+}
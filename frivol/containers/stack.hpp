@@ -2,21 +2,23 @@
 #define FRIVOL_CONTAINERS_STACK_HPP
 
 #include <frivol/common.hpp>
-#include <frivol/containers/array.hpp>
+#include <frivol/containers/dynamic_array.hpp>
 
 namespace frivol {
 namespace containers {
 
-/// Stack of elements. The container constructs elements in advance so they
-/// should be default-constructible.
+/// Stack of elements. The container reserves space for elements in advance,
+/// and they should be default-constructible.
 /// @tparam T The type of stored elements.
-template <typename T>
+/// @tparam AllocatorT The allocator used for the storage (see Array).
+template <typename T, typename AllocatorT = std::allocator<T>>
 class Stack {
 public:
 	BOOST_CONCEPT_ASSERT((boost::DefaultConstructible<T>));
 	
 	/// Constructs empty stack.
-	Stack();
+	/// @param allocator The allocator used for the storage.
+	explicit Stack(const AllocatorT& allocator = AllocatorT());
 	
 	/// Returns true if the stack is empty.
 	bool empty() const;
@@ -32,12 +34,20 @@ public:
 	/// @param element The element to push.
 	void push(const T& element);
 	
-private:
-	/// Array containing the elements. May be larger than size_.
-	Array<T> elements_;
+	/// Removes all elements from the stack, keeping the allocated memory.
+	void clear();
+	
+	/// Makes sure that capacity elements can be pushed without allocating
+	/// memory.
+	/// @param capacity The minimum capacity.
+	void reserve(Idx capacity);
 	
-	/// Number of currently stored elements.
-	Idx size_;
+	/// Returns the memory allocated for the elements.
+	MemoryUsage getMemoryUsage() const;
+	
+private:
+	/// The stored elements, top element last.
+	DynamicArray<T, AllocatorT> elements_;
 };
 
 }
@@ -1,34 +1,42 @@
 namespace frivol {
 namespace containers {
 
-template <typename T>
-Stack<T>::Stack()
-	: elements_(1),
-	  size_(0)
-{ }
+template <typename T, typename AllocatorT>
+Stack<T, AllocatorT>::Stack(const AllocatorT& allocator) : elements_(allocator) { }
 
-template <typename T>
-bool Stack<T>::empty() const {
-	return size_ == 0;
+template <typename T, typename AllocatorT>
+bool Stack<T, AllocatorT>::empty() const {
+	return elements_.getSize() == 0;
 }
 
-template <typename T>
-T& Stack<T>::top() {
-	return elements_[size_ - 1];
+template <typename T, typename AllocatorT>
+T& Stack<T, AllocatorT>::top() {
+	return elements_[elements_.getSize() - 1];
 }
 
-template <typename T>
-void Stack<T>::pop() {
-	--size_;
+template <typename T, typename AllocatorT>
+void Stack<T, AllocatorT>::pop() {
+	elements_.resize(elements_.getSize() - 1);
 }
 
-template <typename T>
-void Stack<T>::push(const T& element) {
-	++size_;
-	if(size_ > elements_.getSize()) {
-		elements_.resize(2 * elements_.getSize());
-	}
-	elements_[size_ - 1] = element;
+template <typename T, typename AllocatorT>
+void Stack<T, AllocatorT>::clear() {
+	elements_.clear();
+}
+
+template <typename T, typename AllocatorT>
+void Stack<T, AllocatorT>::reserve(Idx capacity) {
+	elements_.reserve(capacity);
+}
+
+template <typename T, typename AllocatorT>
+MemoryUsage Stack<T, AllocatorT>::getMemoryUsage() const {
+	return elements_.getMemoryUsage();
+}
+
+template <typename T, typename AllocatorT>
+void Stack<T, AllocatorT>::push(const T& element) {
+	elements_.add(element);
 }
 
 }
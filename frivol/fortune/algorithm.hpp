@@ -1,28 +1,152 @@
 #ifndef FRIVOL_FORTUNE_ALGORITHM_HPP
 #define FRIVOL_FORTUNE_ALGORITHM_HPP
 
+#include <frivol/containers/dynamic_array.hpp>
 #include <frivol/containers/priority_queue_concept.hpp>
+#include <frivol/containers/stack.hpp>
 #include <frivol/fortune/beach_line.hpp>
+#include <frivol/fortune/event_priority.hpp>
+#include <frivol/output_sink_concept.hpp>
 #include <frivol/policy.hpp>
 #include <frivol/voronoi_diagram.hpp>
 #include <frivol/geometry_traits.hpp>
+#include <frivol/site_view.hpp>
+#include <frivol/memory_usage.hpp>
+
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 namespace frivol {
 namespace fortune {
 
+/// Memory footprint of the components of Algorithm.
+struct AlgorithmMemoryUsage {
+	MemoryUsage beach_line;    ///< The beach line and its search tree.
+	MemoryUsage event_queue;   ///< The queue of circle events.
+	MemoryUsage site_events;   ///< The site event order or resident sites.
+	MemoryUsage circle_events; ///< The circumcenters and edges by arc ID.
+	MemoryUsage diagram;       ///< The output diagram or sink.
+	
+	/// Returns the sum of the components.
+	MemoryUsage getTotal() const {
+		return beach_line + event_queue + site_events + circle_events + diagram;
+	}
+};
+
 /// State of Fortune's algorithm.
 /// @tparam PolicyT The algorithm policy to use, instance of Policy template.
-template <typename PolicyT = DefaultPolicy>
+/// @tparam OutputT The sink to which the Voronoi diagram is output, see
+/// OutputSinkConcept. By default, the whole diagram is stored in a
+/// VoronoiDiagram. The functions that give out the VoronoiDiagram can only be
+/// used with the default sink.
+template <
+	typename PolicyT = DefaultPolicy,
+	typename OutputT = VoronoiDiagram<
+		typename PolicyT::Coord,
+		typename PolicyT::Allocator,
+		typename PolicyT::Index
+	>
+>
 class Algorithm {
 public:
 	typedef typename PolicyT::Coord CoordT;
+	typedef typename PolicyT::Allocator AllocatorT;
+	typedef typename PolicyT::Index IndexT;
 	typedef Point<CoordT> PointT;
-	typedef VoronoiDiagram<CoordT> VoronoiDiagramT;
+	typedef SiteView<CoordT> SiteViewT;
+	typedef VoronoiDiagram<CoordT, AllocatorT, IndexT> VoronoiDiagramT;
+	BOOST_CONCEPT_ASSERT((OutputSinkConcept<OutputT, CoordT, AllocatorT>));
+	
+	typedef typename std::conditional<
+		PolicyT::encode_event_priorities,
+		EncodedEventPriority<CoordT>,
+		EventPriority<CoordT>
+	>::type EventPriorityT;
+	typedef typename PolicyT::template EventPriorityQueue<EventPriorityT> EventPriorityQueueT;
+	BOOST_CONCEPT_ASSERT((containers::PriorityQueueConcept<EventPriorityQueueT, EventPriorityT, AllocatorT>));
+	
+	/// Constructs finished algorithm state for no sites. Can be reset to
+	/// compute Voronoi diagrams.
+	/// @param allocator The allocator through which all memory of the
+	/// algorithm state is allocated. The output sink gets it too if it is
+	/// constructible from the number of faces and the allocator, as
+	/// VoronoiDiagram is.
+	explicit Algorithm(const AllocatorT& allocator = AllocatorT());
 	
 	/// Constructs algorithm state.
-	/// @param points Reference to the input set of sites. The object must
-	/// exist throughout the existence of the Algorithm.
-	Algorithm(const containers::Array<PointT>& sites);
+	/// @param sites View of the input set of sites. The viewed memory must
+	/// stay valid throughout the existence of the Algorithm.
+	/// @param sites_sorted If true, the sites must be ordered primarily by Y
+	/// and secondarily by X coordinate, and they are not sorted again.
+	/// @param allocator The allocator of the algorithm state (see
+	/// Algorithm(const AllocatorT&)).
+	Algorithm(const SiteViewT& sites, bool sites_sorted = false, const AllocatorT& allocator = AllocatorT());
+	
+	/// Resets the algorithm state to compute the Voronoi diagram of new sites,
+	/// as if constructed again. The memory allocated by earlier computations
+	/// is reused, so that no memory is allocated if the number of sites is at
+	/// most the largest so far and the diagram has not been moved out.
+	/// @param sites View of the input set of sites. The viewed memory must
+	/// stay valid while the Algorithm is used with it.
+	/// @param sites_sorted If true, the sites must be ordered primarily by Y
+	/// and secondarily by X coordinate, and they are not sorted again.
+	/// @throws std::logic_error if the edges of the diagram would not fit in
+	/// the index type of the policy.
+	/// @throws std::length_error if estimatePeakMemory for the sites exceeds
+	/// the memory limit. Nothing is allocated in that case.
+	void reset(const SiteViewT& sites, bool sites_sorted = false);
+	
+	/// Resets the algorithm state to compute a Voronoi diagram incrementally,
+	/// from sites given one at a time with pushSite in the order of their
+	/// site events. The positions of the sites are stored in slots that are
+	/// reused once the sites are released with releaseSite, so the memory
+	/// use grows with the number of sites that can still have arcs on the
+	/// beach line rather than with the number of all sites. The memory limit
+	/// is not checked in incremental mode, and estimatePeakMemory does not
+	/// apply to it.
+	/// 
+	/// The faces of the output are identified by the slots of their sites,
+	/// and there is no bound of the face IDs in advance, so the output sink
+	/// must add faces on demand as StreamingSink does.
+	void resetIncremental();
+	
+	/// Adds the next site in incremental mode. The following calls of step()
+	/// handle the circle events before the site and then the site event.
+	/// While no site is pending, step() does nothing until the next site is
+	/// pushed or endSites() is called, as the circle events may be after the
+	/// next site.
+	/// @param pos The position of the site. The sites must be pushed in order
+	/// primarily by Y and secondarily by X coordinate.
+	/// @returns the slot of the site, which is its face ID in the output.
+	/// @throws std::logic_error if the algorithm is not in incremental mode
+	/// accepting sites, if the previous site is still pending, if the site is
+	/// before the previous site, or if the number of sites pushed does not
+	/// fit in the index type of the policy.
+	Idx pushSite(const PointT& pos);
+	
+	/// Returns true if the site pushed with pushSite has not been handled
+	/// yet.
+	bool hasPendingSite() const;
+	
+	/// Ends the sites in incremental mode, so that step() handles the
+	/// remaining circle events and the algorithm can finish.
+	/// @throws std::logic_error if the algorithm is not in incremental mode
+	/// accepting sites.
+	void endSites();
+	
+	/// Frees the slot of a site in incremental mode for the sites pushed
+	/// later. The face of the site must have been closed, so that the site
+	/// has no arcs left on the beach line. A face of StreamingSink is closed
+	/// when it calls onFaceClosed for it, at which point the slot may be
+	/// released even though the event that closed it is still being handled.
+	/// @param slot The slot returned by pushSite.
+	void releaseSite(Idx slot);
+	
+	/// Returns the number of sites pushed in incremental mode and not yet
+	/// released.
+	Idx getResidentSiteCount() const;
 	
 	/// Runs the algorithm one event handling forward.
 	void step();
@@ -40,62 +164,110 @@ public:
 	/// Returns the number of Voronoi vertices met in the algorithm.
 	int getVoronoiVertexCount() const;
 	
+	/// Returns the event queue of circle events, keyed by arc ID. Can be used
+	/// for reading statistics of the queue.
+	const EventPriorityQueueT& getEventQueue() const;
+	
 	/// Returns the Voronoi diagram constructed in the algorithm. The diagram
 	/// is complete if the algorithm is finished.
 	const VoronoiDiagramT& getVoronoiDiagram() const;
 	
+	/// @{
+	/// Returns the output sink of the algorithm. The sink is reset when the
+	/// algorithm is reset, but its other state, such as a visitor, is kept.
+	OutputT& getOutput();
+	const OutputT& getOutput() const;
+	/// @}
+	
+	/// Swaps the Voronoi diagram of the algorithm with another diagram. The
+	/// other diagram is reset and reused when the algorithm is reset, so that
+	/// its memory can be used for the next diagram.
+	/// @param diagram The diagram to swap with.
+	void swapVoronoiDiagram(VoronoiDiagramT& diagram);
+	
 	/// Moves the Voronoi diagram from the algorithm state.
 	/// @param algorithm The algorithm state rvalue from which to move the
 	/// Voronoi diagram.
-	static VoronoiDiagramT extractVoronoiDiagram(Algorithm<PolicyT>&& algorithm);
+	static VoronoiDiagramT extractVoronoiDiagram(Algorithm<PolicyT, OutputT>&& algorithm);
+	
+	/// Returns the memory allocated by the algorithm state and the diagram,
+	/// by component.
+	AlgorithmMemoryUsage getMemoryUsage() const;
+	
+	/// Returns an upper bound of the number of bytes that a new algorithm
+	/// state allocates, including the output diagram, when it computes the
+	/// Voronoi diagram of given number of sites. The bound is tight unless
+	/// the beach line search tree allocates its nodes on demand. The input
+	/// sites and the bookkeeping of the allocator are not included.
+	/// @param site_count The number of sites.
+	/// @param sites_sorted The sites_sorted parameter of reset.
+	static std::size_t estimatePeakMemory(Idx site_count, bool sites_sorted = false);
+	
+	/// Sets the limit of estimatePeakMemory for the sites given to reset, so
+	/// that computations that would need too much memory fail before they
+	/// allocate anything. By default there is no limit.
+	/// @param limit The limit in bytes.
+	void setMemoryLimit(std::size_t limit);
+	
+	/// Returns the limit set with setMemoryLimit.
+	std::size_t getMemoryLimit() const;
 	
 private:
 	typedef BeachLine<PolicyT> BeachLineT;
 	
-	/// Priority of events in the event queue.
-	struct EventPriority {
-		/// In site events, the X coordinate of the site. In circle events does
-		/// not matter.
-		CoordT x;
-		
-		/// The sweepline Y coordinate at which the event happens.
-		CoordT y;
-		
-		/// Ordering of events, primarily by y and secondarily by x to handle
-		/// cases of sites on the same horizontal line correctly.
-		bool operator<(const EventPriority& other) const;
+	typedef GeometryTraits<CoordT> GeometryTraitsT;
+	
+	/// Priority of a site event together with the index of the site, used
+	/// for sorting the sites.
+	struct SiteEvent {
+		EventPriorityT priority;
+		IndexT site;
 	};
 	
-	typedef typename PolicyT::template EventPriorityQueue<EventPriority> EventPriorityQueueT;
-	BOOST_CONCEPT_ASSERT((containers::PriorityQueueConcept<EventPriorityQueueT, EventPriority>));
 	
-	typedef GeometryTraits<CoordT> GeometryTraitsT;
+	/// @{
+	/// Constructs the output sink for no faces, with the allocator if the
+	/// sink takes one.
+	static OutputT createOutput_(const AllocatorT& allocator, std::true_type);
+	static OutputT createOutput_(const AllocatorT& allocator, std::false_type);
+	/// @}
 	
+	/// Returns the number of arc IDs needed for given number of sites.
+	static Idx getMaxArcCount_(Idx site_count);
 	
-	/// Returns the event queue key for circle event of given arc.
-	/// @param arc_id The id of the arc.
-	Idx getCircleEventKey_(Idx arc_id) const;
+	/// Returns upper bounds of the numbers of edges and vertices in the
+	/// Voronoi diagram of given number of sites.
+	static std::pair<Idx, Idx> getDiagramSizeBound_(Idx site_count);
 	
-	/// Get the event queue key for site event.
-	/// @param site The index of the site.
-	Idx getSiteEventKey_(Idx site) const;
-	
-	/// Get the number of possible event keys. The event keys are in range
-	/// 0, ..., getEventKeyCount_()-1.
-	Idx getEventKeyCount_() const;
-	
-	/// Returns pair of:
-	///  - boolean with value true if the event is a site event, false if
-	///    the event is a circle event.
-	///  - In case of site event, the index of the site. In case of circle
-	///    event, the arc ID.
-	/// @param event_key The key of the event.
-	std::pair<bool, Idx> getEventInfo_(Idx event_key) const;
-	
-	/// Check whether the breakpoints around an arc converge, and if they do,
-	/// add a circle event to the queue.
+	/// Sorts the indices of the sites to sorted_sites_ in the order of their
+	/// site events.
+	void sortSites_();
+	
+	/// Adds a site slot in incremental mode, growing the arrays indexed by
+	/// arc ID if the beach line may need more arcs.
+	/// @returns the new slot.
+	Idx addSiteSlot_();
+	
+	/// Increases the number of keys of the event queue, keeping the events.
+	/// @param max_arcs The new number of arc IDs.
+	void growEventQueue_(Idx max_arcs);
+	
+	/// Gives the event queue the range of the Y-coordinates of the sites, if
+	/// it accepts a range hint (see containers::HasPriorityRangeHint).
+	void hintEventRange_(std::true_type);
+	void hintEventRange_(std::false_type);
+	
+	/// Returns the index of the site of the next site event, or nil_idx if
+	/// all site events have been handled.
+	Idx getNextSite_() const;
+	
+	/// Updates the circle event of an arc after its neighbours have changed.
+	/// If the breakpoints around the arc converge, the circle event is set to
+	/// the new position, otherwise the possible old event is removed as a
+	/// false alarm. Replacing the event with one setPriority is cheaper than
+	/// removing it first, especially in queues with lazy invalidation.
 	/// @param arc_id The ID of the arc.
-	void tryAddCircleEvent_(Idx arc_id);
+	void updateCircleEvent_(Idx arc_id);
 	
 	/// Handles site event.
 	/// @param site The index of the site.
@@ -110,8 +282,11 @@ private:
 	void markConsecutiveInfiniteEdges_();
 	
 	
-	/// The input set of point sites.
-	const containers::Array<PointT>& sites_;
+	/// View of the input set of point sites.
+	SiteViewT sites_;
+	
+	/// The number of input sites.
+	Idx site_count_;
 	
 	/// The beach line of arcs.
 	BeachLineT beach_line_;
@@ -120,17 +295,60 @@ private:
 	/// called.
 	CoordT sweepline_y_;
 	
-	/// The event queue of site events and circle events. The event keys
-	/// can be translated with #getCircleEventKey_, #getSiteEventKey_ and
-	/// #getEventInfo_.
+	/// If true, the sites are already in the order of their site events and
+	/// sorted_sites_ is not used.
+	bool sites_sorted_;
+	
+	/// The indices of the sites ordered by their site events, if not
+	/// sites_sorted_. The site events are handled by merging this sequence
+	/// with the circle events in event_queue_. In incremental mode, this
+	/// holds only the slot of the last pushed site.
+	containers::DynamicArray<IndexT, AllocatorT> sorted_sites_;
+	
+	/// Work space for sorting the site events in sortSites_.
+	containers::DynamicArray<SiteEvent, AllocatorT> site_events_;
+	
+	/// The position of the next site event in the site event order.
+	Idx next_site_pos_;
+	
+	/// The event queue of circle events, keyed by the ID of the disappearing
+	/// arc.
 	EventPriorityQueueT event_queue_;
 	
-	/// The output Voronoi diagram that is constructed by the algorithm.
-	VoronoiDiagramT diagram_;
+	/// The circumcenters of the sites of the arcs around the arcs that have
+	/// circle events, indexed by the arc ID. Undefined value for the arcs that
+	/// have no circle event.
+	containers::DynamicArray<PointT, AllocatorT> circle_event_centers_;
+	
+	/// The output sink to which the algorithm reports the Voronoi diagram.
+	OutputT output_;
 	
 	/// Indexes of the half-edges the breakpoints are drawing, indexed by the
 	/// arc IDs of the arcs left from the breakpoints.
-	containers::Array<Idx> breakpoint_edge_index_;
+	containers::DynamicArray<IndexT, AllocatorT> breakpoint_edge_index_;
+	
+	/// The limit set with setMemoryLimit.
+	std::size_t memory_limit_;
+	
+	/// True in incremental mode until endSites is called. Then the algorithm
+	/// is not finished even if there are no events left.
+	bool accepting_sites_;
+	
+	/// The positions of the sites by slot in incremental mode, viewed by
+	/// sites_.
+	containers::DynamicArray<PointT, AllocatorT> resident_sites_;
+	
+	/// The released slots of resident_sites_.
+	containers::Stack<IndexT, AllocatorT> free_site_slots_;
+	
+	/// The number of sites pushed and not released in incremental mode.
+	Idx resident_site_count_;
+	
+	/// The number of sites pushed in incremental mode.
+	Idx pushed_site_count_;
+	
+	/// The position of the last pushed site.
+	PointT last_pushed_site_;
 };
 
 }
@@ -1,143 +1,451 @@
+#include <algorithm>
+
 namespace frivol {
 namespace fortune {
 
-template <typename PolicyT>
-Algorithm<PolicyT>::Algorithm(const containers::Array<PointT>& sites)
-	: sites_(sites),
-	  beach_line_(sites_, std::max(2 * sites.getSize(), (Idx)1) - 1),
-	  event_queue_(getEventKeyCount_()),
-	  diagram_(sites_.getSize()),
-	  breakpoint_edge_index_(beach_line_.getMaxArcCount())
+template <typename PolicyT, typename OutputT>
+Algorithm<PolicyT, OutputT>::Algorithm(const AllocatorT& allocator)
+	: site_count_(0),
+	  beach_line_(allocator),
+	  sites_sorted_(true),
+	  sorted_sites_(allocator),
+	  site_events_(allocator),
+	  next_site_pos_(0),
+	  event_queue_(0, allocator),
+	  circle_event_centers_(allocator),
+	  output_(createOutput_(allocator, std::is_constructible<OutputT, Idx, const AllocatorT&>())),
+	  breakpoint_edge_index_(allocator),
+	  memory_limit_(std::numeric_limits<std::size_t>::max()),
+	  accepting_sites_(false),
+	  resident_sites_(allocator),
+	  free_site_slots_(allocator),
+	  resident_site_count_(0),
+	  pushed_site_count_(0)
+{ }
+
+template <typename PolicyT, typename OutputT>
+Algorithm<PolicyT, OutputT>::Algorithm(
+	const SiteViewT& sites,
+	bool sites_sorted,
+	const AllocatorT& allocator
+)
+	: Algorithm(allocator)
 {
-	// All sites must have events in the queue.
-	for(Idx i = 0; i < sites_.getSize(); ++i) {
-		EventPriority priority{sites_[i].x, sites_[i].y};
-		event_queue_.setPriority(getSiteEventKey_(i), priority);
+	reset(sites, sites_sorted);
+}
+
+template <typename PolicyT, typename OutputT>
+void Algorithm<PolicyT, OutputT>::reset(
+	const SiteViewT& sites,
+	bool sites_sorted
+) {
+	// The diagram has at most 3n half-edge pairs, the most numerous IDs.
+	if(sites.getSize() > ((Idx)nilIndex<IndexT>() - 1) / 6) {
+		throw std::logic_error("Algorithm::reset: too many sites for the index type.");
+	}
+	if(estimatePeakMemory(sites.getSize(), sites_sorted) > memory_limit_) {
+		throw std::length_error("Algorithm::reset: estimated memory usage exceeds the limit.");
+	}
+	
+	sites_ = sites;
+	site_count_ = sites.getSize();
+	accepting_sites_ = false;
+	
+	Idx max_arcs = getMaxArcCount_(site_count_);
+	beach_line_.reset(sites, max_arcs);
+	sites_sorted_ = sites_sorted;
+	next_site_pos_ = 0;
+	event_queue_.reset(max_arcs);
+	circle_event_centers_.resize(max_arcs);
+	breakpoint_edge_index_.resize(max_arcs);
+	output_.reset(site_count_);
+	std::pair<Idx, Idx> diagram_size = getDiagramSizeBound_(site_count_);
+	output_.reserve(diagram_size.first, diagram_size.second);
+	
+	if(!sites_sorted_) sortSites_();
+	hintEventRange_(containers::HasPriorityRangeHint<EventPriorityQueueT>());
+}
+
+template <typename PolicyT, typename OutputT>
+void Algorithm<PolicyT, OutputT>::resetIncremental() {
+	resident_sites_.clear();
+	free_site_slots_.clear();
+	resident_site_count_ = 0;
+	pushed_site_count_ = 0;
+	sites_ = SiteViewT();
+	
+	// The pending site is given through sorted_sites_, so that step() needs
+	// no separate case for the incremental mode.
+	site_count_ = 0;
+	sites_sorted_ = false;
+	sorted_sites_.resize(1);
+	next_site_pos_ = 0;
+	accepting_sites_ = true;
+	
+	// The arrays indexed by arc ID grow with the site slots.
+	beach_line_.reset(sites_, 0);
+	event_queue_.reset(0);
+	circle_event_centers_.resize(0);
+	breakpoint_edge_index_.resize(0);
+	output_.reset(0);
+}
+
+template <typename PolicyT, typename OutputT>
+Idx Algorithm<PolicyT, OutputT>::pushSite(const PointT& pos) {
+	if(!accepting_sites_) {
+		throw std::logic_error("Algorithm::pushSite: the algorithm is not accepting sites.");
+	}
+	if(hasPendingSite()) {
+		throw std::logic_error("Algorithm::pushSite: the previous site has not been handled.");
+	}
+	if(
+		pushed_site_count_ != 0 &&
+		EventPriority<CoordT>{pos.x, pos.y} <
+			EventPriority<CoordT>{last_pushed_site_.x, last_pushed_site_.y}
+	) {
+		throw std::logic_error("Algorithm::pushSite: the sites are not in the order of their site events.");
+	}
+	// The beach line gives every inserted site an order number.
+	if(pushed_site_count_ >= (Idx)nilIndex<IndexT>()) {
+		throw std::logic_error("Algorithm::pushSite: too many sites for the index type.");
+	}
+	
+	Idx slot;
+	if(free_site_slots_.empty()) {
+		slot = addSiteSlot_();
+	} else {
+		slot = free_site_slots_.top();
+		free_site_slots_.pop();
 	}
+	resident_sites_[slot] = pos;
+	++resident_site_count_;
+	++pushed_site_count_;
+	last_pushed_site_ = pos;
+	
+	sorted_sites_[0] = compactIndex<IndexT>(slot);
+	site_count_ = 1;
+	next_site_pos_ = 0;
+	
+	return slot;
 }
 
-template <typename PolicyT>
-void Algorithm<PolicyT>::step() {
-	if(event_queue_.empty()) return;
+template <typename PolicyT, typename OutputT>
+bool Algorithm<PolicyT, OutputT>::hasPendingSite() const {
+	return next_site_pos_ != site_count_;
+}
+
+template <typename PolicyT, typename OutputT>
+void Algorithm<PolicyT, OutputT>::endSites() {
+	if(!accepting_sites_) {
+		throw std::logic_error("Algorithm::endSites: the algorithm is not accepting sites.");
+	}
+	accepting_sites_ = false;
 	
-	Idx event_key;
-	EventPriority priority;
-	std::tie(event_key, priority) = event_queue_.pop();
-	sweepline_y_ = priority.y;
+	// If there are no events left, step() would not get to mark the infinite
+	// edges.
+	if(isFinished()) markConsecutiveInfiniteEdges_();
+}
+
+template <typename PolicyT, typename OutputT>
+void Algorithm<PolicyT, OutputT>::releaseSite(Idx slot) {
+	free_site_slots_.push(compactIndex<IndexT>(slot));
+	--resident_site_count_;
+}
+
+template <typename PolicyT, typename OutputT>
+Idx Algorithm<PolicyT, OutputT>::getResidentSiteCount() const {
+	return resident_site_count_;
+}
+
+template <typename PolicyT, typename OutputT>
+void Algorithm<PolicyT, OutputT>::step() {
+	Idx site = getNextSite_();
+	if(site == nil_idx && (accepting_sites_ || event_queue_.empty())) return;
 	
-	std::pair<bool, Idx> event_info = getEventInfo_(event_key);
-	bool is_site_event = event_info.first;
+	// Handle the site event if it is before the first circle event in the
+	// (y, x) order of the events, where circle events have x = 0.
+	bool is_site_event;
+	if(site == nil_idx) {
+		is_site_event = false;
+	} else if(event_queue_.empty()) {
+		is_site_event = true;
+	} else {
+		EventPriorityT site_priority{sites_.getX(site), sites_.getY(site)};
+		is_site_event = site_priority < event_queue_.top().second;
+	}
 	
 	if(is_site_event) {
-		handleSiteEvent_(event_info.second);
+		++next_site_pos_;
+		sweepline_y_ = sites_.getY(site);
+		handleSiteEvent_(site);
 	} else {
-		handleCircleEvent_(event_info.second);
+		Idx arc_id;
+		EventPriorityT priority;
+		std::tie(arc_id, priority) = event_queue_.pop();
+		sweepline_y_ = priority.getY();
+		handleCircleEvent_(arc_id);
 	}
 	
 	// If we are done now, mark all infinite edges consecutive in the Voronoi
 	// diagram.
-	if(event_queue_.empty()) markConsecutiveInfiniteEdges_();
+	if(isFinished()) markConsecutiveInfiniteEdges_();
 }
 
-template <typename PolicyT>
-typename PolicyT::Coord Algorithm<PolicyT>::getSweeplineY() const {
+template <typename PolicyT, typename OutputT>
+typename PolicyT::Coord Algorithm<PolicyT, OutputT>::getSweeplineY() const {
 	return sweepline_y_;
 }
 
-template <typename PolicyT>
-bool Algorithm<PolicyT>::isFinished() {
-	return event_queue_.empty();
+template <typename PolicyT, typename OutputT>
+bool Algorithm<PolicyT, OutputT>::isFinished() {
+	return !accepting_sites_ && getNextSite_() == nil_idx && event_queue_.empty();
 }
 
-template <typename PolicyT>
-void Algorithm<PolicyT>::finish() {
+template <typename PolicyT, typename OutputT>
+void Algorithm<PolicyT, OutputT>::finish() {
 	while(!isFinished()) step();
 }
 
-template <typename PolicyT>
-int Algorithm<PolicyT>::getVoronoiVertexCount() const {
-	return diagram_.getVertexCount();
+template <typename PolicyT, typename OutputT>
+int Algorithm<PolicyT, OutputT>::getVoronoiVertexCount() const {
+	return output_.getVertexCount();
+}
+
+template <typename PolicyT, typename OutputT>
+const typename Algorithm<PolicyT, OutputT>::EventPriorityQueueT&
+Algorithm<PolicyT, OutputT>::getEventQueue() const {
+	return event_queue_;
+}
+
+template <typename PolicyT, typename OutputT>
+const typename Algorithm<PolicyT, OutputT>::VoronoiDiagramT&
+Algorithm<PolicyT, OutputT>::getVoronoiDiagram() const {
+	return output_;
+}
+
+template <typename PolicyT, typename OutputT>
+OutputT& Algorithm<PolicyT, OutputT>::getOutput() {
+	return output_;
+}
+
+template <typename PolicyT, typename OutputT>
+const OutputT& Algorithm<PolicyT, OutputT>::getOutput() const {
+	return output_;
 }
 
-template <typename PolicyT>
-const VoronoiDiagram<typename PolicyT::Coord>& 
-Algorithm<PolicyT>::getVoronoiDiagram() const {
-	return diagram_;
+template <typename PolicyT, typename OutputT>
+void Algorithm<PolicyT, OutputT>::swapVoronoiDiagram(VoronoiDiagramT& diagram) {
+	std::swap(output_, diagram);
 }
 
-template <typename PolicyT>
-VoronoiDiagram<typename PolicyT::Coord> Algorithm<PolicyT>::extractVoronoiDiagram(
-	Algorithm<PolicyT>&& algorithm
+template <typename PolicyT, typename OutputT>
+typename Algorithm<PolicyT, OutputT>::VoronoiDiagramT Algorithm<PolicyT, OutputT>::extractVoronoiDiagram(
+	Algorithm<PolicyT, OutputT>&& algorithm
 ) {
-	return std::move(algorithm.diagram_);
+	return std::move(algorithm.output_);
 }
 
-template <typename PolicyT>
-bool Algorithm<PolicyT>::EventPriority::operator<(const EventPriority& other) const {
-	if(y == other.y) {
-		return x < other.x;
+template <typename PolicyT, typename OutputT>
+AlgorithmMemoryUsage Algorithm<PolicyT, OutputT>::getMemoryUsage() const {
+	AlgorithmMemoryUsage usage;
+	usage.beach_line = beach_line_.getMemoryUsage();
+	usage.event_queue = event_queue_.getMemoryUsage();
+	usage.site_events =
+		sorted_sites_.getMemoryUsage() + site_events_.getMemoryUsage() +
+		resident_sites_.getMemoryUsage() + free_site_slots_.getMemoryUsage();
+	usage.circle_events =
+		circle_event_centers_.getMemoryUsage() + breakpoint_edge_index_.getMemoryUsage();
+	usage.diagram = output_.getMemoryUsage();
+	return usage;
+}
+
+template <typename PolicyT, typename OutputT>
+std::size_t Algorithm<PolicyT, OutputT>::estimatePeakMemory(Idx site_count, bool sites_sorted) {
+	Idx max_arcs = getMaxArcCount_(site_count);
+	std::pair<Idx, Idx> diagram_size = getDiagramSizeBound_(site_count);
+	
+	std::size_t bytes =
+		BeachLineT::estimateMemoryUsage(site_count, max_arcs) +
+		EventPriorityQueueT::estimateMemoryUsage(max_arcs) +
+		max_arcs * (sizeof(PointT) + sizeof(IndexT)) +
+		OutputT::estimateMemoryUsage(site_count, diagram_size.first, diagram_size.second);
+	if(!sites_sorted) {
+		bytes += site_count * (sizeof(SiteEvent) + sizeof(IndexT));
+	}
+	return bytes;
+}
+
+template <typename PolicyT, typename OutputT>
+void Algorithm<PolicyT, OutputT>::setMemoryLimit(std::size_t limit) {
+	memory_limit_ = limit;
+}
+
+template <typename PolicyT, typename OutputT>
+std::size_t Algorithm<PolicyT, OutputT>::getMemoryLimit() const {
+	return memory_limit_;
+}
+
+template <typename PolicyT, typename OutputT>
+OutputT Algorithm<PolicyT, OutputT>::createOutput_(const AllocatorT& allocator, std::true_type) {
+	return OutputT(0, allocator);
+}
+
+template <typename PolicyT, typename OutputT>
+OutputT Algorithm<PolicyT, OutputT>::createOutput_(const AllocatorT&, std::false_type) {
+	return OutputT(0);
+}
+
+template <typename PolicyT, typename OutputT>
+Idx Algorithm<PolicyT, OutputT>::getMaxArcCount_(Idx site_count) {
+	// Each site event adds at most two arcs.
+	return std::max(2 * site_count, (Idx)1) - 1;
+}
+
+template <typename PolicyT, typename OutputT>
+std::pair<Idx, Idx> Algorithm<PolicyT, OutputT>::getDiagramSizeBound_(Idx site_count) {
+	// By Euler's formula, a Voronoi diagram of n >= 3 sites with vertices of
+	// degree three has at most 3n-6 edges and 2n-5 vertices. If the sites are
+	// collinear, there are n-1 edges and no vertices.
+	if(site_count >= 3) {
+		return std::make_pair(3 * site_count - 6, 2 * site_count - 5);
 	} else {
-		return y < other.y;
+		return std::make_pair(std::max(site_count, (Idx)1) - 1, (Idx)0);
 	}
 }
 
-template <typename PolicyT>
-Idx Algorithm<PolicyT>::getCircleEventKey_(Idx arc_id) const {
-	// The arc IDs 0, ..., sites_.getSize()-1 are reserved for site events,
-	// so we need to shift circle events by sites_.getSize().
-	return sites_.getSize() + arc_id;
+template <typename PolicyT, typename OutputT>
+void Algorithm<PolicyT, OutputT>::sortSites_() {
+	// Sort the priorities together with the indices so that the comparisons
+	// do not need to access the sites array.
+	Idx site_count = site_count_;
+	if(site_count == 0) return;
+	
+	site_events_.resize(site_count);
+	for(Idx site = 0; site < site_count; ++site) {
+		site_events_[site] = SiteEvent{{sites_.getX(site), sites_.getY(site)}, compactIndex<IndexT>(site)};
+	}
+	
+	SiteEvent* events = &site_events_[0];
+	std::sort(
+		events,
+		events + site_count,
+		[](const SiteEvent& a, const SiteEvent& b) {
+			return a.priority < b.priority;
+		}
+	);
+	
+	sorted_sites_.resize(site_count);
+	for(Idx pos = 0; pos < site_count; ++pos) {
+		sorted_sites_[pos] = events[pos].site;
+	}
 }
 
-template <typename PolicyT>
-Idx Algorithm<PolicyT>::getSiteEventKey_(Idx site) const {
-	return site;
+template <typename PolicyT, typename OutputT>
+Idx Algorithm<PolicyT, OutputT>::addSiteSlot_() {
+	Idx slot = resident_sites_.add(PointT());
+	sites_ = SiteViewT(&resident_sites_[0], resident_sites_.getSize());
+	
+	// The arcs on the beach line belong to the resident sites, and no two
+	// sites alternate more than twice in the arc sequence, so there are at
+	// most 2k-1 arcs for k slots. The arc capacity is doubled when it grows,
+	// so that the growth takes amortized constant time per site.
+	Idx max_arcs = beach_line_.getMaxArcCount();
+	Idx needed_arcs = 2 * resident_sites_.getSize() - 1;
+	bool grow_arcs = needed_arcs > max_arcs;
+	if(grow_arcs) max_arcs = std::max(needed_arcs, 2 * max_arcs);
+	
+	beach_line_.grow(sites_, max_arcs);
+	if(grow_arcs) {
+		growEventQueue_(max_arcs);
+		circle_event_centers_.resize(max_arcs);
+		breakpoint_edge_index_.resize(max_arcs);
+	}
+	
+	return slot;
 }
 
-template <typename PolicyT>
-Idx Algorithm<PolicyT>::getEventKeyCount_() const {
-	// The possible events are:
-	//  - site events: sites_.getSize()
-	//  - circle events: beach_line_.getMaxArcCount().
-	return sites_.getSize() + beach_line_.getMaxArcCount();
+template <typename PolicyT, typename OutputT>
+void Algorithm<PolicyT, OutputT>::growEventQueue_(Idx max_arcs) {
+	// The queues cannot change their number of keys in place, so the events
+	// are popped and set again after the reset.
+	containers::DynamicArray<std::pair<Idx, EventPriorityT>, AllocatorT> events(
+		circle_event_centers_.getAllocator()
+	);
+	while(!event_queue_.empty()) {
+		events.add(event_queue_.pop());
+	}
+	
+	event_queue_.reset(max_arcs);
+	for(Idx i = 0; i < events.getSize(); ++i) {
+		event_queue_.setPriority(events[i].first, events[i].second);
+	}
 }
 
-template <typename PolicyT>
-std::pair<bool, Idx> Algorithm<PolicyT>::getEventInfo_(Idx event_key) const {
-	if(event_key < sites_.getSize()) {
-		return std::make_pair(true, event_key);
+template <typename PolicyT, typename OutputT>
+void Algorithm<PolicyT, OutputT>::hintEventRange_(std::true_type) {
+	Idx site_count = site_count_;
+	if(site_count == 0) return;
+	
+	// Most circle events are between the first and the last site event.
+	PointT first = sites_[sites_sorted_ ? 0 : sorted_sites_[0]];
+	PointT last = sites_[sites_sorted_ ? site_count - 1 : sorted_sites_[site_count - 1]];
+	event_queue_.setRangeHint(
+		EventPriorityT{first.x, first.y},
+		EventPriorityT{last.x, last.y}
+	);
+}
+
+template <typename PolicyT, typename OutputT>
+void Algorithm<PolicyT, OutputT>::hintEventRange_(std::false_type) { }
+
+template <typename PolicyT, typename OutputT>
+Idx Algorithm<PolicyT, OutputT>::getNextSite_() const {
+	if(next_site_pos_ == site_count_) return nil_idx;
+	
+	if(sites_sorted_) {
+		return next_site_pos_;
 	} else {
-		return std::make_pair(false, event_key - sites_.getSize());
+		return sorted_sites_[next_site_pos_];
 	}
 }
 
-template <typename PolicyT>
-void Algorithm<PolicyT>::tryAddCircleEvent_(Idx arc_id) {
+template <typename PolicyT, typename OutputT>
+void Algorithm<PolicyT, OutputT>::updateCircleEvent_(Idx arc_id) {
 	// If the arc is the leftmost or the rightmost, there can't be circle events.
 	Idx left_arc_id = beach_line_.getLeftArc(arc_id);
 	Idx right_arc_id = beach_line_.getRightArc(arc_id);
-	if(left_arc_id == nil_idx || right_arc_id == nil_idx) return;
+	if(left_arc_id == nil_idx || right_arc_id == nil_idx) {
+		event_queue_.setPriorityNIL(arc_id);
+		return;
+	}
 	
-	const PointT& left_point = sites_[beach_line_.getOriginSite(left_arc_id)];
-	const PointT& middle_point = sites_[beach_line_.getOriginSite(arc_id)];
-	const PointT& right_point = sites_[beach_line_.getOriginSite(right_arc_id)];
+	PointT left_point = sites_[beach_line_.getOriginSite(left_arc_id)];
+	PointT middle_point = sites_[beach_line_.getOriginSite(arc_id)];
+	PointT right_point = sites_[beach_line_.getOriginSite(right_arc_id)];
 	
 	// The arcs converge if the sites form a convex triangle.
-	if(!GeometryTraitsT::isCCW(left_point, middle_point, right_point)) return;
+	if(!GeometryTraitsT::isCCW(left_point, middle_point, right_point)) {
+		event_queue_.setPriorityNIL(arc_id);
+		return;
+	}
 	
-	// The event happens in the top tangent of the circumscribed circle.
-	CoordT event_y = GeometryTraitsT::getCircumcircleTopY(
+	// The event happens in the top tangent of the circumscribed circle. The
+	// center is stored to be used as the Voronoi vertex in the event.
+	PointT center = GeometryTraitsT::getCircumcenter(
 		left_point, middle_point, right_point
 	);
+	circle_event_centers_[arc_id] = center;
+	CoordT event_y = getCircleTopY(center, left_point, middle_point, right_point);
 	
 	// Make sure that our y is monotonous.
 	event_y = std::max(event_y, sweepline_y_);
 	
-	EventPriority priority{0, event_y};
-	event_queue_.setPriority(getCircleEventKey_(arc_id), priority);
+	EventPriorityT priority{0, event_y};
+	event_queue_.setPriority(arc_id, priority);
 }
 
-template <typename PolicyT>
-void Algorithm<PolicyT>::handleSiteEvent_(Idx site) {
+template <typename PolicyT, typename OutputT>
+void Algorithm<PolicyT, OutputT>::handleSiteEvent_(Idx site) {
 	Idx arc_id = beach_line_.insertArc(site, sweepline_y_);
 	
 	Idx left_arc_id = beach_line_.getLeftArc(arc_id);
@@ -146,62 +454,54 @@ void Algorithm<PolicyT>::handleSiteEvent_(Idx site) {
 	// If there are arcs around the new arc, the beach line was not empty.
 	if(right_arc_id != nil_idx) {
 		// The possible circle event around the arc over which the new arc
-		// was placed was false alarm because the situation around it has changed.
-		event_queue_.setPriorityNIL(getCircleEventKey_(right_arc_id));
-		
-		// Add the possible new circle events.
-		tryAddCircleEvent_(left_arc_id);
-		tryAddCircleEvent_(right_arc_id);
+		// was placed is replaced because the situation around it has changed.
+		// The new left arc has no event yet.
+		updateCircleEvent_(left_arc_id);
+		updateCircleEvent_(right_arc_id);
 		
 		// Add the edge between the sites of the new arc and the arc below it.
 		Idx base_site = beach_line_.getOriginSite(right_arc_id);
 		
 		Idx left_edge, right_edge;
-		std::tie(left_edge, right_edge) = diagram_.addEdge(base_site, site);
+		std::tie(left_edge, right_edge) = output_.addEdge(base_site, site);
 		
 		// Mark the edges to the breakpoints drawing them.
-		breakpoint_edge_index_[left_arc_id] = left_edge;
-		breakpoint_edge_index_[arc_id] = right_edge;
+		breakpoint_edge_index_[left_arc_id] = compactIndex<IndexT>(left_edge);
+		breakpoint_edge_index_[arc_id] = compactIndex<IndexT>(right_edge);
 	}
 }
 
-template <typename PolicyT>
-void Algorithm<PolicyT>::handleCircleEvent_(Idx arc_id) {
+template <typename PolicyT, typename OutputT>
+void Algorithm<PolicyT, OutputT>::handleCircleEvent_(Idx arc_id) {
 	Idx left_arc_id = beach_line_.getLeftArc(arc_id);
 	Idx right_arc_id = beach_line_.getRightArc(arc_id);
 	
 	Idx left_site = beach_line_.getOriginSite(left_arc_id);
-	Idx site = beach_line_.getOriginSite(arc_id);
 	Idx right_site = beach_line_.getOriginSite(right_arc_id);
 	
-	// Add the new Voronoi vertex.
-	PointT vertex_pos = GeometryTraitsT::getCircumcenter(
-		sites_[left_site], sites_[site], sites_[right_site]
-	);
+	// Add the new Voronoi vertex, which is the circumcenter computed when
+	// the event was added for the same three sites.
+	const PointT& vertex_pos = circle_event_centers_[arc_id];
 	
 	Idx left_edge = breakpoint_edge_index_[left_arc_id];
 	Idx right_edge = breakpoint_edge_index_[arc_id];
 	Idx new_edge_in, new_edge_out;
-	std::tie(new_edge_out, new_edge_in) = diagram_.addEdge(left_site, right_site);
-	diagram_.addVertex(vertex_pos, new_edge_in, left_edge, right_edge);
+	std::tie(new_edge_out, new_edge_in) = output_.addEdge(left_site, right_site);
+	output_.addVertex(vertex_pos, new_edge_in, left_edge, right_edge);
 	
 	// Update the remaining breakpoint to draw the right edge.
-	breakpoint_edge_index_[left_arc_id] = new_edge_out;
-	
-	// The possible circle event around the left and right arcs are false alarms
-	// because the situations in them have changed.
-	event_queue_.setPriorityNIL(getCircleEventKey_(left_arc_id));
-	event_queue_.setPriorityNIL(getCircleEventKey_(right_arc_id));
+	breakpoint_edge_index_[left_arc_id] = compactIndex<IndexT>(new_edge_out);
 	
 	beach_line_.removeArc(arc_id);
 	
-	// Add the possible new circle events;
-	tryAddCircleEvent_(left_arc_id);
-	tryAddCircleEvent_(right_arc_id);
+	// The possible circle events around the left and right arcs are replaced
+	// because the situations in them have changed.
+	updateCircleEvent_(left_arc_id);
+	updateCircleEvent_(right_arc_id);
 }
 
-template <typename PolicyT>
-void Algorithm<PolicyT>::markConsecutiveInfiniteEdges_() {
+template <typename PolicyT, typename OutputT>
+void Algorithm<PolicyT, OutputT>::markConsecutiveInfiniteEdges_() {
 	// If there are only zero or one arcs, there's nothing to do.
 	if(beach_line_.getLeftmostArc() == nil_idx) return;
 	if(beach_line_.getLeftmostArc() == beach_line_.getRightmostArc()) return;
@@ -213,9 +513,9 @@ void Algorithm<PolicyT>::markConsecutiveInfiniteEdges_() {
 		arc2 != beach_line_.getRightmostArc();
 		arc2 = beach_line_.getRightArc(arc2)
 	) {
-		diagram_.consecutiveEdges(
+		output_.consecutiveEdges(
 			breakpoint_edge_index_[arc2],
-			diagram_.getTwinEdge(breakpoint_edge_index_[arc1])
+			output_.getTwinEdge(breakpoint_edge_index_[arc1])
 		);
 		
 		arc1 = arc2;
@@ -1,9 +1,11 @@
 #ifndef FRIVOL_FORTUNE_BEACH_LINE_HPP
 #define FRIVOL_FORTUNE_BEACH_LINE_HPP
 
+#include <frivol/containers/dynamic_array.hpp>
 #include <frivol/containers/search_tree_concept.hpp>
 #include <frivol/containers/stack.hpp>
 #include <frivol/geometry_traits.hpp>
+#include <frivol/site_view.hpp>
 
 #include <stdexcept>
 
@@ -11,9 +13,11 @@ namespace frivol {
 namespace fortune {
 
 /// Information of an arc in BeachLine.
+/// @tparam IndexT The integer type of the indices (see Policy).
+template <typename IndexT>
 struct Arc {
-	Idx site;   ///< The index of the site from which the arc originates.
-	Idx arc_id; ///< The ID of the arc.
+	IndexT site;   ///< The index of the site from which the arc originates.
+	IndexT arc_id; ///< The ID of the arc.
 };
 
 /// The advancing sweepline of Fortune's algorithm. Consists of parabolic arcs
@@ -29,13 +33,45 @@ template <typename PolicyT>
 class BeachLine {
 public:
 	typedef typename PolicyT::Coord CoordT;
+	typedef typename PolicyT::Allocator AllocatorT;
+	typedef typename PolicyT::Index IndexT;
 	typedef Point<CoordT> PointT;
+	typedef SiteView<CoordT> SiteViewT;
+	
+	/// Constructs empty BeachLine with no arcs. Must be reset before
+	/// inserting arcs.
+	/// @param allocator The allocator used for all memory of the beach line.
+	explicit BeachLine(const AllocatorT& allocator = AllocatorT());
 	
 	/// Constructs BeachLine.
-	/// @param sites The input sites for the algorithm.
+	/// @param sites The input sites for the algorithm. The viewed memory must
+	/// stay valid while the beach line is used.
+	/// @param max_arcs The number of arcs the beach line must be able to
+	/// contain.
+	/// @param allocator The allocator used for all memory of the beach line.
+	/// @throws std::logic_error if the arc IDs or the site indices do not fit
+	/// in the index type of the policy.
+	BeachLine(const SiteViewT& sites, Idx max_arcs, const AllocatorT& allocator = AllocatorT());
+	
+	/// Empties the beach line for new input sites, reusing the allocated
+	/// memory if the new maximum number of arcs is at most the largest so far.
+	/// @param sites The new input sites for the algorithm.
 	/// @param max_arcs The number of arcs the beach line must be able to
 	/// contain.
-	BeachLine(const containers::Array<PointT>& sites, Idx max_arcs);
+	/// @throws std::logic_error if the arc IDs or the site indices do not fit
+	/// in the index type of the policy.
+	void reset(const SiteViewT& sites, Idx max_arcs);
+	
+	/// Extends the beach line to a larger view of the sites and a larger
+	/// maximum number of arcs, keeping the arcs and their IDs. Used when the
+	/// sites are added while the algorithm runs.
+	/// @param sites The new view of the sites. The sites of the arcs must be
+	/// at the same indices as in the old view.
+	/// @param max_arcs The new maximum number of arcs. If it is at most the
+	/// current maximum, the maximum is not changed.
+	/// @throws std::logic_error if the arc IDs or the site indices do not fit
+	/// in the index type of the policy.
+	void grow(const SiteViewT& sites, Idx max_arcs);
 	
 	/// Gets the maximum number of arcs there can be in the beach line. The arc
 	/// IDs are in 0, ..., getMaxArcCount()-1.
@@ -58,13 +94,13 @@ public:
 	/// @param arc_id The ID of the arc to remove.
 	void removeArc(Idx arc_id);
 	
-	/// Returns the ID of the arc left from given arc.
+	/// Returns the ID of the arc left from given arc in constant time.
 	/// @param arc_id ID of the arc.
 	/// @returns arc ID of the arc to the left from arc_id, or nil_idx if arc_id
 	/// is the leftmost arc.
 	Idx getLeftArc(Idx arc_id);
 	
-	/// Returns the ID of the arc right from given arc.
+	/// Returns the ID of the arc right from given arc in constant time.
 	/// @param arc_id ID of the arc.
 	/// @returns arc ID of the arc to the right from arc_id, or nil_idx if arc_id
 	/// is the rightmost arc.
@@ -80,10 +116,20 @@ public:
 	/// @param arc_id ID of the arc.
 	Idx getOriginSite(Idx arc_id);
 	
+	/// Returns the memory allocated for the search tree and the arc arrays.
+	MemoryUsage getMemoryUsage() const;
+	
+	/// Returns an upper bound of the number of bytes a new beach line
+	/// allocates when reset for given numbers of sites and arcs.
+	/// @param site_count The number of input sites.
+	/// @param max_arcs The maximum number of arcs.
+	static std::size_t estimateMemoryUsage(Idx site_count, Idx max_arcs);
+	
 private:
-	typedef typename PolicyT::template BeachLineSearchTree<Arc> SearchTreeT;
+	typedef Arc<IndexT> ArcT;
+	typedef typename PolicyT::template BeachLineSearchTree<ArcT> SearchTreeT;
 	typedef typename SearchTreeT::Iterator SearchTreeIteratorT;
-	BOOST_CONCEPT_ASSERT((containers::SearchTreeConcept<SearchTreeT, Arc>));
+	BOOST_CONCEPT_ASSERT((containers::SearchTreeConcept<SearchTreeT, ArcT, AllocatorT>));
 	
 	typedef GeometryTraits<CoordT> GeometryTraitsT;
 	
@@ -110,8 +156,8 @@ private:
 	/// parabolas.
 	CoordT getBreakpointX_(Idx site1, Idx site2, const CoordT& sweepline_y);
 	
-	/// Array of input point sites.
-	const containers::Array<PointT>& sites_;
+	/// View of the input point sites.
+	SiteViewT sites_;
 	
 	/// The arcs of the beach line, ordered by X-coordinate.
 	SearchTreeT beach_line_;
@@ -120,15 +166,37 @@ private:
 	Idx max_arcs_;
 	
 	/// Stack of currently unoccupied arc IDs from 0, ..., max_arcs-1.
-	containers::Stack<Idx> free_arc_ids_;
+	containers::Stack<IndexT, AllocatorT> free_arc_ids_;
 	
 	/// Mapping from beach line arc IDs to their corresponding iterators
 	/// in beach_line_.
-	containers::Array<SearchTreeIteratorT> arc_iterators_by_id_;
+	containers::DynamicArray<SearchTreeIteratorT, AllocatorT> arc_iterators_by_id_;
+	
+	/// The arc IDs of the left neighbours of the arcs by arc ID, or
+	/// nilIndex<IndexT>() for the leftmost arc. Together with right_arc_ids_ forms a doubly
+	/// linked list of the arcs, so that neighbours can be found without
+	/// traversing the search tree.
+	containers::DynamicArray<IndexT, AllocatorT> left_arc_ids_;
+	
+	/// The arc IDs of the right neighbours of the arcs by arc ID, or
+	/// nilIndex<IndexT>() for the rightmost arc.
+	containers::DynamicArray<IndexT, AllocatorT> right_arc_ids_;
+	
+	/// The ID of the leftmost arc, or nil_idx if the beach line is empty.
+	Idx leftmost_arc_id_;
+	
+	/// The ID of the rightmost arc, or nil_idx if the beach line is empty.
+	Idx rightmost_arc_id_;
+	
+	/// The ID of the arc from which to start searching the position of the
+	/// next arc, or nil_idx if the beach line is empty. This is the last
+	/// inserted arc or its neighbour if it has been removed, because sites
+	/// close to each other are often inserted consecutively.
+	Idx hint_arc_id_;
 	
 	/// Ordering numbers of the sites inserted with insertArc. The next order
 	/// number is next_site_order_.
-	containers::Array<Idx> site_order_;
+	containers::DynamicArray<IndexT, AllocatorT> site_order_;
 	
 	/// Next free site ordering number in site_order_.
 	Idx next_site_order_;
@@ -2,19 +2,79 @@ namespace frivol {
 namespace fortune {
 
 template <typename PolicyT>
-BeachLine<PolicyT>::BeachLine(const containers::Array<PointT>& sites, Idx max_arcs)
-	: sites_(sites),
-	  max_arcs_(max_arcs),
-	  arc_iterators_by_id_(max_arcs),
-	  site_order_(sites.getSize()),
+BeachLine<PolicyT>::BeachLine(const AllocatorT& allocator)
+	: beach_line_(allocator),
+	  max_arcs_(0),
+	  free_arc_ids_(allocator),
+	  arc_iterators_by_id_(allocator),
+	  left_arc_ids_(allocator),
+	  right_arc_ids_(allocator),
+	  leftmost_arc_id_(nil_idx),
+	  rightmost_arc_id_(nil_idx),
+	  hint_arc_id_(nil_idx),
+	  site_order_(allocator),
 	  next_site_order_(0)
+{ }
+
+template <typename PolicyT>
+BeachLine<PolicyT>::BeachLine(const SiteViewT& sites, Idx max_arcs, const AllocatorT& allocator)
+	: BeachLine(allocator)
 {
+	reset(sites, max_arcs);
+}
+
+template <typename PolicyT>
+void BeachLine<PolicyT>::reset(const SiteViewT& sites, Idx max_arcs) {
+	if(max_arcs > (Idx)nilIndex<IndexT>() || sites.getSize() > (Idx)nilIndex<IndexT>()) {
+		throw std::logic_error("BeachLine::reset: too many arcs for the index type.");
+	}
+	
+	sites_ = sites;
+	max_arcs_ = max_arcs;
+	
+	beach_line_.clear();
+	beach_line_.reserve(max_arcs_);
+	arc_iterators_by_id_.resize(max_arcs_);
+	left_arc_ids_.resize(max_arcs_);
+	right_arc_ids_.resize(max_arcs_);
+	leftmost_arc_id_ = nil_idx;
+	rightmost_arc_id_ = nil_idx;
+	hint_arc_id_ = nil_idx;
+	site_order_.resize(sites.getSize());
+	next_site_order_ = 0;
+	
 	// Initially, all arc IDs are free.
+	free_arc_ids_.clear();
+	free_arc_ids_.reserve(max_arcs_);
 	for(Idx arc_id = 0; arc_id < max_arcs_; ++arc_id) {
-		free_arc_ids_.push(arc_id);
+		free_arc_ids_.push(compactIndex<IndexT>(arc_id));
 	}
 }
 
+template <typename PolicyT>
+void BeachLine<PolicyT>::grow(const SiteViewT& sites, Idx max_arcs) {
+	if(max_arcs > (Idx)nilIndex<IndexT>() || sites.getSize() > (Idx)nilIndex<IndexT>()) {
+		throw std::logic_error("BeachLine::grow: too many arcs for the index type.");
+	}
+	
+	sites_ = sites;
+	site_order_.resize(sites.getSize());
+	if(max_arcs <= max_arcs_) return;
+	
+	// The search trees keep their iterators valid when reserving more
+	// elements, so arc_iterators_by_id_ stays valid.
+	beach_line_.reserve(max_arcs);
+	arc_iterators_by_id_.resize(max_arcs);
+	left_arc_ids_.resize(max_arcs);
+	right_arc_ids_.resize(max_arcs);
+	
+	free_arc_ids_.reserve(max_arcs);
+	for(Idx arc_id = max_arcs_; arc_id < max_arcs; ++arc_id) {
+		free_arc_ids_.push(compactIndex<IndexT>(arc_id));
+	}
+	max_arcs_ = max_arcs;
+}
+
 template <typename PolicyT>
 Idx BeachLine<PolicyT>::getMaxArcCount() const {
 	return max_arcs_;
@@ -23,21 +83,27 @@ Idx BeachLine<PolicyT>::getMaxArcCount() const {
 template <typename PolicyT>
 Idx BeachLine<PolicyT>::insertArc(Idx site, const CoordT& sweepline_y) {
 	// Update site ordering.
-	site_order_[site] = next_site_order_++;
+	site_order_[site] = compactIndex<IndexT>(next_site_order_++);
 	
 	// Search for an arc on which to place the new arc.
-	const CoordT& x = sites_[site].x;
+	const CoordT& x = sites_.getX(site);
 	
 	auto order = [this, &x, &sweepline_y](SearchTreeIteratorT iter) {
 		return this->orderArcX_(x, iter->arc_id, sweepline_y);
 	};
 	
-	SearchTreeIteratorT base_iter = beach_line_.search(order);
+	SearchTreeIteratorT base_iter;
+	if(hint_arc_id_ == nil_idx) {
+		base_iter = beach_line_.search(order);
+	} else {
+		base_iter = beach_line_.search(arc_iterators_by_id_[hint_arc_id_], order);
+	}
 	
 	// If there was no match, this is the only arc. Otherwise, split the
 	// base arc to two parts and place the new arc in between.
 	if(base_iter == beach_line_.end()) {
-		return insertArcTo_(beach_line_.end(), site);
+		hint_arc_id_ = insertArcTo_(beach_line_.end(), site);
+		return hint_arc_id_;
 	} else {
 		Idx left_arc_id = insertArcTo_(base_iter, base_iter->site);
 		Idx new_arc_id;
@@ -51,6 +117,7 @@ Idx BeachLine<PolicyT>::insertArc(Idx site, const CoordT& sweepline_y) {
 			throw;
 		}
 		
+		hint_arc_id_ = new_arc_id;
 		return new_arc_id;
 	}
 }
@@ -59,45 +126,47 @@ template <typename PolicyT>
 void BeachLine<PolicyT>::removeArc(Idx arc_id) {
 	SearchTreeIteratorT iter = arc_iterators_by_id_[arc_id];
 	beach_line_.erase(iter);
-	free_arc_ids_.push(arc_id);
+	free_arc_ids_.push(compactIndex<IndexT>(arc_id));
+	
+	// Unlink the arc from the neighbour list.
+	Idx left_arc_id = expandIndex(left_arc_ids_[arc_id]);
+	Idx right_arc_id = expandIndex(right_arc_ids_[arc_id]);
+	
+	if(left_arc_id == nil_idx) {
+		leftmost_arc_id_ = right_arc_id;
+	} else {
+		right_arc_ids_[left_arc_id] = compactIndex<IndexT>(right_arc_id);
+	}
+	
+	if(right_arc_id == nil_idx) {
+		rightmost_arc_id_ = left_arc_id;
+	} else {
+		left_arc_ids_[right_arc_id] = compactIndex<IndexT>(left_arc_id);
+	}
+	
+	if(hint_arc_id_ == arc_id) {
+		hint_arc_id_ = left_arc_id != nil_idx ? left_arc_id : right_arc_id;
+	}
 }
 
 template <typename PolicyT>
 Idx BeachLine<PolicyT>::getLeftArc(Idx arc_id) {
-	SearchTreeIteratorT iter = arc_iterators_by_id_[arc_id];
-	
-	if(iter == beach_line_.begin()) {
-		return nil_idx;
-	} else {
-		--iter;
-		return iter->arc_id;
-	}
+	return expandIndex(left_arc_ids_[arc_id]);
 }
 
 template <typename PolicyT>
 Idx BeachLine<PolicyT>::getRightArc(Idx arc_id) {
-	SearchTreeIteratorT iter = arc_iterators_by_id_[arc_id];
-	++iter;
-	
-	if(iter == beach_line_.end()) {
-		return nil_idx;
-	} else {
-		return iter->arc_id;
-	}
+	return expandIndex(right_arc_ids_[arc_id]);
 }
 
 template <typename PolicyT>
 Idx BeachLine<PolicyT>::getLeftmostArc() {
-	if(beach_line_.empty()) return nil_idx;
-	return beach_line_.begin()->arc_id;
+	return leftmost_arc_id_;
 }
 
 template <typename PolicyT>
 Idx BeachLine<PolicyT>::getRightmostArc() {
-	if(beach_line_.empty()) return nil_idx;
-	SearchTreeIteratorT iter = beach_line_.end();
-	--iter;
-	return iter->arc_id;
+	return rightmost_arc_id_;
 }
 
 template <typename PolicyT>
@@ -106,6 +175,22 @@ Idx BeachLine<PolicyT>::getOriginSite(Idx arc_id) {
 	return iter->site;
 }
 
+template <typename PolicyT>
+MemoryUsage BeachLine<PolicyT>::getMemoryUsage() const {
+	return
+		beach_line_.getMemoryUsage() + free_arc_ids_.getMemoryUsage() +
+		arc_iterators_by_id_.getMemoryUsage() + left_arc_ids_.getMemoryUsage() +
+		right_arc_ids_.getMemoryUsage() + site_order_.getMemoryUsage();
+}
+
+template <typename PolicyT>
+std::size_t BeachLine<PolicyT>::estimateMemoryUsage(Idx site_count, Idx max_arcs) {
+	return
+		SearchTreeT::estimateMemoryUsage(max_arcs) +
+		max_arcs * (3 * sizeof(IndexT) + sizeof(SearchTreeIteratorT)) +
+		site_count * sizeof(IndexT);
+}
+
 template <typename PolicyT>
 Idx BeachLine<PolicyT>::insertArcTo_(SearchTreeIteratorT base_iter, Idx site) {
 	if(free_arc_ids_.empty()) {
@@ -115,11 +200,38 @@ Idx BeachLine<PolicyT>::insertArcTo_(SearchTreeIteratorT base_iter, Idx site) {
 	Idx arc_id = free_arc_ids_.top();
 	free_arc_ids_.pop();
 	
-	Arc arc = {site, arc_id};
+	// The new arc is placed between the base arc and its left neighbour.
+	Idx right_arc_id;
+	Idx left_arc_id;
+	if(base_iter == beach_line_.end()) {
+		right_arc_id = nil_idx;
+		left_arc_id = rightmost_arc_id_;
+	} else {
+		right_arc_id = base_iter->arc_id;
+		left_arc_id = expandIndex(left_arc_ids_[right_arc_id]);
+	}
+	
+	ArcT arc = {compactIndex<IndexT>(site), compactIndex<IndexT>(arc_id)};
 	SearchTreeIteratorT iter = beach_line_.insert(base_iter, arc);
 	
 	arc_iterators_by_id_[arc_id] = iter;
 	
+	// Link the arc to the neighbour list.
+	left_arc_ids_[arc_id] = compactIndex<IndexT>(left_arc_id);
+	right_arc_ids_[arc_id] = compactIndex<IndexT>(right_arc_id);
+	
+	if(left_arc_id == nil_idx) {
+		leftmost_arc_id_ = arc_id;
+	} else {
+		right_arc_ids_[left_arc_id] = compactIndex<IndexT>(arc_id);
+	}
+	
+	if(right_arc_id == nil_idx) {
+		rightmost_arc_id_ = arc_id;
+	} else {
+		left_arc_ids_[right_arc_id] = compactIndex<IndexT>(arc_id);
+	}
+	
 	return arc_id;
 }
 
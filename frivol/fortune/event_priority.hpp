@@ -0,0 +1,161 @@
+#ifndef FRIVOL_FORTUNE_EVENT_PRIORITY_HPP
+#define FRIVOL_FORTUNE_EVENT_PRIORITY_HPP
+
+#include <frivol/containers/ordered_key_traits.hpp>
+
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace frivol {
+namespace fortune {
+
+/// Priority of events in the event queue of Algorithm.
+/// @tparam CoordT The coordinate type.
+template <typename CoordT>
+struct EventPriority {
+	/// Constructs priority with undefined value.
+	EventPriority() { }
+	
+	/// Constructs priority of event.
+	/// @param x The X coordinate.
+	/// @param y The Y coordinate.
+	EventPriority(CoordT x, CoordT y) : x(x), y(y) { }
+	
+	/// In site events, the X coordinate of the site. In circle events does
+	/// not matter.
+	CoordT x;
+	
+	/// The sweepline Y coordinate at which the event happens.
+	CoordT y;
+	
+	/// Returns the sweepline Y coordinate of the event.
+	CoordT getY() const;
+	
+	/// Ordering of events, primarily by y and secondarily by x to handle
+	/// cases of sites on the same horizontal line correctly.
+	bool operator<(const EventPriority<CoordT>& other) const;
+};
+
+/// Traits class for encoding event priorities (y, x) of coordinate type CoordT
+/// as single unsigned integers that are ordered in the same way, so that
+/// comparing them takes one integer comparison. Used by
+/// EncodedEventPriority. Implemented for float (64-bit keys) and double
+/// (128-bit keys on compilers that support them). Required members are:
+///  - typedef Key, the unsigned integer key type.
+///  - Key encode(CoordT x, CoordT y) returns the key of priority (y, x).
+///  - CoordT decodeY(Key key) returns y from a key.
+///  - Idx getDifferingBitCount(Key a, Key b) as in OrderedKeyTraits.
+/// 
+/// @tparam CoordT The coordinate type.
+template <typename CoordT>
+struct EventPriorityEncoding { };
+
+/// Type trait with member constant value true if EventPriorityEncoding is
+/// implemented for CoordT.
+template <typename CoordT, typename Enable = void>
+struct IsEventPriorityEncodable : std::false_type { };
+
+template <typename CoordT>
+struct IsEventPriorityEncodable<
+	CoordT,
+	typename std::enable_if<
+		sizeof(typename EventPriorityEncoding<CoordT>::Key) != 0
+	>::type
+> : std::true_type { };
+
+/// Implementation of EventPriorityEncoding for coordinate types with
+/// OrderedKeyTraitsFloat. The key of y is placed in the upper half of the key
+/// and the key of x in the lower half.
+/// @tparam KeyT Unsigned integer type with twice the bits of the coordinate
+/// key.
+template <typename CoordT, typename KeyT>
+struct EventPriorityEncodingFloat {
+	typedef KeyT Key;
+	
+	static Key encode(CoordT x, CoordT y);
+	static CoordT decodeY(Key key);
+	static Idx getDifferingBitCount(Key a, Key b);
+	
+private:
+	typedef containers::OrderedKeyTraits<CoordT> CoordKeyTraits;
+	static constexpr Idx coord_bits_ = CoordKeyTraits::bits;
+};
+
+template <typename CoordT, typename KeyT>
+constexpr Idx EventPriorityEncodingFloat<CoordT, KeyT>::coord_bits_;
+
+template <>
+struct EventPriorityEncoding<float>
+	: EventPriorityEncodingFloat<float, std::uint64_t> { };
+
+#ifdef __SIZEOF_INT128__
+template <>
+struct EventPriorityEncoding<double>
+	: EventPriorityEncodingFloat<double, unsigned __int128> { };
+#endif
+
+/// Event priority that is stored as an integer key encoded with
+/// EventPriorityEncoding. Ordered like EventPriority, but compared with one
+/// integer comparison.
+/// @tparam CoordT The coordinate type. Must have EventPriorityEncoding.
+template <typename CoordT>
+struct EncodedEventPriority {
+	typedef EventPriorityEncoding<CoordT> Encoding;
+	typedef typename Encoding::Key Key;
+	
+	/// Constructs priority with undefined value.
+	EncodedEventPriority() { }
+	
+	/// Constructs priority of event.
+	/// @param x The X coordinate.
+	/// @param y The Y coordinate.
+	EncodedEventPriority(CoordT x, CoordT y) : key(Encoding::encode(x, y)) { }
+	
+	/// The encoded key.
+	Key key;
+	
+	/// Returns the sweepline Y coordinate of the event.
+	CoordT getY() const;
+	
+	bool operator<(const EncodedEventPriority<CoordT>& other) const;
+};
+
+}
+
+namespace containers {
+
+/// Implementation of OrderedKeyTraits for event priorities, if it is
+/// implemented for the coordinate type. The key is the pair of the keys of
+/// the Y and X coordinates.
+template <typename CoordT>
+struct OrderedKeyTraits<fortune::EventPriority<CoordT>>
+	: OrderedKeyTraitsPair<CoordT, CoordT>
+{
+	typedef OrderedKeyTraitsPair<CoordT, CoordT> PairTraits;
+	typedef typename PairTraits::Key Key;
+	
+	static Key getKey(const fortune::EventPriority<CoordT>& priority);
+};
+
+/// Implementation of OrderedKeyTraits for encoded event priorities. The key
+/// is the encoded key.
+template <typename CoordT>
+struct OrderedKeyTraits<fortune::EncodedEventPriority<CoordT>> {
+	typedef fortune::EventPriorityEncoding<CoordT> Encoding;
+	typedef typename Encoding::Key Key;
+	static constexpr Idx bits = 8 * sizeof(Key);
+	
+	static Key getKey(const fortune::EncodedEventPriority<CoordT>& priority);
+	static Idx getDifferingBitCount(Key a, Key b);
+};
+
+template <typename CoordT>
+constexpr Idx OrderedKeyTraits<fortune::EncodedEventPriority<CoordT>>::bits;
+
+}
+}
+
+#include "event_priority_impl.hpp"
+
+#endif
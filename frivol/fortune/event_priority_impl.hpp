@@ -0,0 +1,84 @@
+namespace frivol {
+namespace fortune {
+
+template <typename CoordT>
+CoordT EventPriority<CoordT>::getY() const {
+	return y;
+}
+
+template <typename CoordT>
+bool EventPriority<CoordT>::operator<(const EventPriority<CoordT>& other) const {
+	if(y == other.y) {
+		return x < other.x;
+	} else {
+		return y < other.y;
+	}
+}
+
+template <typename CoordT, typename KeyT>
+KeyT EventPriorityEncodingFloat<CoordT, KeyT>::encode(CoordT x, CoordT y) {
+	return
+		((KeyT)CoordKeyTraits::getKey(y) << coord_bits_) |
+		(KeyT)CoordKeyTraits::getKey(x);
+}
+
+template <typename CoordT, typename KeyT>
+CoordT EventPriorityEncodingFloat<CoordT, KeyT>::decodeY(KeyT key) {
+	return CoordKeyTraits::getValue((typename CoordKeyTraits::Key)(key >> coord_bits_));
+}
+
+template <typename CoordT, typename KeyT>
+Idx EventPriorityEncodingFloat<CoordT, KeyT>::getDifferingBitCount(KeyT a, KeyT b) {
+	typedef typename CoordKeyTraits::Key CoordKey;
+	
+	KeyT difference = a ^ b;
+	CoordKey high = (CoordKey)(difference >> coord_bits_);
+	if(high != 0) {
+		return coord_bits_ + containers::getBitLength<CoordKey>(high);
+	} else {
+		return containers::getBitLength<CoordKey>((CoordKey)difference);
+	}
+}
+
+template <typename CoordT>
+CoordT EncodedEventPriority<CoordT>::getY() const {
+	return Encoding::decodeY(key);
+}
+
+template <typename CoordT>
+bool EncodedEventPriority<CoordT>::operator<(
+	const EncodedEventPriority<CoordT>& other
+) const {
+	return key < other.key;
+}
+
+}
+
+namespace containers {
+
+template <typename CoordT>
+typename OrderedKeyTraits<fortune::EventPriority<CoordT>>::Key
+OrderedKeyTraits<fortune::EventPriority<CoordT>>::getKey(
+	const fortune::EventPriority<CoordT>& priority
+) {
+	return PairTraits::getKey(priority.y, priority.x);
+}
+
+template <typename CoordT>
+typename OrderedKeyTraits<fortune::EncodedEventPriority<CoordT>>::Key
+OrderedKeyTraits<fortune::EncodedEventPriority<CoordT>>::getKey(
+	const fortune::EncodedEventPriority<CoordT>& priority
+) {
+	return priority.key;
+}
+
+template <typename CoordT>
+Idx OrderedKeyTraits<fortune::EncodedEventPriority<CoordT>>::getDifferingBitCount(
+	Key a,
+	Key b
+) {
+	return Encoding::getDifferingBitCount(a, b);
+}
+
+}
+}
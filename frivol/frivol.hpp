@@ -4,20 +4,130 @@
 #include <frivol/fortune/algorithm.hpp>
 #include <frivol/voronoi_diagram.hpp>
 #include <frivol/point.hpp>
+#include <frivol/segment_list.hpp>
+#include <frivol/site_file.hpp>
+#include <frivol/site_view.hpp>
+#include <frivol/streaming_sink.hpp>
+#include <frivol/streaming_sweep.hpp>
 #include <frivol/containers/array.hpp>
 
 namespace frivol {
 
 /// Compute the Voronoi diagram of an array of points.
-/// @param sites Array of the points.
+/// @param sites View of the points. Arrays of points convert to views
+/// implicitly.
+/// @param sites_sorted If true, the sites must be ordered primarily by Y and
+/// secondarily by X coordinate, and the algorithm skips sorting them.
+/// @param allocator The allocator of the policy, through which the
+/// algorithm state and the diagram are allocated.
 /// @returns the Voronoi diagram. The face indices are equal to their
 /// corresponding input point indices.
 /// @tparam PolicyT The algorithm policy to use, instance of Policy template.
 template <typename PolicyT = DefaultPolicy>
-VoronoiDiagram<typename PolicyT::Coord> computeVoronoiDiagram(
-	const containers::Array<Point<typename PolicyT::Coord>>& sites
+typename fortune::Algorithm<PolicyT>::VoronoiDiagramT computeVoronoiDiagram(
+	const SiteView<typename PolicyT::Coord>& sites,
+	bool sites_sorted = false,
+	const typename PolicyT::Allocator& allocator = typename PolicyT::Allocator()
 );
 
+/// Compute the Voronoi diagram of an array of points, reusing the memory of
+/// an algorithm state and of an earlier output diagram. When the same
+/// workspace and diagram are used repeatedly, the calls stop allocating
+/// memory once they have been used for at least as many sites.
+/// @param sites View of the points. The viewed memory must stay valid while
+/// the workspace is used with it.
+/// @param diagram The diagram to which the result is written. Its memory is
+/// given to the workspace to be reused for the next result.
+/// @param workspace The algorithm state to reuse for the computation.
+/// @param sites_sorted If true, the sites must be ordered primarily by Y and
+/// secondarily by X coordinate, and the algorithm skips sorting them.
+/// @tparam PolicyT The algorithm policy to use, instance of Policy template.
+template <typename PolicyT>
+void computeVoronoiDiagram(
+	const SiteView<typename PolicyT::Coord>& sites,
+	typename fortune::Algorithm<PolicyT>::VoronoiDiagramT& diagram,
+	fortune::Algorithm<PolicyT>& workspace,
+	bool sites_sorted = false
+);
+
+/// Compute the edges of the Voronoi diagram of an array of points as a list
+/// of segments. Faster and smaller than computeVoronoiDiagram when the order
+/// of the edges around the faces is not needed.
+/// @param sites View of the points.
+/// @param sites_sorted If true, the sites must be ordered primarily by Y and
+/// secondarily by X coordinate, and the algorithm skips sorting them.
+/// @param allocator The allocator of the policy, through which the
+/// algorithm state and the segments are allocated.
+/// @returns the segments. The face indices are equal to their corresponding
+/// input point indices.
+/// @tparam PolicyT The algorithm policy to use, instance of Policy template.
+template <typename PolicyT = DefaultPolicy>
+SegmentList<
+	typename PolicyT::Coord,
+	typename PolicyT::Allocator,
+	typename PolicyT::Index
+> computeSegmentList(
+	const SiteView<typename PolicyT::Coord>& sites,
+	bool sites_sorted = false,
+	const typename PolicyT::Allocator& allocator = typename PolicyT::Allocator()
+);
+
+/// Compute the Voronoi diagram of an array of points without storing it,
+/// reporting the vertices, edges and closed faces to a visitor as soon as
+/// they are final (see StreamingSink).
+/// @param sites View of the points.
+/// @param visitor The visitor that receives the diagram.
+/// @param sites_sorted If true, the sites must be ordered primarily by Y and
+/// secondarily by X coordinate, and the algorithm skips sorting them.
+/// @param allocator The allocator of the policy, through which the
+/// algorithm state is allocated.
+/// @tparam PolicyT The algorithm policy to use, instance of Policy template.
+/// @tparam VisitorT The type of the visitor, see StreamingSink.
+template <typename PolicyT = DefaultPolicy, typename VisitorT>
+void streamVoronoiDiagram(
+	const SiteView<typename PolicyT::Coord>& sites,
+	VisitorT& visitor,
+	bool sites_sorted = false,
+	const typename PolicyT::Allocator& allocator = typename PolicyT::Allocator()
+);
+
+/// Compute the Voronoi diagram of a sequence of points sorted primarily by
+/// Y and secondarily by X coordinate, reading the points one at a time and
+/// reporting the diagram to a visitor (see StreamingSweep). Only the points
+/// whose faces are not finished are kept in memory, so the sequence may be
+/// read from a source larger than the memory.
+/// @param begin,end The input iterators of the sequence of points. The face
+/// IDs are the positions of the points in the sequence.
+/// @param visitor The visitor that receives the diagram.
+/// @throws std::logic_error if the points are not sorted.
+/// @tparam PolicyT The algorithm policy to use, instance of Policy template.
+/// @tparam InputIteratorT Input iterator type with Point<PolicyT::Coord>
+/// values.
+/// @tparam VisitorT The type of the visitor, see StreamingSink.
+template <typename PolicyT = DefaultPolicy, typename InputIteratorT, typename VisitorT>
+void streamSortedVoronoiDiagram(InputIteratorT begin, InputIteratorT end, VisitorT& visitor);
+
+/// Compute the Voronoi diagram of the sites in a file sorted by
+/// sortSiteFile, reporting it to a visitor like streamSortedVoronoiDiagram.
+/// @param path The path of the file of SiteRecord<PolicyT::Coord> records.
+/// The face IDs are the indices of the records.
+/// @param visitor The visitor that receives the diagram.
+/// @throws std::runtime_error if reading the file fails.
+/// @throws std::logic_error if the sites are not sorted.
+/// @tparam PolicyT The algorithm policy to use, instance of Policy template.
+/// @tparam VisitorT The type of the visitor, see StreamingSink.
+template <typename PolicyT = DefaultPolicy, typename VisitorT>
+void streamSortedSiteFile(const std::string& path, VisitorT& visitor);
+
+/// Estimates the peak memory that computeVoronoiDiagram allocates for given
+/// number of sites (see fortune::Algorithm::estimatePeakMemory).
+/// @param site_count The number of sites.
+/// @param sites_sorted The sites_sorted parameter of computeVoronoiDiagram.
+/// @returns an upper bound of the number of bytes.
+/// @tparam PolicyT The algorithm policy to use, instance of Policy template.
+template <typename PolicyT = DefaultPolicy>
+std::size_t estimatePeakMemory(Idx site_count, bool sites_sorted = false);
+
 }
 
 #include "frivol_impl.hpp"
@@ -1,12 +1,94 @@
 namespace frivol {
 
 template <typename PolicyT>
-VoronoiDiagram<typename PolicyT::Coord> computeVoronoiDiagram(
-	const containers::Array<Point<typename PolicyT::Coord>>& sites
+typename fortune::Algorithm<PolicyT>::VoronoiDiagramT computeVoronoiDiagram(
+	const SiteView<typename PolicyT::Coord>& sites,
+	bool sites_sorted,
+	const typename PolicyT::Allocator& allocator
 ) {
-	fortune::Algorithm<PolicyT> algorithm(sites);
+	fortune::Algorithm<PolicyT> algorithm(sites, sites_sorted, allocator);
 	algorithm.finish();
 	return fortune::Algorithm<PolicyT>::extractVoronoiDiagram(std::move(algorithm));
 }
 
+template <typename PolicyT>
+void computeVoronoiDiagram(
+	const SiteView<typename PolicyT::Coord>& sites,
+	typename fortune::Algorithm<PolicyT>::VoronoiDiagramT& diagram,
+	fortune::Algorithm<PolicyT>& workspace,
+	bool sites_sorted
+) {
+	workspace.reset(sites, sites_sorted);
+	workspace.finish();
+	workspace.swapVoronoiDiagram(diagram);
+}
+
+template <typename PolicyT>
+SegmentList<
+	typename PolicyT::Coord,
+	typename PolicyT::Allocator,
+	typename PolicyT::Index
+> computeSegmentList(
+	const SiteView<typename PolicyT::Coord>& sites,
+	bool sites_sorted,
+	const typename PolicyT::Allocator& allocator
+) {
+	typedef SegmentList<
+		typename PolicyT::Coord,
+		typename PolicyT::Allocator,
+		typename PolicyT::Index
+	> SegmentListT;
+	
+	fortune::Algorithm<PolicyT, SegmentListT> algorithm(sites, sites_sorted, allocator);
+	algorithm.finish();
+	return std::move(algorithm.getOutput());
+}
+
+template <typename PolicyT, typename VisitorT>
+void streamVoronoiDiagram(
+	const SiteView<typename PolicyT::Coord>& sites,
+	VisitorT& visitor,
+	bool sites_sorted,
+	const typename PolicyT::Allocator& allocator
+) {
+	typedef StreamingSink<
+		VisitorT,
+		typename PolicyT::Coord,
+		typename PolicyT::Allocator,
+		typename PolicyT::Index
+	> SinkT;
+	
+	fortune::Algorithm<PolicyT, SinkT> algorithm(allocator);
+	algorithm.getOutput().setVisitor(&visitor);
+	algorithm.reset(sites, sites_sorted);
+	algorithm.finish();
+}
+
+template <typename PolicyT, typename InputIteratorT, typename VisitorT>
+void streamSortedVoronoiDiagram(InputIteratorT begin, InputIteratorT end, VisitorT& visitor) {
+	StreamingSweep<PolicyT, VisitorT> sweep(visitor);
+	for(Idx face = 0; begin != end; ++begin, ++face) {
+		sweep.addSite(*begin, face);
+	}
+	sweep.finish();
+}
+
+template <typename PolicyT, typename VisitorT>
+void streamSortedSiteFile(const std::string& path, VisitorT& visitor) {
+	typedef typename PolicyT::Coord CoordT;
+	
+	RecordFileReader<SiteRecord<CoordT>> reader(path);
+	StreamingSweep<PolicyT, VisitorT> sweep(visitor);
+	SiteRecord<CoordT> record;
+	while(reader.read(record)) {
+		sweep.addSite(Point<CoordT>(record.x, record.y), (Idx)record.index);
+	}
+	sweep.finish();
+}
+
+template <typename PolicyT>
+std::size_t estimatePeakMemory(Idx site_count, bool sites_sorted) {
+	return fortune::Algorithm<PolicyT>::estimatePeakMemory(site_count, sites_sorted);
+}
+
 }
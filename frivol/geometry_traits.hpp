@@ -5,6 +5,9 @@
 #include <frivol/containers/search_tree_concept.hpp>
 #include <frivol/point.hpp>
 
+#include <type_traits>
+#include <utility>
+
 namespace frivol {
 
 /// Traits class that gives needed geometry operations for the algorithm.
@@ -32,6 +35,14 @@ struct GeometryTraits { };
 ///  - bool isCCW(Point<CoordT> a, Point<CoordT> b, Point<CoordT> c) returns true
 ///    if triangle 'abc' is oriented counterclockwise.
 /// 
+/// Optionally, the traits may implement
+///  - CoordT getCircleTopY(Point<CoordT> center, Point<CoordT> a) returns the Y
+///    coordinate of the top point of the circle around 'center' through 'a'.
+///    The result must be equal to getCircumcircleTopY(a, b, c) when 'center'
+///    is getCircumcenter(a, b, c).
+/// which lets the algorithm compute the circumcenter only once (see
+/// HasCircleTopY).
+/// 
 /// @tparam CoordT The coordinate type.
 template <typename CoordT>
 class GeometryTraitsImplementedConcept {
@@ -54,6 +65,37 @@ private:
 	void sameType(const T&, const T&);
 };
 
+/// Type trait for detecting whether GeometryTraits<CoordT> implements the
+/// optional getCircleTopY (see GeometryTraitsImplementedConcept). Member
+/// constant value is true if it does.
+template <typename CoordT, typename Enable = void>
+struct HasCircleTopY : std::false_type { };
+
+template <typename CoordT>
+struct HasCircleTopY<
+	CoordT,
+	typename std::enable_if<std::is_same<
+		decltype(GeometryTraits<CoordT>::getCircleTopY(
+			std::declval<Point<CoordT>>(), std::declval<Point<CoordT>>()
+		)),
+		CoordT
+	>::value>::type
+> : std::true_type { };
+
+/// Returns the Y coordinate of the top point of the circumscribed circle
+/// around triangle 'abc' with GeometryTraits<CoordT>, when its center has
+/// already been computed with getCircumcenter. Uses the optional
+/// getCircleTopY of the traits if it is implemented, and
+/// getCircumcircleTopY otherwise.
+/// @param center The circumcenter of triangle 'abc'.
+template <typename CoordT>
+CoordT getCircleTopY(
+	const Point<CoordT>& center,
+	const Point<CoordT>& a,
+	const Point<CoordT>& b,
+	const Point<CoordT>& c
+);
+
 // Implementations of GeometryTraits for basic types.
 
 /// Implementation of GeometryTraits for floating point coordinate types
@@ -84,6 +126,11 @@ struct GeometryTraitsFloat {
 		const PointT& c
 	);
 	
+	static CoordT getCircleTopY(
+		const PointT& center,
+		const PointT& a
+	);
+	
 	static bool isCCW(
 		const PointT& a,
 		const PointT& b,
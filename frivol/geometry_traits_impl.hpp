@@ -3,6 +3,38 @@
 
 namespace frivol {
 
+template <typename CoordT>
+CoordT getCircleTopY(
+	const Point<CoordT>& center,
+	const Point<CoordT>& a,
+	const Point<CoordT>&,
+	const Point<CoordT>&,
+	std::true_type
+) {
+	return GeometryTraits<CoordT>::getCircleTopY(center, a);
+}
+
+template <typename CoordT>
+CoordT getCircleTopY(
+	const Point<CoordT>&,
+	const Point<CoordT>& a,
+	const Point<CoordT>& b,
+	const Point<CoordT>& c,
+	std::false_type
+) {
+	return GeometryTraits<CoordT>::getCircumcircleTopY(a, b, c);
+}
+
+template <typename CoordT>
+CoordT getCircleTopY(
+	const Point<CoordT>& center,
+	const Point<CoordT>& a,
+	const Point<CoordT>& b,
+	const Point<CoordT>& c
+) {
+	return getCircleTopY(center, a, b, c, HasCircleTopY<CoordT>());
+}
+
 template <typename CoordT>
 CoordT GeometryTraitsFloat<CoordT>::getBreakpointX(
 	const PointT& a,
@@ -97,8 +129,14 @@ CoordT GeometryTraitsFloat<CoordT>::getCircumcircleTopY(
 	const PointT& b,
 	const PointT& c
 ) {
-	PointT center = getCircumcenter(a, b, c);
-	
+	return getCircleTopY(getCircumcenter(a, b, c), a);
+}
+
+template <typename CoordT>
+CoordT GeometryTraitsFloat<CoordT>::getCircleTopY(
+	const PointT& center,
+	const PointT& a
+) {
 	CoordT dx = center.x - a.x;
 	CoordT dy = center.y - a.y;
 	CoordT ret = center.y + std::sqrt(dx * dx + dy * dy);
@@ -0,0 +1,137 @@
+#ifndef FRIVOL_MAPPED_VORONOI_DIAGRAM_HPP
+#define FRIVOL_MAPPED_VORONOI_DIAGRAM_HPP
+
+#include <frivol/common.hpp>
+#include <frivol/point.hpp>
+#include <frivol/voronoi_diagram_file.hpp>
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+namespace frivol {
+
+/// Read-only Voronoi diagram in a file written by writeVoronoiDiagram,
+/// mapped to memory instead of read, so that opening even a large diagram
+/// takes constant time and the pages are loaded by the operating system on
+/// first access and shared between the processes that map the same file.
+/// The accessors are the same as in VoronoiDiagram, except that the vertex
+/// positions are returned by value, as they are stored little-endian.
+///
+/// Only the header is validated when the file is opened, so the rest of the
+/// file must be written by writeVoronoiDiagram and not modified while it is
+/// mapped. Requires a POSIX system with mmap.
+/// @tparam CoordT The coordinate type of the diagram written to the file.
+/// @tparam IndexT The IndexT of the diagram written to the file.
+template <typename CoordT = double, typename IndexT = Idx>
+class MappedVoronoiDiagram {
+public:
+	typedef Point<CoordT> PointT;
+	
+	/// Constructs an empty diagram with no file mapped.
+	MappedVoronoiDiagram();
+	
+	/// Maps a diagram file to memory.
+	/// @param path The path of the file.
+	/// @throws std::runtime_error if the file cannot be mapped or is not a
+	/// diagram file of this version with the CoordT and IndexT types.
+	MappedVoronoiDiagram(const std::string& path);
+	
+	/// Moves the mapping of another diagram to this diagram.
+	/// @param other The diagram to move from. It is left empty.
+	MappedVoronoiDiagram(MappedVoronoiDiagram<CoordT, IndexT>&& other);
+	
+	MappedVoronoiDiagram(const MappedVoronoiDiagram<CoordT, IndexT>&) = delete;
+	MappedVoronoiDiagram<CoordT, IndexT>& operator=(const MappedVoronoiDiagram<CoordT, IndexT>&) = delete;
+	
+	/// Unmaps the file.
+	~MappedVoronoiDiagram();
+	
+	/// Unmaps the current file, if any, and maps a diagram file to memory.
+	/// @param path The path of the file.
+	/// @throws std::runtime_error if the file cannot be mapped or is not a
+	/// diagram file of this version with the CoordT and IndexT types. The
+	/// diagram is left empty in that case.
+	void open(const std::string& path);
+	
+	/// Unmaps the file, leaving the diagram empty.
+	void close();
+	
+	/// Returns the number of bytes mapped.
+	std::size_t getMappedSize() const;
+	
+	/// Returns the number of faces in the diagram.
+	Idx getFaceCount() const;
+	
+	/// Returns the number of half-edges in the diagram.
+	Idx getEdgeCount() const;
+	
+	/// Returns the number of Voronoi vertices in the diagram.
+	Idx getVertexCount() const;
+	
+	/// Returns the ID of a half-edge that is on the boundary of given face,
+	/// or nil_idx if there is only one face.
+	/// @param face ID of the face that the half-edge should be incident to.
+	Idx getFaceBoundaryEdge(Idx face) const;
+	
+	/// Returns the ID of the twin half-edge of given half-edge.
+	/// @param edge ID of the half-edge.
+	Idx getTwinEdge(Idx edge) const;
+	
+	/// Returns the ID of the incident face of given half-edge.
+	/// @param edge ID of the half-edge.
+	Idx getIncidentFace(Idx edge) const;
+	
+	/// Returns the ID of the Voronoi vertex in the start of given half-edge,
+	/// or nil_idx if the half-edge starts in infinity.
+	/// @param edge ID of the half-edge.
+	Idx getStartVertex(Idx edge) const;
+	
+	/// Returns the ID of the Voronoi vertex in the end of given half-edge,
+	/// or nil_idx if the half-edge ends in infinity.
+	/// @param edge ID of the half-edge.
+	Idx getEndVertex(Idx edge) const;
+	
+	/// Returns the ID of the next half-edge around the incident face.
+	/// @param edge ID of the half-edge.
+	Idx getNextEdge(Idx edge) const;
+	
+	/// Returns the ID of the previous half-edge around the incident face.
+	/// @param edge ID of the half-edge.
+	Idx getPreviousEdge(Idx edge) const;
+	
+	/// Returns the position of a Voronoi vertex.
+	/// @param vertex ID of the Voronoi vertex.
+	PointT getVertexPosition(Idx vertex) const;
+	
+private:
+	/// Reads an ID stored in the file.
+	/// @param bytes The position of the ID in the mapped file.
+	static Idx loadIndex_(const unsigned char* bytes);
+	
+	/// Reads a field of a half-edge.
+	/// @param edge ID of the half-edge.
+	/// @param field The index of the field in the order of the file format.
+	Idx loadEdgeField_(Idx edge, Idx field) const;
+	
+	/// The start of the mapped file, or nullptr if no file is mapped.
+	const unsigned char* data_;
+	
+	/// The number of bytes mapped.
+	std::size_t size_;
+	
+	/// The header of the mapped file.
+	VoronoiDiagramFileHeader header_;
+	
+	/// The starts of the half-edges, the vertex positions and the face
+	/// boundary edges in the mapped file.
+	const unsigned char* edges_;
+	const unsigned char* vertices_;
+	const unsigned char* faces_;
+};
+
+}
+
+#include "mapped_voronoi_diagram_impl.hpp"
+
+#endif
@@ -0,0 +1,171 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace frivol {
+
+template <typename CoordT, typename IndexT>
+MappedVoronoiDiagram<CoordT, IndexT>::MappedVoronoiDiagram()
+	: data_(nullptr),
+	  size_(0),
+	  header_(VoronoiDiagramFileHeader::create<CoordT, IndexT>(0, 0, 0)),
+	  edges_(nullptr),
+	  vertices_(nullptr),
+	  faces_(nullptr)
+{ }
+
+template <typename CoordT, typename IndexT>
+MappedVoronoiDiagram<CoordT, IndexT>::MappedVoronoiDiagram(const std::string& path)
+	: MappedVoronoiDiagram()
+{
+	open(path);
+}
+
+template <typename CoordT, typename IndexT>
+MappedVoronoiDiagram<CoordT, IndexT>::MappedVoronoiDiagram(
+	MappedVoronoiDiagram<CoordT, IndexT>&& other
+)
+	: data_(other.data_),
+	  size_(other.size_),
+	  header_(other.header_),
+	  edges_(other.edges_),
+	  vertices_(other.vertices_),
+	  faces_(other.faces_)
+{
+	other.data_ = nullptr;
+	other.close();
+}
+
+template <typename CoordT, typename IndexT>
+MappedVoronoiDiagram<CoordT, IndexT>::~MappedVoronoiDiagram() {
+	close();
+}
+
+template <typename CoordT, typename IndexT>
+void MappedVoronoiDiagram<CoordT, IndexT>::open(const std::string& path) {
+	close();
+	
+	int fd = ::open(path.c_str(), O_RDONLY);
+	if(fd < 0) {
+		throw std::runtime_error("MappedVoronoiDiagram::open: cannot open " + path + ".");
+	}
+	struct stat file_stat;
+	if(::fstat(fd, &file_stat) != 0 || file_stat.st_size < (off_t)VoronoiDiagramFileHeader::size) {
+		::close(fd);
+		throw std::runtime_error("MappedVoronoiDiagram::open: " + path + " is not a Voronoi diagram file.");
+	}
+	
+	// The mapping stays valid after the descriptor is closed.
+	std::size_t size = (std::size_t)file_stat.st_size;
+	void* data = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+	::close(fd);
+	if(data == MAP_FAILED) {
+		throw std::runtime_error("MappedVoronoiDiagram::open: cannot map " + path + ".");
+	}
+	
+	const unsigned char* bytes = static_cast<const unsigned char*>(data);
+	try {
+		header_ = VoronoiDiagramFileHeader::decode<CoordT, IndexT>(bytes, size);
+	} catch(...) {
+		::munmap(data, size);
+		header_ = VoronoiDiagramFileHeader::create<CoordT, IndexT>(0, 0, 0);
+		throw;
+	}
+	
+	data_ = bytes;
+	size_ = size;
+	edges_ = bytes + header_.edges_offset;
+	vertices_ = bytes + header_.vertices_offset;
+	faces_ = bytes + header_.faces_offset;
+}
+
+template <typename CoordT, typename IndexT>
+void MappedVoronoiDiagram<CoordT, IndexT>::close() {
+	if(data_ != nullptr) {
+		::munmap(const_cast<unsigned char*>(data_), size_);
+	}
+	data_ = nullptr;
+	size_ = 0;
+	header_ = VoronoiDiagramFileHeader::create<CoordT, IndexT>(0, 0, 0);
+	edges_ = nullptr;
+	vertices_ = nullptr;
+	faces_ = nullptr;
+}
+
+template <typename CoordT, typename IndexT>
+std::size_t MappedVoronoiDiagram<CoordT, IndexT>::getMappedSize() const {
+	return size_;
+}
+
+template <typename CoordT, typename IndexT>
+Idx MappedVoronoiDiagram<CoordT, IndexT>::getFaceCount() const {
+	return (Idx)header_.face_count;
+}
+
+template <typename CoordT, typename IndexT>
+Idx MappedVoronoiDiagram<CoordT, IndexT>::getEdgeCount() const {
+	return (Idx)header_.edge_count;
+}
+
+template <typename CoordT, typename IndexT>
+Idx MappedVoronoiDiagram<CoordT, IndexT>::getVertexCount() const {
+	return (Idx)header_.vertex_count;
+}
+
+template <typename CoordT, typename IndexT>
+Idx MappedVoronoiDiagram<CoordT, IndexT>::getFaceBoundaryEdge(Idx face) const {
+	return loadIndex_(faces_ + face * sizeof(IndexT));
+}
+
+template <typename CoordT, typename IndexT>
+Idx MappedVoronoiDiagram<CoordT, IndexT>::getTwinEdge(Idx edge) const {
+	return edge ^ 1;
+}
+
+template <typename CoordT, typename IndexT>
+Idx MappedVoronoiDiagram<CoordT, IndexT>::getIncidentFace(Idx edge) const {
+	return loadEdgeField_(edge, 1);
+}
+
+template <typename CoordT, typename IndexT>
+Idx MappedVoronoiDiagram<CoordT, IndexT>::getStartVertex(Idx edge) const {
+	return loadEdgeField_(getTwinEdge(edge), 0);
+}
+
+template <typename CoordT, typename IndexT>
+Idx MappedVoronoiDiagram<CoordT, IndexT>::getEndVertex(Idx edge) const {
+	return loadEdgeField_(edge, 0);
+}
+
+template <typename CoordT, typename IndexT>
+Idx MappedVoronoiDiagram<CoordT, IndexT>::getNextEdge(Idx edge) const {
+	return loadEdgeField_(edge, 2);
+}
+
+template <typename CoordT, typename IndexT>
+Idx MappedVoronoiDiagram<CoordT, IndexT>::getPreviousEdge(Idx edge) const {
+	return loadEdgeField_(edge, 3);
+}
+
+template <typename CoordT, typename IndexT>
+typename MappedVoronoiDiagram<CoordT, IndexT>::PointT
+MappedVoronoiDiagram<CoordT, IndexT>::getVertexPosition(Idx vertex) const {
+	const unsigned char* pos = vertices_ + vertex * 2 * sizeof(CoordT);
+	return PointT(
+		loadLittleEndian<CoordT>(pos),
+		loadLittleEndian<CoordT>(pos + sizeof(CoordT))
+	);
+}
+
+template <typename CoordT, typename IndexT>
+Idx MappedVoronoiDiagram<CoordT, IndexT>::loadIndex_(const unsigned char* bytes) {
+	return expandIndex(loadLittleEndian<IndexT>(bytes));
+}
+
+template <typename CoordT, typename IndexT>
+Idx MappedVoronoiDiagram<CoordT, IndexT>::loadEdgeField_(Idx edge, Idx field) const {
+	return loadIndex_(edges_ + (4 * edge + field) * sizeof(IndexT));
+}
+
+}
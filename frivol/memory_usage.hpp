@@ -0,0 +1,44 @@
+#ifndef FRIVOL_MEMORY_USAGE_HPP
+#define FRIVOL_MEMORY_USAGE_HPP
+
+#include <cstddef>
+
+namespace frivol {
+
+/// Memory footprint of a data structure in bytes, as returned by the
+/// getMemoryUsage member functions. Only the memory allocated by the data
+/// structure is counted, not the size of the object itself or the bookkeeping
+/// of the allocator.
+struct MemoryUsage {
+	/// Constructs zero memory usage.
+	MemoryUsage() : reserved(0), used(0) { }
+	
+	/// Constructs memory usage with given byte counts.
+	/// @param reserved The number of bytes allocated.
+	/// @param used The number of allocated bytes in use.
+	MemoryUsage(std::size_t reserved, std::size_t used)
+		: reserved(reserved), used(used) { }
+	
+	/// Adds the byte counts of another memory usage to this one.
+	MemoryUsage& operator+=(const MemoryUsage& other) {
+		reserved += other.reserved;
+		used += other.used;
+		return *this;
+	}
+	
+	/// The number of bytes allocated.
+	std::size_t reserved;
+	
+	/// The number of allocated bytes that store elements currently in use.
+	/// The rest of the reserved bytes are kept for growth or reuse.
+	std::size_t used;
+};
+
+inline MemoryUsage operator+(MemoryUsage a, const MemoryUsage& b) {
+	a += b;
+	return a;
+}
+
+}
+
+#endif
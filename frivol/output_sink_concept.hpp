@@ -0,0 +1,91 @@
+#ifndef FRIVOL_OUTPUT_SINK_CONCEPT_HPP
+#define FRIVOL_OUTPUT_SINK_CONCEPT_HPP
+
+#include <frivol/common.hpp>
+#include <frivol/memory_usage.hpp>
+#include <frivol/point.hpp>
+#include <boost/concept_check.hpp>
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace frivol {
+
+/// Concept checking class for the output sinks X of fortune::Algorithm with
+/// coordinate type CoordT and allocator type AllocatorT. The algorithm reports the edges and the vertices
+/// of the Voronoi diagram to the sink as it finds them, and the sink decides
+/// what to store. VoronoiDiagram is the default sink that stores the whole
+/// diagram. X must support the following operations:
+///  - <construct>(Idx faces) creates sink for a diagram with given number of
+///    faces. The sink must be move constructible.
+///  - void reset(Idx faces) starts a new diagram with given number of faces,
+///    keeping the allocated memory for reuse.
+///  - void reserve(Idx edges, Idx vertices) is given upper bounds of the
+///    numbers of edges and vertices of the diagram before they are added.
+///  - std::pair<Idx, Idx> addEdge(Idx face1, Idx face2) adds an edge between
+///    two faces and returns the IDs of its two half-edges, the first one
+///    having face1 and the second one face2 as incident face.
+///  - Idx addVertex(const Point<CoordT>& pos, Idx edge1, Idx edge2, Idx edge3)
+///    adds a Voronoi vertex as the end vertex of three half-edges and
+///    returns its ID. The vertex IDs are 0, 1, 2, ... in the order of the
+///    calls.
+///  - void consecutiveEdges(Idx edge1, Idx edge2) tells that edge2 is next
+///    from edge1 around their face. The algorithm calls this only for the
+///    pairs of infinite half-edges, after all vertices have been added, so
+///    that each unfinished half-edge is edge1 exactly once.
+///  - Idx getTwinEdge(Idx edge) const returns the other half-edge of the
+///    same edge.
+///  - Idx getVertexCount() const returns the number of vertices added.
+///  - MemoryUsage getMemoryUsage() const returns the memory allocated by the
+///    sink.
+///  - static std::size_t estimateMemoryUsage(Idx faces, Idx edges,
+///    Idx vertices) returns an upper bound of the number of bytes allocated
+///    by a new sink for a diagram of given size, excluding the bookkeeping
+///    of the allocator.
+///
+/// The half-edge IDs returned by addEdge are only used by the algorithm until
+/// both ends of the edge are known, so the sink may reuse them after that.
+///
+/// Optionally, X may be constructible as X(faces, allocator) from an
+/// allocator of type AllocatorT, as VoronoiDiagram, SegmentList and
+/// StreamingSink are. Then the algorithm passes its allocator to the sink
+/// instead of using <construct>(Idx faces).
+template <typename X, typename CoordT, typename AllocatorT = std::allocator<char>>
+class OutputSinkConcept {
+public:
+	BOOST_CONCEPT_USAGE(OutputSinkConcept) {
+		X x(construct_(std::is_constructible<X, Idx, const AllocatorT&>()));
+		x.reset(index);
+		x.reserve(index, index);
+		sameType(x.addEdge(index, index), std::pair<Idx, Idx>(index, index));
+		sameType(x.addVertex(pos, index, index, index), Idx());
+		x.consecutiveEdges(index, index);
+		const X& const_x = x;
+		sameType(const_x.getTwinEdge(index), Idx());
+		sameType(const_x.getVertexCount(), Idx());
+		sameType(const_x.getMemoryUsage(), MemoryUsage());
+		sameType(X::estimateMemoryUsage(index, index, index), std::size_t());
+	}
+	
+private:
+	Idx index;
+	Point<CoordT> pos;
+	AllocatorT allocator;
+	
+	X construct_(std::true_type) {
+		return X(index, allocator);
+	}
+	X construct_(std::false_type) {
+		return X(index);
+	}
+	
+	/// Function that causes compile time error if called with parameters of
+	/// different types.
+	template <typename T>
+	void sameType(const T&, const T&);
+};
+
+}
+
+#endif
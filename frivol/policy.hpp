@@ -5,10 +5,21 @@
 #include <frivol/containers/search_tree_concept.hpp>
 
 #include <frivol/containers/priority_queues/binary_heap.hpp>
+#include <frivol/containers/priority_queues/calendar_queue.hpp>
+#include <frivol/containers/priority_queues/d_ary_heap.hpp>
+#include <frivol/containers/priority_queues/lazy_heap.hpp>
+#include <frivol/containers/priority_queues/radix_heap.hpp>
 #include <frivol/containers/search_trees/avl_tree.hpp>
+#include <frivol/containers/search_trees/btree.hpp>
+#include <frivol/containers/search_trees/compact_avl_tree.hpp>
+#include <frivol/containers/search_trees/flat_search_tree.hpp>
 
+#include <frivol/fortune/event_priority.hpp>
 #include <frivol/geometry_traits.hpp>
 
+#include <cstdint>
+#include <type_traits>
+
 namespace frivol {
 
 /// Policy class for the Fortune's algorithm, specifying data types and data
@@ -17,36 +28,105 @@ namespace frivol {
 /// constructible to undefined value. Should have specialization of
 /// GeometryTraits.
 /// @tparam EventQueueT The priority queue type for events. Must conform to
-/// PriorityQueueConcept.
+/// PriorityQueueConcept. The alternatives included here are BinaryHeap,
+/// DAryHeap, which stores the priorities inline in the heap, LazyHeap, which
+/// invalidates the events lazily, the monotone RadixHeap, which requires
+/// OrderedKeyTraits for the coordinate type, and CalendarQueue, which
+/// performs on par with the heaps for uniform and clustered sites but is
+/// slower for sites with skewed Y coordinates, up to twice as slow for
+/// small inputs (see perftest).
 /// @tparam BeachLineT The search tree to use for the "beach line" of arcs.
-/// Must conform to SearchTreeConcept.
+/// Must conform to SearchTreeConcept. The alternatives included here are
+/// the AVL trees (AVLTree, PooledAVLTree), CompactAVLTree, which stores the
+/// AVL nodes in an array linked with 32-bit indices, the high-fanout BTree
+/// and the sorted array FlatSearchTree, which is competitive for small
+/// inputs.
+/// @tparam EncodeEventPrioritiesT If true, the event priorities are
+/// fortune::EncodedEventPriority integer keys instead of pairs of
+/// coordinates compared with operator<. Requires
+/// fortune::EventPriorityEncoding for the coordinate type. By default true
+/// if the encoding is implemented.
+/// @tparam AllocatorT The allocator through which all memory of the algorithm
+/// and its output diagram is allocated, of any value type. The containers
+/// rebind and keep copies of the instance given to fortune::Algorithm, so
+/// the allocator may be stateful, such as an arena. The priority queue and
+/// search tree templates are instantiated with it as their second template
+/// parameter and constructed with the instance.
+/// @tparam IndexT The unsigned integer type in which the algorithm and the
+/// output VoronoiDiagram store site, arc, edge and vertex indices. Using
+/// std::uint32_t instead of the default Idx halves the size of the
+/// half-edges, the beach line neighbour links and the index arrays of the
+/// event queue and FlatSearchTree, but limits the number of sites to about
+/// nilIndex<IndexT>() / 6. The priority queue and search tree templates are
+/// instantiated with it as their third template parameter.
 template <
 	typename CoordT,
-	template <typename PriorityT> class EventPriorityQueueT,
-	template <typename ElementT> class BeachLineSearchTreeT
+	template <typename PriorityT, typename AllocatorT, typename IndexT> class EventPriorityQueueT,
+	template <typename ElementT, typename AllocatorT, typename IndexT> class BeachLineSearchTreeT,
+	bool EncodeEventPrioritiesT = fortune::IsEventPriorityEncodable<CoordT>::value,
+	typename AllocatorT = containers::DefaultAllocator,
+	typename IndexT = Idx
 >
 struct Policy {
 	BOOST_CONCEPT_ASSERT((boost::DefaultConstructible<CoordT>));
 	BOOST_CONCEPT_ASSERT((boost::LessThanComparable<CoordT>));
 	BOOST_CONCEPT_ASSERT((GeometryTraitsImplementedConcept<CoordT>));
+	static_assert(
+		!EncodeEventPrioritiesT || fortune::IsEventPriorityEncodable<CoordT>::value,
+		"Policy: EventPriorityEncoding is not implemented for the coordinate type."
+	);
+	static_assert(
+		std::is_integral<IndexT>::value && std::is_unsigned<IndexT>::value &&
+			sizeof(IndexT) <= sizeof(Idx),
+		"Policy: IndexT must be an unsigned integer type no larger than Idx."
+	);
 	
 	typedef CoordT Coord;
+	typedef AllocatorT Allocator;
+	typedef IndexT Index;
+	
+	static constexpr bool encode_event_priorities = EncodeEventPrioritiesT;
 	
 	template <typename PriorityT>
-	using EventPriorityQueue = EventPriorityQueueT<PriorityT>;
+	using EventPriorityQueue = EventPriorityQueueT<PriorityT, AllocatorT, IndexT>;
 	
 	template <typename ElementT>
-	using BeachLineSearchTree = BeachLineSearchTreeT<ElementT>;
+	using BeachLineSearchTree = BeachLineSearchTreeT<ElementT, AllocatorT, IndexT>;
 };
 
-/// The default policy using double as coordinate type and the (currently) best
-/// data structures.
+template <
+	typename CoordT,
+	template <typename PriorityT, typename AllocatorT, typename IndexT> class EventPriorityQueueT,
+	template <typename ElementT, typename AllocatorT, typename IndexT> class BeachLineSearchTreeT,
+	bool EncodeEventPrioritiesT,
+	typename AllocatorT,
+	typename IndexT
+>
+constexpr bool Policy<
+	CoordT, EventPriorityQueueT, BeachLineSearchTreeT, EncodeEventPrioritiesT, AllocatorT, IndexT
+>::encode_event_priorities;
+
+/// The default policy using double as coordinate type, BinaryHeap and
+/// PooledAVLTree. These are kept as the default for stability, although
+/// DAryHeap and BTree have measured faster for uniformly distributed sites
+/// from about 20000 sites up (see perftest).
 typedef Policy<
 	double,
 	containers::priority_queues::BinaryHeap,
-	containers::search_trees::AVLTree
+	containers::search_trees::PooledAVLTree
 > DefaultPolicy;
 
+/// DefaultPolicy that stores the indices as 32-bit integers, for inputs of
+/// less than about 700 million sites.
+typedef Policy<
+	double,
+	containers::priority_queues::BinaryHeap,
+	containers::search_trees::PooledAVLTree,
+	fortune::IsEventPriorityEncodable<double>::value,
+	containers::DefaultAllocator,
+	std::uint32_t
+> CompactIndexPolicy;
+
 }
 
 #endif
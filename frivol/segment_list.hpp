@@ -0,0 +1,164 @@
+#ifndef FRIVOL_SEGMENT_LIST_HPP
+#define FRIVOL_SEGMENT_LIST_HPP
+
+#include <frivol/containers/allocator.hpp>
+#include <frivol/containers/dynamic_array.hpp>
+#include <frivol/memory_usage.hpp>
+#include <frivol/point.hpp>
+
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace frivol {
+
+/// Output sink of fortune::Algorithm (see OutputSinkConcept) that stores the
+/// edges of the Voronoi diagram as a flat list of segments, without the
+/// linkage of the half-edges around the faces that VoronoiDiagram maintains.
+/// Each segment stores the two faces it separates and its two end vertices,
+/// which is enough for drawing the diagram or testing against its edges.
+///
+/// The segments are numbered 0...count-1 in the order they are found, and
+/// the vertices like in VoronoiDiagram.
+/// @tparam CoordT Coordinate type of the vertices.
+/// @tparam AllocatorT The allocator used for the arrays (see
+/// containers::Array).
+/// @tparam IndexT The unsigned integer type in which the face and vertex IDs
+/// are stored (see VoronoiDiagram).
+template <
+	typename CoordT = double,
+	typename AllocatorT = containers::DefaultAllocator,
+	typename IndexT = Idx
+>
+class SegmentList {
+public:
+	typedef Point<CoordT> PointT;
+	
+	static_assert(
+		std::is_integral<IndexT>::value && std::is_unsigned<IndexT>::value &&
+			sizeof(IndexT) <= sizeof(Idx),
+		"SegmentList: IndexT must be an unsigned integer type no larger than Idx."
+	);
+	
+	/// Constructs empty segment list.
+	/// @param faces Number of faces.
+	/// @param allocator The allocator used for the arrays.
+	/// @throws std::logic_error if the face IDs do not fit in IndexT.
+	SegmentList(Idx faces = 0, const AllocatorT& allocator = AllocatorT());
+	
+	/// Removes all segments and vertices and sets the number of faces,
+	/// keeping the allocated memory for reuse.
+	/// @param faces Number of faces.
+	/// @throws std::logic_error if the face IDs do not fit in IndexT.
+	void reset(Idx faces);
+	
+	/// Reserves memory so that segments and vertices can be added without
+	/// reallocating the storage.
+	/// @param edges The number of segments.
+	/// @param vertices The number of Voronoi vertices.
+	void reserve(Idx edges, Idx vertices);
+	
+	/// Releases the memory reserved for segments and vertices that have not
+	/// been added.
+	void shrinkToFit();
+	
+	/// Returns the memory allocated for the segments and the vertices.
+	MemoryUsage getMemoryUsage() const;
+	
+	/// Returns the number of bytes allocated by a segment list that has been
+	/// reserved for given numbers of segments and vertices.
+	/// @param faces The number of faces.
+	/// @param edges The number of segments.
+	/// @param vertices The number of Voronoi vertices.
+	static std::size_t estimateMemoryUsage(Idx faces, Idx edges, Idx vertices);
+	
+	/// Returns the number of faces.
+	Idx getFaceCount() const;
+	
+	/// Returns the number of segments.
+	Idx getSegmentCount() const;
+	
+	/// Returns the number of Voronoi vertices.
+	Idx getVertexCount() const;
+	
+	/// Returns the face on the left of a segment, when going from the start
+	/// vertex to the end vertex.
+	/// @param segment The index of the segment.
+	Idx getLeftFace(Idx segment) const;
+	
+	/// Returns the face on the right of a segment, when going from the start
+	/// vertex to the end vertex.
+	/// @param segment The index of the segment.
+	Idx getRightFace(Idx segment) const;
+	
+	/// Returns the start vertex of a segment, or nil_idx if the segment is
+	/// infinite in that direction.
+	/// @param segment The index of the segment.
+	Idx getStartVertex(Idx segment) const;
+	
+	/// Returns the end vertex of a segment, or nil_idx if the segment is
+	/// infinite in that direction.
+	/// @param segment The index of the segment.
+	Idx getEndVertex(Idx segment) const;
+	
+	/// Returns the position of a Voronoi vertex.
+	/// @param vertex ID of the Voronoi vertex.
+	const PointT& getVertexPosition(Idx vertex) const;
+	
+	/// Returns the ID of the twin half-edge of given half-edge. The
+	/// half-edges of segment i, used while the list is constructed, are 2i
+	/// and 2i+1, the first one going from the start to the end vertex.
+	/// @param edge ID of the half-edge.
+	Idx getTwinEdge(Idx edge) const;
+	
+	/// Adds a new segment between two faces, with unknown end vertices.
+	/// @param face1 The face on the left of the segment.
+	/// @param face2 The face on the right of the segment.
+	/// @returns the IDs of the two half-edges of the segment, the first one
+	/// having face1 and the second one face2 as incident face.
+	/// @throws std::logic_error if the half-edge IDs would not fit in IndexT.
+	std::pair<Idx, Idx> addEdge(Idx face1, Idx face2);
+	
+	/// Adds a new Voronoi vertex.
+	/// @param pos Position of the vertex.
+	/// @param edge1,edge2,edge3 The half-edges having the new vertex as end
+	/// vertex.
+	/// @returns the ID of the new vertex.
+	/// @throws std::logic_error if the vertex ID would not fit in IndexT.
+	Idx addVertex(const PointT& pos, Idx edge1, Idx edge2, Idx edge3);
+	
+	/// Does nothing, as the order of the edges around the faces is not
+	/// stored.
+	void consecutiveEdges(Idx edge1, Idx edge2);
+	
+private:
+	/// Data stored for each segment.
+	struct Segment {
+		/// The faces on the left and on the right.
+		IndexT face[2];
+		
+		/// The start and end vertices, nilIndex<IndexT>() for infinite or
+		/// not yet known ends.
+		IndexT vertex[2];
+	};
+	
+	/// Sets the end vertex of a half-edge.
+	/// @param edge The ID of the half-edge.
+	/// @param vertex The ID of the vertex.
+	void setEndVertex_(Idx edge, Idx vertex);
+	
+	/// The number of faces.
+	Idx face_count_;
+	
+	/// The segments by index.
+	containers::DynamicArray<Segment, AllocatorT> segments_;
+	
+	/// The positions of the Voronoi vertices.
+	containers::DynamicArray<PointT, AllocatorT> vertex_pos_;
+};
+
+}
+
+#include "segment_list_impl.hpp"
+
+#endif
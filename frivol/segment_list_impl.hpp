@@ -0,0 +1,134 @@
+namespace frivol {
+
+template <typename CoordT, typename AllocatorT, typename IndexT>
+SegmentList<CoordT, AllocatorT, IndexT>::SegmentList(Idx faces, const AllocatorT& allocator)
+	: segments_(allocator),
+	  vertex_pos_(allocator)
+{
+	reset(faces);
+}
+
+template <typename CoordT, typename AllocatorT, typename IndexT>
+void SegmentList<CoordT, AllocatorT, IndexT>::reset(Idx faces) {
+	if(faces > (Idx)nilIndex<IndexT>()) {
+		throw std::logic_error("SegmentList::reset: too many faces for the index type.");
+	}
+	
+	face_count_ = faces;
+	segments_.clear();
+	vertex_pos_.clear();
+}
+
+template <typename CoordT, typename AllocatorT, typename IndexT>
+void SegmentList<CoordT, AllocatorT, IndexT>::reserve(Idx edges, Idx vertices) {
+	segments_.reserve(edges);
+	vertex_pos_.reserve(vertices);
+}
+
+template <typename CoordT, typename AllocatorT, typename IndexT>
+void SegmentList<CoordT, AllocatorT, IndexT>::shrinkToFit() {
+	segments_.shrinkToFit();
+	vertex_pos_.shrinkToFit();
+}
+
+template <typename CoordT, typename AllocatorT, typename IndexT>
+MemoryUsage SegmentList<CoordT, AllocatorT, IndexT>::getMemoryUsage() const {
+	return segments_.getMemoryUsage() + vertex_pos_.getMemoryUsage();
+}
+
+template <typename CoordT, typename AllocatorT, typename IndexT>
+std::size_t SegmentList<CoordT, AllocatorT, IndexT>::estimateMemoryUsage(Idx, Idx edges, Idx vertices) {
+	return edges * sizeof(Segment) + vertices * sizeof(PointT);
+}
+
+template <typename CoordT, typename AllocatorT, typename IndexT>
+Idx SegmentList<CoordT, AllocatorT, IndexT>::getFaceCount() const {
+	return face_count_;
+}
+
+template <typename CoordT, typename AllocatorT, typename IndexT>
+Idx SegmentList<CoordT, AllocatorT, IndexT>::getSegmentCount() const {
+	return segments_.getSize();
+}
+
+template <typename CoordT, typename AllocatorT, typename IndexT>
+Idx SegmentList<CoordT, AllocatorT, IndexT>::getVertexCount() const {
+	return vertex_pos_.getSize();
+}
+
+template <typename CoordT, typename AllocatorT, typename IndexT>
+Idx SegmentList<CoordT, AllocatorT, IndexT>::getLeftFace(Idx segment) const {
+	return expandIndex(segments_[segment].face[0]);
+}
+
+template <typename CoordT, typename AllocatorT, typename IndexT>
+Idx SegmentList<CoordT, AllocatorT, IndexT>::getRightFace(Idx segment) const {
+	return expandIndex(segments_[segment].face[1]);
+}
+
+template <typename CoordT, typename AllocatorT, typename IndexT>
+Idx SegmentList<CoordT, AllocatorT, IndexT>::getStartVertex(Idx segment) const {
+	return expandIndex(segments_[segment].vertex[0]);
+}
+
+template <typename CoordT, typename AllocatorT, typename IndexT>
+Idx SegmentList<CoordT, AllocatorT, IndexT>::getEndVertex(Idx segment) const {
+	return expandIndex(segments_[segment].vertex[1]);
+}
+
+template <typename CoordT, typename AllocatorT, typename IndexT>
+const typename SegmentList<CoordT, AllocatorT, IndexT>::PointT&
+SegmentList<CoordT, AllocatorT, IndexT>::getVertexPosition(Idx vertex) const {
+	return vertex_pos_[vertex];
+}
+
+template <typename CoordT, typename AllocatorT, typename IndexT>
+Idx SegmentList<CoordT, AllocatorT, IndexT>::getTwinEdge(Idx edge) const {
+	return edge ^ 1;
+}
+
+template <typename CoordT, typename AllocatorT, typename IndexT>
+std::pair<Idx, Idx> SegmentList<CoordT, AllocatorT, IndexT>::addEdge(Idx face1, Idx face2) {
+	// The ID of the second half-edge must be less than nilIndex<IndexT>().
+	if(2 * segments_.getSize() + 1 >= (Idx)nilIndex<IndexT>()) {
+		throw std::logic_error("SegmentList::addEdge: too many edges for the index type.");
+	}
+	
+	Segment segment;
+	segment.face[0] = compactIndex<IndexT>(face1);
+	segment.face[1] = compactIndex<IndexT>(face2);
+	segment.vertex[0] = nilIndex<IndexT>();
+	segment.vertex[1] = nilIndex<IndexT>();
+	
+	Idx index = segments_.add(segment);
+	return std::make_pair(2 * index, 2 * index + 1);
+}
+
+template <typename CoordT, typename AllocatorT, typename IndexT>
+Idx SegmentList<CoordT, AllocatorT, IndexT>::addVertex(
+	const PointT& pos, Idx edge1, Idx edge2, Idx edge3
+) {
+	if(vertex_pos_.getSize() >= (Idx)nilIndex<IndexT>()) {
+		throw std::logic_error("SegmentList::addVertex: too many vertices for the index type.");
+	}
+	
+	Idx vertex = vertex_pos_.add(pos);
+	
+	setEndVertex_(edge1, vertex);
+	setEndVertex_(edge2, vertex);
+	setEndVertex_(edge3, vertex);
+	
+	return vertex;
+}
+
+template <typename CoordT, typename AllocatorT, typename IndexT>
+void SegmentList<CoordT, AllocatorT, IndexT>::consecutiveEdges(Idx, Idx) { }
+
+template <typename CoordT, typename AllocatorT, typename IndexT>
+void SegmentList<CoordT, AllocatorT, IndexT>::setEndVertex_(Idx edge, Idx vertex) {
+	// Half-edge 2i ends in the end vertex of segment i, and half-edge 2i+1 in
+	// its start vertex.
+	segments_[edge / 2].vertex[1 - edge % 2] = compactIndex<IndexT>(vertex);
+}
+
+}
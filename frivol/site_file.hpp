@@ -0,0 +1,172 @@
+#ifndef FRIVOL_SITE_FILE_HPP
+#define FRIVOL_SITE_FILE_HPP
+
+#include <frivol/common.hpp>
+#include <frivol/containers/array.hpp>
+#include <frivol/containers/dynamic_array.hpp>
+#include <frivol/containers/priority_queues/binary_heap.hpp>
+#include <frivol/point.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace frivol {
+
+/// A site in a sorted site file: the position of the site and its index in
+/// the original input, which is used as the ID of its face. The records are
+/// stored in the files in native binary layout.
+/// @tparam CoordT The coordinate type of the sites.
+template <typename CoordT = double>
+struct SiteRecord {
+	CoordT x;           ///< The X coordinate.
+	CoordT y;           ///< The Y coordinate.
+	std::uint64_t index; ///< The index of the site in the unsorted input.
+	
+	/// Orders the records like the site events of the sites, primarily by Y
+	/// and secondarily by X coordinate, and the equal sites by index.
+	bool operator<(const SiteRecord<CoordT>& other) const;
+};
+
+/// Buffered reader of a binary file of fixed-size records in native layout.
+/// @tparam RecordT The trivially copyable record type.
+template <typename RecordT>
+class RecordFileReader {
+public:
+	static_assert(
+		std::is_trivially_copyable<RecordT>::value,
+		"RecordFileReader: RecordT must be trivially copyable."
+	);
+	
+	/// Constructs reader with no file open.
+	RecordFileReader();
+	
+	/// Opens a file for reading.
+	/// @param path The path of the file.
+	/// @param buffer_size The number of records read at a time.
+	/// @throws std::runtime_error if the file cannot be opened.
+	RecordFileReader(const std::string& path, Idx buffer_size = 4096);
+	
+	RecordFileReader(const RecordFileReader<RecordT>&) = delete;
+	RecordFileReader<RecordT>& operator=(const RecordFileReader<RecordT>&) = delete;
+	
+	/// Closes the file.
+	~RecordFileReader();
+	
+	/// Closes the open file, if any, and opens a file for reading.
+	/// @param path The path of the file.
+	/// @param buffer_size The number of records read at a time.
+	/// @throws std::runtime_error if the file cannot be opened.
+	void open(const std::string& path, Idx buffer_size = 4096);
+	
+	/// Reads the next record.
+	/// @param record Set to the record read.
+	/// @returns false if the end of the file has been reached.
+	/// @throws std::runtime_error if reading fails or the file ends in the
+	/// middle of a record.
+	bool read(RecordT& record);
+	
+	/// Closes the file.
+	void close();
+	
+private:
+	/// Reads the next records to buffer_.
+	void fill_();
+	
+	/// The open file, or nullptr.
+	std::FILE* file_;
+	
+	/// The path of the file for the error messages.
+	std::string path_;
+	
+	/// The records read from the file but not returned yet are at
+	/// buffer_pos_, ..., buffer_end_-1.
+	containers::Array<RecordT> buffer_;
+	Idx buffer_pos_;
+	Idx buffer_end_;
+};
+
+/// Buffered writer of a binary file of fixed-size records in native layout.
+/// @tparam RecordT The trivially copyable record type.
+template <typename RecordT>
+class RecordFileWriter {
+public:
+	static_assert(
+		std::is_trivially_copyable<RecordT>::value,
+		"RecordFileWriter: RecordT must be trivially copyable."
+	);
+	
+	/// Creates or truncates a file for writing.
+	/// @param path The path of the file.
+	/// @param buffer_size The number of records written at a time.
+	/// @throws std::runtime_error if the file cannot be opened.
+	RecordFileWriter(const std::string& path, Idx buffer_size = 4096);
+	
+	RecordFileWriter(const RecordFileWriter<RecordT>&) = delete;
+	RecordFileWriter<RecordT>& operator=(const RecordFileWriter<RecordT>&) = delete;
+	
+	/// Closes the file if close() has not been called. Write errors are not
+	/// reported in that case.
+	~RecordFileWriter();
+	
+	/// Writes a record.
+	/// @param record The record.
+	/// @throws std::runtime_error if writing fails.
+	void write(const RecordT& record);
+	
+	/// Writes the buffered records and closes the file.
+	/// @throws std::runtime_error if writing fails.
+	void close();
+	
+private:
+	/// Writes the buffered records to the file.
+	void flush_();
+	
+	/// The open file, or nullptr after close().
+	std::FILE* file_;
+	
+	/// The path of the file for the error messages.
+	std::string path_;
+	
+	/// The records not written yet are at 0, ..., buffer_end_-1.
+	containers::Array<RecordT> buffer_;
+	Idx buffer_end_;
+};
+
+/// Sorts a file of sites that may not fit in memory to the order of their
+/// site events, so that the Voronoi diagram can be computed from it with
+/// streamSortedSiteFile. External merge sort is used: the input is sorted in
+/// runs of run_size sites to temporary files output_path.run0,
+/// output_path.run1, ..., which are merged at most merge_fan_in at a time to
+/// new runs until the last merge writes the output file. The temporary
+/// files are removed, and so is the output file if writing it fails. At most run_size records are sorted in memory at a
+/// time, and the merges buffer max(run_size / merge_fan_in, 4096) records
+/// per run.
+///
+/// For n sites, there are ceil(n / run_size) initial runs, and the merge
+/// passes over the data about log(n / run_size) / log(merge_fan_in) times,
+/// with at most merge_fan_in + 1 files open.
+/// @param input_path The input file of sites as consecutive X and Y
+/// coordinates of type CoordT in native binary layout.
+/// @param output_path The output file of SiteRecord<CoordT> records. The
+/// index of a record is the index of the site in the input file.
+/// @param run_size The number of sites sorted in memory at a time.
+/// @param merge_fan_in The largest number of runs merged at a time.
+/// @throws std::runtime_error if reading or writing the files fails.
+/// @throws std::logic_error if run_size is 0 or merge_fan_in is less than 2.
+/// @tparam CoordT The coordinate type of the sites.
+template <typename CoordT = double>
+void sortSiteFile(
+	const std::string& input_path,
+	const std::string& output_path,
+	Idx run_size,
+	Idx merge_fan_in = 128
+);
+
+}
+
+#include "site_file_impl.hpp"
+
+#endif
@@ -0,0 +1,230 @@
+#include <algorithm>
+#include <tuple>
+
+namespace frivol {
+
+template <typename CoordT>
+bool SiteRecord<CoordT>::operator<(const SiteRecord<CoordT>& other) const {
+	if(y != other.y) return y < other.y;
+	if(x != other.x) return x < other.x;
+	return index < other.index;
+}
+
+template <typename RecordT>
+RecordFileReader<RecordT>::RecordFileReader()
+	: file_(nullptr),
+	  buffer_pos_(0),
+	  buffer_end_(0)
+{ }
+
+template <typename RecordT>
+RecordFileReader<RecordT>::RecordFileReader(const std::string& path, Idx buffer_size)
+	: RecordFileReader()
+{
+	open(path, buffer_size);
+}
+
+template <typename RecordT>
+RecordFileReader<RecordT>::~RecordFileReader() {
+	close();
+}
+
+template <typename RecordT>
+void RecordFileReader<RecordT>::open(const std::string& path, Idx buffer_size) {
+	close();
+	
+	file_ = std::fopen(path.c_str(), "rb");
+	if(file_ == nullptr) {
+		throw std::runtime_error("RecordFileReader::open: cannot open " + path + ".");
+	}
+	path_ = path;
+	buffer_.resize(std::max(buffer_size, (Idx)1));
+	buffer_pos_ = 0;
+	buffer_end_ = 0;
+}
+
+template <typename RecordT>
+bool RecordFileReader<RecordT>::read(RecordT& record) {
+	if(buffer_pos_ == buffer_end_) {
+		fill_();
+		if(buffer_end_ == 0) return false;
+	}
+	
+	record = buffer_[buffer_pos_++];
+	return true;
+}
+
+template <typename RecordT>
+void RecordFileReader<RecordT>::close() {
+	if(file_ != nullptr) {
+		std::fclose(file_);
+		file_ = nullptr;
+	}
+}
+
+template <typename RecordT>
+void RecordFileReader<RecordT>::fill_() {
+	buffer_pos_ = 0;
+	buffer_end_ = 0;
+	if(file_ == nullptr) return;
+	
+	// Read bytes rather than records, so that a partial record at the end is
+	// noticed.
+	std::size_t bytes = std::fread(&buffer_[0], 1, buffer_.getSize() * sizeof(RecordT), file_);
+	if(std::ferror(file_)) {
+		throw std::runtime_error("RecordFileReader::read: cannot read " + path_ + ".");
+	}
+	if(bytes % sizeof(RecordT) != 0) {
+		throw std::runtime_error("RecordFileReader::read: " + path_ + " ends in a partial record.");
+	}
+	buffer_end_ = bytes / sizeof(RecordT);
+}
+
+template <typename RecordT>
+RecordFileWriter<RecordT>::RecordFileWriter(const std::string& path, Idx buffer_size)
+	: path_(path),
+	  buffer_(std::max(buffer_size, (Idx)1)),
+	  buffer_end_(0)
+{
+	file_ = std::fopen(path.c_str(), "wb");
+	if(file_ == nullptr) {
+		throw std::runtime_error("RecordFileWriter: cannot open " + path + ".");
+	}
+}
+
+template <typename RecordT>
+RecordFileWriter<RecordT>::~RecordFileWriter() {
+	if(file_ != nullptr) std::fclose(file_);
+}
+
+template <typename RecordT>
+void RecordFileWriter<RecordT>::write(const RecordT& record) {
+	if(buffer_end_ == buffer_.getSize()) flush_();
+	buffer_[buffer_end_++] = record;
+}
+
+template <typename RecordT>
+void RecordFileWriter<RecordT>::close() {
+	if(file_ == nullptr) return;
+	
+	flush_();
+	int result = std::fclose(file_);
+	file_ = nullptr;
+	if(result != 0) {
+		throw std::runtime_error("RecordFileWriter::close: cannot write " + path_ + ".");
+	}
+}
+
+template <typename RecordT>
+void RecordFileWriter<RecordT>::flush_() {
+	if(buffer_end_ == 0) return;
+	
+	Idx count = buffer_end_;
+	buffer_end_ = 0;
+	if(std::fwrite(&buffer_[0], sizeof(RecordT), count, file_) != count) {
+		throw std::runtime_error("RecordFileWriter::write: cannot write " + path_ + ".");
+	}
+}
+
+template <typename CoordT>
+void sortSiteFile(
+	const std::string& input_path,
+	const std::string& output_path,
+	Idx run_size,
+	Idx merge_fan_in
+) {
+	typedef SiteRecord<CoordT> RecordT;
+	
+	if(run_size == 0) {
+		throw std::logic_error("sortSiteFile: the run size must be positive.");
+	}
+	if(merge_fan_in < 2) {
+		throw std::logic_error("sortSiteFile: the merge fan-in must be at least 2.");
+	}
+	
+	// The runs are numbered in the order they are written, and the runs not
+	// merged yet are first_run, ..., next_run-1.
+	Idx first_run = 0;
+	Idx next_run = 0;
+	auto getRunPath = [&output_path](Idx run) {
+		return output_path + ".run" + std::to_string(run);
+	};
+	auto removeRuns = [&next_run, &getRunPath]() {
+		for(Idx run = 0; run < next_run; ++run) {
+			std::remove(getRunPath(run).c_str());
+		}
+	};
+	
+	// Merges runs first_run, ..., first_run+count-1 to a file, taking the
+	// least of the first unmerged records of the runs from a heap keyed by
+	// run. The read buffers share the memory of one sorted run, but are
+	// kept large enough that the files are read in large blocks.
+	Idx buffer_size = std::max(run_size / merge_fan_in, (Idx)4096);
+	auto mergeRuns = [&](Idx count, const std::string& path) {
+		containers::Array<RecordFileReader<RecordT>> readers(count);
+		containers::priority_queues::BinaryHeap<RecordT> heads(count);
+		for(Idx i = 0; i < count; ++i) {
+			readers[i].open(getRunPath(first_run + i), buffer_size);
+			RecordT record;
+			if(readers[i].read(record)) heads.setPriority(i, record);
+		}
+		
+		RecordFileWriter<RecordT> output(path, buffer_size);
+		while(!heads.empty()) {
+			Idx i;
+			RecordT record;
+			std::tie(i, record) = heads.pop();
+			output.write(record);
+			if(readers[i].read(record)) heads.setPriority(i, record);
+		}
+		output.close();
+		
+		for(Idx i = 0; i < count; ++i) {
+			readers[i].close();
+			std::remove(getRunPath(first_run + i).c_str());
+		}
+		first_run += count;
+	};
+	
+	bool writing_output = false;
+	try {
+		// Sort the runs, releasing the run buffer before the merge.
+		{
+			RecordFileReader<Point<CoordT>> input(input_path);
+			containers::DynamicArray<RecordT> run;
+			std::uint64_t index = 0;
+			Point<CoordT> site;
+			bool has_site = input.read(site);
+			while(has_site) {
+				run.clear();
+				while(has_site && run.getSize() < run_size) {
+					run.add(RecordT{site.x, site.y, index++});
+					has_site = input.read(site);
+				}
+				std::sort(&run[0], &run[0] + run.getSize());
+				
+				RecordFileWriter<RecordT> writer(getRunPath(next_run++));
+				for(Idx i = 0; i < run.getSize(); ++i) {
+					writer.write(run[i]);
+				}
+				writer.close();
+			}
+		}
+		
+		// Merge at most merge_fan_in runs at a time to new runs, so that the
+		// number of open files stays bounded, until one merge is enough.
+		while(next_run - first_run > merge_fan_in) {
+			mergeRuns(merge_fan_in, getRunPath(next_run++));
+		}
+		writing_output = true;
+		mergeRuns(next_run - first_run, output_path);
+	} catch(...) {
+		removeRuns();
+		
+		// Do not leave a partial output that could be taken as sorted.
+		if(writing_output) std::remove(output_path.c_str());
+		throw;
+	}
+}
+
+}
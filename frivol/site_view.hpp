@@ -0,0 +1,83 @@
+#ifndef FRIVOL_SITE_VIEW_HPP
+#define FRIVOL_SITE_VIEW_HPP
+
+#include <frivol/common.hpp>
+#include <frivol/containers/array.hpp>
+#include <frivol/point.hpp>
+
+#include <cstddef>
+#include <stdexcept>
+
+namespace frivol {
+
+/// Non-owning read-only view of the input sites of the algorithm. The X and
+/// Y coordinates of the sites are read from memory owned by the caller, with
+/// a byte stride between consecutive sites, so that arrays of points,
+/// interleaved coordinate buffers, separate coordinate arrays (structure of
+/// arrays) and arrays of larger records can all be used without copying. The
+/// viewed memory must stay valid and unchanged while the view is used.
+/// @tparam CoordT The coordinate type of the sites.
+template <typename CoordT = double>
+class SiteView {
+public:
+	typedef Point<CoordT> PointT;
+	
+	/// Constructs an empty view.
+	SiteView();
+	
+	/// Constructs a view of the points in an array. Implicit so that arrays
+	/// can be passed wherever views are expected.
+	/// @param sites The array.
+	SiteView(const containers::Array<PointT>& sites);
+	
+	/// Constructs a view of contiguous points.
+	/// @param sites Pointer to the first point.
+	/// @param count The number of points.
+	SiteView(const PointT* sites, Idx count);
+	
+	/// Constructs a view of coordinates at a constant byte stride. For
+	/// example, a buffer of interleaved coordinates x0, y0, x1, y1, ... is
+	/// viewed with SiteView(buffer, buffer + 1, count, 2 * sizeof(CoordT)),
+	/// and separate arrays of the X and Y coordinates with
+	/// SiteView(xs, ys, count).
+	/// @param x Pointer to the X coordinate of the first site.
+	/// @param y Pointer to the Y coordinate of the first site.
+	/// @param count The number of sites.
+	/// @param stride The distance in bytes between the coordinates of
+	/// consecutive sites. Must keep the coordinates aligned.
+	SiteView(const CoordT* x, const CoordT* y, Idx count, std::size_t stride = sizeof(CoordT));
+	
+	/// Returns the number of sites.
+	Idx getSize() const;
+	
+	/// Returns the position of a site.
+	/// @param index The index of the site.
+	/// @throws std::out_of_range if FRIVOL_ARRAY_BOUNDS_CHECKING is defined and 'index' overflows.
+	PointT operator[](Idx index) const;
+	
+	/// @{
+	/// Returns the X or the Y coordinate of a site.
+	/// @param index The index of the site.
+	/// @throws std::out_of_range if FRIVOL_ARRAY_BOUNDS_CHECKING is defined and 'index' overflows.
+	const CoordT& getX(Idx index) const;
+	const CoordT& getY(Idx index) const;
+	/// @}
+	
+private:
+	/// The X and Y coordinates of the first site, as bytes for the stride
+	/// arithmetic.
+	const char* x_;
+	const char* y_;
+	
+	/// The number of sites.
+	Idx count_;
+	
+	/// The distance in bytes between consecutive sites.
+	std::size_t stride_;
+};
+
+}
+
+#include "site_view_impl.hpp"
+
+#endif
@@ -0,0 +1,66 @@
+namespace frivol {
+
+template <typename CoordT>
+SiteView<CoordT>::SiteView()
+	: x_(nullptr),
+	  y_(nullptr),
+	  count_(0),
+	  stride_(sizeof(PointT))
+{ }
+
+template <typename CoordT>
+SiteView<CoordT>::SiteView(const containers::Array<PointT>& sites)
+	: SiteView()
+{
+	if(sites.getSize() != 0) {
+		*this = SiteView<CoordT>(&sites[0], sites.getSize());
+	}
+}
+
+template <typename CoordT>
+SiteView<CoordT>::SiteView(const PointT* sites, Idx count)
+	: x_(reinterpret_cast<const char*>(&sites->x)),
+	  y_(reinterpret_cast<const char*>(&sites->y)),
+	  count_(count),
+	  stride_(sizeof(PointT))
+{ }
+
+template <typename CoordT>
+SiteView<CoordT>::SiteView(const CoordT* x, const CoordT* y, Idx count, std::size_t stride)
+	: x_(reinterpret_cast<const char*>(x)),
+	  y_(reinterpret_cast<const char*>(y)),
+	  count_(count),
+	  stride_(stride)
+{ }
+
+template <typename CoordT>
+Idx SiteView<CoordT>::getSize() const {
+	return count_;
+}
+
+template <typename CoordT>
+Point<CoordT> SiteView<CoordT>::operator[](Idx index) const {
+	return PointT(getX(index), getY(index));
+}
+
+template <typename CoordT>
+const CoordT& SiteView<CoordT>::getX(Idx index) const {
+#ifdef FRIVOL_ARRAY_BOUNDS_CHECKING
+	if(index >= count_) {
+		throw std::out_of_range("SiteView::getX: Site index out of bounds.");
+	}
+#endif
+	return *reinterpret_cast<const CoordT*>(x_ + index * stride_);
+}
+
+template <typename CoordT>
+const CoordT& SiteView<CoordT>::getY(Idx index) const {
+#ifdef FRIVOL_ARRAY_BOUNDS_CHECKING
+	if(index >= count_) {
+		throw std::out_of_range("SiteView::getY: Site index out of bounds.");
+	}
+#endif
+	return *reinterpret_cast<const CoordT*>(y_ + index * stride_);
+}
+
+}
@@ -0,0 +1,184 @@
+#ifndef FRIVOL_STREAMING_SINK_HPP
+#define FRIVOL_STREAMING_SINK_HPP
+
+#include <frivol/containers/allocator.hpp>
+#include <frivol/containers/dynamic_array.hpp>
+#include <frivol/containers/stack.hpp>
+#include <frivol/memory_usage.hpp>
+#include <frivol/point.hpp>
+
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace frivol {
+
+/// Output sink of fortune::Algorithm (see OutputSinkConcept) that reports the
+/// diagram to a visitor as soon as its parts are final, instead of storing
+/// it. Only the edges that still have an unknown end are stored, so the
+/// output takes memory proportional to the number of breakpoints on the beach
+/// line rather than to the size of the diagram, apart from a counter per
+/// face.
+///
+/// Faces with IDs beyond the number given to reset are added when edges are
+/// added to them, so the sink can also be used when the number of faces is
+/// not known in advance, as in the incremental mode of fortune::Algorithm.
+///
+/// The visitor must have the following member functions, called in the
+/// order in which the parts become final:
+///  - void onVertex(Idx vertex, const Point<CoordT>& pos) for each Voronoi
+///    vertex. The vertex IDs are 0, 1, 2, ... in the order of the calls.
+///  - void onEdgeFinished(Idx face1, Idx face2, Idx vertex1, Idx vertex2)
+///    for each edge when both of its ends are known. The half-edge from
+///    vertex1 to vertex2 has face1 as incident face (see VoronoiDiagram), and
+///    its twin has face2. Infinite ends are nil_idx. The vertices have been
+///    reported before the edge.
+///  - void onFaceClosed(Idx face) for each face when all of its edges have
+///    been reported. The bounded faces are closed during the sweep and the
+///    unbounded ones when the algorithm finishes. Faces with no edges, which
+///    only occur if there is only one site, are never closed.
+///
+/// @tparam VisitorT The type of the visitor.
+/// @tparam CoordT The coordinate type of the vertices.
+/// @tparam AllocatorT The allocator used for the internal arrays (see
+/// containers::Array).
+/// @tparam IndexT The unsigned integer type in which the face and vertex IDs
+/// are stored (see VoronoiDiagram).
+template <
+	typename VisitorT,
+	typename CoordT = double,
+	typename AllocatorT = containers::DefaultAllocator,
+	typename IndexT = Idx
+>
+class StreamingSink {
+public:
+	typedef Point<CoordT> PointT;
+	
+	static_assert(
+		std::is_integral<IndexT>::value && std::is_unsigned<IndexT>::value &&
+			sizeof(IndexT) <= sizeof(Idx),
+		"StreamingSink: IndexT must be an unsigned integer type no larger than Idx."
+	);
+	
+	/// Constructs sink with no visitor. The visitor must be set with
+	/// setVisitor before the sink is used.
+	/// @param faces Number of faces.
+	/// @param allocator The allocator used for the internal arrays.
+	/// @throws std::logic_error if the face IDs do not fit in IndexT.
+	StreamingSink(Idx faces = 0, const AllocatorT& allocator = AllocatorT());
+	
+	/// Sets the visitor to which the diagram is reported.
+	/// @param visitor Pointer to the visitor. The visitor must exist while
+	/// the sink is used.
+	void setVisitor(VisitorT* visitor);
+	
+	/// Returns the visitor set with setVisitor, or nullptr.
+	VisitorT* getVisitor() const;
+	
+	/// Starts a new diagram, keeping the visitor and the allocated memory.
+	/// @param faces Number of faces.
+	/// @throws std::logic_error if the face IDs do not fit in IndexT.
+	void reset(Idx faces);
+	
+	/// Does nothing, as the stored edges are bounded by the beach line and
+	/// not by the size of the diagram.
+	void reserve(Idx edges, Idx vertices);
+	
+	/// Returns the number of vertices reported.
+	Idx getVertexCount() const;
+	
+	/// Returns the number of edges that have been added but not yet reported.
+	Idx getOpenEdgeCount() const;
+	
+	/// Returns the memory allocated for the unfinished edges and the face
+	/// counters.
+	MemoryUsage getMemoryUsage() const;
+	
+	/// Returns an upper bound of the number of bytes allocated by a new sink
+	/// for a diagram of given size.
+	/// @param faces The number of faces.
+	/// @param edges The number of edges (pairs of twin half-edges).
+	/// @param vertices The number of vertices.
+	static std::size_t estimateMemoryUsage(Idx faces, Idx edges, Idx vertices);
+	
+	/// Returns the ID of the twin half-edge of given half-edge.
+	/// @param edge ID of the half-edge.
+	Idx getTwinEdge(Idx edge) const;
+	
+	/// Adds a new edge that is reported when both of its ends are known. The
+	/// half-edge IDs are reused after that.
+	/// @param face1,face2 The IDs of the faces incident to the edge.
+	/// @returns the IDs of the new half-edges, first one having face1 and
+	/// the second one having face2 as incident face.
+	/// @throws std::logic_error if the face IDs do not fit in IndexT.
+	std::pair<Idx, Idx> addEdge(Idx face1, Idx face2);
+	
+	/// Reports a new Voronoi vertex, and the edges that it finishes.
+	/// @param pos Position of the vertex.
+	/// @param edge1,edge2,edge3 The half-edges having the new vertex as end
+	/// vertex.
+	/// @returns the ID of the new vertex.
+	/// @throws std::logic_error if the vertex ID would not fit in IndexT.
+	Idx addVertex(const PointT& pos, Idx edge1, Idx edge2, Idx edge3);
+	
+	/// Marks edge1 to end in infinity, as the algorithm only marks infinite
+	/// half-edges consecutive.
+	/// @param edge1,edge2 The IDs of the half-edges such that edge2 is next
+	/// from edge1.
+	void consecutiveEdges(Idx edge1, Idx edge2);
+	
+private:
+	/// An edge that has been added but not yet reported. The half-edges of
+	/// slot i have IDs 2i and 2i+1.
+	struct EdgeSlot {
+		/// The incident faces of the two half-edges.
+		IndexT face[2];
+		
+		/// The end vertices of the two half-edges, nilIndex<IndexT>() for
+		/// unknown or infinite ends.
+		IndexT end_vertex[2];
+		
+		/// The number of ends that are known, including infinite ends.
+		unsigned char known_ends;
+	};
+	
+	/// Sets the end of a half-edge, and reports the edge if both ends are
+	/// known.
+	/// @param edge The ID of the half-edge.
+	/// @param vertex The end vertex, or nil_idx for infinity.
+	void setEndVertex_(Idx edge, Idx vertex);
+	
+	/// Decrements the number of unfinished edges of a face, and reports the
+	/// face as closed when it drops to zero.
+	/// @param face The ID of the face.
+	void releaseFace_(Idx face);
+	
+	/// Adds faces with no edges so that there are at least given number of
+	/// faces.
+	/// @param faces The number of faces.
+	void addFaces_(Idx faces);
+	
+	/// The visitor, or nullptr if not set.
+	VisitorT* visitor_;
+	
+	/// The edges by slot index. The slots in free_slots_ are unused.
+	containers::DynamicArray<EdgeSlot, AllocatorT> slots_;
+	
+	/// The indices of the unused slots of slots_.
+	containers::Stack<IndexT, AllocatorT> free_slots_;
+	
+	/// The numbers of unreported edges incident to the faces.
+	containers::DynamicArray<IndexT, AllocatorT> open_edge_counts_;
+	
+	/// The number of edges that have been added but not yet reported.
+	Idx open_edge_count_;
+	
+	/// The number of vertices reported.
+	Idx vertex_count_;
+};
+
+}
+
+#include "streaming_sink_impl.hpp"
+
+#endif
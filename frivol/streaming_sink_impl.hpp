@@ -0,0 +1,176 @@
+#include <algorithm>
+
+namespace frivol {
+
+template <typename VisitorT, typename CoordT, typename AllocatorT, typename IndexT>
+StreamingSink<VisitorT, CoordT, AllocatorT, IndexT>::StreamingSink(Idx faces, const AllocatorT& allocator)
+	: visitor_(nullptr),
+	  slots_(allocator),
+	  free_slots_(allocator),
+	  open_edge_counts_(allocator)
+{
+	reset(faces);
+}
+
+template <typename VisitorT, typename CoordT, typename AllocatorT, typename IndexT>
+void StreamingSink<VisitorT, CoordT, AllocatorT, IndexT>::setVisitor(VisitorT* visitor) {
+	visitor_ = visitor;
+}
+
+template <typename VisitorT, typename CoordT, typename AllocatorT, typename IndexT>
+VisitorT* StreamingSink<VisitorT, CoordT, AllocatorT, IndexT>::getVisitor() const {
+	return visitor_;
+}
+
+template <typename VisitorT, typename CoordT, typename AllocatorT, typename IndexT>
+void StreamingSink<VisitorT, CoordT, AllocatorT, IndexT>::reset(Idx faces) {
+	if(faces > (Idx)nilIndex<IndexT>()) {
+		throw std::logic_error("StreamingSink::reset: too many faces for the index type.");
+	}
+	
+	slots_.clear();
+	free_slots_.clear();
+	open_edge_counts_.resize(faces);
+	for(Idx face = 0; face < faces; ++face) {
+		open_edge_counts_[face] = 0;
+	}
+	open_edge_count_ = 0;
+	vertex_count_ = 0;
+}
+
+template <typename VisitorT, typename CoordT, typename AllocatorT, typename IndexT>
+void StreamingSink<VisitorT, CoordT, AllocatorT, IndexT>::reserve(Idx, Idx) { }
+
+template <typename VisitorT, typename CoordT, typename AllocatorT, typename IndexT>
+Idx StreamingSink<VisitorT, CoordT, AllocatorT, IndexT>::getVertexCount() const {
+	return vertex_count_;
+}
+
+template <typename VisitorT, typename CoordT, typename AllocatorT, typename IndexT>
+Idx StreamingSink<VisitorT, CoordT, AllocatorT, IndexT>::getOpenEdgeCount() const {
+	return open_edge_count_;
+}
+
+template <typename VisitorT, typename CoordT, typename AllocatorT, typename IndexT>
+MemoryUsage StreamingSink<VisitorT, CoordT, AllocatorT, IndexT>::getMemoryUsage() const {
+	return
+		slots_.getMemoryUsage() + free_slots_.getMemoryUsage() +
+		open_edge_counts_.getMemoryUsage();
+}
+
+template <typename VisitorT, typename CoordT, typename AllocatorT, typename IndexT>
+std::size_t StreamingSink<VisitorT, CoordT, AllocatorT, IndexT>::estimateMemoryUsage(
+	Idx faces, Idx edges, Idx
+) {
+	// Each unfinished edge has a half-edge drawn by a breakpoint, and there
+	// are less than 2 * faces breakpoints. The slot and free slot arrays grow
+	// by doubling up to that.
+	Idx max_slots = std::min(edges, 2 * faces);
+	Idx capacity = 0;
+	if(max_slots != 0) {
+		capacity = 1;
+		while(capacity < max_slots) capacity *= 2;
+	}
+	return capacity * (sizeof(EdgeSlot) + sizeof(IndexT)) + faces * sizeof(IndexT);
+}
+
+template <typename VisitorT, typename CoordT, typename AllocatorT, typename IndexT>
+Idx StreamingSink<VisitorT, CoordT, AllocatorT, IndexT>::getTwinEdge(Idx edge) const {
+	return edge ^ 1;
+}
+
+template <typename VisitorT, typename CoordT, typename AllocatorT, typename IndexT>
+std::pair<Idx, Idx> StreamingSink<VisitorT, CoordT, AllocatorT, IndexT>::addEdge(
+	Idx face1, Idx face2
+) {
+	Idx max_face = std::max(face1, face2);
+	if(max_face >= open_edge_counts_.getSize()) addFaces_(max_face + 1);
+	
+	EdgeSlot slot;
+	slot.face[0] = compactIndex<IndexT>(face1);
+	slot.face[1] = compactIndex<IndexT>(face2);
+	slot.end_vertex[0] = nilIndex<IndexT>();
+	slot.end_vertex[1] = nilIndex<IndexT>();
+	slot.known_ends = 0;
+	
+	Idx slot_idx;
+	if(free_slots_.empty()) {
+		slot_idx = slots_.add(slot);
+	} else {
+		slot_idx = free_slots_.top();
+		free_slots_.pop();
+		slots_[slot_idx] = slot;
+	}
+	
+	++open_edge_count_;
+	++open_edge_counts_[face1];
+	++open_edge_counts_[face2];
+	
+	return std::make_pair(2 * slot_idx, 2 * slot_idx + 1);
+}
+
+template <typename VisitorT, typename CoordT, typename AllocatorT, typename IndexT>
+Idx StreamingSink<VisitorT, CoordT, AllocatorT, IndexT>::addVertex(
+	const PointT& pos, Idx edge1, Idx edge2, Idx edge3
+) {
+	if(vertex_count_ >= (Idx)nilIndex<IndexT>()) {
+		throw std::logic_error("StreamingSink::addVertex: too many vertices for the index type.");
+	}
+	
+	Idx vertex = vertex_count_++;
+	visitor_->onVertex(vertex, pos);
+	
+	setEndVertex_(edge1, vertex);
+	setEndVertex_(edge2, vertex);
+	setEndVertex_(edge3, vertex);
+	
+	return vertex;
+}
+
+template <typename VisitorT, typename CoordT, typename AllocatorT, typename IndexT>
+void StreamingSink<VisitorT, CoordT, AllocatorT, IndexT>::consecutiveEdges(Idx edge1, Idx) {
+	setEndVertex_(edge1, nil_idx);
+}
+
+template <typename VisitorT, typename CoordT, typename AllocatorT, typename IndexT>
+void StreamingSink<VisitorT, CoordT, AllocatorT, IndexT>::setEndVertex_(Idx edge, Idx vertex) {
+	Idx slot_idx = edge / 2;
+	EdgeSlot& slot = slots_[slot_idx];
+	slot.end_vertex[edge % 2] = compactIndex<IndexT>(vertex);
+	if(++slot.known_ends < 2) return;
+	
+	// The half-edge 2i starts from the end of its twin.
+	Idx face1 = expandIndex(slot.face[0]);
+	Idx face2 = expandIndex(slot.face[1]);
+	visitor_->onEdgeFinished(
+		face1,
+		face2,
+		expandIndex(slot.end_vertex[1]),
+		expandIndex(slot.end_vertex[0])
+	);
+	
+	free_slots_.push(compactIndex<IndexT>(slot_idx));
+	--open_edge_count_;
+	releaseFace_(face1);
+	releaseFace_(face2);
+}
+
+template <typename VisitorT, typename CoordT, typename AllocatorT, typename IndexT>
+void StreamingSink<VisitorT, CoordT, AllocatorT, IndexT>::releaseFace_(Idx face) {
+	if(--open_edge_counts_[face] == 0) visitor_->onFaceClosed(face);
+}
+
+template <typename VisitorT, typename CoordT, typename AllocatorT, typename IndexT>
+void StreamingSink<VisitorT, CoordT, AllocatorT, IndexT>::addFaces_(Idx faces) {
+	if(faces > (Idx)nilIndex<IndexT>()) {
+		throw std::logic_error("StreamingSink::addEdge: too many faces for the index type.");
+	}
+	
+	Idx old_faces = open_edge_counts_.getSize();
+	open_edge_counts_.resize(faces);
+	for(Idx face = old_faces; face < faces; ++face) {
+		open_edge_counts_[face] = 0;
+	}
+}
+
+}
@@ -0,0 +1,117 @@
+#ifndef FRIVOL_STREAMING_SWEEP_HPP
+#define FRIVOL_STREAMING_SWEEP_HPP
+
+#include <frivol/containers/dynamic_array.hpp>
+#include <frivol/fortune/algorithm.hpp>
+#include <frivol/memory_usage.hpp>
+#include <frivol/point.hpp>
+#include <frivol/policy.hpp>
+#include <frivol/streaming_sink.hpp>
+
+namespace frivol {
+
+/// Computes the Voronoi diagram of sites that are given one at a time in the
+/// order of their site events, reporting it to a visitor like StreamingSink.
+/// Only the sites whose faces are still open are kept in memory: the faces
+/// are closed by the sink as soon as their last edges are finished, and
+/// their sites are evicted from the algorithm state. The memory use is thus
+/// proportional to the width of the beach line, which makes it possible to
+/// compute the diagram of inputs that do not fit in memory when they are
+/// read from a sorted file (see sortSiteFile).
+///
+/// The sites of the unbounded faces stay in memory until the end.
+/// @tparam PolicyT The algorithm policy to use, instance of Policy template.
+/// @tparam VisitorT The type of the visitor, see StreamingSink. The faces
+/// are reported with the IDs given to addSite.
+template <typename PolicyT, typename VisitorT>
+class StreamingSweep {
+public:
+	typedef typename PolicyT::Coord CoordT;
+	typedef typename PolicyT::Allocator AllocatorT;
+	typedef Point<CoordT> PointT;
+	
+	/// Starts a sweep with no sites.
+	/// @param visitor The visitor that receives the diagram. It must exist
+	/// while the sweep is used.
+	/// @param allocator The allocator through which all memory of the sweep
+	/// is allocated.
+	StreamingSweep(VisitorT& visitor, const AllocatorT& allocator = AllocatorT());
+	
+	/// The sink of the algorithm refers to the sweep, so it cannot be copied.
+	StreamingSweep(const StreamingSweep<PolicyT, VisitorT>&) = delete;
+	StreamingSweep<PolicyT, VisitorT>& operator=(const StreamingSweep<PolicyT, VisitorT>&) = delete;
+	
+	/// Adds the next site and handles the events before it.
+	/// @param pos The position of the site. The sites must be added in order
+	/// primarily by Y and secondarily by X coordinate.
+	/// @param face The ID with which the face of the site is reported to the
+	/// visitor.
+	/// @throws std::logic_error if the sweep has been finished or if the site
+	/// is before the previous site.
+	void addSite(const PointT& pos, Idx face);
+	
+	/// Handles the remaining events after the last site, reporting the rest
+	/// of the diagram. No sites can be added after this.
+	void finish();
+	
+	/// Returns the number of sites added.
+	Idx getSiteCount() const;
+	
+	/// Returns the number of sites currently kept in memory.
+	Idx getResidentSiteCount() const;
+	
+	/// Returns the largest number of sites kept in memory at a time.
+	Idx getMaxResidentSiteCount() const;
+	
+	/// Returns the memory allocated by the algorithm state, the unfinished
+	/// edges and the face IDs of the resident sites.
+	MemoryUsage getMemoryUsage() const;
+	
+private:
+	/// Visitor of the sink of the algorithm, which translates the site slots
+	/// of the algorithm to the face IDs of the sites and evicts the sites of
+	/// the closed faces.
+	class SlotVisitor_ {
+	public:
+		SlotVisitor_(StreamingSweep<PolicyT, VisitorT>& sweep);
+		
+		void onVertex(Idx vertex, const PointT& pos);
+		void onEdgeFinished(Idx slot1, Idx slot2, Idx vertex1, Idx vertex2);
+		void onFaceClosed(Idx slot);
+	
+	private:
+		StreamingSweep<PolicyT, VisitorT>& sweep_;
+	};
+	
+	typedef StreamingSink<
+		SlotVisitor_,
+		CoordT,
+		AllocatorT,
+		typename PolicyT::Index
+	> SinkT;
+	typedef fortune::Algorithm<PolicyT, SinkT> AlgorithmT;
+	
+	/// The visitor given in the constructor.
+	VisitorT& visitor_;
+	
+	/// The visitor of the sink.
+	SlotVisitor_ slot_visitor_;
+	
+	/// The algorithm state in incremental mode.
+	AlgorithmT algorithm_;
+	
+	/// The face IDs of the resident sites by slot.
+	containers::DynamicArray<Idx, AllocatorT> face_ids_;
+	
+	/// The number of sites added.
+	Idx site_count_;
+	
+	/// The largest number of resident sites so far.
+	Idx max_resident_site_count_;
+};
+
+}
+
+#include "streaming_sweep_impl.hpp"
+
+#endif
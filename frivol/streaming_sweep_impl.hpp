@@ -0,0 +1,90 @@
+#include <algorithm>
+
+namespace frivol {
+
+template <typename PolicyT, typename VisitorT>
+StreamingSweep<PolicyT, VisitorT>::StreamingSweep(VisitorT& visitor, const AllocatorT& allocator)
+	: visitor_(visitor),
+	  slot_visitor_(*this),
+	  algorithm_(allocator),
+	  face_ids_(allocator),
+	  site_count_(0),
+	  max_resident_site_count_(0)
+{
+	algorithm_.getOutput().setVisitor(&slot_visitor_);
+	algorithm_.resetIncremental();
+}
+
+template <typename PolicyT, typename VisitorT>
+void StreamingSweep<PolicyT, VisitorT>::addSite(const PointT& pos, Idx face) {
+	Idx slot = algorithm_.pushSite(pos);
+	if(slot >= face_ids_.getSize()) face_ids_.resize(slot + 1);
+	face_ids_[slot] = face;
+	++site_count_;
+	
+	Idx resident_site_count = algorithm_.getResidentSiteCount();
+	max_resident_site_count_ = std::max(max_resident_site_count_, resident_site_count);
+	
+	while(algorithm_.hasPendingSite()) algorithm_.step();
+}
+
+template <typename PolicyT, typename VisitorT>
+void StreamingSweep<PolicyT, VisitorT>::finish() {
+	algorithm_.endSites();
+	algorithm_.finish();
+}
+
+template <typename PolicyT, typename VisitorT>
+Idx StreamingSweep<PolicyT, VisitorT>::getSiteCount() const {
+	return site_count_;
+}
+
+template <typename PolicyT, typename VisitorT>
+Idx StreamingSweep<PolicyT, VisitorT>::getResidentSiteCount() const {
+	return algorithm_.getResidentSiteCount();
+}
+
+template <typename PolicyT, typename VisitorT>
+Idx StreamingSweep<PolicyT, VisitorT>::getMaxResidentSiteCount() const {
+	return max_resident_site_count_;
+}
+
+template <typename PolicyT, typename VisitorT>
+MemoryUsage StreamingSweep<PolicyT, VisitorT>::getMemoryUsage() const {
+	return algorithm_.getMemoryUsage().getTotal() + face_ids_.getMemoryUsage();
+}
+
+template <typename PolicyT, typename VisitorT>
+StreamingSweep<PolicyT, VisitorT>::SlotVisitor_::SlotVisitor_(
+	StreamingSweep<PolicyT, VisitorT>& sweep
+)
+	: sweep_(sweep)
+{ }
+
+template <typename PolicyT, typename VisitorT>
+void StreamingSweep<PolicyT, VisitorT>::SlotVisitor_::onVertex(Idx vertex, const PointT& pos) {
+	sweep_.visitor_.onVertex(vertex, pos);
+}
+
+template <typename PolicyT, typename VisitorT>
+void StreamingSweep<PolicyT, VisitorT>::SlotVisitor_::onEdgeFinished(
+	Idx slot1, Idx slot2, Idx vertex1, Idx vertex2
+) {
+	sweep_.visitor_.onEdgeFinished(
+		sweep_.face_ids_[slot1],
+		sweep_.face_ids_[slot2],
+		vertex1,
+		vertex2
+	);
+}
+
+template <typename PolicyT, typename VisitorT>
+void StreamingSweep<PolicyT, VisitorT>::SlotVisitor_::onFaceClosed(Idx slot) {
+	sweep_.visitor_.onFaceClosed(sweep_.face_ids_[slot]);
+	
+	// A closed face has no arcs left, so its slot can be given to the next
+	// site although the event that closed it is still being handled.
+	sweep_.algorithm_.releaseSite(slot);
+}
+
+}
@@ -3,8 +3,12 @@
 
 #include <frivol/containers/array.hpp>
 #include <frivol/containers/dynamic_array.hpp>
+#include <frivol/memory_usage.hpp>
 #include <frivol/point.hpp>
 
+#include <stdexcept>
+#include <type_traits>
+
 namespace frivol {
 
 /// Structure for storing a Voronoi diagram. The diagram consists of faces
@@ -21,14 +25,61 @@ namespace frivol {
 /// 0...count-1. The ID of the faces should be the same as their corresponding
 /// input site indices.
 /// @tparam CoordT Coordinate type of the points stored in the Voronoi diagram.
-template <typename CoordT = double>
+/// @tparam AllocatorT The allocator used for the arrays of the diagram (see
+/// containers::Array). The diagram keeps the allocator given to its
+/// constructor, moves it along with the arrays and selects the allocator of
+/// a copy with select_on_container_copy_construction.
+/// @tparam IndexT The unsigned integer type in which the IDs are stored. A
+/// smaller type than Idx, such as std::uint32_t, makes the half-edges smaller
+/// but limits the IDs to be less than nilIndex<IndexT>(). The IDs are still
+/// passed and returned as Idx, with nil_idx for missing IDs.
+template <
+	typename CoordT = double,
+	typename AllocatorT = containers::DefaultAllocator,
+	typename IndexT = Idx
+>
 class VoronoiDiagram {
 public:
 	typedef Point<CoordT> PointT;
 	
+	static_assert(
+		std::is_integral<IndexT>::value && std::is_unsigned<IndexT>::value &&
+			sizeof(IndexT) <= sizeof(Idx),
+		"VoronoiDiagram: IndexT must be an unsigned integer type no larger than Idx."
+	);
+	
 	/// Constructs Voronoi diagram.
 	/// @param faces Number of faces.
-	VoronoiDiagram(Idx faces);
+	/// @param allocator The allocator used for the arrays of the diagram.
+	/// @throws std::logic_error if the face IDs do not fit in IndexT.
+	VoronoiDiagram(Idx faces, const AllocatorT& allocator = AllocatorT());
+	
+	/// Removes all edges and vertices and sets the number of faces, keeping
+	/// the allocated memory for reuse.
+	/// @param faces Number of faces.
+	/// @throws std::logic_error if the face IDs do not fit in IndexT.
+	void reset(Idx faces);
+	
+	/// Reserves memory so that edges can be added with addEdge and vertices
+	/// with addVertex without reallocating the storage.
+	/// @param edges The number of edges (pairs of twin half-edges).
+	/// @param vertices The number of Voronoi vertices.
+	void reserve(Idx edges, Idx vertices);
+	
+	/// Releases the memory reserved for edges and vertices that have not been
+	/// added. Useful when the diagram is kept for a long time after it has
+	/// been computed.
+	void shrinkToFit();
+	
+	/// Returns the memory allocated for the faces, edges and vertices.
+	MemoryUsage getMemoryUsage() const;
+	
+	/// Returns the number of bytes allocated by a new diagram after
+	/// reset(faces) and reserve(edges, vertices).
+	/// @param faces Number of faces.
+	/// @param edges The number of edges (pairs of twin half-edges).
+	/// @param vertices The number of Voronoi vertices.
+	static std::size_t estimateMemoryUsage(Idx faces, Idx edges, Idx vertices);
 	
 	/// Returns the number of faces in the diagram.
 	Idx getFaceCount() const;
@@ -82,11 +133,12 @@ public:
 	/// @param vertex ID of the Voronoi vertex.
 	const PointT& getVertexPosition(Idx vertex) const;
 	
-
+	
 	/// Adds a new edge (two twin half-edges) to the Voronoi diagram.
 	/// @param face1,face2 The IDs of the faces incident to the edge.
 	/// @returns the IDs of the new half-edges, first one having face1 and
 	/// the second one having face2 as incident face.
+	/// @throws std::logic_error if the half-edge IDs would not fit in IndexT.
 	std::pair<Idx, Idx> addEdge(Idx face1, Idx face2);
 	
 	/// Adds a new Voronoi vertex.
@@ -94,6 +146,7 @@ public:
 	/// @param edge1,edge2,edge3 The half-edges having the new vertex as end
 	/// vertex, in counterclockwise order.
 	/// @returns the ID of the new vertex.
+	/// @throws std::logic_error if the vertex ID would not fit in IndexT.
 	Idx addVertex(const PointT& pos, Idx edge1, Idx edge2, Idx edge3);
 	
 	/// Mark half-edges as being consecutive. Done automatically by addVertex
@@ -104,35 +157,35 @@ public:
 	
 private:
 	/// Data stored for each half-edge of the Voronoi diagram. If a member has
-	/// not yet been populated, nil_idx is stored.
+	/// not yet been populated, nilIndex<IndexT>() is stored.
 	struct Edge {
-		/// Index of the vertex in which the half-edge ends. Has value nil_idx
-		/// if the half-edge ends in infinity.
-		Idx end_vertex;
+		/// Index of the vertex in which the half-edge ends. Has value
+		/// nilIndex<IndexT>() if the half-edge ends in infinity.
+		IndexT end_vertex;
 		
 		/// Index of the incident face.
-		Idx face;
+		IndexT face;
 		
 		/// The next half-edge (from end_vertex) around 'face'. Can be
 		/// disconnected from this half-edge if this half-edge ends in infinity.
-		Idx next_edge;
+		IndexT next_edge;
 		
 		/// The previous half-edge (to start_vertex) around 'face'. Can be
 		/// disconnected from this half-edge if this half-edge starts in infinity.
-		Idx prev_edge;
+		IndexT prev_edge;
 	};
 	
 	
 	/// Index of one boundary edge for each face. If no edges has been found for
-	/// a site, nil_idx is stored.
-	containers::Array<Idx> face_boundary_edge_;
+	/// a site, nilIndex<IndexT>() is stored.
+	containers::DynamicArray<IndexT, AllocatorT> face_boundary_edge_;
 	
 	/// Information for each half-edge. The twin half-edges should always be in
 	/// pairs, so that 2i and 2i+1 are twins for all i.
-	containers::DynamicArray<Edge> edges_;
+	containers::DynamicArray<Edge, AllocatorT> edges_;
 	
 	/// The positions of the Voronoi vertices.
-	containers::DynamicArray<PointT> vertex_pos_;
+	containers::DynamicArray<PointT, AllocatorT> vertex_pos_;
 };
 
 }
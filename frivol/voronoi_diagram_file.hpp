@@ -0,0 +1,183 @@
+#ifndef FRIVOL_VORONOI_DIAGRAM_FILE_HPP
+#define FRIVOL_VORONOI_DIAGRAM_FILE_HPP
+
+#include <frivol/common.hpp>
+#include <frivol/containers/array.hpp>
+#include <frivol/voronoi_diagram.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace frivol {
+
+/// Header of the binary file format of Voronoi diagrams, written by
+/// writeVoronoiDiagram and read by MappedVoronoiDiagram. All numbers in the
+/// file are little-endian. The file consists of
+///  - the header of 'size' bytes, starting with the 8 bytes "FRIVOLVD" and
+///    followed by the fields in the order of declaration below, with zero
+///    bytes up to 'size',
+///  - the half-edges at edges_offset, each as four IDs: the end vertex, the
+///    incident face, the next and the previous half-edge (see
+///    VoronoiDiagram),
+///  - the vertex positions at vertices_offset, each as the X and Y
+///    coordinates,
+///  - a boundary half-edge of each face at faces_offset.
+///
+/// The IDs are unsigned integers of index_size bytes, with the all-ones
+/// value for missing IDs. The sections start at multiples of 'alignment'
+/// bytes, so that the file can be used in place when it is mapped to
+/// memory. Readers must reject files with a different version.
+struct VoronoiDiagramFileHeader {
+	/// The size of the header in bytes.
+	static constexpr std::size_t size = 128;
+	
+	/// The alignment of the sections in bytes.
+	static constexpr std::size_t alignment = 64;
+	
+	/// The version of the format described here.
+	static constexpr std::uint32_t current_version = 1;
+	
+	/// Values of coord_type.
+	enum CoordType : std::uint32_t {
+		unsigned_integer = 0,
+		signed_integer = 1,
+		floating_point = 2
+	};
+	
+	std::uint32_t version;         ///< The version of the format.
+	std::uint32_t index_size;      ///< The size of the IDs in bytes.
+	std::uint32_t coord_size;      ///< The size of the coordinates in bytes.
+	std::uint32_t coord_type;      ///< The CoordType of the coordinates.
+	std::uint64_t face_count;      ///< The number of faces.
+	std::uint64_t edge_count;      ///< The number of half-edges.
+	std::uint64_t vertex_count;    ///< The number of Voronoi vertices.
+	std::uint64_t edges_offset;    ///< The byte offset of the half-edges.
+	std::uint64_t vertices_offset; ///< The byte offset of the vertices.
+	std::uint64_t faces_offset;    ///< The byte offset of the faces.
+	std::uint64_t file_size;       ///< The size of the file in bytes.
+	
+	/// Constructs the header of a file for a diagram of given size, with
+	/// the sections laid out after each other.
+	/// @tparam CoordT The coordinate type, which must be arithmetic.
+	/// @tparam IndexT The unsigned integer type of the IDs.
+	/// @param faces The number of faces.
+	/// @param edges The number of half-edges.
+	/// @param vertices The number of Voronoi vertices.
+	template <typename CoordT, typename IndexT>
+	static VoronoiDiagramFileHeader create(Idx faces, Idx edges, Idx vertices);
+	
+	/// Writes the header to 'size' bytes.
+	/// @param bytes The destination.
+	void encode(unsigned char* bytes) const;
+	
+	/// Reads a header from 'size' bytes and checks that it describes a file
+	/// of this version with given types and size.
+	/// @tparam CoordT The expected coordinate type.
+	/// @tparam IndexT The expected type of the IDs.
+	/// @param bytes The header bytes.
+	/// @param file_size The size of the file.
+	/// @throws std::runtime_error if the header is not valid.
+	template <typename CoordT, typename IndexT>
+	static VoronoiDiagramFileHeader decode(const unsigned char* bytes, std::uint64_t file_size);
+	
+	/// Returns the CoordType of type CoordT.
+	template <typename CoordT>
+	static std::uint32_t getCoordType();
+	
+private:
+	/// Rounds a byte offset up to a multiple of 'alignment'.
+	/// @param offset The offset.
+	static std::uint64_t alignOffset_(std::uint64_t offset);
+};
+
+/// Reads a little-endian number.
+/// @tparam T An arithmetic type.
+/// @param bytes The first of the sizeof(T) bytes of the number.
+template <typename T>
+T loadLittleEndian(const unsigned char* bytes);
+
+/// Writes a number as little-endian.
+/// @tparam T An arithmetic type.
+/// @param bytes The first of the sizeof(T) destination bytes.
+/// @param value The number.
+template <typename T>
+void storeLittleEndian(unsigned char* bytes, T value);
+
+/// Buffered writer of little-endian numbers to a binary file.
+class LittleEndianFileWriter {
+public:
+	/// Creates or truncates a file for writing.
+	/// @param path The path of the file.
+	/// @throws std::runtime_error if the file cannot be opened.
+	LittleEndianFileWriter(const std::string& path);
+	
+	LittleEndianFileWriter(const LittleEndianFileWriter&) = delete;
+	LittleEndianFileWriter& operator=(const LittleEndianFileWriter&) = delete;
+	
+	/// Closes the file if close() has not been called. Write errors are not
+	/// reported in that case.
+	~LittleEndianFileWriter();
+	
+	/// Writes a number.
+	/// @tparam T An arithmetic type.
+	/// @param value The number.
+	/// @throws std::runtime_error if writing fails.
+	template <typename T>
+	void write(T value);
+	
+	/// Writes bytes as is.
+	/// @param bytes The bytes.
+	/// @param count The number of bytes.
+	/// @throws std::runtime_error if writing fails.
+	void writeBytes(const unsigned char* bytes, std::size_t count);
+	
+	/// Writes zero bytes until given position.
+	/// @param position The byte position, at least getPosition().
+	/// @throws std::runtime_error if writing fails.
+	void padTo(std::uint64_t position);
+	
+	/// Returns the number of bytes written.
+	std::uint64_t getPosition() const;
+	
+	/// Writes the buffered bytes and closes the file.
+	/// @throws std::runtime_error if writing fails.
+	void close();
+	
+private:
+	/// Writes the buffered bytes to the file.
+	void flush_();
+	
+	/// The open file, or nullptr after close().
+	std::FILE* file_;
+	
+	/// The path of the file for the error messages.
+	std::string path_;
+	
+	/// The bytes not written yet are at 0, ..., buffer_end_-1.
+	containers::Array<unsigned char> buffer_;
+	std::size_t buffer_end_;
+	
+	/// The number of bytes written, including the buffered bytes.
+	std::uint64_t position_;
+};
+
+/// Writes a Voronoi diagram to a file in the format described in
+/// VoronoiDiagramFileHeader, to be mapped to memory with
+/// MappedVoronoiDiagram.
+/// @param diagram The diagram. Its coordinate type must be arithmetic.
+/// @param path The path of the file.
+/// @throws std::runtime_error if writing the file fails.
+template <typename CoordT, typename AllocatorT, typename IndexT>
+void writeVoronoiDiagram(
+	const VoronoiDiagram<CoordT, AllocatorT, IndexT>& diagram,
+	const std::string& path
+);
+
+}
+
+#include "voronoi_diagram_file_impl.hpp"
+
+#endif
@@ -0,0 +1,263 @@
+#include <algorithm>
+#include <cstring>
+
+// The file format is little-endian, so the bytes are reversed on big-endian
+// hosts. Elsewhere the numbers are copied as is.
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define FRIVOL_BIG_ENDIAN_HOST
+#endif
+
+namespace frivol {
+
+constexpr std::size_t VoronoiDiagramFileHeader::size;
+constexpr std::size_t VoronoiDiagramFileHeader::alignment;
+constexpr std::uint32_t VoronoiDiagramFileHeader::current_version;
+
+template <typename CoordT, typename IndexT>
+VoronoiDiagramFileHeader VoronoiDiagramFileHeader::create(Idx faces, Idx edges, Idx vertices) {
+	VoronoiDiagramFileHeader header;
+	header.version = current_version;
+	header.index_size = sizeof(IndexT);
+	header.coord_size = sizeof(CoordT);
+	header.coord_type = getCoordType<CoordT>();
+	header.face_count = faces;
+	header.edge_count = edges;
+	header.vertex_count = vertices;
+	header.edges_offset = alignOffset_(size);
+	header.vertices_offset = alignOffset_(header.edges_offset + (std::uint64_t)edges * 4 * sizeof(IndexT));
+	header.faces_offset = alignOffset_(header.vertices_offset + (std::uint64_t)vertices * 2 * sizeof(CoordT));
+	header.file_size = header.faces_offset + (std::uint64_t)faces * sizeof(IndexT);
+	return header;
+}
+
+inline void VoronoiDiagramFileHeader::encode(unsigned char* bytes) const {
+	std::fill(bytes, bytes + size, 0);
+	std::memcpy(bytes, "FRIVOLVD", 8);
+	storeLittleEndian(bytes + 8, version);
+	storeLittleEndian(bytes + 12, index_size);
+	storeLittleEndian(bytes + 16, coord_size);
+	storeLittleEndian(bytes + 20, coord_type);
+	storeLittleEndian(bytes + 24, face_count);
+	storeLittleEndian(bytes + 32, edge_count);
+	storeLittleEndian(bytes + 40, vertex_count);
+	storeLittleEndian(bytes + 48, edges_offset);
+	storeLittleEndian(bytes + 56, vertices_offset);
+	storeLittleEndian(bytes + 64, faces_offset);
+	storeLittleEndian(bytes + 72, file_size);
+}
+
+template <typename CoordT, typename IndexT>
+VoronoiDiagramFileHeader VoronoiDiagramFileHeader::decode(
+	const unsigned char* bytes,
+	std::uint64_t file_size
+) {
+	if(file_size < size || std::memcmp(bytes, "FRIVOLVD", 8) != 0) {
+		throw std::runtime_error("VoronoiDiagramFileHeader::decode: not a Voronoi diagram file.");
+	}
+	
+	VoronoiDiagramFileHeader header;
+	header.version = loadLittleEndian<std::uint32_t>(bytes + 8);
+	header.index_size = loadLittleEndian<std::uint32_t>(bytes + 12);
+	header.coord_size = loadLittleEndian<std::uint32_t>(bytes + 16);
+	header.coord_type = loadLittleEndian<std::uint32_t>(bytes + 20);
+	header.face_count = loadLittleEndian<std::uint64_t>(bytes + 24);
+	header.edge_count = loadLittleEndian<std::uint64_t>(bytes + 32);
+	header.vertex_count = loadLittleEndian<std::uint64_t>(bytes + 40);
+	header.edges_offset = loadLittleEndian<std::uint64_t>(bytes + 48);
+	header.vertices_offset = loadLittleEndian<std::uint64_t>(bytes + 56);
+	header.faces_offset = loadLittleEndian<std::uint64_t>(bytes + 64);
+	header.file_size = loadLittleEndian<std::uint64_t>(bytes + 72);
+	
+	if(header.version != current_version) {
+		throw std::runtime_error("VoronoiDiagramFileHeader::decode: unsupported version.");
+	}
+	if(
+		header.index_size != sizeof(IndexT) ||
+		header.coord_size != sizeof(CoordT) ||
+		header.coord_type != getCoordType<CoordT>()
+	) {
+		throw std::runtime_error("VoronoiDiagramFileHeader::decode: the index or coordinate type does not match.");
+	}
+	
+	// The counts must fit in the index type and the sections in the file.
+	// The sections are bounded by division before create() multiplies the
+	// counts, so that huge counts cannot wrap the offsets around to a layout
+	// that seems valid.
+	if(
+		header.face_count > (std::uint64_t)nilIndex<IndexT>() ||
+		header.edge_count > (std::uint64_t)nilIndex<IndexT>() ||
+		header.vertex_count > (std::uint64_t)nilIndex<IndexT>() ||
+		header.edge_count % 2 != 0
+	) {
+		throw std::runtime_error("VoronoiDiagramFileHeader::decode: invalid numbers of IDs.");
+	}
+	std::uint64_t section_offset = alignOffset_(size);
+	auto checkSection = [&section_offset, file_size](std::uint64_t count, std::uint64_t record_size) {
+		if(section_offset > file_size || count > (file_size - section_offset) / record_size) {
+			throw std::runtime_error("VoronoiDiagramFileHeader::decode: the file is truncated.");
+		}
+		section_offset = alignOffset_(section_offset + count * record_size);
+	};
+	checkSection(header.edge_count, 4 * sizeof(IndexT));
+	checkSection(header.vertex_count, 2 * sizeof(CoordT));
+	checkSection(header.face_count, sizeof(IndexT));
+	
+	// The layout must be the one create() gives.
+	VoronoiDiagramFileHeader expected = create<CoordT, IndexT>(
+		header.face_count, header.edge_count, header.vertex_count
+	);
+	if(
+		header.edges_offset != expected.edges_offset ||
+		header.vertices_offset != expected.vertices_offset ||
+		header.faces_offset != expected.faces_offset ||
+		header.file_size != expected.file_size
+	) {
+		throw std::runtime_error("VoronoiDiagramFileHeader::decode: invalid section layout.");
+	}
+	if(header.file_size > file_size) {
+		throw std::runtime_error("VoronoiDiagramFileHeader::decode: the file is truncated.");
+	}
+	
+	return header;
+}
+
+inline std::uint64_t VoronoiDiagramFileHeader::alignOffset_(std::uint64_t offset) {
+	return (offset + alignment - 1) / alignment * alignment;
+}
+
+template <typename CoordT>
+std::uint32_t VoronoiDiagramFileHeader::getCoordType() {
+	static_assert(
+		std::is_arithmetic<CoordT>::value,
+		"VoronoiDiagramFileHeader: the coordinate type must be arithmetic."
+	);
+	if(std::is_floating_point<CoordT>::value) return floating_point;
+	return std::is_signed<CoordT>::value ? signed_integer : unsigned_integer;
+}
+
+template <typename T>
+T loadLittleEndian(const unsigned char* bytes) {
+	static_assert(std::is_arithmetic<T>::value, "loadLittleEndian: T must be arithmetic.");
+	
+	T value;
+#ifdef FRIVOL_BIG_ENDIAN_HOST
+	unsigned char reversed[sizeof(T)];
+	std::reverse_copy(bytes, bytes + sizeof(T), reversed);
+	std::memcpy(&value, reversed, sizeof(T));
+#else
+	std::memcpy(&value, bytes, sizeof(T));
+#endif
+	return value;
+}
+
+template <typename T>
+void storeLittleEndian(unsigned char* bytes, T value) {
+	static_assert(std::is_arithmetic<T>::value, "storeLittleEndian: T must be arithmetic.");
+	
+	std::memcpy(bytes, &value, sizeof(T));
+#ifdef FRIVOL_BIG_ENDIAN_HOST
+	std::reverse(bytes, bytes + sizeof(T));
+#endif
+}
+
+inline LittleEndianFileWriter::LittleEndianFileWriter(const std::string& path)
+	: path_(path),
+	  buffer_(65536),
+	  buffer_end_(0),
+	  position_(0)
+{
+	file_ = std::fopen(path.c_str(), "wb");
+	if(file_ == nullptr) {
+		throw std::runtime_error("LittleEndianFileWriter: cannot open " + path + ".");
+	}
+}
+
+inline LittleEndianFileWriter::~LittleEndianFileWriter() {
+	if(file_ != nullptr) std::fclose(file_);
+}
+
+template <typename T>
+void LittleEndianFileWriter::write(T value) {
+	if(buffer_end_ + sizeof(T) > buffer_.getSize()) flush_();
+	storeLittleEndian(&buffer_[buffer_end_], value);
+	buffer_end_ += sizeof(T);
+	position_ += sizeof(T);
+}
+
+inline void LittleEndianFileWriter::writeBytes(const unsigned char* bytes, std::size_t count) {
+	for(std::size_t i = 0; i < count; ++i) {
+		write(bytes[i]);
+	}
+}
+
+inline void LittleEndianFileWriter::padTo(std::uint64_t position) {
+	while(position_ < position) {
+		write((unsigned char)0);
+	}
+}
+
+inline std::uint64_t LittleEndianFileWriter::getPosition() const {
+	return position_;
+}
+
+inline void LittleEndianFileWriter::close() {
+	if(file_ == nullptr) return;
+	
+	flush_();
+	int result = std::fclose(file_);
+	file_ = nullptr;
+	if(result != 0) {
+		throw std::runtime_error("LittleEndianFileWriter::close: cannot write " + path_ + ".");
+	}
+}
+
+inline void LittleEndianFileWriter::flush_() {
+	if(buffer_end_ == 0) return;
+	
+	std::size_t count = buffer_end_;
+	buffer_end_ = 0;
+	if(std::fwrite(&buffer_[0], 1, count, file_) != count) {
+		throw std::runtime_error("LittleEndianFileWriter::write: cannot write " + path_ + ".");
+	}
+}
+
+template <typename CoordT, typename AllocatorT, typename IndexT>
+void writeVoronoiDiagram(
+	const VoronoiDiagram<CoordT, AllocatorT, IndexT>& diagram,
+	const std::string& path
+) {
+	VoronoiDiagramFileHeader header = VoronoiDiagramFileHeader::create<CoordT, IndexT>(
+		diagram.getFaceCount(),
+		diagram.getEdgeCount(),
+		diagram.getVertexCount()
+	);
+	
+	LittleEndianFileWriter writer(path);
+	unsigned char header_bytes[VoronoiDiagramFileHeader::size];
+	header.encode(header_bytes);
+	writer.writeBytes(header_bytes, VoronoiDiagramFileHeader::size);
+	
+	writer.padTo(header.edges_offset);
+	for(Idx edge = 0; edge < diagram.getEdgeCount(); ++edge) {
+		writer.write(compactIndex<IndexT>(diagram.getEndVertex(edge)));
+		writer.write(compactIndex<IndexT>(diagram.getIncidentFace(edge)));
+		writer.write(compactIndex<IndexT>(diagram.getNextEdge(edge)));
+		writer.write(compactIndex<IndexT>(diagram.getPreviousEdge(edge)));
+	}
+	
+	writer.padTo(header.vertices_offset);
+	for(Idx vertex = 0; vertex < diagram.getVertexCount(); ++vertex) {
+		const Point<CoordT>& pos = diagram.getVertexPosition(vertex);
+		writer.write(pos.x);
+		writer.write(pos.y);
+	}
+	
+	writer.padTo(header.faces_offset);
+	for(Idx face = 0; face < diagram.getFaceCount(); ++face) {
+		writer.write(compactIndex<IndexT>(diagram.getFaceBoundaryEdge(face)));
+	}
+	
+	writer.close();
+}
+
+}
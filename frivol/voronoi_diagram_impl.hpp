@@ -1,107 +1,155 @@
 namespace frivol {
 
-template <typename CoordT>
-VoronoiDiagram<CoordT>::VoronoiDiagram(Idx faces)
-	: face_boundary_edge_(faces)
+template <typename CoordT, typename AllocatorT, typename IndexT>
+VoronoiDiagram<CoordT, AllocatorT, IndexT>::VoronoiDiagram(Idx faces, const AllocatorT& allocator)
+	: face_boundary_edge_(allocator),
+	  edges_(allocator),
+	  vertex_pos_(allocator)
 {
+	reset(faces);
+}
+
+template <typename CoordT, typename AllocatorT, typename IndexT>
+void VoronoiDiagram<CoordT, AllocatorT, IndexT>::reset(Idx faces) {
+	if(faces > (Idx)nilIndex<IndexT>()) {
+		throw std::logic_error("VoronoiDiagram::reset: too many faces for the index type.");
+	}
+	
+	face_boundary_edge_.resize(faces);
 	for(Idx i = 0; i < faces; ++i) {
-		face_boundary_edge_[i] = nil_idx;
+		face_boundary_edge_[i] = nilIndex<IndexT>();
 	}
+	edges_.clear();
+	vertex_pos_.clear();
+}
+
+template <typename CoordT, typename AllocatorT, typename IndexT>
+void VoronoiDiagram<CoordT, AllocatorT, IndexT>::reserve(Idx edges, Idx vertices) {
+	edges_.reserve(2 * edges);
+	vertex_pos_.reserve(vertices);
+}
+
+template <typename CoordT, typename AllocatorT, typename IndexT>
+void VoronoiDiagram<CoordT, AllocatorT, IndexT>::shrinkToFit() {
+	face_boundary_edge_.shrinkToFit();
+	edges_.shrinkToFit();
+	vertex_pos_.shrinkToFit();
 }
 
-template <typename CoordT>
-Idx VoronoiDiagram<CoordT>::getFaceCount() const {
+template <typename CoordT, typename AllocatorT, typename IndexT>
+MemoryUsage VoronoiDiagram<CoordT, AllocatorT, IndexT>::getMemoryUsage() const {
+	return
+		face_boundary_edge_.getMemoryUsage() + edges_.getMemoryUsage() +
+		vertex_pos_.getMemoryUsage();
+}
+
+template <typename CoordT, typename AllocatorT, typename IndexT>
+std::size_t VoronoiDiagram<CoordT, AllocatorT, IndexT>::estimateMemoryUsage(Idx faces, Idx edges, Idx vertices) {
+	return faces * sizeof(IndexT) + 2 * edges * sizeof(Edge) + vertices * sizeof(PointT);
+}
+
+template <typename CoordT, typename AllocatorT, typename IndexT>
+Idx VoronoiDiagram<CoordT, AllocatorT, IndexT>::getFaceCount() const {
 	return face_boundary_edge_.getSize();
 }
 
-template <typename CoordT>
-Idx VoronoiDiagram<CoordT>::getEdgeCount() const {
+template <typename CoordT, typename AllocatorT, typename IndexT>
+Idx VoronoiDiagram<CoordT, AllocatorT, IndexT>::getEdgeCount() const {
 	return edges_.getSize();
 }
 
-template <typename CoordT>
-Idx VoronoiDiagram<CoordT>::getVertexCount() const {
+template <typename CoordT, typename AllocatorT, typename IndexT>
+Idx VoronoiDiagram<CoordT, AllocatorT, IndexT>::getVertexCount() const {
 	return vertex_pos_.getSize();
 }
 
-template <typename CoordT>
-Idx VoronoiDiagram<CoordT>::getFaceBoundaryEdge(Idx face) const {
-	return face_boundary_edge_[face];
+template <typename CoordT, typename AllocatorT, typename IndexT>
+Idx VoronoiDiagram<CoordT, AllocatorT, IndexT>::getFaceBoundaryEdge(Idx face) const {
+	return expandIndex(face_boundary_edge_[face]);
 }
 
-template <typename CoordT>
-Idx VoronoiDiagram<CoordT>::getTwinEdge(Idx edge) const {
+template <typename CoordT, typename AllocatorT, typename IndexT>
+Idx VoronoiDiagram<CoordT, AllocatorT, IndexT>::getTwinEdge(Idx edge) const {
 	// Flipping first bit adds one to even numbers and subtracts one from odd
 	// numbers.
 	return edge ^ 1;
 }
 
-template <typename CoordT>
-Idx VoronoiDiagram<CoordT>::getIncidentFace(Idx edge) const {
+template <typename CoordT, typename AllocatorT, typename IndexT>
+Idx VoronoiDiagram<CoordT, AllocatorT, IndexT>::getIncidentFace(Idx edge) const {
 	return edges_[edge].face;
 }
 
-template <typename CoordT>
-Idx VoronoiDiagram<CoordT>::getStartVertex(Idx edge) const {
-	return edges_[getTwinEdge(edge)].end_vertex;
+template <typename CoordT, typename AllocatorT, typename IndexT>
+Idx VoronoiDiagram<CoordT, AllocatorT, IndexT>::getStartVertex(Idx edge) const {
+	return expandIndex(edges_[getTwinEdge(edge)].end_vertex);
 }
 
-template <typename CoordT>
-Idx VoronoiDiagram<CoordT>::getEndVertex(Idx edge) const {
-	return edges_[edge].end_vertex;
+template <typename CoordT, typename AllocatorT, typename IndexT>
+Idx VoronoiDiagram<CoordT, AllocatorT, IndexT>::getEndVertex(Idx edge) const {
+	return expandIndex(edges_[edge].end_vertex);
 }
 
-template <typename CoordT>
-Idx VoronoiDiagram<CoordT>::getNextEdge(Idx edge) const {
-	return edges_[edge].next_edge;
+template <typename CoordT, typename AllocatorT, typename IndexT>
+Idx VoronoiDiagram<CoordT, AllocatorT, IndexT>::getNextEdge(Idx edge) const {
+	return expandIndex(edges_[edge].next_edge);
 }
 
-template <typename CoordT>
-Idx VoronoiDiagram<CoordT>::getPreviousEdge(Idx edge) const {
-	return edges_[edge].prev_edge;
+template <typename CoordT, typename AllocatorT, typename IndexT>
+Idx VoronoiDiagram<CoordT, AllocatorT, IndexT>::getPreviousEdge(Idx edge) const {
+	return expandIndex(edges_[edge].prev_edge);
 }
 
-template <typename CoordT>
-const Point<CoordT>& VoronoiDiagram<CoordT>::getVertexPosition(Idx vertex) const {
+template <typename CoordT, typename AllocatorT, typename IndexT>
+const Point<CoordT>& VoronoiDiagram<CoordT, AllocatorT, IndexT>::getVertexPosition(Idx vertex) const {
 	return vertex_pos_[vertex];
 }
 
-template <typename CoordT>
-std::pair<Idx, Idx> VoronoiDiagram<CoordT>::addEdge(Idx face1, Idx face2) {
+template <typename CoordT, typename AllocatorT, typename IndexT>
+std::pair<Idx, Idx> VoronoiDiagram<CoordT, AllocatorT, IndexT>::addEdge(Idx face1, Idx face2) {
+	// The ID of the second half-edge must be less than nilIndex<IndexT>().
+	if(edges_.getSize() + 1 >= (Idx)nilIndex<IndexT>()) {
+		throw std::logic_error("VoronoiDiagram::addEdge: too many edges for the index type.");
+	}
+	
 	Edge edge1, edge2;
 	
-	edge1.face = face1;
-	edge2.face = face2;
+	edge1.face = compactIndex<IndexT>(face1);
+	edge2.face = compactIndex<IndexT>(face2);
 	
-	edge1.end_vertex = nil_idx;
-	edge2.end_vertex = nil_idx;
-	edge1.next_edge = nil_idx;
-	edge2.next_edge = nil_idx;
-	edge1.prev_edge = nil_idx;
-	edge2.prev_edge = nil_idx;
+	edge1.end_vertex = nilIndex<IndexT>();
+	edge2.end_vertex = nilIndex<IndexT>();
+	edge1.next_edge = nilIndex<IndexT>();
+	edge2.next_edge = nilIndex<IndexT>();
+	edge1.prev_edge = nilIndex<IndexT>();
+	edge2.prev_edge = nilIndex<IndexT>();
 	
 	Idx id1 = edges_.add(edge1);
 	Idx id2 = edges_.add(edge2);
 	
-	if(face_boundary_edge_[face1] == nil_idx) {
-		face_boundary_edge_[face1] = id1;
+	if(face_boundary_edge_[face1] == nilIndex<IndexT>()) {
+		face_boundary_edge_[face1] = compactIndex<IndexT>(id1);
 	}
-	if(face_boundary_edge_[face2] == nil_idx) {
-		face_boundary_edge_[face2] = id2;
+	if(face_boundary_edge_[face2] == nilIndex<IndexT>()) {
+		face_boundary_edge_[face2] = compactIndex<IndexT>(id2);
 	}
 	
 	return std::make_pair(id1, id2);
 }
 
-template <typename CoordT>
-Idx VoronoiDiagram<CoordT>::addVertex(
+template <typename CoordT, typename AllocatorT, typename IndexT>
+Idx VoronoiDiagram<CoordT, AllocatorT, IndexT>::addVertex(
 	const PointT& pos, Idx edge1, Idx edge2, Idx edge3
 ) {
+	if(vertex_pos_.getSize() >= (Idx)nilIndex<IndexT>()) {
+		throw std::logic_error("VoronoiDiagram::addVertex: too many vertices for the index type.");
+	}
+	
 	Idx vertex = vertex_pos_.add(pos);
 	
-	edges_[edge1].end_vertex = vertex;
-	edges_[edge2].end_vertex = vertex;
-	edges_[edge3].end_vertex = vertex;
+	edges_[edge1].end_vertex = compactIndex<IndexT>(vertex);
+	edges_[edge2].end_vertex = compactIndex<IndexT>(vertex);
+	edges_[edge3].end_vertex = compactIndex<IndexT>(vertex);
 	
 	consecutiveEdges(edge1, getTwinEdge(edge3));
 	consecutiveEdges(edge2, getTwinEdge(edge1));
@@ -110,10 +158,10 @@ Idx VoronoiDiagram<CoordT>::addVertex(
 	return vertex;
 }
 
-template <typename CoordT>
-void VoronoiDiagram<CoordT>::consecutiveEdges(Idx edge1, Idx edge2) {
-	edges_[edge1].next_edge = edge2;
-	edges_[edge2].prev_edge = edge1;
+template <typename CoordT, typename AllocatorT, typename IndexT>
+void VoronoiDiagram<CoordT, AllocatorT, IndexT>::consecutiveEdges(Idx edge1, Idx edge2) {
+	edges_[edge1].next_edge = compactIndex<IndexT>(edge2);
+	edges_[edge2].prev_edge = compactIndex<IndexT>(edge1);
 }
 
 }
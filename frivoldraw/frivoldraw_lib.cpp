@@ -4,20 +4,22 @@
 struct Voronoi {
 	Voronoi() : diagram(0) { }
 	
-	frivol::containers::Array<frivol::Point<>> sites; // Array of the sites.
+	frivol::SiteView<> sites; // View of the sites in the caller's buffer.
 	frivol::VoronoiDiagram<> diagram; // The voronoi diagram.
 };
 
 // Get endpoint of infinite edge between site1 and site2.
 std::pair<double, double> getInfinitePoint(
-	const frivol::containers::Array<frivol::Point<>>& sites,
+	const frivol::SiteView<>& sites,
 	frivol::Idx site1,
 	frivol::Idx site2
 ) {
-	double midx = 0.5 * (sites[site1].x + sites[site2].x);
-	double midy = 0.5 * (sites[site1].y + sites[site2].y);
-	double dx = sites[site2].x - sites[site1].x;
-	double dy = sites[site2].y - sites[site1].y;
+	frivol::Point<> p1 = sites[site1];
+	frivol::Point<> p2 = sites[site2];
+	double midx = 0.5 * (p1.x + p2.x);
+	double midy = 0.5 * (p1.y + p2.y);
+	double dx = p2.x - p1.x;
+	double dy = p2.y - p1.y;
 	double coef;
 	if(std::abs(dx) > std::abs(dy)) {
 		coef = 1e5 / std::abs(dx);
@@ -32,15 +34,11 @@ extern "C" {
 
 // Compute a Voronoi diagram of 'site_count' sites from array 'sites' and
 // (each point occupies two indices, first one is X coordinate and the second Y).
-// The returned pointer must be freed by frivoldraw_FreeDiagram.
+// The returned pointer must be freed by frivoldraw_FreeDiagram. The sites are
+// not copied, so 'sites' must stay valid until then.
 Voronoi* frivoldraw_ComputeVoronoi(double* sites, int site_count) {
 	Voronoi* voronoi = new Voronoi();
-	voronoi->sites.resize(site_count);
-	double* sites_pos = sites;
-	for(int sitei = 0; sitei < site_count; ++sitei) {
-		voronoi->sites[sitei].x = *(sites_pos++);
-		voronoi->sites[sitei].y = *(sites_pos++);
-	}
+	voronoi->sites = frivol::SiteView<>(sites, sites + 1, site_count, 2 * sizeof(double));
 	voronoi->diagram = std::move(frivol::computeVoronoiDiagram<>(voronoi->sites));
 	return voronoi;
 }
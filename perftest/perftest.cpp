@@ -1,10 +1,17 @@
 #include <frivol/frivol.hpp>
 #include <frivol/containers/priority_queues/dummy_priority_queue.hpp>
 #include <frivol/containers/search_trees/dummy_search_tree.hpp>
+#include <frivol/containers/search_trees/flat_search_tree.hpp>
 #include <fstream>
 #include <random>
 #include <chrono>
+#include <cmath>
 #include <iostream>
+#include <string>
+
+#ifdef __unix__
+#include <sys/resource.h>
+#endif
 
 // Return the number of seconds it takes to run 'func'. Runs 'func' repeatedly
 // until 'time' seconds has elapsed.
@@ -23,10 +30,174 @@ double getExecutionTime(FuncT func, double time) {
 	return elapsed / (double)times;
 }
 
-int main() {
+// Return the time it takes to compute the Voronoi diagram of 'sites' using
+// PolicyT.
+template <typename PolicyT>
+double getPolicyExecutionTime(
+	const frivol::containers::Array<frivol::Point<>>& sites,
+	double time
+) {
+	return getExecutionTime([&]() {
+		frivol::computeVoronoiDiagram<PolicyT>(sites);
+	}, time);
+}
+
+// Return the peak resident set size of the process in bytes, or 0 if it is
+// not available.
+std::size_t getPeakRSS() {
+#ifdef __unix__
+	rusage usage;
+	if(getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+	return (std::size_t)usage.ru_maxrss * 1024;
+#else
+	return 0;
+#endif
+}
+
+// Return 'sitecount' sites sampled uniformly from the unit square.
+frivol::containers::Array<frivol::Point<>> generateUniformSites(int sitecount, std::mt19937& rng) {
+	std::uniform_real_distribution<double> dist(0, 1);
+	
+	frivol::containers::Array<frivol::Point<>> sites(sitecount);
+	for(int sitei = 0; sitei < sitecount; ++sitei) {
+		sites[sitei] = frivol::Point<>(dist(rng), dist(rng));
+	}
+	return sites;
+}
+
+// Return 'sitecount' sites sampled from 10 small gaussian clusters.
+frivol::containers::Array<frivol::Point<>> generateClusteredSites(int sitecount, std::mt19937& rng) {
+	std::normal_distribution<double> dist(0, 0.01);
+	
+	frivol::containers::Array<frivol::Point<>> sites(sitecount);
+	for(int sitei = 0; sitei < sitecount; ++sitei) {
+		int cluster = sitei % 10;
+		sites[sitei] = frivol::Point<>(
+			0.1 * cluster + dist(rng),
+			std::fmod(0.37 * cluster * cluster, 1.0) + dist(rng)
+		);
+	}
+	return sites;
+}
+
+// Return 'sitecount' sites with uniform X and exponentially skewed Y
+// coordinates, so that most of the sites are near the top of the range.
+frivol::containers::Array<frivol::Point<>> generateSkewedSites(int sitecount, std::mt19937& rng) {
+	std::uniform_real_distribution<double> dist(0, 1);
+	
+	frivol::containers::Array<frivol::Point<>> sites(sitecount);
+	for(int sitei = 0; sitei < sitecount; ++sitei) {
+		sites[sitei] = frivol::Point<>(dist(rng), std::exp(30 * dist(rng)));
+	}
+	return sites;
+}
+
+// Record the run times of the event priority queues against the site count
+// for uniform, clustered and skewed sites. Each line of the output files has
+// the site count and the run times with BinaryHeap, DAryHeap and
+// CalendarQueue (all with PooledAVLTree).
+int runDistributionTest() {
+	typedef frivol::containers::Array<frivol::Point<>> (*GeneratorT)(int, std::mt19937&);
+	const char* const names[3] = {"uniform", "clustered", "skewed"};
+	const GeneratorT generators[3] = {
+		generateUniformSites, generateClusteredSites, generateSkewedSites
+	};
+	
+	std::mt19937 rng;
+	
+	for(int distribution = 0; distribution < 3; ++distribution) {
+		std::ofstream out(std::string(names[distribution]) + "_queues_out.txt");
+		
+		for(int sitecount = 1000; sitecount <= 1000000; sitecount += sitecount / 4) {
+			std::cout << "Testing " << names[distribution] << " sites with site count ";
+			std::cout << sitecount << "\n";
+			
+			frivol::containers::Array<frivol::Point<>> sites =
+				generators[distribution](sitecount, rng);
+			
+			out << sitecount << " ";
+			out << getPolicyExecutionTime<frivol::Policy<
+				double,
+				frivol::containers::priority_queues::BinaryHeap,
+				frivol::containers::search_trees::PooledAVLTree
+			>>(sites, 0.3) << " ";
+			out << getPolicyExecutionTime<frivol::Policy<
+				double,
+				frivol::containers::priority_queues::DAryHeap,
+				frivol::containers::search_trees::PooledAVLTree
+			>>(sites, 0.3) << " ";
+			out << getPolicyExecutionTime<frivol::Policy<
+				double,
+				frivol::containers::priority_queues::CalendarQueue,
+				frivol::containers::search_trees::PooledAVLTree
+			>>(sites, 0.3) << "\n";
+			out.flush();
+		}
+		
+		out.close();
+		if(!out.good()) {
+			std::cerr << "Writing output failed.\n";
+			return 1;
+		}
+	}
+	
+	return 0;
+}
+
+// Record the estimated and the measured memory usage of the default policy
+// against the site count. The site counts increase so that the peak RSS of
+// the process is the peak of the latest computation.
+int runMemoryTest() {
+	std::ofstream memory_out("memory_out.txt");
+	
+	std::mt19937 rng;
+	std::uniform_real_distribution<double> dist(0, 1);
+	
+	for(int sitecount = 1000; sitecount <= 4000000; sitecount += sitecount / 10) {
+		std::cout << "Testing memory with site count " << sitecount << "\n";
+		
+		frivol::containers::Array<frivol::Point<>> sites(sitecount);
+		for(int sitei = 0; sitei < sitecount; ++sitei) {
+			sites[sitei] = frivol::Point<>(dist(rng), dist(rng));
+		}
+		
+		frivol::fortune::Algorithm<> algorithm(sites);
+		algorithm.finish();
+		
+		memory_out << sitecount << " ";
+		memory_out << frivol::estimatePeakMemory(sitecount) << " ";
+		memory_out << algorithm.getMemoryUsage().getTotal().reserved << " ";
+		memory_out << sitecount * sizeof(frivol::Point<>) << " ";
+		memory_out << getPeakRSS() << "\n";
+		memory_out.flush();
+	}
+	
+	memory_out.close();
+	if(!memory_out.good()) {
+		std::cerr << "Writing output failed.\n";
+		return 1;
+	}
+	
+	return 0;
+}
+
+int main(int argc, char* argv[]) {
+	if(argc > 1 && std::string(argv[1]) == "memory") return runMemoryTest();
+	if(argc > 1 && std::string(argv[1]) == "distributions") return runDistributionTest();
+	
 	// Output files for test run times.
 	std::ofstream default_out("default_out.txt"); // Default data structures.
 	std::ofstream dummy_out("dummy_out.txt"); // Dummy data structures.
+	std::ofstream avl_out("avl_out.txt"); // AVL tree beach line.
+	std::ofstream btree_out("btree_out.txt"); // B-tree beach line.
+	std::ofstream compact_avl_out("compact_avl_out.txt"); // Compact AVL tree beach line.
+	std::ofstream flat_out("flat_out.txt"); // Sorted array beach line.
+	std::ofstream dary_out("dary_out.txt"); // 4-ary heap event queue.
+	std::ofstream radix_out("radix_out.txt"); // Radix heap event queue.
+	std::ofstream lazy_out("lazy_out.txt"); // Lazy invalidation event queue.
+	std::ofstream calendar_out("calendar_out.txt"); // Calendar event queue.
+	std::ofstream compact_out("compact_out.txt"); // 32-bit indices.
+	std::ofstream segment_out("segment_out.txt"); // SegmentList output.
 	
 	// Initialize random number generator.
 	std::mt19937 rng;
@@ -55,6 +226,86 @@ int main() {
 		default_out << sitecount << " " << default_runtime << "\n";
 		default_out.flush();
 		
+		double compact_runtime = getPolicyExecutionTime<frivol::CompactIndexPolicy>(sites, 0.3);
+		compact_out << sitecount << " " << compact_runtime << "\n";
+		compact_out.flush();
+		
+		// Compare the segment list output with the full diagram in time and
+		// output size.
+		double segment_runtime = getExecutionTime([&]() {
+			frivol::computeSegmentList(sites);
+		}, 0.3);
+		segment_out << sitecount << " " << segment_runtime << " ";
+		segment_out << frivol::computeSegmentList(sites).getMemoryUsage().used << " ";
+		segment_out << frivol::computeVoronoiDiagram(sites).getMemoryUsage().used << "\n";
+		segment_out.flush();
+		
+		// Compare the search trees with the default priority queue.
+		double avl_runtime = getPolicyExecutionTime<frivol::Policy<
+			double,
+			frivol::containers::priority_queues::BinaryHeap,
+			frivol::containers::search_trees::PooledAVLTree
+		>>(sites, 0.3);
+		avl_out << sitecount << " " << avl_runtime << "\n";
+		avl_out.flush();
+		
+		double btree_runtime = getPolicyExecutionTime<frivol::Policy<
+			double,
+			frivol::containers::priority_queues::BinaryHeap,
+			frivol::containers::search_trees::BTree
+		>>(sites, 0.3);
+		btree_out << sitecount << " " << btree_runtime << "\n";
+		btree_out.flush();
+		
+		double compact_avl_runtime = getPolicyExecutionTime<frivol::Policy<
+			double,
+			frivol::containers::priority_queues::BinaryHeap,
+			frivol::containers::search_trees::CompactAVLTree
+		>>(sites, 0.3);
+		compact_avl_out << sitecount << " " << compact_avl_runtime << "\n";
+		compact_avl_out.flush();
+		
+		double flat_runtime = getPolicyExecutionTime<frivol::Policy<
+			double,
+			frivol::containers::priority_queues::BinaryHeap,
+			frivol::containers::search_trees::FlatSearchTree
+		>>(sites, 0.3);
+		flat_out << sitecount << " " << flat_runtime << "\n";
+		flat_out.flush();
+		
+		// Compare the priority queues with the AVL tree beach line.
+		double dary_runtime = getPolicyExecutionTime<frivol::Policy<
+			double,
+			frivol::containers::priority_queues::DAryHeap,
+			frivol::containers::search_trees::PooledAVLTree
+		>>(sites, 0.3);
+		dary_out << sitecount << " " << dary_runtime << "\n";
+		dary_out.flush();
+		
+		double radix_runtime = getPolicyExecutionTime<frivol::Policy<
+			double,
+			frivol::containers::priority_queues::RadixHeap,
+			frivol::containers::search_trees::PooledAVLTree
+		>>(sites, 0.3);
+		radix_out << sitecount << " " << radix_runtime << "\n";
+		radix_out.flush();
+		
+		double lazy_runtime = getPolicyExecutionTime<frivol::Policy<
+			double,
+			frivol::containers::priority_queues::LazyHeap,
+			frivol::containers::search_trees::PooledAVLTree
+		>>(sites, 0.3);
+		lazy_out << sitecount << " " << lazy_runtime << "\n";
+		lazy_out.flush();
+		
+		double calendar_runtime = getPolicyExecutionTime<frivol::Policy<
+			double,
+			frivol::containers::priority_queues::CalendarQueue,
+			frivol::containers::search_trees::PooledAVLTree
+		>>(sites, 0.3);
+		calendar_out << sitecount << " " << calendar_runtime << "\n";
+		calendar_out.flush();
+		
 		// Don't run dummy for too large inputs.
 		if(sitecount > 2500) continue;
 		
@@ -73,8 +324,24 @@ int main() {
 	
 	default_out.close();
 	dummy_out.close();
+	avl_out.close();
+	btree_out.close();
+	compact_avl_out.close();
+	flat_out.close();
+	dary_out.close();
+	radix_out.close();
+	lazy_out.close();
+	calendar_out.close();
+	compact_out.close();
+	segment_out.close();
 	
-	if(!default_out.good() || !dummy_out.good()) {
+	if(
+		!default_out.good() || !dummy_out.good() ||
+		!avl_out.good() || !btree_out.good() || !compact_avl_out.good() ||
+		!flat_out.good() || !dary_out.good() || !radix_out.good() ||
+		!lazy_out.good() || !calendar_out.good() || !compact_out.good() ||
+		!segment_out.good()
+	) {
 		std::cerr << "Writing output failed.\n";
 		return 1;
 	}
@@ -2,6 +2,9 @@
 
 #include "frivol/containers/array.hpp"
 
+#include <stdexcept>
+#include <string>
+
 using namespace frivol;
 using namespace frivol::containers;
 
@@ -68,4 +71,149 @@ BOOST_AUTO_TEST_CASE(default_constructor_works) {
 	BOOST_CHECK_EQUAL(array.getSize(), 5);
 }
 
+BOOST_AUTO_TEST_CASE(no_init_constructor_size_works) {
+	Array<double> array(7, no_init);
+	BOOST_CHECK_EQUAL(array.getSize(), 7);
+	array[6] = 2.5;
+	BOOST_CHECK_EQUAL(array[6], 2.5);
+}
+
+BOOST_AUTO_TEST_CASE(preserving_resize_works) {
+	Array<int> array(4);
+	for(int i = 0; i < 4; ++i) {
+		array[i] = 7 * i;
+	}
+	array.resize(10, 2);
+	BOOST_CHECK_EQUAL(array.getSize(), 10);
+	BOOST_CHECK_EQUAL(array[0], 0);
+	BOOST_CHECK_EQUAL(array[1], 7);
+}
+
+namespace {
+
+/// Element type that counts its live instances.
+struct Counted {
+	Counted() : value(-1) { ++count; }
+	Counted(const Counted& other) : value(other.value) { ++count; }
+	Counted& operator=(const Counted& other) { value = other.value; return *this; }
+	~Counted() { --count; }
+	
+	int value;
+	
+	static int count;
+};
+
+int Counted::count = 0;
+
+}
+
+BOOST_AUTO_TEST_CASE(non_trivial_elements_are_constructed_and_destroyed) {
+	{
+		Array<Counted> array(3, no_init);
+		BOOST_CHECK_EQUAL(Counted::count, 3);
+		BOOST_CHECK_EQUAL(array[2].value, -1);
+		array[1].value = 5;
+		
+		array.resize(6);
+		BOOST_CHECK_EQUAL(Counted::count, 6);
+		BOOST_CHECK_EQUAL(array[1].value, 5);
+		BOOST_CHECK_EQUAL(array[5].value, -1);
+		
+		array.resize(2, 1);
+		BOOST_CHECK_EQUAL(Counted::count, 2);
+		BOOST_CHECK_EQUAL(array[1].value, -1);
+		
+		Array<Counted> moved(std::move(array));
+		BOOST_CHECK_EQUAL(array.getSize(), 0);
+		BOOST_CHECK_EQUAL(moved.getSize(), 2);
+		BOOST_CHECK_EQUAL(Counted::count, 2);
+	}
+	BOOST_CHECK_EQUAL(Counted::count, 0);
+}
+
+namespace {
+
+/// Element type that counts its live instances and throws from the
+/// constructor that would create the live instance number 'limit'.
+struct Throwing {
+	Throwing() : value(-1) { construct_(); }
+	Throwing(const Throwing& other) : value(other.value) { construct_(); }
+	
+	// The move constructor may throw, so the array must copy instead.
+	Throwing(Throwing&& other) : value(other.value) {
+		construct_();
+		other.value = -2;
+	}
+	
+	Throwing& operator=(const Throwing& other) { value = other.value; return *this; }
+	~Throwing() { --count; }
+	
+	int value;
+	
+	static int count;
+	static int limit;
+	
+private:
+	void construct_() {
+		if(count + 1 >= limit) throw std::runtime_error("Throwing: limit reached");
+		++count;
+	}
+};
+
+int Throwing::count = 0;
+int Throwing::limit = 1000;
+
+}
+
+BOOST_AUTO_TEST_CASE(throwing_element_constructors_roll_back) {
+	Throwing::limit = 4;
+	BOOST_CHECK_THROW(Array<Throwing>(5), std::runtime_error);
+	BOOST_CHECK_EQUAL(Throwing::count, 0);
+	BOOST_CHECK_THROW(Array<Throwing>(5, no_init), std::runtime_error);
+	BOOST_CHECK_EQUAL(Throwing::count, 0);
+	
+	{
+		Throwing::limit = 1000;
+		Array<Throwing> array(3);
+		for(int i = 0; i < 3; ++i) {
+			array[i].value = i;
+		}
+		
+		// Throws while constructing the new elements.
+		Throwing::limit = 6;
+		BOOST_CHECK_THROW(array.resize(8), std::runtime_error);
+		BOOST_CHECK_EQUAL(Throwing::count, 3);
+		
+		// Throws while relocating the preserved elements.
+		Throwing::limit = 7;
+		BOOST_CHECK_THROW(array.resize(4, 3), std::runtime_error);
+		BOOST_CHECK_EQUAL(Throwing::count, 3);
+		
+		BOOST_REQUIRE_EQUAL(array.getSize(), 3);
+		for(int i = 0; i < 3; ++i) {
+			BOOST_CHECK_EQUAL(array[i].value, i);
+		}
+		
+		Throwing::limit = 1000;
+		array.resize(5);
+		BOOST_CHECK_EQUAL(Throwing::count, 5);
+		BOOST_CHECK_EQUAL(array[2].value, 2);
+		BOOST_CHECK_EQUAL(array[4].value, -1);
+	}
+	BOOST_CHECK_EQUAL(Throwing::count, 0);
+}
+
+BOOST_AUTO_TEST_CASE(non_trivially_copyable_elements_are_moved) {
+	Array<std::string> array(2);
+	array[0] = "first";
+	array[1] = "second";
+	array.resize(40);
+	BOOST_CHECK_EQUAL(array[0], "first");
+	BOOST_CHECK_EQUAL(array[1], "second");
+	BOOST_CHECK_EQUAL(array[39], "");
+	
+	array = Array<std::string>(1);
+	BOOST_CHECK_EQUAL(array.getSize(), 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -3,6 +3,8 @@
 
 #include <frivol/containers/search_trees/avl_node.hpp>
 
+#include <vector>
+
 using namespace frivol;
 using namespace frivol::containers;
 using namespace frivol::containers::search_trees;
@@ -11,6 +13,26 @@ typedef AVLNode<int> AVLNodeT;
 
 BOOST_AUTO_TEST_SUITE(avl_node)
 
+void collectInOrder(AVLNodeT* node, std::vector<AVLNodeT*>& nodes) {
+	if(node == nullptr) return;
+	
+	collectInOrder(node->getLeftChild(), nodes);
+	nodes.push_back(node);
+	collectInOrder(node->getRightChild(), nodes);
+}
+
+void assertThreadsCorrect(AVLNodeT* root) {
+	std::vector<AVLNodeT*> nodes;
+	collectInOrder(root, nodes);
+	
+	for(std::size_t i = 0; i < nodes.size(); ++i) {
+		AVLNodeT* prev = i == 0 ? nullptr : nodes[i - 1];
+		AVLNodeT* next = i + 1 == nodes.size() ? nullptr : nodes[i + 1];
+		BOOST_CHECK_EQUAL(nodes[i]->getPreviousNode(), prev);
+		BOOST_CHECK_EQUAL(nodes[i]->getNextNode(), next);
+	}
+}
+
 void assertHeightsCorrect(AVLNodeT* node) {
 	if(node == nullptr) return;
 	
@@ -113,6 +135,7 @@ BOOST_AUTO_TEST_CASE(removal_works) {
 		cmp->getRightChild()->createRightChild(5);
 		assertSubtreesEqual(cmp.get(), cmp.get());
 		assertHeightsCorrect(cmp.get());
+		assertThreadsCorrect(root.get());
 	}
 	
 	BOOST_CHECK_EQUAL(root->getRightChild()->remove(root), false);
@@ -125,6 +148,7 @@ BOOST_AUTO_TEST_CASE(removal_works) {
 		cmp->getRightChild()->createRightChild(5);
 		assertSubtreesEqual(cmp.get(), cmp.get());
 		assertHeightsCorrect(cmp.get());
+		assertThreadsCorrect(root.get());
 	}
 	
 	BOOST_CHECK_EQUAL(root->getRightChild()->remove(root), true);
@@ -134,6 +158,7 @@ BOOST_AUTO_TEST_CASE(removal_works) {
 		cmp->createLeftChild(2);
 		assertSubtreesEqual(cmp.get(), cmp.get());
 		assertHeightsCorrect(cmp.get());
+		assertThreadsCorrect(root.get());
 	}
 	
 	BOOST_CHECK_EQUAL(root->remove(root), false);
@@ -144,6 +169,7 @@ BOOST_AUTO_TEST_CASE(removal_works) {
 		cmp->createLeftChild(2);
 		assertSubtreesEqual(cmp.get(), cmp.get());
 		assertHeightsCorrect(cmp.get());
+		assertThreadsCorrect(root.get());
 	}
 	
 	BOOST_CHECK_EQUAL(root->remove(root), true);
@@ -151,6 +177,7 @@ BOOST_AUTO_TEST_CASE(removal_works) {
 		std::unique_ptr<AVLNodeT> cmp(new AVLNodeT(2));
 		assertSubtreesEqual(cmp.get(), cmp.get());
 		assertHeightsCorrect(cmp.get());
+		assertThreadsCorrect(root.get());
 	}
 }
 
@@ -173,6 +200,7 @@ BOOST_AUTO_TEST_CASE(right_rotation_on_root_works) {
 	
 	assertSubtreesEqual(root.get(), cmp.get());
 	assertHeightsCorrect(root.get());
+	assertThreadsCorrect(root.get());
 }
 
 BOOST_AUTO_TEST_CASE(left_rotation_on_root_works) {
@@ -194,6 +222,7 @@ BOOST_AUTO_TEST_CASE(left_rotation_on_root_works) {
 	
 	assertSubtreesEqual(root.get(), cmp.get());
 	assertHeightsCorrect(root.get());
+	assertThreadsCorrect(root.get());
 }
 
 BOOST_AUTO_TEST_CASE(left_rotation_on_non_root_works) {
@@ -217,6 +246,7 @@ BOOST_AUTO_TEST_CASE(left_rotation_on_non_root_works) {
 	
 	assertSubtreesEqual(root.get(), cmp.get());
 	assertHeightsCorrect(root.get());
+	assertThreadsCorrect(root.get());
 }
 
 BOOST_AUTO_TEST_CASE(right_rotation_with_two_vertices_works) {
@@ -232,6 +262,7 @@ BOOST_AUTO_TEST_CASE(right_rotation_with_two_vertices_works) {
 	BOOST_CHECK_EQUAL(B->getLeftChild(), (AVLNodeT*)nullptr);
 	BOOST_CHECK_EQUAL(B->getRightChild(), A);
 	assertHeightsCorrect(root.get());
+	assertThreadsCorrect(root.get());
 }
 
 BOOST_AUTO_TEST_CASE(traversal_works) {
@@ -247,6 +278,7 @@ BOOST_AUTO_TEST_CASE(traversal_works) {
 	root->getRightChild()->getRightChild()->createRightChild(8);
 	
 	assertHeightsCorrect(root.get());
+	assertThreadsCorrect(root.get());
 	
 	AVLNodeT* node = root->getLeftmostDescendant();
 	for(int i = 0; i < 8; ++i) {
@@ -279,6 +311,7 @@ BOOST_AUTO_TEST_CASE(swap_nodes_works) {
 		cmp->createRightChild(0);
 		assertSubtreesEqual(root.get(), cmp.get());
 		assertHeightsCorrect(root.get());
+		assertThreadsCorrect(root.get());
 	}
 	
 	AVLNodeT::swapNodes(root->getRightChild(), root->getLeftChild()->getRightChild(), root);
@@ -289,6 +322,7 @@ BOOST_AUTO_TEST_CASE(swap_nodes_works) {
 		cmp->createRightChild(2);
 		assertSubtreesEqual(root.get(), cmp.get());
 		assertHeightsCorrect(root.get());
+		assertThreadsCorrect(root.get());
 	}
 }
 
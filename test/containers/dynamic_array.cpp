@@ -50,4 +50,57 @@ BOOST_AUTO_TEST_CASE(large_add_works) {
 	}
 }
 
+BOOST_AUTO_TEST_CASE(resize_keeps_capacity) {
+	DynamicArray<int> array(3);
+	array[2] = 7;
+	array.resize(100);
+	BOOST_CHECK_EQUAL(array.getSize(), 100);
+	BOOST_CHECK_EQUAL(array[2], 7);
+	Idx capacity = array.getCapacity();
+	BOOST_CHECK(capacity >= 100);
+	
+	array.clear();
+	BOOST_CHECK_EQUAL(array.getSize(), 0);
+	array.resize(50);
+	array.resize(100);
+	BOOST_CHECK_EQUAL(array.getSize(), 100);
+	BOOST_CHECK_EQUAL(array.getCapacity(), capacity);
+}
+
+BOOST_AUTO_TEST_CASE(reserve_and_shrink_to_fit_work) {
+	DynamicArray<int> array;
+	array.reserve(100);
+	BOOST_CHECK_EQUAL(array.getSize(), 0);
+	BOOST_CHECK_EQUAL(array.getCapacity(), 100);
+	
+	for(int i = 0; i < 100; ++i) {
+		array.add(i);
+	}
+	BOOST_CHECK_EQUAL(array.getCapacity(), 100);
+	
+	array.reserve(50);
+	BOOST_CHECK_EQUAL(array.getCapacity(), 100);
+	
+	array.resize(30);
+	array.shrinkToFit();
+	BOOST_CHECK_EQUAL(array.getSize(), 30);
+	BOOST_CHECK_EQUAL(array.getCapacity(), 30);
+	for(int i = 0; i < 30; ++i) {
+		BOOST_CHECK_EQUAL(array[i], i);
+	}
+	
+	array.add(30);
+	BOOST_CHECK_EQUAL(array[30], 30);
+}
+
+BOOST_AUTO_TEST_CASE(memory_usage_follows_capacity_and_size) {
+	DynamicArray<double> array;
+	array.reserve(10);
+	array.resize(4);
+	
+	MemoryUsage usage = array.getMemoryUsage();
+	BOOST_CHECK_EQUAL(usage.reserved, 10 * sizeof(double));
+	BOOST_CHECK_EQUAL(usage.used, 4 * sizeof(double));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,152 @@
+#include <boost/test/unit_test.hpp>
+#include <boost/mpl/list.hpp>
+
+#include <frivol/containers/ordered_key_traits.hpp>
+#include <frivol/fortune/event_priority.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+using namespace frivol;
+using namespace frivol::containers;
+
+BOOST_AUTO_TEST_SUITE(ordered_key_traits)
+
+typedef boost::mpl::list<
+	unsigned char, unsigned int, unsigned long long,
+	signed char, int, long long,
+	float, double
+> KeyTypes;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(implements_concept, T, KeyTypes) {
+	BOOST_CONCEPT_ASSERT((OrderedKeyTraitsImplementedConcept<T>));
+}
+
+BOOST_AUTO_TEST_CASE(implements_concept_for_compound_types) {
+	BOOST_CONCEPT_ASSERT((OrderedKeyTraitsImplementedConcept<std::pair<int, double>>));
+	BOOST_CONCEPT_ASSERT((OrderedKeyTraitsImplementedConcept<fortune::EventPriority<float>>));
+	BOOST_CONCEPT_ASSERT((OrderedKeyTraitsImplementedConcept<fortune::EventPriority<double>>));
+	BOOST_CONCEPT_ASSERT((OrderedKeyTraitsImplementedConcept<fortune::EncodedEventPriority<float>>));
+	BOOST_CONCEPT_ASSERT((OrderedKeyTraitsImplementedConcept<fortune::EncodedEventPriority<double>>));
+}
+
+/// Checks that the keys of sorted values are in the same order, and that
+/// getDifferingBitCount is consistent with the keys.
+template <typename T>
+void checkOrderPreserved(const std::vector<T>& values) {
+	typedef OrderedKeyTraits<T> Traits;
+	typedef typename Traits::Key Key;
+	
+	for(std::size_t i = 0; i < values.size(); ++i) {
+		for(std::size_t j = 0; j < values.size(); ++j) {
+			Key a = Traits::getKey(values[i]);
+			Key b = Traits::getKey(values[j]);
+			BOOST_CHECK_EQUAL(a < b, values[i] < values[j]);
+			
+			Idx differing = Traits::getDifferingBitCount(a, b);
+			BOOST_CHECK_EQUAL(differing == 0, a == b);
+			BOOST_CHECK(differing <= Traits::bits);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(integer_order_is_preserved, T, KeyTypes) {
+	std::vector<T> values;
+	values.push_back(std::numeric_limits<T>::lowest());
+	values.push_back(std::numeric_limits<T>::max());
+	for(int value = -100; value <= 100; value += 7) {
+		T converted = (T)value;
+		if(std::numeric_limits<T>::is_signed || value >= 0) {
+			values.push_back(converted);
+		}
+	}
+	checkOrderPreserved(values);
+}
+
+BOOST_AUTO_TEST_CASE(float_order_is_preserved) {
+	const double inf = std::numeric_limits<double>::infinity();
+	std::vector<double> values = {
+		-inf, -1e300, -1.5, -1, -1e-300, -std::numeric_limits<double>::denorm_min(),
+		0, std::numeric_limits<double>::denorm_min(), 1e-300, 1, 1.5, 1e300, inf
+	};
+	checkOrderPreserved(values);
+	
+	std::vector<float> float_values;
+	for(double value : values) float_values.push_back((float)value);
+	float_values.erase(std::unique(float_values.begin(), float_values.end()), float_values.end());
+	checkOrderPreserved(float_values);
+}
+
+BOOST_AUTO_TEST_CASE(negative_zero_has_same_key_as_zero) {
+	BOOST_CHECK(OrderedKeyTraits<double>::getKey(-0.0) == OrderedKeyTraits<double>::getKey(0.0));
+	BOOST_CHECK(OrderedKeyTraits<float>::getKey(-0.0f) == OrderedKeyTraits<float>::getKey(0.0f));
+}
+
+BOOST_AUTO_TEST_CASE(differing_bit_count_works) {
+	typedef OrderedKeyTraits<unsigned int> Traits;
+	BOOST_CHECK_EQUAL(Traits::getDifferingBitCount(5, 5), 0);
+	BOOST_CHECK_EQUAL(Traits::getDifferingBitCount(4, 5), 1);
+	BOOST_CHECK_EQUAL(Traits::getDifferingBitCount(0, 8), 4);
+	BOOST_CHECK_EQUAL(Traits::getDifferingBitCount(0, 0x80000000u), 32);
+	
+	typedef OrderedKeyTraits<std::pair<unsigned int, unsigned int>> PairTraits;
+	BOOST_CHECK_EQUAL(PairTraits::bits, 64);
+	BOOST_CHECK_EQUAL(PairTraits::getDifferingBitCount(std::make_pair(1u, 3u), std::make_pair(1u, 2u)), 1);
+	BOOST_CHECK_EQUAL(PairTraits::getDifferingBitCount(std::make_pair(1u, 3u), std::make_pair(0u, 3u)), 33);
+}
+
+BOOST_AUTO_TEST_CASE(float_keys_are_decoded) {
+	for(double value : {-1e300, -1.5, -1e-300, 0.0, 1e-300, 1.0, 1e300}) {
+		BOOST_CHECK_EQUAL(OrderedKeyTraits<double>::getValue(OrderedKeyTraits<double>::getKey(value)), value);
+		float float_value = (float)value;
+		BOOST_CHECK_EQUAL(OrderedKeyTraits<float>::getValue(OrderedKeyTraits<float>::getKey(float_value)), float_value);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(event_priority_order_is_preserved) {
+	typedef fortune::EventPriority<double> PriorityT;
+	std::vector<PriorityT> values;
+	for(double y : {-2.0, -0.5, 0.0, 0.5, 3.0}) {
+		for(double x : {-1.0, 0.0, 0.25, 7.0}) {
+			values.push_back(PriorityT{x, y});
+		}
+	}
+	checkOrderPreserved(values);
+}
+
+typedef boost::mpl::list<float, double> EncodableCoordTypes;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(encoded_event_priority_order_is_preserved, CoordT, EncodableCoordTypes) {
+	BOOST_CHECK(fortune::IsEventPriorityEncodable<CoordT>::value);
+	
+	typedef fortune::EventPriority<CoordT> PriorityT;
+	typedef fortune::EncodedEventPriority<CoordT> EncodedPriorityT;
+	std::vector<CoordT> coords = {-1e30f, -2, -0.5, -1e-30f, 0, 0.25, 1e-30f, 3, 1e30f};
+	
+	std::vector<EncodedPriorityT> encoded_values;
+	for(CoordT y : coords) {
+		for(CoordT x : coords) {
+			PriorityT priority(x, y);
+			EncodedPriorityT encoded(x, y);
+			BOOST_CHECK_EQUAL(encoded.getY(), y);
+			
+			for(CoordT other_y : coords) {
+				for(CoordT other_x : coords) {
+					PriorityT other(other_x, other_y);
+					EncodedPriorityT other_encoded(other_x, other_y);
+					BOOST_CHECK_EQUAL(encoded < other_encoded, priority < other);
+				}
+			}
+			encoded_values.push_back(encoded);
+		}
+	}
+	checkOrderPreserved(encoded_values);
+}
+
+BOOST_AUTO_TEST_CASE(user_defined_coordinates_are_not_encodable) {
+	BOOST_CHECK(!fortune::IsEventPriorityEncodable<int>::value);
+	BOOST_CHECK(!fortune::IsEventPriorityEncodable<long double>::value);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
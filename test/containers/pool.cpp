@@ -0,0 +1,99 @@
+#include <boost/test/unit_test.hpp>
+
+#include <frivol/containers/pool.hpp>
+
+#include <set>
+
+using namespace frivol;
+using namespace frivol::containers;
+
+BOOST_AUTO_TEST_SUITE(pool)
+
+BOOST_AUTO_TEST_CASE(empty_pool_works) {
+	Pool<double> pool;
+	BOOST_CHECK_EQUAL(pool.getCapacity(), 0);
+	BOOST_CHECK_EQUAL(pool.getFreeCount(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(reserve_works) {
+	Pool<int> pool;
+	pool.reserve(12);
+	BOOST_CHECK_EQUAL(pool.getCapacity(), 12);
+	BOOST_CHECK_EQUAL(pool.getFreeCount(), 12);
+	pool.reserve(5);
+	BOOST_CHECK_EQUAL(pool.getCapacity(), 12);
+	pool.reserve(20);
+	BOOST_CHECK_EQUAL(pool.getCapacity(), 20);
+	BOOST_CHECK_EQUAL(pool.getFreeCount(), 20);
+}
+
+BOOST_AUTO_TEST_CASE(allocations_are_distinct) {
+	Pool<int> pool;
+	std::set<int*> ptrs;
+	for(int i = 0; i < 100; ++i) {
+		int* ptr = pool.allocate();
+		*ptr = i;
+		ptrs.insert(ptr);
+	}
+	BOOST_CHECK_EQUAL(ptrs.size(), 100);
+	BOOST_CHECK_EQUAL(pool.getFreeCount(), pool.getCapacity() - 100);
+	
+	int sum = 0;
+	for(int* ptr : ptrs) {
+		sum += *ptr;
+	}
+	BOOST_CHECK_EQUAL(sum, 4950);
+}
+
+BOOST_AUTO_TEST_CASE(reserved_pool_does_not_grow) {
+	Pool<double> pool;
+	pool.reserve(8);
+	for(int round = 0; round < 10; ++round) {
+		double* ptrs[8];
+		for(int i = 0; i < 8; ++i) {
+			ptrs[i] = pool.allocate();
+		}
+		BOOST_CHECK_EQUAL(pool.getFreeCount(), 0);
+		for(int i = 0; i < 8; ++i) {
+			pool.deallocate(ptrs[i]);
+		}
+	}
+	BOOST_CHECK_EQUAL(pool.getCapacity(), 8);
+	BOOST_CHECK_EQUAL(pool.getFreeCount(), 8);
+}
+
+BOOST_AUTO_TEST_CASE(move_works) {
+	Pool<int> pool;
+	int* ptr = pool.allocate();
+	*ptr = 5;
+	
+	Pool<int> pool2(std::move(pool));
+	BOOST_CHECK_EQUAL(pool.getCapacity(), 0);
+	BOOST_CHECK_EQUAL(*ptr, 5);
+	pool2.deallocate(ptr);
+	BOOST_CHECK_EQUAL(pool2.getFreeCount(), pool2.getCapacity());
+}
+
+BOOST_AUTO_TEST_CASE(memory_usage_counts_allocated_slots) {
+	Pool<double> pool;
+	BOOST_CHECK_EQUAL(pool.getMemoryUsage().reserved, 0);
+	BOOST_CHECK_EQUAL(Pool<double>::estimateMemoryUsage(0), 0);
+	
+	pool.reserve(10);
+	MemoryUsage usage = pool.getMemoryUsage();
+	BOOST_CHECK_EQUAL(usage.reserved, Pool<double>::estimateMemoryUsage(10));
+	BOOST_CHECK_EQUAL(usage.used, 0);
+	
+	double* ptrs[3];
+	for(int i = 0; i < 3; ++i) {
+		ptrs[i] = pool.allocate();
+	}
+	BOOST_CHECK_EQUAL(pool.getMemoryUsage().used, 3 * sizeof(double));
+	for(int i = 0; i < 3; ++i) {
+		pool.deallocate(ptrs[i]);
+	}
+	BOOST_CHECK_EQUAL(pool.getMemoryUsage().used, 0);
+	BOOST_CHECK_EQUAL(pool.getMemoryUsage().reserved, usage.reserved);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
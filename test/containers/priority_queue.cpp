@@ -5,6 +5,19 @@
 
 #include <frivol/containers/priority_queues/dummy_priority_queue.hpp>
 #include <frivol/containers/priority_queues/binary_heap.hpp>
+#include <frivol/containers/priority_queues/calendar_queue.hpp>
+#include <frivol/containers/priority_queues/d_ary_heap.hpp>
+#include <frivol/containers/priority_queues/lazy_heap.hpp>
+#include <frivol/containers/priority_queues/radix_heap.hpp>
+#include <frivol/fortune/event_priority.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <random>
+#include <set>
+#include <vector>
 
 using namespace frivol;
 using namespace frivol::containers;
@@ -12,7 +25,21 @@ using namespace frivol::containers::priority_queues;
 
 BOOST_AUTO_TEST_SUITE(priority_queue)
 
-typedef boost::mpl::list<DummyPriorityQueue<double>, BinaryHeap<double>> PriorityQueueTypes;
+typedef boost::mpl::list<
+	DummyPriorityQueue<double>,
+	BinaryHeap<double>,
+	DAryHeap<double>,
+	BasicDAryHeap<double, 2>,
+	BasicDAryHeap<double, 3>,
+	RadixHeap<double>,
+	LazyHeap<double>,
+	CalendarQueue<double>,
+	BinaryHeap<double, DefaultAllocator, std::uint8_t>,
+	BasicDAryHeap<double, 4, DefaultAllocator, std::uint8_t>,
+	RadixHeap<double, DefaultAllocator, std::uint8_t>,
+	LazyHeap<double, DefaultAllocator, std::uint8_t>,
+	CalendarQueue<double, DefaultAllocator, std::uint8_t>
+> PriorityQueueTypes;
 
 BOOST_AUTO_TEST_CASE_TEMPLATE(implements_concept, PriorityQueue, PriorityQueueTypes) {
 	BOOST_CONCEPT_ASSERT((PriorityQueueConcept<PriorityQueue, double>));
@@ -37,6 +64,20 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(pop_works, PriorityQueue, PriorityQueueTypes) {
 	BOOST_CHECK(q.empty());
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE(top_works, PriorityQueue, PriorityQueueTypes) {
+	PriorityQueue q(7);
+	q.setPriority(2, 5.55);
+	q.setPriority(5, -351);
+	BOOST_CHECK(q.top() == (std::pair<Idx, double>(5, -351)));
+	BOOST_CHECK(q.top() == (std::pair<Idx, double>(5, -351)));
+	q.setPriority(4, -400);
+	BOOST_CHECK(q.top() == (std::pair<Idx, double>(4, -400)));
+	BOOST_CHECK(q.pop() == (std::pair<Idx, double>(4, -400)));
+	q.setPriorityNIL(5);
+	BOOST_CHECK(q.top() == (std::pair<Idx, double>(2, 5.55)));
+	BOOST_CHECK(!q.empty());
+}
+
 
 BOOST_AUTO_TEST_CASE_TEMPLATE(basic, PriorityQueue, PriorityQueueTypes) {
 	PriorityQueue q(15);
@@ -117,4 +158,240 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(binary_heap_removal_hard_case, PriorityQueue, Prio
 	BOOST_CHECK(q.empty());
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE(matches_reference_in_random_operations, PriorityQueue, PriorityQueueTypes) {
+	const Idx n = 200;
+	std::mt19937 rng(1234);
+	std::uniform_int_distribution<int> op_dist(0, 3);
+	std::uniform_int_distribution<Idx> key_dist(0, n - 1);
+	std::uniform_int_distribution<int> priority_dist(0, 50);
+	
+	PriorityQueue q(n);
+	std::map<Idx, double> priorities;
+	std::set<std::pair<double, Idx>> order;
+	
+	for(int step = 0; step < 20000; ++step) {
+		int op = op_dist(rng);
+		Idx key = key_dist(rng);
+		if(op <= 1) {
+			// Set or change priority, also of keys already in the queue.
+			double priority = priority_dist(rng);
+			if(priorities.count(key)) order.erase(std::make_pair(priorities[key], key));
+			priorities[key] = priority;
+			order.insert(std::make_pair(priority, key));
+			q.setPriority(key, priority);
+		} else if(op == 2) {
+			if(priorities.count(key)) {
+				order.erase(std::make_pair(priorities[key], key));
+				priorities.erase(key);
+			}
+			q.setPriorityNIL(key);
+		} else if(!order.empty()) {
+			// Ties may be popped in any order, so only check the priority.
+			std::pair<Idx, double> top = q.top();
+			std::pair<Idx, double> popped = q.pop();
+			BOOST_CHECK(popped == top);
+			BOOST_REQUIRE(priorities.count(popped.first));
+			BOOST_CHECK_EQUAL(popped.second, priorities[popped.first]);
+			BOOST_CHECK_EQUAL(popped.second, order.begin()->first);
+			order.erase(std::make_pair(popped.second, popped.first));
+			priorities.erase(popped.first);
+		}
+		BOOST_REQUIRE_EQUAL(q.empty(), order.empty());
+	}
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(reset_works, PriorityQueue, PriorityQueueTypes) {
+	PriorityQueue q(5);
+	q.setPriority(1, 3.5);
+	q.setPriority(4, -2);
+	q.pop();
+	
+	q.reset(3);
+	BOOST_CHECK(q.empty());
+	q.setPriority(2, 1);
+	q.setPriority(0, 4);
+	BOOST_CHECK(q.pop() == (std::pair<Idx, double>(2, 1)));
+	
+	q.reset(200);
+	BOOST_CHECK(q.empty());
+	for(Idx key = 0; key < 200; ++key) {
+		q.setPriority(key, (double)((key * 37) % 200));
+	}
+	for(Idx i = 0; i < 200; ++i) {
+		BOOST_CHECK_EQUAL(q.pop().second, (double)i);
+	}
+	BOOST_CHECK(q.empty());
+}
+
+BOOST_AUTO_TEST_CASE(lazy_invalidation_is_detected) {
+	BOOST_CHECK(IsLazyPriorityQueue<LazyHeap<double>>::value);
+	BOOST_CHECK(!IsLazyPriorityQueue<BinaryHeap<double>>::value);
+	BOOST_CHECK(!IsLazyPriorityQueue<DAryHeap<double>>::value);
+	BOOST_CHECK(!IsLazyPriorityQueue<DummyPriorityQueue<double>>::value);
+}
+
+BOOST_AUTO_TEST_CASE(lazy_heap_counts_invalidations) {
+	LazyHeap<double> q(4);
+	q.setPriority(0, 1);
+	q.setPriority(1, 2);
+	q.setPriority(2, 3);
+	q.setPriorityNIL(2);
+	q.setPriorityNIL(2);
+	q.setPriority(0, 4);
+	BOOST_CHECK_EQUAL(q.getInvalidationCount(), 2);
+	
+	// The stale entry of key 0 with priority 1 is discarded from the top.
+	BOOST_CHECK(q.pop() == (std::pair<Idx, double>(1, 2)));
+	BOOST_CHECK_EQUAL(q.getDiscardCount(), 1);
+	BOOST_CHECK(q.pop() == (std::pair<Idx, double>(0, 4)));
+	BOOST_CHECK(q.empty());
+}
+
+BOOST_AUTO_TEST_CASE(lazy_heap_compacts_stale_entries) {
+	const Idx n = 10;
+	LazyHeap<double> q(n);
+	
+	// Replace the priorities many times so that the heap fills up with stale
+	// entries.
+	for(int round = 0; round < 100; ++round) {
+		for(Idx key = 0; key < n; ++key) {
+			q.setPriority(key, (double)((key * 7 + round) % n));
+		}
+	}
+	BOOST_CHECK(q.getCompactedCount() > 0);
+	BOOST_CHECK_EQUAL(q.getInvalidationCount(), 99 * n);
+	
+	for(Idx i = 0; i < n; ++i) {
+		std::pair<Idx, double> popped = q.pop();
+		BOOST_CHECK_EQUAL(popped.second, (double)i);
+		BOOST_CHECK_EQUAL((popped.first * 7 + 99) % n, i);
+	}
+	BOOST_CHECK(q.empty());
+}
+
+BOOST_AUTO_TEST_CASE(radix_heap_pop_order_matches_binary_heap) {
+	// Simulate the event queue of Fortune's algorithm: the new priorities
+	// are mostly after the last popped priority, sometimes equal in Y or
+	// before it, and keys are often removed.
+	typedef fortune::EventPriority<double> PriorityT;
+	const Idx n = 300;
+	std::mt19937 rng(4321);
+	std::uniform_int_distribution<int> op_dist(0, 4);
+	std::uniform_int_distribution<Idx> key_dist(0, n - 1);
+	std::uniform_real_distribution<double> coord_dist(-1, 1);
+	
+	BinaryHeap<PriorityT> binary_heap(n);
+	RadixHeap<PriorityT> radix_heap(n);
+	PriorityT last{-2, -2};
+	
+	for(int step = 0; step < 50000; ++step) {
+		int op = op_dist(rng);
+		Idx key = key_dist(rng);
+		if(op <= 1) {
+			PriorityT priority{coord_dist(rng), last.y + std::abs(coord_dist(rng))};
+			if(op == 1 && step % 3 == 0) priority.y = last.y;
+			if(op == 1 && step % 7 == 0) priority.y = last.y - 0.001;
+			binary_heap.setPriority(key, priority);
+			radix_heap.setPriority(key, priority);
+		} else if(op == 2) {
+			binary_heap.setPriorityNIL(key);
+			radix_heap.setPriorityNIL(key);
+		} else if(!binary_heap.empty()) {
+			std::pair<Idx, PriorityT> expected = binary_heap.pop();
+			std::pair<Idx, PriorityT> popped = radix_heap.pop();
+			BOOST_REQUIRE_EQUAL(popped.first, expected.first);
+			BOOST_REQUIRE_EQUAL(popped.second.x, expected.second.x);
+			BOOST_REQUIRE_EQUAL(popped.second.y, expected.second.y);
+			last = popped.second;
+		}
+		BOOST_REQUIRE_EQUAL(radix_heap.empty(), binary_heap.empty());
+	}
+}
+
+BOOST_AUTO_TEST_CASE(radix_heap_handles_negative_and_extreme_priorities) {
+	const Idx n = 8;
+	double priorities[n] = {
+		0.0, -0.0, -1e300, 1e300, -std::numeric_limits<double>::infinity(),
+		std::numeric_limits<double>::infinity(), -1e-300, 1e-300
+	};
+	double sorted[n] = {
+		-std::numeric_limits<double>::infinity(), -1e300, -1e-300, 0.0, 0.0,
+		1e-300, 1e300, std::numeric_limits<double>::infinity()
+	};
+	
+	RadixHeap<double> q(n);
+	for(Idx i = 0; i < n; ++i) {
+		q.setPriority(i, priorities[i]);
+	}
+	for(Idx i = 0; i < n; ++i) {
+		BOOST_CHECK_EQUAL(q.pop().second, sorted[i]);
+	}
+	BOOST_CHECK(q.empty());
+}
+
+BOOST_AUTO_TEST_CASE(range_hint_is_detected) {
+	BOOST_CHECK(HasPriorityRangeHint<CalendarQueue<double>>::value);
+	BOOST_CHECK(!HasPriorityRangeHint<BinaryHeap<double>>::value);
+	BOOST_CHECK(!HasPriorityRangeHint<LazyHeap<double>>::value);
+}
+
+BOOST_AUTO_TEST_CASE(calendar_queue_handles_priorities_outside_range_hint) {
+	const Idx n = 1000;
+	std::mt19937 rng(99);
+	std::uniform_real_distribution<double> dist(0, 1);
+	
+	// Most priorities are far above the hinted range and in a narrow band,
+	// so that they are all placed to the last bucket.
+	CalendarQueue<double> q(n);
+	q.setRangeHint(-1000, -999);
+	std::vector<double> priorities;
+	for(Idx key = 0; key < n; ++key) {
+		double priority = key % 10 == 0 ? -1000 * dist(rng) : 1e6 + dist(rng);
+		q.setPriority(key, priority);
+		priorities.push_back(priority);
+	}
+	
+	std::sort(priorities.begin(), priorities.end());
+	for(Idx i = 0; i < n; ++i) {
+		BOOST_REQUIRE_EQUAL(q.pop().second, priorities[i]);
+	}
+	BOOST_CHECK(q.empty());
+	
+	// The range was recomputed when the popping reached the last bucket.
+	BOOST_CHECK(q.getResizeCount() > 0);
+}
+
+BOOST_AUTO_TEST_CASE(calendar_queue_handles_extreme_priorities) {
+	const Idx n = 6;
+	double priorities[n] = {
+		0.0, 1e300, -std::numeric_limits<double>::infinity(),
+		std::numeric_limits<double>::infinity(), -1e300, 1e-300
+	};
+	
+	CalendarQueue<double> q(n);
+	q.setRangeHint(0, 1);
+	for(Idx i = 0; i < n; ++i) {
+		q.setPriority(i, priorities[i]);
+	}
+	std::sort(priorities, priorities + n);
+	for(Idx i = 0; i < n; ++i) {
+		BOOST_CHECK_EQUAL(q.pop().second, priorities[i]);
+	}
+	BOOST_CHECK(q.empty());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(memory_usage_matches_estimate, PriorityQueue, PriorityQueueTypes) {
+	PriorityQueue q(100);
+	MemoryUsage usage = q.getMemoryUsage();
+	BOOST_CHECK_EQUAL(usage.reserved, PriorityQueue::estimateMemoryUsage(100));
+	BOOST_CHECK(usage.used <= usage.reserved);
+	
+	// The memory is kept for reuse when the queue is reset smaller.
+	for(Idx key = 0; key < 100; ++key) {
+		q.setPriority(key, (double)key);
+	}
+	q.reset(10);
+	BOOST_CHECK_EQUAL(q.getMemoryUsage().reserved, usage.reserved);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -1,10 +1,17 @@
 #include <boost/test/unit_test.hpp>
 #include <boost/mpl/list.hpp>
 
+#include <cstdint>
+#include <random>
+#include <vector>
+
 #include <frivol/containers/search_tree_concept.hpp>
 
 #include <frivol/containers/search_trees/dummy_search_tree.hpp>
 #include <frivol/containers/search_trees/avl_tree.hpp>
+#include <frivol/containers/search_trees/compact_avl_tree.hpp>
+#include <frivol/containers/search_trees/btree.hpp>
+#include <frivol/containers/search_trees/flat_search_tree.hpp>
 
 using namespace frivol;
 using namespace frivol::containers;
@@ -12,7 +19,16 @@ using namespace frivol::containers::search_trees;
 
 BOOST_AUTO_TEST_SUITE(search_tree)
 
-typedef boost::mpl::list<DummySearchTree<int>, AVLTree<int>> SearchTreeTypes;
+typedef boost::mpl::list<
+	DummySearchTree<int>,
+	AVLTree<int>,
+	PooledAVLTree<int>,
+	CompactAVLTree<int>,
+	BTree<int>,
+	BasicBTree<int, 4>,
+	FlatSearchTree<int>,
+	FlatSearchTree<int, DefaultAllocator, std::uint16_t>
+> SearchTreeTypes;
 
 BOOST_AUTO_TEST_CASE_TEMPLATE(implements_concept, SearchTree, SearchTreeTypes) {
 	BOOST_CONCEPT_ASSERT((SearchTreeConcept<SearchTree, int>));
@@ -69,6 +85,102 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(iteration_works2, SearchTree, SearchTreeTypes) {
 	BOOST_CHECK(iter == t.end());
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE(extremes_stay_correct_when_erasing, SearchTree, SearchTreeTypes) {
+	SearchTree t;
+	for(int i = 0; i < 64; ++i) {
+		t.insert(t.end(), i);
+	}
+	
+	int low = 0;
+	int high = 63;
+	int size = 64;
+	while(size >= 6) {
+		// Erase the first, the last and a middle element.
+		t.erase(t.begin());
+		t.erase(--t.end());
+		++low;
+		--high;
+		
+		auto iter = t.begin();
+		for(int i = 0; i < size / 2 - 1; ++i) ++iter;
+		t.erase(iter);
+		size -= 3;
+		
+		BOOST_CHECK_EQUAL(*t.begin(), low);
+		BOOST_CHECK_EQUAL(*--t.end(), high);
+	}
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(reserve_keeps_contents, SearchTree, SearchTreeTypes) {
+	SearchTree t;
+	t.insert(t.end(), 1);
+	t.insert(t.end(), 2);
+	t.reserve(100);
+	for(int i = 3; i <= 100; ++i) {
+		t.insert(t.end(), i);
+	}
+	
+	int expected = 1;
+	for(auto iter = t.begin(); iter != t.end(); ++iter) {
+		BOOST_CHECK_EQUAL(*iter, expected);
+		++expected;
+	}
+	BOOST_CHECK_EQUAL(expected, 101);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(clear_works, SearchTree, SearchTreeTypes) {
+	SearchTree t;
+	t.reserve(100);
+	for(int round = 0; round < 3; ++round) {
+		for(int i = 0; i < 100; ++i) {
+			t.insert(t.end(), i);
+		}
+		t.clear();
+		BOOST_CHECK(t.empty());
+		BOOST_CHECK(t.begin() == t.end());
+	}
+	
+	t.insert(t.end(), 7);
+	BOOST_CHECK_EQUAL(*t.begin(), 7);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(matches_reference_in_random_operations, SearchTree, SearchTreeTypes) {
+	typedef typename SearchTree::Iterator Iterator;
+	SearchTree tree;
+	std::vector<Iterator> iters;
+	std::vector<int> reference;
+	
+	std::mt19937 rng(1234);
+	int next_value = 0;
+	for(int step = 0; step < 4000; ++step) {
+		// Insert with higher probability in the first half.
+		bool insert = reference.empty() || rng() % 100 < (step < 2000 ? 70 : 30);
+		if(insert) {
+			std::size_t pos = rng() % (reference.size() + 1);
+			Iterator base = pos == reference.size() ? tree.end() : iters[pos];
+			iters.insert(iters.begin() + pos, tree.insert(base, next_value));
+			reference.insert(reference.begin() + pos, next_value);
+			++next_value;
+		} else {
+			std::size_t pos = rng() % reference.size();
+			tree.erase(iters[pos]);
+			iters.erase(iters.begin() + pos);
+			reference.erase(reference.begin() + pos);
+		}
+		
+		if(step % 100 == 0) {
+			auto iter = tree.begin();
+			for(std::size_t i = 0; i < reference.size(); ++i) {
+				BOOST_REQUIRE(iter == iters[i]);
+				BOOST_CHECK_EQUAL(*iter, reference[i]);
+				++iter;
+			}
+			BOOST_CHECK(iter == tree.end());
+		}
+	}
+	BOOST_CHECK_EQUAL(tree.empty(), reference.empty());
+}
+
 BOOST_AUTO_TEST_CASE_TEMPLATE(search_positive_works, SearchTree, SearchTreeTypes) {
 	SearchTree t;
 	typedef typename SearchTree::Iterator Iterator;
@@ -96,12 +208,13 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(search_negative_works, SearchTree, SearchTreeTypes
 	BOOST_CHECK(result == t.end());
 }
 
-void checkAVLTreeBalanced(AVLTree<int>& tree) {
+template <typename TreeT>
+void checkAVLTreeBalanced(TreeT& tree) {
 	int size = 0;
 	int max_queries = 0;
 	for(auto iter = tree.begin(); iter != tree.end(); ++iter) {
 		int queries = 0;
-		auto find_iter = tree.search([&](AVLTree<int>::Iterator search_iter) {
+		auto find_iter = tree.search([&](typename TreeT::Iterator search_iter) {
 			++queries;
 			return *iter - *search_iter;
 		});
@@ -133,4 +246,140 @@ BOOST_AUTO_TEST_CASE(avl_tree_balanced_when_adding_in_decreasing_order) {
 	}
 }
 
+BOOST_AUTO_TEST_CASE(compact_avl_tree_balanced_when_adding_in_increasing_order) {
+	CompactAVLTree<int> tree;
+	checkAVLTreeBalanced(tree);
+	for(int i = 0; i < 1000; ++i) {
+		tree.insert(tree.end(), i);
+		checkAVLTreeBalanced(tree);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(compact_avl_tree_balanced_when_erasing) {
+	CompactAVLTree<int> tree;
+	typedef CompactAVLTree<int>::Iterator Iterator;
+	std::vector<Iterator> iters;
+	for(int i = 0; i < 512; ++i) {
+		iters.push_back(tree.insert(tree.end(), i));
+	}
+	
+	// Erase every other element from the middle outwards so that nodes with
+	// two children are removed too.
+	for(int i = 256; i < 512; i += 2) {
+		tree.erase(iters[i]);
+		tree.erase(iters[511 - i]);
+		checkAVLTreeBalanced(tree);
+	}
+	
+	// The even elements below 256 and the odd elements above it remain.
+	int expected = 0;
+	for(Iterator iter = tree.begin(); iter != tree.end(); ++iter) {
+		BOOST_CHECK_EQUAL(*iter, expected);
+		expected += 2;
+		if(expected == 256) expected = 257;
+	}
+	BOOST_CHECK_EQUAL(expected, 513);
+}
+
+BOOST_AUTO_TEST_CASE(pooled_avl_tree_recycles_nodes) {
+	PooledAVLTree<int> tree;
+	tree.reserve(10);
+	for(int round = 0; round < 100; ++round) {
+		for(int i = 0; i < 10; ++i) {
+			tree.insert(tree.end(), i);
+		}
+		for(int i = 0; i < 10; ++i) {
+			BOOST_CHECK_EQUAL(*tree.begin(), i);
+			tree.erase(tree.begin());
+		}
+		BOOST_CHECK(tree.empty());
+	}
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(hinted_search_works, SearchTree, SearchTreeTypes) {
+	typedef typename SearchTree::Iterator Iterator;
+	SearchTree t;
+	std::vector<Iterator> iters;
+	for(int i = 0; i < 100; ++i) {
+		iters.push_back(t.insert(t.end(), 2 * i));
+	}
+	iters.push_back(t.end());
+	
+	// Search every element and some missing values from every hint.
+	for(Iterator hint : iters) {
+		for(int value = -1; value <= 200; ++value) {
+			auto order = [&](Iterator iter) { return value - *iter; };
+			Iterator result = t.search(hint, order);
+			
+			if(value >= 0 && value < 200 && value % 2 == 0) {
+				BOOST_REQUIRE(result != t.end());
+				BOOST_CHECK_EQUAL(*result, value);
+			} else {
+				BOOST_CHECK(result == t.end());
+			}
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(hinted_search_is_fast_near_hint, SearchTree, SearchTreeTypes) {
+	typedef typename SearchTree::Iterator Iterator;
+	SearchTree t;
+	std::vector<Iterator> iters;
+	for(int i = 0; i < 4096; ++i) {
+		iters.push_back(t.insert(t.end(), i));
+	}
+	
+	// Search the next element from each element.
+	int queries = 0;
+	for(int i = 0; i + 1 < 4096; ++i) {
+		Iterator result = t.search(iters[i], [&](Iterator iter) {
+			++queries;
+			return (i + 1) - *iter;
+		});
+		BOOST_REQUIRE(result == iters[i + 1]);
+	}
+	
+	// Searching from the root would take about 12 queries each.
+	BOOST_CHECK(queries < 6 * 4095);
+}
+
+BOOST_AUTO_TEST_CASE(btree_height_is_logarithmic) {
+	BTree<int> tree;
+	for(int i = 0; i < 4096; ++i) {
+		tree.insert(tree.end(), i);
+	}
+	
+	// The nodes are at least half full, so the height is at most
+	// 1 + log_8(4096).
+	BOOST_CHECK(tree.getHeight() <= 5);
+	
+	for(int i = 0; i < 4096; ++i) {
+		auto iter = tree.search([&](BTree<int>::Iterator iter) {
+			return i - *iter;
+		});
+		BOOST_REQUIRE(iter != tree.end());
+		BOOST_CHECK_EQUAL(*iter, i);
+	}
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(memory_usage_is_within_estimate, SearchTree, SearchTreeTypes) {
+	SearchTree tree;
+	tree.reserve(500);
+	for(int i = 0; i < 500; ++i) {
+		tree.insert(tree.end(), i);
+	}
+	
+	MemoryUsage usage = tree.getMemoryUsage();
+	BOOST_CHECK(usage.reserved <= SearchTree::estimateMemoryUsage(500));
+	BOOST_CHECK(usage.used >= 500 * sizeof(int));
+	BOOST_CHECK(usage.used <= usage.reserved);
+	
+	for(int i = 0; i < 250; ++i) {
+		tree.erase(tree.begin());
+	}
+	MemoryUsage half_usage = tree.getMemoryUsage();
+	BOOST_CHECK(half_usage.used < usage.used);
+	BOOST_CHECK(half_usage.reserved <= usage.reserved);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
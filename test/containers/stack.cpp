@@ -45,5 +45,27 @@ BOOST_AUTO_TEST_CASE(empty_works) {
 	BOOST_CHECK(stack.empty());
 }
 
+BOOST_AUTO_TEST_CASE(clear_works) {
+	Stack<int> stack;
+	stack.push(1);
+	stack.push(2);
+	stack.clear();
+	BOOST_CHECK(stack.empty());
+	stack.push(3);
+	BOOST_CHECK_EQUAL(stack.top(), 3);
+}
+
+
+BOOST_AUTO_TEST_CASE(reserve_works) {
+	Stack<int> stack;
+	stack.reserve(20);
+	BOOST_CHECK_EQUAL(stack.getMemoryUsage().reserved, 20 * sizeof(int));
+	for(int i = 0; i < 20; ++i) {
+		stack.push(i);
+	}
+	BOOST_CHECK_EQUAL(stack.getMemoryUsage().reserved, 20 * sizeof(int));
+	BOOST_CHECK_EQUAL(stack.getMemoryUsage().used, 20 * sizeof(int));
+	BOOST_CHECK_EQUAL(stack.top(), 19);
+}
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -1,7 +1,10 @@
 #include <boost/test/unit_test.hpp>
 #include <boost/mpl/list.hpp>
 
+#include <algorithm>
 #include <cmath>
+#include <random>
+#include <vector>
 
 #include <frivol/fortune/algorithm.hpp>
 
@@ -222,4 +225,234 @@ BOOST_AUTO_TEST_CASE(hard_case_zigzag) {
 	BOOST_CHECK_EQUAL(algo.getVoronoiDiagram().getVertexCount(), 2);
 }
 
+BOOST_AUTO_TEST_CASE(presorted_sites_give_same_diagram) {
+	const int site_count = 1000;
+	
+	std::mt19937 rng;
+	std::uniform_real_distribution<double> site_dist(0, 1);
+	std::vector<Point<>> site_vector;
+	for(int sitei = 0; sitei < site_count; ++sitei) {
+		site_vector.push_back(Point<>(site_dist(rng), site_dist(rng)));
+	}
+	std::sort(site_vector.begin(), site_vector.end(), [](const Point<>& a, const Point<>& b) {
+		return a.y < b.y || (a.y == b.y && a.x < b.x);
+	});
+	
+	containers::Array<Point<>> sites(site_count);
+	for(int sitei = 0; sitei < site_count; ++sitei) {
+		sites[sitei] = site_vector[sitei];
+	}
+	
+	fortune::Algorithm<> sorting_algo(sites);
+	sorting_algo.finish();
+	fortune::Algorithm<> presorted_algo(sites, true);
+	presorted_algo.finish();
+	
+	const VoronoiDiagram<double>& expected = sorting_algo.getVoronoiDiagram();
+	const VoronoiDiagram<double>& diagram = presorted_algo.getVoronoiDiagram();
+	BOOST_REQUIRE_EQUAL(diagram.getEdgeCount(), expected.getEdgeCount());
+	BOOST_REQUIRE_EQUAL(diagram.getVertexCount(), expected.getVertexCount());
+	for(Idx edge = 0; edge < diagram.getEdgeCount(); ++edge) {
+		BOOST_CHECK_EQUAL(diagram.getIncidentFace(edge), expected.getIncidentFace(edge));
+		BOOST_CHECK_EQUAL(diagram.getNextEdge(edge), expected.getNextEdge(edge));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(sites_on_horizontal_line_are_handled_in_order) {
+	// Sites on the same horizontal line are handled from left to right, even
+	// if a circle event happens at the same sweepline position.
+	containers::Array<Point<>> sites(4);
+	sites[0] = Point<>(3, 1);
+	sites[1] = Point<>(0, 0);
+	sites[2] = Point<>(2, 0);
+	sites[3] = Point<>(1, 1);
+	fortune::Algorithm<> algo(sites);
+	algo.finish();
+	const VoronoiDiagram<double>& diagram = algo.getVoronoiDiagram();
+	BOOST_CHECK_EQUAL(diagram.getFaceCount(), 4);
+	BOOST_CHECK_EQUAL(diagram.getVertexCount(), 2);
+	BOOST_CHECK_EQUAL(diagram.getEdgeCount(), 10);
+}
+
+// Checks that the half-edge structure of the diagram of the sites is
+// consistent and that the vertices are equidistant from the sites of the
+// faces around them and no site is closer to them.
+void checkDiagramValid(const containers::Array<Point<>>& sites) {
+	fortune::Algorithm<> algo(sites);
+	algo.finish();
+	const VoronoiDiagram<double>& diagram = algo.getVoronoiDiagram();
+	BOOST_REQUIRE_EQUAL(diagram.getFaceCount(), sites.getSize());
+	
+	auto getDistance = [&](Idx site, Idx vertex) {
+		const Point<>& a = sites[site];
+		const Point<>& b = diagram.getVertexPosition(vertex);
+		return std::sqrt((a.x - b.x) * (a.x - b.x) + (a.y - b.y) * (a.y - b.y));
+	};
+	
+	for(Idx edge = 0; edge < diagram.getEdgeCount(); ++edge) {
+		Idx twin = diagram.getTwinEdge(edge);
+		Idx face = diagram.getIncidentFace(edge);
+		BOOST_CHECK_EQUAL(diagram.getTwinEdge(twin), edge);
+		BOOST_CHECK(diagram.getIncidentFace(twin) != face);
+		BOOST_CHECK_EQUAL(diagram.getNextEdge(diagram.getPreviousEdge(edge)), edge);
+		BOOST_CHECK_EQUAL(diagram.getIncidentFace(diagram.getNextEdge(edge)), face);
+		
+		Idx vertex = diagram.getStartVertex(edge);
+		if(vertex == nil_idx) continue;
+		double dist = getDistance(face, vertex);
+		BOOST_CHECK_SMALL(getDistance(diagram.getIncidentFace(twin), vertex) - dist, 1e-9);
+		for(Idx site = 0; site < sites.getSize(); ++site) {
+			BOOST_CHECK(getDistance(site, vertex) > dist - 1e-9);
+		}
+	}
+	
+	// Each edge is in the boundary cycle of its face.
+	Idx cycle_edge_count = 0;
+	for(Idx face = 0; face < diagram.getFaceCount(); ++face) {
+		Idx start_edge = diagram.getFaceBoundaryEdge(face);
+		if(start_edge == nil_idx) continue;
+		Idx edge = start_edge;
+		do {
+			BOOST_REQUIRE_EQUAL(diagram.getIncidentFace(edge), face);
+			++cycle_edge_count;
+			edge = diagram.getNextEdge(edge);
+		} while(edge != start_edge);
+	}
+	BOOST_CHECK_EQUAL(cycle_edge_count, diagram.getEdgeCount());
+}
+
+BOOST_AUTO_TEST_CASE(cocircular_sites_with_later_sites_at_circle_top_are_valid) {
+	// The circle event of the first three sites happens at y = 1, where the
+	// other sites are before, at and after the event in the (y, x) order.
+	std::vector<std::vector<Point<>>> cases = {
+		{Point<>(-1, 0), Point<>(1, 0), Point<>(0, -1), Point<>(0, 1)},
+		{Point<>(-1, 0), Point<>(1, 0), Point<>(0, -1), Point<>(-2, 1)},
+		{Point<>(-1, 0), Point<>(1, 0), Point<>(0, -1), Point<>(2, 1)},
+		{Point<>(-1, 0), Point<>(1, 0), Point<>(0, -1), Point<>(-2, 1), Point<>(0, 1), Point<>(2, 1)},
+		{
+			Point<>(-1, 0), Point<>(1, 0), Point<>(0, -1), Point<>(0.6, -0.8),
+			Point<>(-0.8, -0.6), Point<>(0.8, 0.6), Point<>(-0.6, 0.8), Point<>(0, 1),
+			Point<>(-3, 1), Point<>(3, 1)
+		}
+	};
+	for(const std::vector<Point<>>& case_sites : cases) {
+		containers::Array<Point<>> sites(case_sites.size());
+		for(Idx i = 0; i < case_sites.size(); ++i) {
+			sites[i] = case_sites[i];
+		}
+		checkDiagramValid(sites);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(grid_sites_are_valid) {
+	// In the square grid, four sites are cocircular around each vertex. In
+	// the diagonal grid, the circle events of three sites happen exactly at
+	// the fourth site.
+	containers::Array<Point<>> grid_sites(400);
+	for(int i = 0; i < 400; ++i) {
+		grid_sites[i] = Point<>(i % 20, i / 20);
+	}
+	checkDiagramValid(grid_sites);
+	
+	containers::Array<Point<>> diagonal_grid_sites(200);
+	for(int i = 0; i < 200; ++i) {
+		int y = i / 10;
+		diagonal_grid_sites[i] = Point<>(2 * (i % 10) + y % 2 - 10, y);
+	}
+	checkDiagramValid(diagonal_grid_sites);
+}
+
+BOOST_AUTO_TEST_CASE(diagram_sizes_are_within_euler_bounds) {
+	// The algorithm reserves the diagram by these bounds, so the degenerate
+	// grid with four cocircular sites around each vertex must not exceed
+	// them either.
+	auto checkBounds = [](const containers::Array<Point<>>& sites) {
+		fortune::Algorithm<> algo(sites);
+		algo.finish();
+		const VoronoiDiagram<double>& diagram = algo.getVoronoiDiagram();
+		Idx n = sites.getSize();
+		BOOST_CHECK(diagram.getEdgeCount() <= 2 * (3 * n - 6));
+		BOOST_CHECK(diagram.getVertexCount() <= 2 * n - 5);
+	};
+	
+	containers::Array<Point<>> grid_sites(400);
+	for(int i = 0; i < 400; ++i) {
+		grid_sites[i] = Point<>(i % 20, i / 20);
+	}
+	checkBounds(grid_sites);
+	
+	std::mt19937 rng;
+	std::uniform_real_distribution<double> site_dist(0, 1);
+	containers::Array<Point<>> random_sites(1000);
+	for(int i = 0; i < 1000; ++i) {
+		random_sites[i] = Point<>(site_dist(rng), site_dist(rng));
+	}
+	checkBounds(random_sites);
+}
+
+BOOST_AUTO_TEST_CASE(memory_usage_is_within_estimate) {
+	typedef Policy<
+		double,
+		containers::priority_queues::LazyHeap,
+		containers::search_trees::AVLTree
+	> OnDemandPolicy;
+	
+	std::mt19937 rng;
+	std::uniform_real_distribution<double> site_dist(0, 1);
+	for(int site_count : {0, 1, 2, 3, 10, 1000}) {
+		containers::Array<Point<>> sites(site_count);
+		for(int i = 0; i < site_count; ++i) {
+			sites[i] = Point<>(site_dist(rng), site_dist(rng));
+		}
+		
+		// All memory of the default policy is reserved in advance.
+		fortune::Algorithm<> algo(sites);
+		algo.finish();
+		fortune::AlgorithmMemoryUsage usage = algo.getMemoryUsage();
+		BOOST_CHECK_EQUAL(
+			usage.getTotal().reserved,
+			fortune::Algorithm<>::estimatePeakMemory(site_count)
+		);
+		BOOST_CHECK(usage.getTotal().used <= usage.getTotal().reserved);
+		BOOST_CHECK_EQUAL(
+			usage.diagram.used,
+			algo.getVoronoiDiagram().getMemoryUsage().used
+		);
+		
+		// The AVL tree allocates its nodes as needed.
+		fortune::Algorithm<OnDemandPolicy> on_demand_algo(sites);
+		on_demand_algo.finish();
+		BOOST_CHECK(
+			on_demand_algo.getMemoryUsage().getTotal().reserved <=
+			fortune::Algorithm<OnDemandPolicy>::estimatePeakMemory(site_count)
+		);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(memory_limit_fails_before_allocating) {
+	containers::Array<Point<>> sites(100);
+	for(int i = 0; i < 100; ++i) {
+		sites[i] = Point<>(i % 10, 0.1 * i);
+	}
+	std::size_t estimate = fortune::Algorithm<>::estimatePeakMemory(100);
+	
+	fortune::Algorithm<> algo;
+	std::size_t initial_reserved = algo.getMemoryUsage().getTotal().reserved;
+	algo.setMemoryLimit(estimate - 1);
+	BOOST_CHECK_EQUAL(algo.getMemoryLimit(), estimate - 1);
+	BOOST_CHECK_THROW(algo.reset(sites), std::length_error);
+	BOOST_CHECK_EQUAL(algo.getMemoryUsage().getTotal().reserved, initial_reserved);
+	
+	// The sites are already sorted by Y, and presorted sites need less
+	// memory.
+	algo.reset(sites, true);
+	algo.finish();
+	BOOST_CHECK(algo.getMemoryUsage().getTotal().reserved < estimate);
+	
+	algo.setMemoryLimit(estimate);
+	algo.reset(sites);
+	algo.finish();
+	BOOST_CHECK_EQUAL(algo.getVoronoiDiagram().getFaceCount(), 100);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -1,10 +1,188 @@
 #include <boost/test/unit_test.hpp>
+#include <boost/mpl/list.hpp>
 
 #include <frivol/frivol.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
 #include <random>
+#include <vector>
 
 using namespace frivol;
 
+// Count the memory allocations of the whole test program to check that
+// reused workspaces do not allocate.
+namespace {
+std::size_t allocation_count = 0;
+}
+
+void* operator new(std::size_t size) {
+	++allocation_count;
+	void* ptr = std::malloc(size == 0 ? 1 : size);
+	if(ptr == nullptr) throw std::bad_alloc();
+	return ptr;
+}
+
+void operator delete(void* ptr) noexcept {
+	std::free(ptr);
+}
+
+// Allocator that counts its allocations and live blocks in global state, like
+// an arena allocator that finds its arena through global state.
+namespace {
+std::size_t counting_allocator_allocations = 0;
+std::size_t counting_allocator_live_blocks = 0;
+}
+
+template <typename T>
+struct CountingAllocator {
+	typedef T value_type;
+	
+	CountingAllocator() { }
+	
+	template <typename U>
+	CountingAllocator(const CountingAllocator<U>&) { }
+	
+	T* allocate(std::size_t count) {
+		++counting_allocator_allocations;
+		++counting_allocator_live_blocks;
+		void* ptr = std::malloc(count == 0 ? 1 : count * sizeof(T));
+		if(ptr == nullptr) throw std::bad_alloc();
+		return static_cast<T*>(ptr);
+	}
+	
+	void deallocate(T* ptr, std::size_t) {
+		--counting_allocator_live_blocks;
+		std::free(ptr);
+	}
+};
+
+template <typename T, typename U>
+bool operator==(const CountingAllocator<T>&, const CountingAllocator<U>&) {
+	return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const CountingAllocator<T>&, const CountingAllocator<U>&) {
+	return false;
+}
+
+// Stateful allocator without a default constructor that allocates from the
+// arena it refers to, like a NUMA-local arena. Each arena checks that only
+// its own blocks are returned to it, so two allocators in use at the same
+// time must never share state.
+class Arena {
+public:
+	explicit Arena(std::size_t capacity)
+		: buffer_(capacity),
+		  used_(0),
+		  live_blocks_(0),
+		  copy_selections_(0)
+	{ }
+	
+	void* allocate(std::size_t size) {
+		const std::size_t align = alignof(std::max_align_t);
+		std::size_t begin = (used_ + align - 1) / align * align;
+		if(begin + size > buffer_.size()) throw std::bad_alloc();
+		used_ = begin + size;
+		++live_blocks_;
+		return &buffer_[begin];
+	}
+	
+	void deallocate(void* ptr) {
+		// Memory is only reclaimed when the arena is destroyed.
+		BOOST_CHECK(owns_(ptr));
+		--live_blocks_;
+	}
+	
+	void selectCopy() {
+		++copy_selections_;
+	}
+	
+	std::size_t getUsed() const {
+		return used_;
+	}
+	
+	std::size_t getLiveBlockCount() const {
+		return live_blocks_;
+	}
+	
+	std::size_t getCopySelectionCount() const {
+		return copy_selections_;
+	}
+	
+private:
+	bool owns_(const void* ptr) const {
+		const char* byte = static_cast<const char*>(ptr);
+		return byte >= &buffer_[0] && byte < &buffer_[0] + buffer_.size();
+	}
+	
+	std::vector<char> buffer_;
+	std::size_t used_;
+	std::size_t live_blocks_;
+	std::size_t copy_selections_;
+};
+
+template <typename T>
+struct ArenaAllocator {
+	typedef T value_type;
+	
+	explicit ArenaAllocator(Arena& arena) : arena(&arena) { }
+	
+	template <typename U>
+	ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.arena) { }
+	
+	T* allocate(std::size_t count) {
+		return static_cast<T*>(arena->allocate(count == 0 ? 1 : count * sizeof(T)));
+	}
+	
+	void deallocate(T* ptr, std::size_t) {
+		arena->deallocate(ptr);
+	}
+	
+	ArenaAllocator select_on_container_copy_construction() const {
+		arena->selectCopy();
+		return *this;
+	}
+	
+	Arena* arena;
+};
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) {
+	return a.arena == b.arena;
+}
+
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) {
+	return a.arena != b.arena;
+}
+
+// User geometry traits that implement only the required operations of
+// GeometryTraitsImplementedConcept.
+namespace frivol {
+template <>
+struct GeometryTraits<long double> {
+	typedef GeometryTraitsFloat<long double> FloatTraits;
+	typedef Point<long double> PointT;
+	
+	static long double getBreakpointX(const PointT& a, const PointT& b, long double topy, bool positive_big) {
+		return FloatTraits::getBreakpointX(a, b, topy, positive_big);
+	}
+	static PointT getCircumcenter(const PointT& a, const PointT& b, const PointT& c) {
+		return FloatTraits::getCircumcenter(a, b, c);
+	}
+	static long double getCircumcircleTopY(const PointT& a, const PointT& b, const PointT& c) {
+		return FloatTraits::getCircumcircleTopY(a, b, c);
+	}
+	static bool isCCW(const PointT& a, const PointT& b, const PointT& c) {
+		return FloatTraits::isCCW(a, b, c);
+	}
+};
+}
+
 BOOST_AUTO_TEST_SUITE(frivol)
 
 double distance2(const Point<>& a, const Point<>& b) {
@@ -81,4 +259,334 @@ BOOST_AUTO_TEST_CASE(compute_voronoi_diagram_works) {
 	}
 }
 
+typedef boost::mpl::list<
+	Policy<double, containers::priority_queues::BinaryHeap, containers::search_trees::PooledAVLTree, false>,
+	Policy<double, containers::priority_queues::DAryHeap, containers::search_trees::PooledAVLTree>,
+	Policy<double, containers::priority_queues::RadixHeap, containers::search_trees::PooledAVLTree>,
+	Policy<double, containers::priority_queues::LazyHeap, containers::search_trees::PooledAVLTree>,
+	Policy<double, containers::priority_queues::CalendarQueue, containers::search_trees::PooledAVLTree>,
+	Policy<double, containers::priority_queues::CalendarQueue, containers::search_trees::PooledAVLTree, false>
+> QueuePolicies;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(event_queue_policies_give_same_diagram, QueuePolicy, QueuePolicies) {
+	const int site_count = 2000;
+	
+	std::mt19937 rng;
+	std::uniform_real_distribution<double> site_dist(0, 1);
+	
+	containers::Array<Point<>> sites(site_count);
+	for(int sitei = 0; sitei < site_count; ++sitei) {
+		sites[sitei] = Point<>(site_dist(rng), site_dist(rng));
+	}
+	
+	VoronoiDiagram<> expected = computeVoronoiDiagram(sites);
+	VoronoiDiagram<> vd = computeVoronoiDiagram<QueuePolicy>(sites);
+	
+	BOOST_REQUIRE_EQUAL(vd.getEdgeCount(), expected.getEdgeCount());
+	BOOST_REQUIRE_EQUAL(vd.getVertexCount(), expected.getVertexCount());
+	for(Idx edge = 0; edge < vd.getEdgeCount(); ++edge) {
+		BOOST_CHECK_EQUAL(vd.getIncidentFace(edge), expected.getIncidentFace(edge));
+		BOOST_CHECK_EQUAL(vd.getNextEdge(edge), expected.getNextEdge(edge));
+		BOOST_CHECK_EQUAL(vd.getStartVertex(edge), expected.getStartVertex(edge));
+	}
+	for(Idx vertex = 0; vertex < vd.getVertexCount(); ++vertex) {
+		BOOST_CHECK_EQUAL(vd.getVertexPosition(vertex).x, expected.getVertexPosition(vertex).x);
+		BOOST_CHECK_EQUAL(vd.getVertexPosition(vertex).y, expected.getVertexPosition(vertex).y);
+	}
+}
+
+typedef boost::mpl::list<
+	DefaultPolicy,
+	Policy<double, containers::priority_queues::DAryHeap, containers::search_trees::BTree>,
+	Policy<double, containers::priority_queues::RadixHeap, containers::search_trees::FlatSearchTree>,
+	Policy<double, containers::priority_queues::LazyHeap, containers::search_trees::PooledAVLTree>,
+	Policy<double, containers::priority_queues::CalendarQueue, containers::search_trees::PooledAVLTree>
+> WorkspacePolicies;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(reused_workspace_does_not_allocate, WorkspacePolicy, WorkspacePolicies) {
+	std::mt19937 rng;
+	std::uniform_real_distribution<double> site_dist(0, 1);
+	
+	// Inputs of varying sizes, the largest first.
+	std::vector<containers::Array<Point<>>> inputs;
+	for(int site_count : {3000, 1000, 2999, 1, 0, 3000}) {
+		containers::Array<Point<>> sites(site_count);
+		for(int sitei = 0; sitei < site_count; ++sitei) {
+			sites[sitei] = Point<>(site_dist(rng), site_dist(rng));
+		}
+		inputs.push_back(std::move(sites));
+	}
+	
+	fortune::Algorithm<WorkspacePolicy> workspace;
+	VoronoiDiagram<> vd(0);
+	
+	// The memory of both the workspace and the output diagram grows in the
+	// first two calls.
+	std::size_t first_allocations = allocation_count;
+	computeVoronoiDiagram(inputs[0], vd, workspace);
+	BOOST_CHECK(allocation_count > first_allocations);
+	computeVoronoiDiagram(inputs[0], vd, workspace);
+	
+	for(const containers::Array<Point<>>& sites : inputs) {
+		std::size_t allocations_before = allocation_count;
+		computeVoronoiDiagram(sites, vd, workspace);
+		BOOST_CHECK_EQUAL(allocation_count - allocations_before, 0);
+		
+		VoronoiDiagram<> expected = computeVoronoiDiagram<WorkspacePolicy>(sites);
+		BOOST_REQUIRE_EQUAL(vd.getFaceCount(), expected.getFaceCount());
+		BOOST_REQUIRE_EQUAL(vd.getEdgeCount(), expected.getEdgeCount());
+		BOOST_REQUIRE_EQUAL(vd.getVertexCount(), expected.getVertexCount());
+		for(Idx edge = 0; edge < vd.getEdgeCount(); ++edge) {
+			BOOST_CHECK_EQUAL(vd.getIncidentFace(edge), expected.getIncidentFace(edge));
+			BOOST_CHECK_EQUAL(vd.getNextEdge(edge), expected.getNextEdge(edge));
+			BOOST_CHECK_EQUAL(vd.getStartVertex(edge), expected.getStartVertex(edge));
+		}
+		for(Idx face = 0; face < vd.getFaceCount(); ++face) {
+			BOOST_CHECK_EQUAL(vd.getFaceBoundaryEdge(face), expected.getFaceBoundaryEdge(face));
+		}
+		for(Idx vertex = 0; vertex < vd.getVertexCount(); ++vertex) {
+			BOOST_CHECK_EQUAL(vd.getVertexPosition(vertex).x, expected.getVertexPosition(vertex).x);
+			BOOST_CHECK_EQUAL(vd.getVertexPosition(vertex).y, expected.getVertexPosition(vertex).y);
+		}
+	}
+}
+
+template <
+	template <typename PriorityT, typename AllocatorT, typename IndexT> class EventPriorityQueueT,
+	template <typename ElementT, typename AllocatorT, typename IndexT> class BeachLineSearchTreeT
+>
+using CompactIndexPolicyWith = Policy<
+	double,
+	EventPriorityQueueT,
+	BeachLineSearchTreeT,
+	fortune::IsEventPriorityEncodable<double>::value,
+	containers::DefaultAllocator,
+	std::uint32_t
+>;
+
+typedef boost::mpl::list<
+	CompactIndexPolicy,
+	CompactIndexPolicyWith<containers::priority_queues::RadixHeap, containers::search_trees::BTree>,
+	CompactIndexPolicyWith<containers::priority_queues::CalendarQueue, containers::search_trees::FlatSearchTree>,
+	CompactIndexPolicyWith<containers::priority_queues::LazyHeap, containers::search_trees::CompactAVLTree>
+> IndexPolicies;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(compact_index_policy_gives_same_diagram, IndexPolicy, IndexPolicies) {
+	const int site_count = 3000;
+	
+	std::mt19937 rng;
+	std::uniform_real_distribution<double> site_dist(0, 1);
+	
+	containers::Array<Point<>> sites(site_count);
+	for(int sitei = 0; sitei < site_count; ++sitei) {
+		sites[sitei] = Point<>(site_dist(rng), site_dist(rng));
+	}
+	
+	VoronoiDiagram<> expected = computeVoronoiDiagram(sites);
+	VoronoiDiagram<double, containers::DefaultAllocator, std::uint32_t> vd =
+		computeVoronoiDiagram<IndexPolicy>(sites);
+	
+	BOOST_REQUIRE_EQUAL(vd.getEdgeCount(), expected.getEdgeCount());
+	BOOST_REQUIRE_EQUAL(vd.getVertexCount(), expected.getVertexCount());
+	for(Idx face = 0; face < vd.getFaceCount(); ++face) {
+		BOOST_CHECK_EQUAL(vd.getFaceBoundaryEdge(face), expected.getFaceBoundaryEdge(face));
+	}
+	for(Idx edge = 0; edge < vd.getEdgeCount(); ++edge) {
+		BOOST_CHECK_EQUAL(vd.getIncidentFace(edge), expected.getIncidentFace(edge));
+		BOOST_CHECK_EQUAL(vd.getEndVertex(edge), expected.getEndVertex(edge));
+		BOOST_CHECK_EQUAL(vd.getNextEdge(edge), expected.getNextEdge(edge));
+		BOOST_CHECK_EQUAL(vd.getPreviousEdge(edge), expected.getPreviousEdge(edge));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(geometry_traits_without_circle_top_y_work) {
+	static_assert(HasCircleTopY<double>::value, "double traits have getCircleTopY");
+	static_assert(!HasCircleTopY<long double>::value, "long double traits lack getCircleTopY");
+	
+	const int site_count = 500;
+	
+	std::mt19937 rng;
+	std::uniform_real_distribution<double> site_dist(0, 1);
+	
+	containers::Array<Point<>> sites(site_count);
+	containers::Array<Point<long double>> long_sites(site_count);
+	for(int sitei = 0; sitei < site_count; ++sitei) {
+		sites[sitei] = Point<>(site_dist(rng), site_dist(rng));
+		long_sites[sitei] = Point<long double>(sites[sitei].x, sites[sitei].y);
+	}
+	
+	VoronoiDiagram<> expected = computeVoronoiDiagram(sites);
+	VoronoiDiagram<long double> vd = computeVoronoiDiagram<
+		Policy<long double, containers::priority_queues::BinaryHeap, containers::search_trees::PooledAVLTree>
+	>(long_sites);
+	
+	BOOST_REQUIRE_EQUAL(vd.getEdgeCount(), expected.getEdgeCount());
+	BOOST_REQUIRE_EQUAL(vd.getVertexCount(), expected.getVertexCount());
+	for(Idx edge = 0; edge < vd.getEdgeCount(); ++edge) {
+		BOOST_CHECK_EQUAL(vd.getIncidentFace(edge), expected.getIncidentFace(edge));
+		BOOST_CHECK_EQUAL(vd.getNextEdge(edge), expected.getNextEdge(edge));
+	}
+	for(Idx vertex = 0; vertex < vd.getVertexCount(); ++vertex) {
+		BOOST_CHECK_SMALL((double)vd.getVertexPosition(vertex).x - expected.getVertexPosition(vertex).x, 1e-9);
+		BOOST_CHECK_SMALL((double)vd.getVertexPosition(vertex).y - expected.getVertexPosition(vertex).y, 1e-9);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(too_many_sites_for_index_type_throws) {
+	typedef Policy<
+		double,
+		containers::priority_queues::BinaryHeap,
+		containers::search_trees::PooledAVLTree,
+		fortune::IsEventPriorityEncodable<double>::value,
+		containers::DefaultAllocator,
+		std::uint8_t
+	> SmallIndexPolicy;
+	
+	containers::Array<Point<>> sites(100);
+	for(int sitei = 0; sitei < 100; ++sitei) {
+		sites[sitei] = Point<>(sitei % 10, sitei / 10);
+	}
+	BOOST_CHECK_THROW(computeVoronoiDiagram<SmallIndexPolicy>(sites), std::logic_error);
+	
+	containers::Array<Point<>> few_sites(20);
+	for(int sitei = 0; sitei < 20; ++sitei) {
+		few_sites[sitei] = Point<>(sitei % 5, 0.5 * sitei);
+	}
+	BOOST_CHECK_EQUAL(
+		computeVoronoiDiagram<SmallIndexPolicy>(few_sites).getEdgeCount(),
+		computeVoronoiDiagram(few_sites).getEdgeCount()
+	);
+}
+
+template <
+	template <typename PriorityT, typename AllocatorT, typename IndexT> class EventPriorityQueueT,
+	template <typename ElementT, typename AllocatorT, typename IndexT> class BeachLineSearchTreeT
+>
+using CountingAllocatorPolicy = Policy<
+	double,
+	EventPriorityQueueT,
+	BeachLineSearchTreeT,
+	fortune::IsEventPriorityEncodable<double>::value,
+	CountingAllocator<char>
+>;
+
+typedef boost::mpl::list<
+	CountingAllocatorPolicy<containers::priority_queues::BinaryHeap, containers::search_trees::PooledAVLTree>,
+	CountingAllocatorPolicy<containers::priority_queues::DAryHeap, containers::search_trees::AVLTree>,
+	CountingAllocatorPolicy<containers::priority_queues::RadixHeap, containers::search_trees::BTree>,
+	CountingAllocatorPolicy<containers::priority_queues::LazyHeap, containers::search_trees::CompactAVLTree>,
+	CountingAllocatorPolicy<containers::priority_queues::CalendarQueue, containers::search_trees::FlatSearchTree>
+> AllocatorPolicies;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(policy_allocator_is_used_for_all_memory, AllocatorPolicy, AllocatorPolicies) {
+	const int site_count = 2000;
+	
+	std::mt19937 rng;
+	std::uniform_real_distribution<double> site_dist(0, 1);
+	
+	containers::Array<Point<>> sites(site_count);
+	for(int sitei = 0; sitei < site_count; ++sitei) {
+		sites[sitei] = Point<>(site_dist(rng), site_dist(rng));
+	}
+	
+	VoronoiDiagram<> expected = computeVoronoiDiagram(sites);
+	
+	std::size_t allocations_before = allocation_count;
+	std::size_t allocator_allocations_before = counting_allocator_allocations;
+	{
+		VoronoiDiagram<double, CountingAllocator<char>> vd =
+			computeVoronoiDiagram<AllocatorPolicy>(sites);
+		BOOST_CHECK_EQUAL(allocation_count - allocations_before, 0);
+		BOOST_CHECK(counting_allocator_allocations > allocator_allocations_before);
+		
+		// Only the output diagram is still allocated.
+		BOOST_CHECK(counting_allocator_live_blocks > 0);
+		
+		BOOST_REQUIRE_EQUAL(vd.getEdgeCount(), expected.getEdgeCount());
+		for(Idx edge = 0; edge < vd.getEdgeCount(); ++edge) {
+			BOOST_CHECK_EQUAL(vd.getNextEdge(edge), expected.getNextEdge(edge));
+		}
+	}
+	BOOST_CHECK_EQUAL(counting_allocator_live_blocks, 0);
+}
+
+template <
+	template <typename PriorityT, typename AllocatorT, typename IndexT> class EventPriorityQueueT,
+	template <typename ElementT, typename AllocatorT, typename IndexT> class BeachLineSearchTreeT
+>
+using ArenaAllocatorPolicy = Policy<
+	double,
+	EventPriorityQueueT,
+	BeachLineSearchTreeT,
+	fortune::IsEventPriorityEncodable<double>::value,
+	ArenaAllocator<char>
+>;
+
+typedef boost::mpl::list<
+	ArenaAllocatorPolicy<containers::priority_queues::BinaryHeap, containers::search_trees::PooledAVLTree>,
+	ArenaAllocatorPolicy<containers::priority_queues::DAryHeap, containers::search_trees::AVLTree>,
+	ArenaAllocatorPolicy<containers::priority_queues::RadixHeap, containers::search_trees::BTree>,
+	ArenaAllocatorPolicy<containers::priority_queues::LazyHeap, containers::search_trees::CompactAVLTree>,
+	ArenaAllocatorPolicy<containers::priority_queues::CalendarQueue, containers::search_trees::FlatSearchTree>
+> ArenaAllocatorPolicies;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(stateful_allocators_keep_their_own_arenas, AllocatorPolicy, ArenaAllocatorPolicies) {
+	typedef fortune::Algorithm<AllocatorPolicy> AlgorithmT;
+	typedef VoronoiDiagram<double, ArenaAllocator<char>> VoronoiDiagramT;
+	
+	std::mt19937 rng;
+	std::uniform_real_distribution<double> site_dist(0, 1);
+	
+	containers::Array<Point<>> sites1(2000);
+	for(Idx sitei = 0; sitei < sites1.getSize(); ++sitei) {
+		sites1[sitei] = Point<>(site_dist(rng), site_dist(rng));
+	}
+	containers::Array<Point<>> sites2(1500);
+	for(Idx sitei = 0; sitei < sites2.getSize(); ++sitei) {
+		sites2[sitei] = Point<>(site_dist(rng), site_dist(rng));
+	}
+	
+	VoronoiDiagram<> expected1 = computeVoronoiDiagram(sites1);
+	VoronoiDiagram<> expected2 = computeVoronoiDiagram(sites2);
+	
+	Arena arena1(1 << 23);
+	Arena arena2(1 << 23);
+	
+	std::size_t allocations_before = allocation_count;
+	{
+		AlgorithmT algorithm1(sites1, false, ArenaAllocator<char>(arena1));
+		AlgorithmT algorithm2(sites2, false, ArenaAllocator<char>(arena2));
+		
+		// Interleave the algorithms so that both arenas are in use at once.
+		while(!algorithm1.isFinished() || !algorithm2.isFinished()) {
+			if(!algorithm1.isFinished()) algorithm1.step();
+			if(!algorithm2.isFinished()) algorithm2.step();
+		}
+		
+		// Moved diagrams keep their arenas and copies select theirs.
+		VoronoiDiagramT vd1 = AlgorithmT::extractVoronoiDiagram(std::move(algorithm1));
+		VoronoiDiagramT vd2 = AlgorithmT::extractVoronoiDiagram(std::move(algorithm2));
+		std::size_t used_before_copy = arena1.getUsed();
+		VoronoiDiagramT vd1_copy(vd1);
+		BOOST_CHECK(arena1.getUsed() > used_before_copy);
+		BOOST_CHECK(arena1.getCopySelectionCount() > 0);
+		BOOST_CHECK_EQUAL(arena2.getCopySelectionCount(), 0);
+		
+		BOOST_CHECK_EQUAL(allocation_count - allocations_before, 0);
+		
+		BOOST_REQUIRE_EQUAL(vd1.getEdgeCount(), expected1.getEdgeCount());
+		BOOST_REQUIRE_EQUAL(vd1_copy.getEdgeCount(), expected1.getEdgeCount());
+		for(Idx edge = 0; edge < vd1.getEdgeCount(); ++edge) {
+			BOOST_CHECK_EQUAL(vd1.getNextEdge(edge), expected1.getNextEdge(edge));
+			BOOST_CHECK_EQUAL(vd1_copy.getNextEdge(edge), expected1.getNextEdge(edge));
+		}
+		BOOST_REQUIRE_EQUAL(vd2.getEdgeCount(), expected2.getEdgeCount());
+		for(Idx edge = 0; edge < vd2.getEdgeCount(); ++edge) {
+			BOOST_CHECK_EQUAL(vd2.getNextEdge(edge), expected2.getNextEdge(edge));
+		}
+	}
+	BOOST_CHECK_EQUAL(arena1.getLiveBlockCount(), 0);
+	BOOST_CHECK_EQUAL(arena2.getLiveBlockCount(), 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -116,4 +116,21 @@ BOOST_AUTO_TEST_CASE(circumcircle_topy_works) {
 	BOOST_CHECK_CLOSE(TraitsT::getCircumcircleTopY(a, b, c), p.y + 1, eps);
 }
 
+BOOST_AUTO_TEST_CASE(circle_topy_matches_circumcircle_topy) {
+	PointT p(-2, 3.5);
+	
+	float angle_a = 1;
+	float angle_b = 1.4;
+	float angle_c = 3.24;
+	
+	PointT a(p.x + std::cos(angle_a), p.y + std::sin(angle_a));
+	PointT b(p.x + std::cos(angle_b), p.y + std::sin(angle_b));
+	PointT c(p.x + std::cos(angle_c), p.y + std::sin(angle_c));
+	
+	PointT center = TraitsT::getCircumcenter(a, b, c);
+	BOOST_CHECK_EQUAL(TraitsT::getCircleTopY(center, a), TraitsT::getCircumcircleTopY(a, b, c));
+	BOOST_CHECK_CLOSE(TraitsT::getCircleTopY(p, a), p.y + 1, eps);
+	BOOST_CHECK_EQUAL(getCircleTopY(center, a, b, c), TraitsT::getCircleTopY(center, a));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
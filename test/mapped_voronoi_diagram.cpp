@@ -0,0 +1,188 @@
+#include <boost/test/unit_test.hpp>
+#include <boost/mpl/list.hpp>
+
+#include <frivol/frivol.hpp>
+#include <frivol/mapped_voronoi_diagram.hpp>
+#include <frivol/voronoi_diagram_file.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace frivol;
+
+namespace {
+
+const char* const diagram_path = "mapped_voronoi_diagram_test.bin";
+
+// Reads the bytes of a file.
+std::vector<unsigned char> readFile(const std::string& path) {
+	std::ifstream file(path, std::ios::binary);
+	return std::vector<unsigned char>(
+		std::istreambuf_iterator<char>(file),
+		std::istreambuf_iterator<char>()
+	);
+}
+
+// Writes bytes to a file.
+void writeFile(const std::string& path, const std::vector<unsigned char>& bytes) {
+	std::ofstream file(path, std::ios::binary);
+	file.write((const char*)bytes.data(), bytes.size());
+}
+
+// Checks that the mapped diagram has the same accessor values as the
+// diagram.
+template <typename DiagramT, typename MappedDiagramT>
+void checkSameDiagram(const DiagramT& diagram, const MappedDiagramT& mapped) {
+	BOOST_REQUIRE_EQUAL(mapped.getFaceCount(), diagram.getFaceCount());
+	BOOST_REQUIRE_EQUAL(mapped.getEdgeCount(), diagram.getEdgeCount());
+	BOOST_REQUIRE_EQUAL(mapped.getVertexCount(), diagram.getVertexCount());
+	for(Idx face = 0; face < diagram.getFaceCount(); ++face) {
+		BOOST_CHECK_EQUAL(mapped.getFaceBoundaryEdge(face), diagram.getFaceBoundaryEdge(face));
+	}
+	for(Idx edge = 0; edge < diagram.getEdgeCount(); ++edge) {
+		BOOST_CHECK_EQUAL(mapped.getTwinEdge(edge), diagram.getTwinEdge(edge));
+		BOOST_CHECK_EQUAL(mapped.getIncidentFace(edge), diagram.getIncidentFace(edge));
+		BOOST_CHECK_EQUAL(mapped.getStartVertex(edge), diagram.getStartVertex(edge));
+		BOOST_CHECK_EQUAL(mapped.getEndVertex(edge), diagram.getEndVertex(edge));
+		BOOST_CHECK_EQUAL(mapped.getNextEdge(edge), diagram.getNextEdge(edge));
+		BOOST_CHECK_EQUAL(mapped.getPreviousEdge(edge), diagram.getPreviousEdge(edge));
+	}
+	for(Idx vertex = 0; vertex < diagram.getVertexCount(); ++vertex) {
+		BOOST_CHECK_EQUAL(mapped.getVertexPosition(vertex).x, diagram.getVertexPosition(vertex).x);
+		BOOST_CHECK_EQUAL(mapped.getVertexPosition(vertex).y, diagram.getVertexPosition(vertex).y);
+	}
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(mapped_voronoi_diagram)
+
+typedef boost::mpl::list<DefaultPolicy, CompactIndexPolicy> FilePolicies;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(written_diagram_maps_to_same_diagram, FilePolicy, FilePolicies) {
+	typedef typename FilePolicy::Index IndexT;
+	
+	std::mt19937 rng;
+	std::uniform_real_distribution<double> site_dist(0, 1);
+	for(int site_count : {0, 1, 2, 3, 10, 2000}) {
+		containers::Array<Point<>> sites(site_count);
+		for(int i = 0; i < site_count; ++i) {
+			sites[i] = Point<>(site_dist(rng), site_dist(rng));
+		}
+		
+		auto diagram = computeVoronoiDiagram<FilePolicy>(sites);
+		writeVoronoiDiagram(diagram, diagram_path);
+		
+		MappedVoronoiDiagram<double, IndexT> mapped(diagram_path);
+		checkSameDiagram(diagram, mapped);
+		BOOST_CHECK_EQUAL(mapped.getMappedSize(), readFile(diagram_path).size());
+		
+		// Moving keeps the mapping.
+		MappedVoronoiDiagram<double, IndexT> moved(std::move(mapped));
+		BOOST_CHECK_EQUAL(mapped.getEdgeCount(), 0);
+		checkSameDiagram(diagram, moved);
+	}
+	std::remove(diagram_path);
+}
+
+BOOST_AUTO_TEST_CASE(file_layout_is_little_endian_and_aligned) {
+	containers::Array<Point<>> sites(3);
+	sites[0] = Point<>(0, 0);
+	sites[1] = Point<>(1, 0);
+	sites[2] = Point<>(0, 1);
+	VoronoiDiagram<> diagram = computeVoronoiDiagram(sites);
+	writeVoronoiDiagram(diagram, diagram_path);
+	std::vector<unsigned char> bytes = readFile(diagram_path);
+	
+	BOOST_REQUIRE(bytes.size() >= VoronoiDiagramFileHeader::size);
+	BOOST_CHECK_EQUAL(std::string(bytes.begin(), bytes.begin() + 8), "FRIVOLVD");
+	BOOST_CHECK_EQUAL(bytes[8], 1);
+	BOOST_CHECK_EQUAL(bytes[9], 0);
+	BOOST_CHECK_EQUAL(bytes[12], sizeof(Idx));
+	
+	VoronoiDiagramFileHeader header =
+		VoronoiDiagramFileHeader::decode<double, Idx>(bytes.data(), bytes.size());
+	BOOST_CHECK_EQUAL(header.edge_count, diagram.getEdgeCount());
+	BOOST_CHECK_EQUAL(header.vertex_count, 1);
+	BOOST_CHECK_EQUAL(header.edges_offset % VoronoiDiagramFileHeader::alignment, 0);
+	BOOST_CHECK_EQUAL(header.vertices_offset % VoronoiDiagramFileHeader::alignment, 0);
+	BOOST_CHECK_EQUAL(header.faces_offset % VoronoiDiagramFileHeader::alignment, 0);
+	BOOST_CHECK_EQUAL(header.file_size, bytes.size());
+	
+	// The incident face of the second half-edge is its second field.
+	const unsigned char* face_bytes = &bytes[header.edges_offset + 5 * sizeof(Idx)];
+	BOOST_CHECK_EQUAL(loadLittleEndian<Idx>(face_bytes), diagram.getIncidentFace(1));
+	BOOST_CHECK_EQUAL(face_bytes[0], diagram.getIncidentFace(1));
+	
+	std::remove(diagram_path);
+}
+
+BOOST_AUTO_TEST_CASE(invalid_files_are_rejected) {
+	typedef MappedVoronoiDiagram<> MappedT;
+	
+	std::remove(diagram_path);
+	BOOST_CHECK_THROW(MappedT mapped(diagram_path), std::runtime_error);
+	
+	containers::Array<Point<>> sites(100);
+	std::mt19937 rng;
+	std::uniform_real_distribution<double> site_dist(0, 1);
+	for(Idx i = 0; i < sites.getSize(); ++i) {
+		sites[i] = Point<>(site_dist(rng), site_dist(rng));
+	}
+	writeVoronoiDiagram(computeVoronoiDiagram(sites), diagram_path);
+	std::vector<unsigned char> bytes = readFile(diagram_path);
+	
+	// Wrong types.
+	typedef MappedVoronoiDiagram<float, Idx> FloatMappedT;
+	typedef MappedVoronoiDiagram<double, std::uint32_t> CompactMappedT;
+	BOOST_CHECK_THROW(FloatMappedT mapped(diagram_path), std::runtime_error);
+	BOOST_CHECK_THROW(CompactMappedT mapped(diagram_path), std::runtime_error);
+	
+	// Truncated file.
+	std::vector<unsigned char> truncated(bytes.begin(), bytes.end() - 1);
+	writeFile(diagram_path, truncated);
+	BOOST_CHECK_THROW(MappedT mapped(diagram_path), std::runtime_error);
+	
+	// Other version.
+	std::vector<unsigned char> other_version = bytes;
+	other_version[8] = 2;
+	writeFile(diagram_path, other_version);
+	BOOST_CHECK_THROW(MappedT mapped(diagram_path), std::runtime_error);
+	
+	// Not a diagram file.
+	std::vector<unsigned char> other_magic = bytes;
+	other_magic[0] = 'X';
+	writeFile(diagram_path, other_magic);
+	MappedT mapped;
+	BOOST_CHECK_THROW(mapped.open(diagram_path), std::runtime_error);
+	BOOST_CHECK_EQUAL(mapped.getFaceCount(), 0);
+	
+	// A header claiming so many edges that the section sizes wrap around to
+	// a layout that matches the counts.
+	VoronoiDiagramFileHeader huge_header =
+		VoronoiDiagramFileHeader::create<double, Idx>(0, (Idx)1 << 61, 0);
+	BOOST_CHECK(huge_header.file_size <= VoronoiDiagramFileHeader::size);
+	std::vector<unsigned char> huge(VoronoiDiagramFileHeader::size);
+	huge_header.encode(huge.data());
+	writeFile(diagram_path, huge);
+	BOOST_CHECK_THROW(mapped.open(diagram_path), std::runtime_error);
+	BOOST_CHECK_EQUAL(mapped.getEdgeCount(), 0);
+	BOOST_CHECK_THROW(
+		(VoronoiDiagramFileHeader::decode<double, Idx>(huge.data(), huge.size())),
+		std::runtime_error
+	);
+	
+	writeFile(diagram_path, bytes);
+	mapped.open(diagram_path);
+	BOOST_CHECK_EQUAL(mapped.getFaceCount(), 100);
+	
+	std::remove(diagram_path);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
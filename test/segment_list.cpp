@@ -0,0 +1,109 @@
+#include <boost/test/unit_test.hpp>
+
+#include <frivol/frivol.hpp>
+#include <frivol/segment_list.hpp>
+
+#include <random>
+
+using namespace frivol;
+
+BOOST_AUTO_TEST_SUITE(segment_list)
+
+BOOST_AUTO_TEST_CASE(half_edges_set_segment_ends) {
+	SegmentList<> segments(3);
+	BOOST_CHECK_EQUAL(segments.getFaceCount(), 3);
+	
+	Idx edge1, edge2;
+	std::tie(edge1, edge2) = segments.addEdge(0, 1);
+	BOOST_CHECK_EQUAL(segments.getTwinEdge(edge1), edge2);
+	BOOST_CHECK_EQUAL(segments.getTwinEdge(edge2), edge1);
+	segments.addEdge(1, 2);
+	segments.addEdge(2, 0);
+	BOOST_REQUIRE_EQUAL(segments.getSegmentCount(), 3);
+	BOOST_CHECK_EQUAL(segments.getLeftFace(0), 0);
+	BOOST_CHECK_EQUAL(segments.getRightFace(0), 1);
+	BOOST_CHECK_EQUAL(segments.getStartVertex(0), nil_idx);
+	BOOST_CHECK_EQUAL(segments.getEndVertex(0), nil_idx);
+	
+	Idx vertex = segments.addVertex(Point<>(1, 2), edge1, 3, 4);
+	BOOST_CHECK_EQUAL(vertex, 0);
+	BOOST_CHECK_EQUAL(segments.getVertexCount(), 1);
+	BOOST_CHECK_EQUAL(segments.getVertexPosition(0).x, 1);
+	BOOST_CHECK_EQUAL(segments.getVertexPosition(0).y, 2);
+	BOOST_CHECK_EQUAL(segments.getStartVertex(0), nil_idx);
+	BOOST_CHECK_EQUAL(segments.getEndVertex(0), 0);
+	BOOST_CHECK_EQUAL(segments.getStartVertex(1), 0);
+	BOOST_CHECK_EQUAL(segments.getEndVertex(1), nil_idx);
+	BOOST_CHECK_EQUAL(segments.getStartVertex(2), nil_idx);
+	BOOST_CHECK_EQUAL(segments.getEndVertex(2), 0);
+	
+	segments.reset(2);
+	BOOST_CHECK_EQUAL(segments.getFaceCount(), 2);
+	BOOST_CHECK_EQUAL(segments.getSegmentCount(), 0);
+	BOOST_CHECK_EQUAL(segments.getVertexCount(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(segments_match_voronoi_diagram) {
+	std::mt19937 rng;
+	std::uniform_real_distribution<double> site_dist(0, 1);
+	for(int site_count : {0, 1, 2, 3, 10, 2000}) {
+		containers::Array<Point<>> sites(site_count);
+		for(int i = 0; i < site_count; ++i) {
+			sites[i] = Point<>(site_dist(rng), site_dist(rng));
+		}
+		
+		VoronoiDiagram<> diagram = computeVoronoiDiagram(sites);
+		SegmentList<> segments = computeSegmentList(sites);
+		
+		// The segments are in the order of the first half-edges of the pairs.
+		BOOST_CHECK_EQUAL(segments.getFaceCount(), diagram.getFaceCount());
+		BOOST_REQUIRE_EQUAL(2 * segments.getSegmentCount(), diagram.getEdgeCount());
+		for(Idx segment = 0; segment < segments.getSegmentCount(); ++segment) {
+			Idx edge = 2 * segment;
+			BOOST_CHECK_EQUAL(segments.getLeftFace(segment), diagram.getIncidentFace(edge));
+			BOOST_CHECK_EQUAL(
+				segments.getRightFace(segment),
+				diagram.getIncidentFace(diagram.getTwinEdge(edge))
+			);
+			BOOST_CHECK_EQUAL(segments.getStartVertex(segment), diagram.getStartVertex(edge));
+			BOOST_CHECK_EQUAL(segments.getEndVertex(segment), diagram.getEndVertex(edge));
+		}
+		BOOST_REQUIRE_EQUAL(segments.getVertexCount(), diagram.getVertexCount());
+		for(Idx vertex = 0; vertex < segments.getVertexCount(); ++vertex) {
+			BOOST_CHECK_EQUAL(segments.getVertexPosition(vertex).x, diagram.getVertexPosition(vertex).x);
+			BOOST_CHECK_EQUAL(segments.getVertexPosition(vertex).y, diagram.getVertexPosition(vertex).y);
+		}
+		
+		// A segment takes half the size of the two half-edges, and there are
+		// no face boundary edges.
+		if(site_count >= 10) {
+			BOOST_CHECK(
+				3 * segments.getMemoryUsage().reserved <
+				2 * diagram.getMemoryUsage().reserved
+			);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(memory_usage_matches_estimate) {
+	typedef fortune::Algorithm<DefaultPolicy, SegmentList<>> AlgorithmT;
+	
+	std::mt19937 rng;
+	std::uniform_real_distribution<double> site_dist(0, 1);
+	for(int site_count : {0, 1, 2, 3, 1000}) {
+		containers::Array<Point<>> sites(site_count);
+		for(int i = 0; i < site_count; ++i) {
+			sites[i] = Point<>(site_dist(rng), site_dist(rng));
+		}
+		
+		AlgorithmT algo(sites);
+		algo.finish();
+		BOOST_CHECK_EQUAL(
+			algo.getMemoryUsage().getTotal().reserved,
+			AlgorithmT::estimatePeakMemory(site_count)
+		);
+		BOOST_CHECK_EQUAL(algo.getVoronoiVertexCount(), algo.getOutput().getVertexCount());
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
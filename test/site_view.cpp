@@ -0,0 +1,97 @@
+#include <boost/test/unit_test.hpp>
+
+#include <frivol/frivol.hpp>
+#include <frivol/site_view.hpp>
+
+#include <random>
+#include <vector>
+
+using namespace frivol;
+
+BOOST_AUTO_TEST_SUITE(site_view)
+
+BOOST_AUTO_TEST_CASE(default_view_is_empty) {
+	SiteView<> view;
+	BOOST_CHECK_EQUAL(view.getSize(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(array_view_reads_points) {
+	containers::Array<Point<>> sites(3);
+	sites[0] = Point<>(1, 2);
+	sites[1] = Point<>(3, 4);
+	sites[2] = Point<>(5, 6);
+	
+	SiteView<> view = sites;
+	BOOST_REQUIRE_EQUAL(view.getSize(), 3);
+	for(Idx i = 0; i < 3; ++i) {
+		BOOST_CHECK_EQUAL(view[i].x, sites[i].x);
+		BOOST_CHECK_EQUAL(view[i].y, sites[i].y);
+		BOOST_CHECK_EQUAL(&view.getX(i), &sites[i].x);
+		BOOST_CHECK_EQUAL(&view.getY(i), &sites[i].y);
+	}
+	
+	containers::Array<Point<>> empty;
+	BOOST_CHECK_EQUAL(SiteView<>(empty).getSize(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(strided_views_read_coordinates) {
+	double interleaved[] = {1, 2, 3, 4, 5, 6};
+	SiteView<> interleaved_view(interleaved, interleaved + 1, 3, 2 * sizeof(double));
+	
+	double xs[] = {1, 3, 5};
+	double ys[] = {2, 4, 6};
+	SiteView<> separate_view(xs, ys, 3);
+	
+	struct Record {
+		int id;
+		float x;
+		float y;
+	};
+	Record records[] = {{7, 1, 2}, {8, 3, 4}, {9, 5, 6}};
+	SiteView<float> record_view(&records[0].x, &records[0].y, 3, sizeof(Record));
+	
+	BOOST_REQUIRE_EQUAL(interleaved_view.getSize(), 3);
+	BOOST_REQUIRE_EQUAL(separate_view.getSize(), 3);
+	BOOST_REQUIRE_EQUAL(record_view.getSize(), 3);
+	for(Idx i = 0; i < 3; ++i) {
+		BOOST_CHECK_EQUAL(interleaved_view[i].x, 2 * i + 1);
+		BOOST_CHECK_EQUAL(interleaved_view[i].y, 2 * i + 2);
+		BOOST_CHECK_EQUAL(separate_view.getX(i), 2 * i + 1);
+		BOOST_CHECK_EQUAL(separate_view.getY(i), 2 * i + 2);
+		BOOST_CHECK_EQUAL(record_view[i].x, 2 * i + 1);
+		BOOST_CHECK_EQUAL(record_view[i].y, 2 * i + 2);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(separate_coordinate_arrays_give_same_diagram) {
+	const int site_count = 2000;
+	
+	std::mt19937 rng;
+	std::uniform_real_distribution<double> site_dist(0, 1);
+	
+	containers::Array<Point<>> sites(site_count);
+	std::vector<double> xs(site_count);
+	std::vector<double> ys(site_count);
+	for(int sitei = 0; sitei < site_count; ++sitei) {
+		sites[sitei] = Point<>(site_dist(rng), site_dist(rng));
+		xs[sitei] = sites[sitei].x;
+		ys[sitei] = sites[sitei].y;
+	}
+	
+	VoronoiDiagram<> expected = computeVoronoiDiagram(sites);
+	VoronoiDiagram<> vd = computeVoronoiDiagram(SiteView<>(&xs[0], &ys[0], site_count));
+	
+	BOOST_REQUIRE_EQUAL(vd.getEdgeCount(), expected.getEdgeCount());
+	BOOST_REQUIRE_EQUAL(vd.getVertexCount(), expected.getVertexCount());
+	for(Idx edge = 0; edge < vd.getEdgeCount(); ++edge) {
+		BOOST_CHECK_EQUAL(vd.getIncidentFace(edge), expected.getIncidentFace(edge));
+		BOOST_CHECK_EQUAL(vd.getNextEdge(edge), expected.getNextEdge(edge));
+		BOOST_CHECK_EQUAL(vd.getStartVertex(edge), expected.getStartVertex(edge));
+	}
+	for(Idx vertex = 0; vertex < vd.getVertexCount(); ++vertex) {
+		BOOST_CHECK_EQUAL(vd.getVertexPosition(vertex).x, expected.getVertexPosition(vertex).x);
+		BOOST_CHECK_EQUAL(vd.getVertexPosition(vertex).y, expected.getVertexPosition(vertex).y);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
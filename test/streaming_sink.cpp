@@ -0,0 +1,165 @@
+#include <boost/test/unit_test.hpp>
+
+#include <frivol/frivol.hpp>
+#include <frivol/streaming_sink.hpp>
+
+#include <algorithm>
+#include <random>
+#include <tuple>
+#include <vector>
+
+using namespace frivol;
+
+namespace {
+
+typedef std::tuple<Idx, Idx, Idx, Idx> EdgeTuple;
+
+// Visitor that records everything reported by StreamingSink and checks the
+// order of the reports.
+struct RecordingVisitor {
+	RecordingVisitor(Idx faces) : closed(faces, false), edge_counts(faces, 0) { }
+	
+	void onVertex(Idx vertex, const Point<>& pos) {
+		BOOST_CHECK_EQUAL(vertex, vertices.size());
+		vertices.push_back(pos);
+	}
+	
+	void onEdgeFinished(Idx face1, Idx face2, Idx vertex1, Idx vertex2) {
+		BOOST_CHECK(!closed[face1]);
+		BOOST_CHECK(!closed[face2]);
+		BOOST_CHECK(vertex1 == nil_idx || vertex1 < vertices.size());
+		BOOST_CHECK(vertex2 == nil_idx || vertex2 < vertices.size());
+		edges.push_back(EdgeTuple(face1, face2, vertex1, vertex2));
+		++edge_counts[face1];
+		++edge_counts[face2];
+	}
+	
+	void onFaceClosed(Idx face) {
+		BOOST_CHECK(!closed[face]);
+		closed[face] = true;
+		closed_faces.push_back(face);
+	}
+	
+	std::vector<Point<>> vertices;
+	std::vector<EdgeTuple> edges;
+	std::vector<bool> closed;
+	std::vector<Idx> closed_faces;
+	std::vector<Idx> edge_counts;
+};
+
+// Checks that the reports of the visitor describe the same diagram as
+// computeVoronoiDiagram.
+void checkStreamedDiagram(const containers::Array<Point<>>& sites) {
+	Idx site_count = sites.getSize();
+	RecordingVisitor visitor(site_count);
+	streamVoronoiDiagram(sites, visitor);
+	
+	VoronoiDiagram<> diagram = computeVoronoiDiagram(sites);
+	BOOST_REQUIRE_EQUAL(visitor.vertices.size(), diagram.getVertexCount());
+	for(Idx vertex = 0; vertex < diagram.getVertexCount(); ++vertex) {
+		BOOST_CHECK_EQUAL(visitor.vertices[vertex].x, diagram.getVertexPosition(vertex).x);
+		BOOST_CHECK_EQUAL(visitor.vertices[vertex].y, diagram.getVertexPosition(vertex).y);
+	}
+	
+	// The first half-edge of each pair has the first face of addEdge.
+	std::vector<EdgeTuple> expected;
+	std::vector<Idx> expected_counts(site_count, 0);
+	for(Idx edge = 0; edge < diagram.getEdgeCount(); edge += 2) {
+		Idx twin = diagram.getTwinEdge(edge);
+		expected.push_back(EdgeTuple(
+			diagram.getIncidentFace(edge),
+			diagram.getIncidentFace(twin),
+			diagram.getStartVertex(edge),
+			diagram.getEndVertex(edge)
+		));
+		++expected_counts[diagram.getIncidentFace(edge)];
+		++expected_counts[diagram.getIncidentFace(twin)];
+	}
+	std::vector<EdgeTuple> edges = visitor.edges;
+	std::sort(edges.begin(), edges.end());
+	std::sort(expected.begin(), expected.end());
+	BOOST_CHECK(edges == expected);
+	
+	// Every face with edges is closed once all of its edges are reported.
+	BOOST_CHECK(visitor.edge_counts == expected_counts);
+	for(Idx face = 0; face < site_count; ++face) {
+		BOOST_CHECK_EQUAL(visitor.closed[face], expected_counts[face] != 0);
+	}
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(streaming_sink)
+
+BOOST_AUTO_TEST_CASE(small_inputs_are_streamed) {
+	containers::Array<Point<>> sites;
+	checkStreamedDiagram(sites);
+	
+	sites.resize(1);
+	sites[0] = Point<>(0, 0);
+	checkStreamedDiagram(sites);
+	
+	sites.resize(2);
+	sites[1] = Point<>(1, 0);
+	checkStreamedDiagram(sites);
+	
+	sites.resize(4);
+	sites[0] = Point<>(0, 0);
+	sites[1] = Point<>(1, 0);
+	sites[2] = Point<>(2, 0);
+	sites[3] = Point<>(1, 1);
+	checkStreamedDiagram(sites);
+}
+
+BOOST_AUTO_TEST_CASE(random_inputs_give_same_diagram) {
+	std::mt19937 rng;
+	std::uniform_real_distribution<double> site_dist(0, 1);
+	for(int site_count : {3, 10, 100, 2000}) {
+		containers::Array<Point<>> sites(site_count);
+		for(int i = 0; i < site_count; ++i) {
+			sites[i] = Point<>(site_dist(rng), site_dist(rng));
+		}
+		checkStreamedDiagram(sites);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(stored_edges_stay_on_the_beach_line) {
+	const int site_count = 20000;
+	
+	std::mt19937 rng;
+	std::uniform_real_distribution<double> site_dist(0, 1);
+	containers::Array<Point<>> sites(site_count);
+	for(int i = 0; i < site_count; ++i) {
+		sites[i] = Point<>(site_dist(rng), site_dist(rng));
+	}
+	
+	typedef fortune::Algorithm<DefaultPolicy, StreamingSink<RecordingVisitor>> AlgorithmT;
+	RecordingVisitor visitor(site_count);
+	AlgorithmT algo;
+	algo.getOutput().setVisitor(&visitor);
+	algo.reset(sites);
+	
+	// For uniformly distributed sites, the beach line has about sqrt(n)
+	// arcs at a time.
+	Idx max_open_edges = 0;
+	while(!algo.isFinished()) {
+		algo.step();
+		max_open_edges = std::max(max_open_edges, algo.getOutput().getOpenEdgeCount());
+	}
+	BOOST_CHECK_EQUAL(algo.getOutput().getOpenEdgeCount(), 0);
+	BOOST_CHECK(max_open_edges < site_count / 20);
+	BOOST_CHECK_EQUAL(algo.getVoronoiVertexCount(), visitor.vertices.size());
+	
+	fortune::Algorithm<> full_algo(sites);
+	full_algo.finish();
+	BOOST_CHECK(
+		10 * algo.getMemoryUsage().diagram.reserved <
+		full_algo.getMemoryUsage().diagram.reserved
+	);
+	BOOST_CHECK(
+		algo.getMemoryUsage().getTotal().reserved <=
+		AlgorithmT::estimatePeakMemory(site_count)
+	);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
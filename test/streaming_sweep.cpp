@@ -0,0 +1,227 @@
+#include <boost/test/unit_test.hpp>
+#include <boost/mpl/list.hpp>
+
+#include <frivol/frivol.hpp>
+#include <frivol/containers/search_trees/compact_avl_tree.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace frivol;
+
+namespace {
+
+typedef std::tuple<Idx, Idx, Idx, Idx> EdgeTuple;
+
+// Visitor that records the reported diagram and the order of the reports.
+struct DiagramRecorder {
+	void onVertex(Idx vertex, const Point<>& pos) {
+		BOOST_CHECK_EQUAL(vertex, vertices.size());
+		vertices.push_back(pos);
+	}
+	
+	void onEdgeFinished(Idx face1, Idx face2, Idx vertex1, Idx vertex2) {
+		edges.push_back(EdgeTuple(face1, face2, vertex1, vertex2));
+	}
+	
+	void onFaceClosed(Idx face) {
+		closed_faces.push_back(face);
+	}
+	
+	// Checks that the same diagram was reported to both recorders, up to the
+	// order of the edges and the faces.
+	void checkSame(const DiagramRecorder& expected) const {
+		BOOST_REQUIRE_EQUAL(vertices.size(), expected.vertices.size());
+		for(Idx vertex = 0; vertex < vertices.size(); ++vertex) {
+			BOOST_CHECK_EQUAL(vertices[vertex].x, expected.vertices[vertex].x);
+			BOOST_CHECK_EQUAL(vertices[vertex].y, expected.vertices[vertex].y);
+		}
+		
+		std::vector<EdgeTuple> sorted_edges = edges;
+		std::vector<EdgeTuple> expected_edges = expected.edges;
+		std::sort(sorted_edges.begin(), sorted_edges.end());
+		std::sort(expected_edges.begin(), expected_edges.end());
+		BOOST_CHECK(sorted_edges == expected_edges);
+		
+		std::vector<Idx> sorted_faces = closed_faces;
+		std::vector<Idx> expected_faces = expected.closed_faces;
+		std::sort(sorted_faces.begin(), sorted_faces.end());
+		std::sort(expected_faces.begin(), expected_faces.end());
+		BOOST_CHECK(sorted_faces == expected_faces);
+	}
+	
+	std::vector<Point<>> vertices;
+	std::vector<EdgeTuple> edges;
+	std::vector<Idx> closed_faces;
+};
+
+// Returns uniformly distributed random sites, sorted by their site events if
+// 'sorted' is true.
+std::vector<Point<>> getRandomSites(int site_count, bool sorted) {
+	std::mt19937 rng(site_count);
+	std::uniform_real_distribution<double> site_dist(0, 1);
+	std::vector<Point<>> sites(site_count);
+	for(Point<>& site : sites) {
+		site = Point<>(site_dist(rng), site_dist(rng));
+	}
+	if(sorted) {
+		std::sort(sites.begin(), sites.end(), [](const Point<>& a, const Point<>& b) {
+			return a.y < b.y || (a.y == b.y && a.x < b.x);
+		});
+	}
+	return sites;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(streaming_sweep)
+
+typedef boost::mpl::list<
+	DefaultPolicy,
+	CompactIndexPolicy,
+	Policy<double, containers::priority_queues::DAryHeap, containers::search_trees::BTree>,
+	Policy<double, containers::priority_queues::RadixHeap, containers::search_trees::FlatSearchTree>,
+	Policy<double, containers::priority_queues::LazyHeap, containers::search_trees::CompactAVLTree>,
+	Policy<double, containers::priority_queues::CalendarQueue, containers::search_trees::AVLTree>
+> SweepPolicies;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(sorted_sequence_gives_same_diagram, SweepPolicy, SweepPolicies) {
+	for(int site_count : {0, 1, 2, 3, 10, 100, 3000}) {
+		std::vector<Point<>> sites = getRandomSites(site_count, true);
+		
+		DiagramRecorder expected;
+		streamVoronoiDiagram<SweepPolicy>(SiteView<>(sites.data(), sites.size()), expected, true);
+		
+		DiagramRecorder recorder;
+		streamSortedVoronoiDiagram<SweepPolicy>(sites.begin(), sites.end(), recorder);
+		recorder.checkSame(expected);
+	}
+	
+	// Sites on a horizontal line followed by a site above them.
+	std::vector<Point<>> sites = {
+		Point<>(0, 0), Point<>(1, 0), Point<>(2, 0), Point<>(3, 0), Point<>(1.5, 1)
+	};
+	DiagramRecorder expected;
+	streamVoronoiDiagram<SweepPolicy>(SiteView<>(sites.data(), sites.size()), expected, true);
+	DiagramRecorder recorder;
+	streamSortedVoronoiDiagram<SweepPolicy>(sites.begin(), sites.end(), recorder);
+	recorder.checkSame(expected);
+}
+
+BOOST_AUTO_TEST_CASE(closed_faces_are_evicted) {
+	const int site_count = 100000;
+	std::vector<Point<>> sites = getRandomSites(site_count, true);
+	
+	DiagramRecorder recorder;
+	StreamingSweep<DefaultPolicy, DiagramRecorder> sweep(recorder);
+	for(int site = 0; site < site_count; ++site) {
+		sweep.addSite(sites[site], site);
+	}
+	MemoryUsage memory_before_finish = sweep.getMemoryUsage();
+	sweep.finish();
+	BOOST_CHECK_EQUAL(sweep.getSiteCount(), site_count);
+	BOOST_CHECK_EQUAL(recorder.closed_faces.size(), site_count);
+	
+	// For uniformly distributed sites, the beach line has about sqrt(n)
+	// arcs at a time.
+	BOOST_CHECK(sweep.getMaxResidentSiteCount() < site_count / 50);
+	BOOST_CHECK(
+		50 * memory_before_finish.reserved <
+		estimatePeakMemory(site_count, true)
+	);
+}
+
+BOOST_AUTO_TEST_CASE(incremental_mode_checks_the_site_order) {
+	fortune::Algorithm<DefaultPolicy, StreamingSink<DiagramRecorder>> algo;
+	DiagramRecorder recorder;
+	algo.getOutput().setVisitor(&recorder);
+	BOOST_CHECK_THROW(algo.pushSite(Point<>(0, 0)), std::logic_error);
+	
+	algo.resetIncremental();
+	BOOST_CHECK(!algo.isFinished());
+	Idx slot = algo.pushSite(Point<>(1, 1));
+	BOOST_CHECK(algo.hasPendingSite());
+	BOOST_CHECK_THROW(algo.pushSite(Point<>(2, 1)), std::logic_error);
+	algo.step();
+	BOOST_CHECK(!algo.hasPendingSite());
+	BOOST_CHECK_EQUAL(algo.getResidentSiteCount(), 1);
+	
+	BOOST_CHECK_THROW(algo.pushSite(Point<>(2, 0)), std::logic_error);
+	BOOST_CHECK_THROW(algo.pushSite(Point<>(0, 1)), std::logic_error);
+	BOOST_CHECK(algo.pushSite(Point<>(2, 1)) != slot);
+	algo.step();
+	
+	// Without further sites, the sweep waits.
+	algo.step();
+	BOOST_CHECK(!algo.isFinished());
+	algo.endSites();
+	algo.finish();
+	BOOST_CHECK_EQUAL(recorder.edges.size(), 1);
+	BOOST_CHECK_EQUAL(recorder.closed_faces.size(), 2);
+	BOOST_CHECK_THROW(algo.pushSite(Point<>(3, 3)), std::logic_error);
+}
+
+BOOST_AUTO_TEST_CASE(external_sort_gives_same_diagram) {
+	const int site_count = 5000;
+	const std::string input_path = "streaming_sweep_test_sites.bin";
+	const std::string sorted_path = "streaming_sweep_test_sorted.bin";
+	
+	std::vector<Point<>> sites = getRandomSites(site_count, false);
+	{
+		RecordFileWriter<Point<>> writer(input_path);
+		for(const Point<>& site : sites) {
+			writer.write(site);
+		}
+		writer.close();
+	}
+	
+	DiagramRecorder expected;
+	streamVoronoiDiagram(SiteView<>(sites.data(), sites.size()), expected);
+	
+	// Many runs with a partial last run, merged in one pass, and 100 runs
+	// merged in several passes of three runs.
+	for(std::pair<Idx, Idx> sizes : {std::make_pair(333, 128), std::make_pair(50, 3)}) {
+		sortSiteFile<double>(input_path, sorted_path, sizes.first, sizes.second);
+		
+		Idx record_count = 0;
+		{
+			RecordFileReader<SiteRecord<>> reader(sorted_path, 100);
+			SiteRecord<> prev, record;
+			while(reader.read(record)) {
+				BOOST_REQUIRE(record.index < (std::uint64_t)site_count);
+				BOOST_CHECK_EQUAL(record.x, sites[record.index].x);
+				BOOST_CHECK_EQUAL(record.y, sites[record.index].y);
+				if(record_count != 0) BOOST_CHECK(prev < record);
+				prev = record;
+				++record_count;
+			}
+		}
+		BOOST_CHECK_EQUAL(record_count, site_count);
+		
+		// The temporary runs have been removed.
+		for(Idx run = 0; run < 200; ++run) {
+			std::FILE* file = std::fopen((sorted_path + ".run" + std::to_string(run)).c_str(), "rb");
+			BOOST_CHECK(file == nullptr);
+			if(file != nullptr) std::fclose(file);
+		}
+		
+		DiagramRecorder recorder;
+		streamSortedSiteFile(sorted_path, recorder);
+		recorder.checkSame(expected);
+	}
+	
+	DiagramRecorder recorder;
+	std::remove(input_path.c_str());
+	std::remove(sorted_path.c_str());
+	
+	BOOST_CHECK_THROW(sortSiteFile<double>(input_path, sorted_path, 100), std::runtime_error);
+	BOOST_CHECK_THROW(sortSiteFile<double>(input_path, sorted_path, 100, 1), std::logic_error);
+	BOOST_CHECK_THROW(streamSortedSiteFile(sorted_path, recorder), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -2,6 +2,9 @@
 
 #include <frivol/voronoi_diagram.hpp>
 
+#include <cstdint>
+#include <stdexcept>
+
 using namespace frivol;
 
 BOOST_AUTO_TEST_SUITE(voronoi_diagram)
@@ -91,4 +94,55 @@ BOOST_AUTO_TEST_CASE(consecutive_infinite_works) {
 	BOOST_CHECK_EQUAL(vd.getPreviousEdge(edge1), edge0);
 }
 
+BOOST_AUTO_TEST_CASE(reserve_and_shrink_to_fit_keep_contents) {
+	VoronoiDiagram<double> vd(3);
+	vd.reserve(10, 10);
+	
+	Idx edge0 = vd.addEdge(0, 1).first;
+	Idx edge1 = vd.addEdge(1, 2).first;
+	Idx edge2 = vd.addEdge(2, 0).first;
+	vd.addVertex(Point<double>(1, 2), edge0, edge1, edge2);
+	
+	vd.shrinkToFit();
+	vd.reserve(20, 20);
+	
+	BOOST_CHECK_EQUAL(vd.getFaceCount(), 3);
+	BOOST_CHECK_EQUAL(vd.getEdgeCount(), 6);
+	BOOST_CHECK_EQUAL(vd.getVertexCount(), 1);
+	BOOST_CHECK_EQUAL(vd.getIncidentFace(edge1), 1);
+	BOOST_CHECK_EQUAL(vd.getEndVertex(edge2), 0);
+	BOOST_CHECK_EQUAL(vd.getNextEdge(edge0), vd.getTwinEdge(edge2));
+	BOOST_CHECK_EQUAL(vd.getVertexPosition(0).y, 2);
+}
+
+BOOST_AUTO_TEST_CASE(compact_index_type_keeps_nil_idx) {
+	VoronoiDiagram<double, containers::DefaultAllocator, std::uint32_t> vd(3);
+	BOOST_CHECK_EQUAL(vd.getFaceBoundaryEdge(2), nil_idx);
+	
+	Idx edge0 = vd.addEdge(0, 1).first;
+	Idx edge1 = vd.addEdge(1, 2).first;
+	BOOST_CHECK_EQUAL(vd.getEndVertex(edge0), nil_idx);
+	BOOST_CHECK_EQUAL(vd.getNextEdge(edge1), nil_idx);
+	BOOST_CHECK_EQUAL(vd.getPreviousEdge(edge1), nil_idx);
+	
+	Idx edge2 = vd.addEdge(2, 0).first;
+	vd.addVertex(Point<double>(1, 2), edge0, edge1, edge2);
+	BOOST_CHECK_EQUAL(vd.getFaceBoundaryEdge(2), vd.getTwinEdge(edge1));
+	BOOST_CHECK_EQUAL(vd.getEndVertex(edge2), 0);
+	BOOST_CHECK_EQUAL(vd.getNextEdge(edge0), vd.getTwinEdge(edge2));
+	BOOST_CHECK_EQUAL(vd.getPreviousEdge(vd.getTwinEdge(edge2)), edge0);
+}
+
+BOOST_AUTO_TEST_CASE(index_type_overflow_throws) {
+	typedef VoronoiDiagram<double, containers::DefaultAllocator, std::uint8_t> SmallVoronoiDiagram;
+	BOOST_CHECK_THROW(SmallVoronoiDiagram(300), std::logic_error);
+	
+	// The half-edge IDs must stay below 255.
+	SmallVoronoiDiagram vd(2);
+	for(int i = 0; i < 127; ++i) vd.addEdge(0, 1);
+	BOOST_CHECK_EQUAL(vd.getEdgeCount(), 254);
+	BOOST_CHECK_THROW(vd.addEdge(0, 1), std::logic_error);
+	BOOST_CHECK_EQUAL(vd.getEdgeCount(), 254);
+}
+
 BOOST_AUTO_TEST_SUITE_END()